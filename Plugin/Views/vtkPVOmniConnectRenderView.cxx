@@ -31,6 +31,7 @@
 #include "vtkPVOmniConnectGlobalState.h"
 #include "vtkPVOmniConnectAnimProxy.h"
 #include "vtkPVOmniConnectNamesManager.h"
+#include "OmniConnectProfiler.h"
 
 #include "vtkInformation.h"
 #include "vtkMultiProcessController.h"
@@ -55,10 +56,12 @@
 #include "vtkGlyphSource2D.h"
 #include "vtkPVSynchronizedRenderer.h"
 #include "vtkGeometryRepresentation.h"
+#include "vtkLogger.h"
 
 #include <cassert>
 #include <cstring>
 #include <algorithm>
+#include <sstream>
 
 vtkStandardNewMacro(vtkPVOmniConnectRenderView);
 
@@ -191,6 +194,7 @@ vtkPVOmniConnectRenderView::~vtkPVOmniConnectRenderView()
 {
   //this->UnRegisterProgress(this);
   delete ExplicitConnectionSettings;
+  this->SetProfilingTraceFileName(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -224,7 +228,12 @@ void vtkPVOmniConnectRenderView::GetSettingsFromGlobalInstance(vtkOmniConnectSet
     (bool)omniSettings->GetUseStickLines(),
     (bool)omniSettings->GetUseStickWireframe(),
     (bool)omniSettings->GetUseMeshVolume(),
-    (bool)omniSettings->GetCreateNewOmniSession()
+    (bool)omniSettings->GetCreateNewOmniSession(),
+    (OmniConnectVolumeCompression)omniSettings->GetVolumeCompression(),
+    (bool)omniSettings->GetVolumeHalfFloat(),
+    (float)omniSettings->GetVolumeQuantizationTolerance(),
+    (OmniConnectNormalsEncoding)omniSettings->GetNormalsEncoding(),
+    (bool)omniSettings->GetGenericArraysHalfFloat()
   };
 }
 
@@ -420,8 +429,40 @@ void vtkPVOmniConnectRenderView::Render(bool interactive, bool skip_rendering)
     }
   }
 
+  if (this->ProfilingEnabled)
+    OmniConnectProfiler::ResetStatistics();
+
   this->Superclass::Render(interactive, true); // Workaround: Deal with update requests first, which often leaves mappers in a dirty state. No rendering.
   this->Superclass::Render(interactive, skip_rendering); // Update again to deal with the dirty state. Then render.
+
+  if (this->ProfilingEnabled)
+    this->ReportProfilingStatistics();
+}
+
+void vtkPVOmniConnectRenderView::ReportProfilingStatistics()
+{
+  std::vector<OmniConnectProfiler::Statistic> statistics;
+  OmniConnectProfiler::GetStatistics(statistics);
+  if (statistics.empty())
+    return;
+
+  // Ends up in the log file of the Qt client (pqOmniConnectFileLogger)
+  std::ostringstream summary;
+  summary << "Omniverse Connector frame profile:";
+  for (const OmniConnectProfiler::Statistic& stat : statistics)
+  {
+    if (stat.IsCounter)
+      summary << "\n  " << stat.Name << ": " << (int64_t)stat.Total << " (" << stat.Count << " increments)";
+    else
+      summary << "\n  " << stat.Name << ": " << stat.Total << " ms in " << stat.Count << " calls, max " << stat.Max << " ms";
+  }
+  vtkLog(INFO, << summary.str());
+
+  if (this->ProfilingTraceFileName && *this->ProfilingTraceFileName &&
+    !OmniConnectProfiler::WriteChromeTrace(this->ProfilingTraceFileName))
+  {
+    vtkWarningMacro("Could not write profiling trace to " << this->ProfilingTraceFileName);
+  }
 }
 
 void vtkPVOmniConnectRenderView::PrintSelf(ostream& os, vtkIndent indent)
@@ -486,6 +527,26 @@ void vtkPVOmniConnectRenderView::SetForceTimeVaryingTextures(bool enabled)
 
   this->Modified();
 }
+void vtkPVOmniConnectRenderView::SetTextureEncoding(int encoding)
+{
+  TextureEncoding = encoding;
+
+  if (OmniConnectPass->GetSceneGraph())
+    OmniConnectPass->GetSceneGraph()->SetTextureEncoding(encoding);
+
+  this->Modified();
+}
+void vtkPVOmniConnectRenderView::SetLodTriangleBudgets(int lod1, int lod2, int lod3)
+{
+  LodTriangleBudgets[0] = lod1;
+  LodTriangleBudgets[1] = lod2;
+  LodTriangleBudgets[2] = lod3;
+
+  if (OmniConnectPass->GetSceneGraph())
+    OmniConnectPass->GetSceneGraph()->SetLodTriangleBudgets(lod1, lod2, lod3);
+
+  this->Modified();
+}
 void vtkPVOmniConnectRenderView::SetForceTimeVaryingMaterialParams(bool enabled)
 {
   ForceTimeVaryingMaterialParams = enabled;
@@ -553,5 +614,13 @@ void vtkPVOmniConnectRenderView::SetGlobalTimeScale(double globalTimeScale)
   this->Modified();
 }
 
+void vtkPVOmniConnectRenderView::SetProfilingEnabled(bool enabled)
+{
+  ProfilingEnabled = enabled;
+  OmniConnectProfiler::SetEnabled(enabled);
+
+  this->Modified();
+}
+
 
 
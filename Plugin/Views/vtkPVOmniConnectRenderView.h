@@ -58,6 +58,12 @@ public:
   vtkGetMacro(ForceTimeVaryingTextures, bool);
   vtkBooleanMacro(ForceTimeVaryingTextures, bool);
 
+  virtual void SetTextureEncoding(int);
+  vtkGetMacro(TextureEncoding, int);
+
+  virtual void SetLodTriangleBudgets(int, int, int);
+  vtkGetVector3Macro(LodTriangleBudgets, int);
+
   virtual void SetForceTimeVaryingMaterialParams(bool);
   vtkGetMacro(ForceTimeVaryingMaterialParams, bool);
   vtkBooleanMacro(ForceTimeVaryingMaterialParams, bool);
@@ -81,6 +87,14 @@ public:
   virtual void SetGlobalTimeScale(double);
   vtkGetMacro(GlobalTimeScale, double);
 
+  // Connector timings are logged per frame, and written as a Chrome trace if a trace file name is set
+  virtual void SetProfilingEnabled(bool);
+  vtkGetMacro(ProfilingEnabled, bool);
+  vtkBooleanMacro(ProfilingEnabled, bool);
+
+  vtkSetStringMacro(ProfilingTraceFileName);
+  vtkGetStringMacro(ProfilingTraceFileName);
+
   void Update() override;
   void Render(bool interactive, bool skip_rendering) override;
   void SetViewTime(double value) override;
@@ -96,17 +110,22 @@ protected:
   void ReceiveAnimatedObjects();
   void UpdateActorNamesFromProxy();
   bool HasAnimatedParent(vtkExecutive* exec);
+  void ReportProfilingStatistics();
 
   bool Initialized = false;
 
   bool RenderingEnabled = true;
   bool ForceTimeVaryingTextures = false;
+  int TextureEncoding = 0;
+  int LodTriangleBudgets[3] = { 0, 0, 0 };
   bool ForceTimeVaryingMaterialParams = false;
   bool ForceConsistentWinding = false;
   bool MergeTfIntoVol = false;
   bool LiveWorkflowEnabled = false;
   bool AllowWidgetActors = false;
   double GlobalTimeScale = 1.0;
+  bool ProfilingEnabled = false;
+  char* ProfilingTraceFileName = nullptr;
 
   double ViewTime = 0.0;
 
@@ -71,6 +71,11 @@ vtkPVOmniConnectSettings::vtkPVOmniConnectSettings()
   , UseStickWireframe(false)
   , UseMeshVolume(false)
   , CreateNewOmniSession(true)
+  , VolumeCompression(2)
+  , VolumeHalfFloat(false)
+  , VolumeQuantizationTolerance(0.0)
+  , NormalsEncoding(0)
+  , GenericArraysHalfFloat(false)
 {
   vtkPVOmniConnectGlobalState::GetInstance(); // Make sure a global state instance is created
 }
@@ -86,6 +86,21 @@ public:
   vtkSetMacro(CreateNewOmniSession, int);
   vtkGetMacro(CreateNewOmniSession, int);
 
+  vtkSetMacro(VolumeCompression, int);
+  vtkGetMacro(VolumeCompression, int);
+
+  vtkSetMacro(VolumeHalfFloat, int);
+  vtkGetMacro(VolumeHalfFloat, int);
+
+  vtkSetMacro(VolumeQuantizationTolerance, double);
+  vtkGetMacro(VolumeQuantizationTolerance, double);
+
+  vtkSetMacro(NormalsEncoding, int);
+  vtkGetMacro(NormalsEncoding, int);
+
+  vtkSetMacro(GenericArraysHalfFloat, int);
+  vtkGetMacro(GenericArraysHalfFloat, int);
+
 protected:
   vtkPVOmniConnectSettings();
   ~vtkPVOmniConnectSettings();
@@ -104,6 +119,11 @@ protected:
   int UseStickWireframe;
   int UseMeshVolume;
   int CreateNewOmniSession;
+  int VolumeCompression;
+  int VolumeHalfFloat;
+  double VolumeQuantizationTolerance;
+  int NormalsEncoding;
+  int GenericArraysHalfFloat;
 
   static vtkSmartPointer<vtkPVOmniConnectSettings> Instance;
 
@@ -121,6 +121,20 @@ enum class OmniConnectAxis
   Z
 };
 
+enum class OmniConnectVolumeCompression
+{
+  NONE,
+  ZIP,
+  BLOSC
+};
+
+enum class OmniConnectNormalsEncoding
+{
+  FLOAT,     // float3 normals attribute
+  HALF,      // half3 normals primvar
+  OCTAHEDRAL // int normalsOct primvar, holding two snorm16 components of an octahedral mapping (see ocutils::OctEncodeNormals)
+};
+
 typedef void(*OmniConnectLogCallback)(OmniConnectLogLevel, void*, const char*);
 
 void OmniConnectAuthCallbackFunc(void* userData, bool show, const char* server, uint32_t authHandle) noexcept;
@@ -138,6 +152,12 @@ struct OmniConnectSettings
   bool UsePointInstancer;           // Either use UsdGeomPointInstancer for point data, or otherwise UsdGeomPoints
   bool UseMeshVolume;               // Represent volumes as regular textured meshes
   bool CreateNewOmniSession;        // Find a new Omniverse session directory on creation of the connector, or re-use the last opened one.
+  OmniConnectVolumeCompression VolumeCompression = OmniConnectVolumeCompression::BLOSC; // Codec of the OpenVDB volume output (falls back to ZIP if Blosc is unavailable)
+  bool VolumeHalfFloat = false;             // Store floating point volume grids with 16-bit precision
+  float VolumeQuantizationTolerance = 0.0f; // When > 0, floating point volume values are quantized with at most this absolute error (lossy)
+  OmniConnectNormalsEncoding NormalsEncoding = OmniConnectNormalsEncoding::FLOAT; // Precision of mesh and curve normals (lossy unless FLOAT)
+  bool GenericArraysHalfFloat = false;      // Store scalar floating point generic arrays as half primvars
+  bool DiscardAssetWrites = false;          // With OutputLocal, asset files (textures, volumes) are only counted instead of written, for measuring the connector in isolation
 };
 
 struct OmniConnectEnvironment
@@ -162,7 +182,7 @@ struct OmniConnectGenericArray
   bool PerPoly;
   bool TimeVarying;
 
-  void* Data;
+  void* Data; // Copied by the update call, so it may be modified or released right after
   size_t NumElements;
   OmniConnectType DataType;
 };
@@ -195,6 +215,8 @@ struct OmniConnectMeshData
 	
   void* Points = nullptr; 
   OmniConnectType PointsType = OmniConnectType::UNDEFINED;
+  double PointsBounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}; // Optional precomputed bounds of Points (xmin,xmax,ymin,ymax,zmin,zmax), the extent is computed from Points otherwise
+  bool HasPointsBounds = false;
   void* Normals = nullptr;
   OmniConnectType NormalsType = OmniConnectType::UNDEFINED;
   bool PerPrimNormals = false;
@@ -209,6 +231,14 @@ struct OmniConnectMeshData
   uint64_t NumIndices = 0;
 };
 
+// Decimated levels of detail of a mesh are uploaded as meshes of their own, with ids above those of regular meshes.
+// The connector selects between a mesh and its levels with a LOD variant set on the actor prim.
+constexpr int OmniConnectMaxLodLevels = 3;
+constexpr size_t OmniConnectLodMeshIdBase = size_t(1) << 48;
+
+inline size_t OmniConnectLodMeshId(size_t meshId, int lodLevel) { return OmniConnectLodMeshIdBase + meshId * OmniConnectMaxLodLevels + (lodLevel - 1); }
+inline bool OmniConnectIsLodMeshId(size_t meshId) { return meshId >= OmniConnectLodMeshIdBase; }
+
 struct OmniConnectInstancerData
 {
   static const OmniConnectGeomType GeomType = OmniConnectGeomType::INSTANCER;
@@ -256,6 +286,8 @@ struct OmniConnectInstancerData
   uint64_t NumPoints = 0;
   void* Points = nullptr; 
   OmniConnectType PointsType = OmniConnectType::UNDEFINED;
+  double PointsBounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}; // Optional, see OmniConnectMeshData
+  bool HasPointsBounds = false;
   int* ShapeIndices = nullptr; //if set, one for every point
   void* Scales = nullptr;// 3-vector scale
   OmniConnectType ScalesType = OmniConnectType::UNDEFINED;
@@ -305,6 +337,8 @@ struct OmniConnectCurveData
 
   void* Points = nullptr;
   OmniConnectType PointsType = OmniConnectType::UNDEFINED;
+  double PointsBounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}; // Optional, see OmniConnectMeshData
+  bool HasPointsBounds = false;
   void* Normals = nullptr;
   OmniConnectType NormalsType = OmniConnectType::UNDEFINED;
   bool PerPrimNormals = false;
@@ -25,6 +25,22 @@
 
 #include <cstring>
 #include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define OMNICONNECT_SIMD_X86 1
+  #include <immintrin.h>
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #endif
+  #if defined(__GNUC__) || defined(__clang__)
+    #define OMNICONNECT_TARGET_AVX2 __attribute__((target("avx2")))
+  #else
+    #define OMNICONNECT_TARGET_AVX2
+  #endif
+#endif
 
 namespace ocutils
 {
@@ -137,6 +153,315 @@ namespace ocutils
     color[2] = SrgbToLinear(color[2]);
   } 
 
+  namespace
+  {
+    void SrgbToLinearBatchScalar(const uint8_t* srgb, float* linearRgb, size_t numColors, int components, size_t first = 0)
+    {
+      const float* table = SrgbToLinearTable();
+      for (size_t i = first; i < numColors; ++i)
+      {
+        const uint8_t* in = srgb + components * i;
+        float* out = linearRgb + 3 * i;
+        out[0] = table[in[0]];
+        out[1] = table[in[1]];
+        out[2] = table[in[2]];
+      }
+    }
+
+    // Colors only arrive as bytes, so the conversion is a lookup into the 256-entry table. SSE4.1 and NEON have no gather, and
+    // kernels for them would load every table entry individually just like the scalar loop; only AVX2 gets a kernel.
+#if defined(OMNICONNECT_SIMD_X86)
+    enum class SimdLevel
+    {
+      SCALAR,
+      AVX2
+    };
+
+    SimdLevel DetectSimdLevel()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 0);
+      int maxLeaf = info[0];
+      __cpuid(info, 1);
+      bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+      if (maxLeaf >= 7 && osAvx)
+      {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+          return SimdLevel::AVX2;
+      }
+      return SimdLevel::SCALAR;
+#else
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+      return SimdLevel::SCALAR;
+#endif
+    }
+
+    SimdLevel GetSimdLevel()
+    {
+      static const SimdLevel simdLevel = DetectSimdLevel();
+      return simdLevel;
+    }
+
+    // AVX2 gathers from the byte table; 3-component colors are contiguous in both input and output, so they convert as one channel stream
+    OMNICONNECT_TARGET_AVX2 void SrgbToLinearBatchAvx2(const uint8_t* srgb, float* linearRgb, size_t numColors, int components)
+    {
+      const float* table = SrgbToLinearTable();
+      if (components == 3)
+      {
+        size_t numValues = 3 * numColors, j = 0;
+        for (; j + 8 <= numValues; j += 8)
+        {
+          __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srgb + j)));
+          _mm256_storeu_ps(linearRgb + j, _mm256_i32gather_ps(table, idx, 4));
+        }
+        for (; j < numValues; ++j)
+          linearRgb[j] = table[srgb[j]];
+        return;
+      }
+
+      // Two colors per iteration, alpha lanes are permuted to the end and masked out
+      const __m256i rgbPerm = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+      const __m256i rgbMask = _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+      size_t i = 0;
+      for (; i + 2 <= numColors; i += 2)
+      {
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srgb + 4 * i)));
+        __m256 vals = _mm256_i32gather_ps(table, idx, 4);
+        _mm256_maskstore_ps(linearRgb + 3 * i, rgbMask, _mm256_permutevar8x32_ps(vals, rgbPerm));
+      }
+      SrgbToLinearBatchScalar(srgb, linearRgb, numColors, components, i);
+    }
+#endif
+  }
+
+  void SrgbToLinearBatch(const uint8_t* srgb, float* linearRgb, size_t numColors, int components, float* linearAlpha)
+  {
+    assert(components >= 3);
+
+#if defined(OMNICONNECT_SIMD_X86)
+    if (GetSimdLevel() == SimdLevel::AVX2 && (components == 3 || components == 4))
+      SrgbToLinearBatchAvx2(srgb, linearRgb, numColors, components);
+    else
+#endif
+      SrgbToLinearBatchScalar(srgb, linearRgb, numColors, components);
+
+    if (components > 3 && linearAlpha)
+    {
+      for (size_t i = 0; i < numColors; ++i)
+        linearAlpha[i] = (float)srgb[components * i + 3] / 255.0f;
+    }
+  }
+
+  namespace
+  {
+    inline int32_t FloatToSnorm16(float val)
+    {
+      val = std::min(std::max(val, -1.0f), 1.0f);
+      return (int32_t)std::lround(val * 32767.0f);
+    }
+
+    template<class T>
+    void OctEncodeNormalsT(const T* normals, int32_t* encoded, size_t numNormals)
+    {
+      for (size_t i = 0; i < numNormals; ++i)
+      {
+        float x = (float)normals[3 * i], y = (float)normals[3 * i + 1], z = (float)normals[3 * i + 2];
+
+        // Project onto the octahedron, fold the lower hemisphere over the diagonals
+        float l1Norm = std::fabs(x) + std::fabs(y) + std::fabs(z);
+        float invL1Norm = (l1Norm > 0.0f) ? 1.0f / l1Norm : 0.0f;
+        float octX = x * invL1Norm, octY = y * invL1Norm;
+        if (z < 0.0f)
+        {
+          float foldX = (1.0f - std::fabs(octY)) * (octX >= 0.0f ? 1.0f : -1.0f);
+          float foldY = (1.0f - std::fabs(octX)) * (octY >= 0.0f ? 1.0f : -1.0f);
+          octX = foldX;
+          octY = foldY;
+        }
+
+        uint32_t packedX = (uint16_t)FloatToSnorm16(octX);
+        uint32_t packedY = (uint16_t)FloatToSnorm16(octY);
+        encoded[i] = (int32_t)(packedX | (packedY << 16));
+      }
+    }
+  }
+
+  void OctEncodeNormals(const float* normals, int32_t* encoded, size_t numNormals)
+  {
+    OctEncodeNormalsT(normals, encoded, numNormals);
+  }
+
+  void OctEncodeNormals(const double* normals, int32_t* encoded, size_t numNormals)
+  {
+    OctEncodeNormalsT(normals, encoded, numNormals);
+  }
+
+  void OctDecodeNormals(const int32_t* encoded, float* normals, size_t numNormals)
+  {
+    for (size_t i = 0; i < numNormals; ++i)
+    {
+      uint32_t packed = (uint32_t)encoded[i];
+      float x = std::max((int16_t)(packed & 0xFFFF) / 32767.0f, -1.0f);
+      float y = std::max((int16_t)(packed >> 16) / 32767.0f, -1.0f);
+      float z = 1.0f - std::fabs(x) - std::fabs(y);
+      if (z < 0.0f)
+      {
+        float unfoldX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float unfoldY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = unfoldX;
+        y = unfoldY;
+      }
+
+      float length = std::sqrt(x * x + y * y + z * z);
+      float invLength = (length > 0.0f) ? 1.0f / length : 0.0f;
+      normals[3 * i] = x * invLength;
+      normals[3 * i + 1] = y * invLength;
+      normals[3 * i + 2] = z * invLength;
+    }
+  }
+
+  namespace
+  {
+    const float HalfMaxValue = 65504.0f;
+
+    // Round to nearest even, see F. Giesen's float_to_half_fast3_rtne
+    inline uint16_t FloatToHalfBits(float val)
+    {
+      uint32_t bits;
+      memcpy(&bits, &val, sizeof(bits));
+      uint32_t sign = bits & 0x80000000u;
+      bits ^= sign;
+
+      uint16_t half;
+      if (bits >= 0x47800000u) // Beyond the half exponent range, inf or nan
+      {
+        half = (bits > 0x7F800000u) ? 0x7E00 : 0x7C00;
+      }
+      else if (bits < 0x38800000u) // Subnormal half or zero; the float addition aligns and rounds the mantissa
+      {
+        const uint32_t denormMagicBits = 126u << 23;
+        float denormMagic, shifted;
+        memcpy(&denormMagic, &denormMagicBits, sizeof(float));
+        memcpy(&shifted, &bits, sizeof(float));
+        shifted += denormMagic;
+        uint32_t shiftedBits;
+        memcpy(&shiftedBits, &shifted, sizeof(shiftedBits));
+        half = (uint16_t)(shiftedBits - denormMagicBits);
+      }
+      else
+      {
+        uint32_t mantOdd = (bits >> 13) & 1;
+        bits += ((uint32_t)(15 - 127) << 23) + 0xFFF + mantOdd;
+        half = (uint16_t)(bits >> 13);
+      }
+      return half | (uint16_t)(sign >> 16);
+    }
+
+    template<class T>
+    size_t FloatToHalfT(const T* values, uint16_t* halfs, size_t numValues)
+    {
+      size_t numClamped = 0;
+      for (size_t i = 0; i < numValues; ++i)
+      {
+        float val = (float)values[i];
+        if (std::fabs(val) > HalfMaxValue && std::isfinite(val))
+        {
+          val = std::copysign(HalfMaxValue, val);
+          ++numClamped;
+        }
+        halfs[i] = FloatToHalfBits(val);
+      }
+      return numClamped;
+    }
+  }
+
+  size_t FloatToHalf(const float* values, uint16_t* halfs, size_t numValues)
+  {
+    return FloatToHalfT(values, halfs, numValues);
+  }
+
+  size_t FloatToHalf(const double* values, uint16_t* halfs, size_t numValues)
+  {
+    return FloatToHalfT(values, halfs, numValues);
+  }
+
+  float HalfToFloat(uint16_t half)
+  {
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    float val;
+    if (exponent == 0)
+      val = std::ldexp((float)mantissa, -24);
+    else if (exponent == 31)
+      val = mantissa ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+    else
+      val = std::ldexp((float)(mantissa | 0x400), (int)exponent - 25);
+
+    return (half & 0x8000) ? -val : val;
+  }
+
+  namespace
+  {
+    inline uint64_t HashMix(uint64_t val)
+    {
+      val ^= val >> 33;
+      val *= 0xff51afd7ed558ccdull;
+      val ^= val >> 33;
+      val *= 0xc4ceb9fe1a85ec53ull;
+      val ^= val >> 33;
+      return val;
+    }
+
+    // Non-cryptographic; four independent lanes over 32 byte blocks to keep the multiplies pipelined.
+    // Returns the combined lanes and tail bytes, the lanes themselves are left in lanes for wider digests.
+    uint64_t HashByteLanes(const void* data, size_t size, uint64_t seed, uint64_t lanes[4])
+    {
+      const uint64_t prime = 0x9e3779b97f4a7c15ull;
+      const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+      lanes[0] = seed ^ prime; lanes[1] = seed + prime; lanes[2] = ~seed; lanes[3] = seed ^ (prime >> 1);
+      size_t pos = 0;
+      for (; pos + 32 <= size; pos += 32)
+      {
+        for (int l = 0; l < 4; ++l)
+        {
+          uint64_t word;
+          memcpy(&word, bytes + pos + 8 * l, sizeof(word));
+          lanes[l] = (lanes[l] ^ word) * prime;
+          lanes[l] ^= lanes[l] >> 29;
+        }
+      }
+
+      uint64_t hash = HashMix(size ^ lanes[0]) ^ HashMix(lanes[1] + 1) ^ HashMix(lanes[2] + 2) ^ HashMix(lanes[3] + 3);
+      for (; pos < size; pos += 8)
+      {
+        uint64_t word = 0;
+        memcpy(&word, bytes + pos, std::min(size - pos, sizeof(word)));
+        hash = HashMix((hash ^ word) * prime);
+      }
+      return hash;
+    }
+  }
+
+  uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+  {
+    uint64_t lanes[4];
+    return HashMix(HashByteLanes(data, size, seed, lanes));
+  }
+
+  void HashBytes128(const void* data, size_t size, uint64_t hash[2])
+  {
+    uint64_t lanes[4];
+    uint64_t tail = HashByteLanes(data, size, hash[0] ^ HashMix(hash[1] + size), lanes);
+    hash[0] = HashMix(tail);
+    hash[1] = HashMix(HashMix(lanes[0] ^ lanes[3]) + HashMix(lanes[1] ^ (lanes[2] << 1)) + tail);
+  }
+
 }
 
 std::ostream& operator<<(std::ostream& stream, const OmniConnectType& type)
@@ -27,6 +27,8 @@
 #include <OmniConnectData.h>
 
 #include <ostream>
+#include <cstdint>
+#include <cstddef>
 
 namespace ocutils
 {
@@ -35,6 +37,25 @@ namespace ocutils
   const float* SrgbToLinearTable(); // returns a float[256] array
   float SrgbToLinear(float val);
   void SrgbToLinear3(float* color); // expects a float[3]
+
+  // Converts numColors interleaved colors of 3 or 4 components to linear rgb triplets in linearRgb (float[3*numColors]).
+  // For 4 components, the alpha channel is written to linearAlpha (float[numColors]) if not null, normalized to [0,1].
+  void SrgbToLinearBatch(const uint8_t* srgb, float* linearRgb, size_t numColors, int components, float* linearAlpha = nullptr);
+
+  // Encodes unit normals as two snorm16 components of an octahedral mapping, packed into an int32 with x in the low and y in the high 16 bits.
+  // Decoding: (x, y) /= 32767; n = (x, y, 1 - |x| - |y|); if n.z < 0: n.xy = (1 - |n.yx|) * sign(n.xy); normalize(n).
+  void OctEncodeNormals(const float* normals, int32_t* encoded, size_t numNormals);
+  void OctEncodeNormals(const double* normals, int32_t* encoded, size_t numNormals);
+  void OctDecodeNormals(const int32_t* encoded, float* normals, size_t numNormals);
+
+  // Converts to IEEE half floats with round to nearest even. Finite values beyond the half range are clamped to +-65504 instead of
+  // turning into infinities; returns the number of clamped values.
+  size_t FloatToHalf(const float* values, uint16_t* halfs, size_t numValues);
+  size_t FloatToHalf(const double* values, uint16_t* halfs, size_t numValues);
+  float HalfToFloat(uint16_t half);
+
+  uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+  void HashBytes128(const void* data, size_t size, uint64_t hash[2]); // Combines data into the running 128-bit hash
 }
 
 std::ostream& operator<<(std::ostream& stream, const OmniConnectType& type);
@@ -22,6 +22,8 @@
 ###############################################################################*/
 
 #include "OmniConnectConnection.h"
+#include "OmniConnectWriteQueue.h"
+#include "OmniConnectProfiler.h"
 
 #include <fstream>
 #include <atomic>
@@ -75,6 +77,12 @@ namespace fs = std::filesystem;
 
 OmniConnectLogCallback OmniConnectConnection::LogCallback = nullptr;
 void* OmniConnectConnection::LogUserData = nullptr;
+thread_local std::string OmniConnectConnection::TempUrl;
+
+OmniConnectConnection::~OmniConnectConnection()
+{
+  DestroyWriteQueue();
+}
 
 const char* OmniConnectConnection::GetBaseUrl() const
 {
@@ -90,14 +98,66 @@ const char* OmniConnectConnection::GetUrl(const char* path) const
 bool OmniConnectConnection::Initialize(const OmniConnectConnectionSettings& settings, 
   OmniConnectLogCallback logCallback, void* logUserData)
 {
+  // On re-initialization, pending writes still belong to the previous settings, and the queue is rebuilt when its parameters change
+  if (WriteQueue)
+  {
+    if (WriteQueue->GetNumThreads() != settings.NumWriteThreads || WriteQueue->GetMaxPendingBytes() != settings.MaxPendingWriteBytes)
+      DestroyWriteQueue();
+    else
+      Flush();
+  }
+
   Settings = settings;
   OmniConnectConnection::LogCallback = logCallback;
   OmniConnectConnection::LogUserData = logUserData;
+
+  if (!WriteQueue)
+  {
+    WriteQueue = new OmniConnectWriteQueue(
+      [this](const char* data, size_t dataSize, const char* filePath, bool binary)
+      {
+        OMNICONNECT_PROFILE_SCOPE("ConnectionWrite");
+        return this->WriteFileImmediate(data, dataSize, filePath, binary);
+      },
+      Settings.NumWriteThreads, Settings.MaxPendingWriteBytes);
+  }
   return true;
 }
 
 void OmniConnectConnection::Shutdown()
 {
+  Flush();
+}
+
+bool OmniConnectConnection::Flush() const
+{
+  if (!WriteQueue)
+    return true;
+
+  std::vector<std::string> failedPaths;
+  bool success = WriteQueue->WaitAll(&failedPaths);
+  for (const std::string& failedPath : failedPaths)
+  {
+    OmniConnectLogMacro(OmniConnectLogLevel::ERR, "Failed to write file: " << failedPath);
+  }
+  return success;
+}
+
+void OmniConnectConnection::CancelPendingWrite(const char* filePath) const
+{
+  if (WriteQueue)
+    WriteQueue->Cancel(filePath);
+}
+
+void OmniConnectConnection::DestroyWriteQueue()
+{
+  // Has to be called from the destructor of the most derived class, as the queue threads call WriteFileImmediate()
+  if (WriteQueue)
+  {
+    Flush();
+    delete WriteQueue;
+    WriteQueue = nullptr;
+  }
 }
 
 int OmniConnectConnection::MaxSessionNr() const
@@ -132,6 +192,8 @@ bool OmniConnectConnection::CreateFolder(const char* dirName, bool mayExist, boo
 
 bool OmniConnectConnection::RemoveFolder(const char* dirName) const
 {
+  Flush();
+
   bool success = false;
   try
   {
@@ -146,6 +208,18 @@ bool OmniConnectConnection::RemoveFolder(const char* dirName) const
 
 bool OmniConnectConnection::WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary) const
 {
+  OMNICONNECT_PROFILE_COUNT("ConnectionWriteBytes", (int64_t)dataSize);
+
+  if (WriteQueue)
+    return WriteQueue->Enqueue(data, dataSize, filePath, binary);
+
+  OMNICONNECT_PROFILE_SCOPE("ConnectionWrite");
+  return WriteFileImmediate(data, dataSize, filePath, binary);
+}
+
+bool OmniConnectConnection::WriteFileImmediate(const char* data, size_t dataSize, const char* filePath, bool binary) const
+{
+  // Runs concurrently with the main thread, so TempUrl cannot be used
   try
   {
     std::ofstream file(Settings.WorkingDirectory + filePath, std::ios_base::out
@@ -165,6 +239,8 @@ bool OmniConnectConnection::WriteFile(const char* data, size_t dataSize, const c
 
 bool OmniConnectConnection::RemoveFile(const char* filePath) const
 {
+  CancelPendingWrite(filePath);
+
   bool success = false;
   try
   {
@@ -177,6 +253,18 @@ bool OmniConnectConnection::RemoveFile(const char* filePath) const
   return success;
 }
 
+const char* OmniConnectConnection::GetDirectWritePath(const char* filePath) const
+{
+  if (!Settings.DirectFileWrites)
+    return nullptr;
+
+  // The caller's write replaces whatever is still queued for this file
+  CancelPendingWrite(filePath);
+
+  TempUrl = Settings.WorkingDirectory + filePath;
+  return TempUrl.c_str();
+}
+
 bool OmniConnectConnection::ProcessUpdates()
 {
   return true;
@@ -238,7 +326,7 @@ public:
   // To facility the Omniverse path methods
   static constexpr size_t MaxBaseUrlSize = 4096;
   char BaseUrlBuffer[MaxBaseUrlSize];
-  char TempUrlBuffer[MaxBaseUrlSize];
+  static thread_local char TempUrlBuffer[MaxBaseUrlSize]; // Per thread, see OmniConnectConnection::TempUrl
 
   // Status callback handle
   uint32_t StatusCallbackHandle = 0;
@@ -257,6 +345,8 @@ public:
 
 using OmniConnectUrlStrings = OmniConnectRemoteConnectionInternals::UrlStringsType;
 
+thread_local char OmniConnectRemoteConnectionInternals::TempUrlBuffer[OmniConnectRemoteConnectionInternals::MaxBaseUrlSize];
+
 bool OmniConnectRemoteConnection::OmniClientInitialized = false;
 int OmniConnectRemoteConnection::NumInitializedConnInstances = 0;
 int OmniConnectRemoteConnection::ConnectionLogLevel = 0;
@@ -268,6 +358,7 @@ OmniConnectRemoteConnection::OmniConnectRemoteConnection()
 
 OmniConnectRemoteConnection::~OmniConnectRemoteConnection()
 {
+  DestroyWriteQueue();
   delete Internals;
 }
 
@@ -495,6 +586,8 @@ bool OmniConnectRemoteConnection::Initialize(const OmniConnectConnectionSettings
 
 void OmniConnectRemoteConnection::Shutdown()
 {
+  OmniConnectConnection::Shutdown();
+
   if (ConnectionInitialized && --NumInitializedConnInstances == 0)
   {
     omniClientSetLogCallback(nullptr);
@@ -565,6 +658,8 @@ bool OmniConnectRemoteConnection::CreateFolder(const char* dirName, bool mayExis
 
 bool OmniConnectRemoteConnection::RemoveFolder(const char* dirName) const
 {
+  Flush();
+
   DefaultContext context;
 
   const char* dirUrl = this->GetUrl(dirName);
@@ -582,12 +677,24 @@ bool OmniConnectRemoteConnection::RemoveFolder(const char* dirName) const
 
 bool OmniConnectRemoteConnection::WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary) const
 {
-  (void)binary;
   OmniConnectLogMacro(OmniConnectLogLevel::STATUS, "Copying data to: " << filePath);
 
+  return OmniConnectConnection::WriteFile(data, dataSize, filePath, binary);
+}
+
+bool OmniConnectRemoteConnection::WriteFileImmediate(const char* data, size_t dataSize, const char* filePath, bool binary) const
+{
+  (void)binary;
+
   DefaultContext context;
 
-  const char* fileUrl = this->GetUrl(filePath);
+  // Runs concurrently with the main thread, so the shared TempUrlBuffer cannot be used
+  char fileUrlBuffer[OmniConnectRemoteConnectionInternals::MaxBaseUrlSize];
+  size_t parsedBufSize = OmniConnectRemoteConnectionInternals::MaxBaseUrlSize;
+  const char* fileUrl = omniClientCombineUrls(Internals->BaseUrlBuffer, filePath, fileUrlBuffer, &parsedBufSize);
+  if (!fileUrl)
+    return false;
+
   OmniClientContent omniContent{ (void*)data, dataSize, nullptr };
   omniClientWait( omniClientWriteFile(fileUrl, &omniContent, &context, [](void* userData, OmniClientResult result) OMNICLIENT_NOEXCEPT
     {
@@ -600,8 +707,15 @@ bool OmniConnectRemoteConnection::WriteFile(const char* data, size_t dataSize, c
   return context.result == eOmniClientResult_Ok || context.result == eOmniClientResult_OkLatest;
 }
 
+const char* OmniConnectRemoteConnection::GetDirectWritePath(const char* filePath) const
+{
+  return nullptr; // All writes go through the client library
+}
+
 bool OmniConnectRemoteConnection::RemoveFile(const char* filePath) const
 {
+  CancelPendingWrite(filePath);
+
   DefaultContext context;
   OmniConnectLogMacro(OmniConnectLogLevel::STATUS, "Removing file: " << filePath);
 
@@ -815,11 +929,21 @@ bool OmniConnectRemoteConnection::WriteFile(const char* data, size_t dataSize, c
   return OmniConnectConnection::WriteFile(data, dataSize, filePath, binary);
 }
 
+bool OmniConnectRemoteConnection::WriteFileImmediate(const char* data, size_t dataSize, const char* filePath, bool binary) const
+{
+  return OmniConnectConnection::WriteFileImmediate(data, dataSize, filePath, binary);
+}
+
 bool OmniConnectRemoteConnection::RemoveFile(const char* filePath) const
 {
   return OmniConnectConnection::RemoveFile(filePath);
 }
 
+const char* OmniConnectRemoteConnection::GetDirectWritePath(const char* filePath) const
+{
+  return OmniConnectConnection::GetDirectWritePath(filePath);
+}
+
 bool OmniConnectRemoteConnection::ProcessUpdates()
 {
   OmniConnectConnection::ProcessUpdates();
@@ -875,6 +999,7 @@ OmniConnectLocalConnection::OmniConnectLocalConnection()
 
 OmniConnectLocalConnection::~OmniConnectLocalConnection()
 {
+  DestroyWriteQueue();
 }
 
 const char* OmniConnectLocalConnection::GetBaseUrl() const
@@ -946,6 +1071,11 @@ bool OmniConnectLocalConnection::RemoveFile(const char* filePath) const
   return OmniConnectConnection::RemoveFile(filePath);
 }
 
+const char* OmniConnectLocalConnection::GetDirectWritePath(const char* filePath) const
+{
+  return OmniConnectConnection::GetDirectWritePath(filePath);
+}
+
 bool OmniConnectLocalConnection::ProcessUpdates()
 {
   OmniConnectConnection::ProcessUpdates();
@@ -978,3 +1108,40 @@ void OmniConnectLocalConnection::CancelOmniClientAuth(uint32_t authHandle)
   OmniConnectConnection::CancelOmniClientAuth(authHandle);
 }
 
+OmniConnectNullConnection::OmniConnectNullConnection()
+{
+}
+
+OmniConnectNullConnection::~OmniConnectNullConnection()
+{
+}
+
+void OmniConnectNullConnection::Shutdown()
+{
+  OmniConnectLocalConnection::Shutdown();
+
+  OmniConnectLogMacro(OmniConnectLogLevel::STATUS, "Null connection discarded " << NumWriteCalls << " file writes ("
+    << NumWrittenBytes << " bytes), " << NumRemoveCalls << " file removals.");
+}
+
+bool OmniConnectNullConnection::WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary) const
+{
+  ++NumWriteCalls;
+  NumWrittenBytes += dataSize;
+  OMNICONNECT_PROFILE_COUNT("DiscardedWriteBytes", (int64_t)dataSize);
+  return true;
+}
+
+bool OmniConnectNullConnection::RemoveFile(const char* filePath) const
+{
+  ++NumRemoveCalls;
+
+  // Usd layers do exist on disk
+  return OmniConnectLocalConnection::RemoveFile(filePath);
+}
+
+const char* OmniConnectNullConnection::GetDirectWritePath(const char* filePath) const
+{
+  // All data has to pass through WriteFile to be counted
+  return nullptr;
+}
@@ -29,21 +29,26 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <atomic>
 
 class OmniConnectRemoteConnectionInternals;
+class OmniConnectWriteQueue;
 
 struct OmniConnectConnectionSettings
 {
   std::string HostName;
   std::string WorkingDirectory;
   bool CheckWritePermissions;
+  size_t NumWriteThreads = 4; // WriteFile is performed asynchronously by this many threads, 0 for synchronous writes
+  size_t MaxPendingWriteBytes = size_t(512) << 20; // WriteFile blocks when the queued data exceeds this size
+  bool DirectFileWrites = true; // Allow large outputs to be streamed directly into files, bypassing WriteFile (local filesystem only)
 };
 
 class OmniConnectConnection
 {
 public:
   OmniConnectConnection() {}
-  virtual ~OmniConnectConnection() {};
+  virtual ~OmniConnectConnection();
 
   virtual const char* GetBaseUrl() const = 0;
   virtual const char* GetUrl(const char* path) const = 0;
@@ -58,9 +63,16 @@ public:
   virtual bool RemoveFolder(const char* dirName) const = 0;
   virtual bool WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary = true) const = 0;
   virtual bool RemoveFile(const char* filePath) const = 0;
+
+  // Returns a filesystem path that the caller can stream filePath's contents into directly, or nullptr if not supported.
+  // Pending writes to filePath are dropped; the returned string is valid until the next GetUrl call.
+  virtual const char* GetDirectWritePath(const char* filePath) const;
   
   virtual bool ProcessUpdates() = 0;
 
+  // Waits for all WriteFile calls to complete, returns false if any of them failed.
+  bool Flush() const;
+
   virtual const char* GetOmniUser(const char* serverUrl) const = 0;
   virtual OmniConnectUrlInfoList GetOmniConnectUrlInfoList(const char* serverUrl) = 0;
   virtual const char* GetOmniClientVersion() = 0;
@@ -75,7 +87,14 @@ public:
 
 protected:
 
-  mutable std::string TempUrl;
+  // Performs the actual write, called from the write queue threads
+  virtual bool WriteFileImmediate(const char* data, size_t dataSize, const char* filePath, bool binary) const;
+
+  void CancelPendingWrite(const char* filePath) const;
+  void DestroyWriteQueue();
+
+  static thread_local std::string TempUrl; // Actors are authored concurrently, which all build urls
+  OmniConnectWriteQueue* WriteQueue = nullptr;
 };
 
 
@@ -98,6 +117,7 @@ public:
   bool RemoveFolder(const char* dirName) const override;
   bool WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary = true) const override;
   bool RemoveFile(const char* filePath) const override;
+  const char* GetDirectWritePath(const char* filePath) const override;
 
   bool ProcessUpdates() override;
 
@@ -110,6 +130,30 @@ public:
 protected:
 };
 
+// Local connection that discards all files written through it, only counting the calls and bytes.
+// Usd layers are still saved by Usd itself. Meant for measuring the connector without storage or network costs.
+class OmniConnectNullConnection : public OmniConnectLocalConnection
+{
+public:
+  OmniConnectNullConnection();
+  ~OmniConnectNullConnection() override;
+
+  void Shutdown() override;
+
+  bool WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary = true) const override;
+  bool RemoveFile(const char* filePath) const override;
+  const char* GetDirectWritePath(const char* filePath) const override;
+
+  size_t GetNumWriteCalls() const { return NumWriteCalls; }
+  size_t GetNumWrittenBytes() const { return NumWrittenBytes; }
+  size_t GetNumRemoveCalls() const { return NumRemoveCalls; }
+
+protected:
+  mutable std::atomic<size_t> NumWriteCalls{0};
+  mutable std::atomic<size_t> NumWrittenBytes{0};
+  mutable std::atomic<size_t> NumRemoveCalls{0};
+};
+
 class OmniConnectRemoteConnection : public OmniConnectConnection
 {
 public:
@@ -129,6 +173,7 @@ public:
   bool RemoveFolder(const char* dirName) const override;
   bool WriteFile(const char* data, size_t dataSize, const char* filePath, bool binary = true) const override;
   bool RemoveFile(const char* filePath) const override;
+  const char* GetDirectWritePath(const char* filePath) const override;
 
   bool ProcessUpdates() override;
 
@@ -146,6 +191,8 @@ public:
 
 protected:
 
+  bool WriteFileImmediate(const char* data, size_t dataSize, const char* filePath, bool binary) const override;
+
   bool CheckWritePermissions();
 
   OmniConnectRemoteConnectionInternals* Internals;
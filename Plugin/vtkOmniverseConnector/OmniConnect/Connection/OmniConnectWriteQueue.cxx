@@ -0,0 +1,211 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#include "OmniConnectWriteQueue.h"
+
+#include <algorithm>
+
+OmniConnectWriteQueue::OmniConnectWriteQueue(WriteFunc writeFunc, size_t numThreads, size_t maxPendingBytes)
+  : WriteFileFunc(writeFunc)
+  , MaxPendingBytes(maxPendingBytes)
+{
+  for (size_t i = 0; i < numThreads; ++i)
+    Workers.emplace_back(&OmniConnectWriteQueue::WorkerLoop, this);
+}
+
+OmniConnectWriteQueue::~OmniConnectWriteQueue()
+{
+  Shutdown();
+}
+
+bool OmniConnectWriteQueue::Enqueue(const char* data, size_t dataSize, const char* filePath, bool binary)
+{
+  if (Workers.empty())
+  {
+    // No worker threads, write synchronously; failures are reported both here and at the next barrier
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    if (Stopping)
+      return false;
+    lock.unlock();
+
+    bool success = false;
+    try
+    {
+      success = WriteFileFunc(data, dataSize, filePath, binary);
+    }
+    catch (...)
+    {
+    }
+    if (!success)
+    {
+      lock.lock();
+      FailedPaths.push_back(filePath);
+    }
+    return success;
+  }
+
+  std::string path(filePath);
+
+  std::unique_lock<std::mutex> lock(QueueMutex);
+
+  // Back-pressure; a single write larger than the budget is still accepted once the queue has drained
+  WorkDone.wait(lock, [this, dataSize]() {
+    return Stopping || PendingBytes == 0 || PendingBytes + dataSize <= MaxPendingBytes; });
+
+  if (Stopping)
+    return false;
+
+  auto pendingIt = PendingWrites.find(path);
+  if (pendingIt != PendingWrites.end())
+  {
+    // Coalesce with the write that hasn't been issued yet, keeping its position in the queue
+    PendingWrite& pending = pendingIt->second;
+    PendingBytes -= pending.Data.size();
+    pending.Data.assign(data, data + dataSize);
+    pending.Binary = binary;
+  }
+  else
+  {
+    PendingWrite& pending = PendingWrites[path];
+    pending.Data.assign(data, data + dataSize);
+    pending.Binary = binary;
+    PendingOrder.push_back(path);
+  }
+  PendingBytes += dataSize;
+
+  lock.unlock();
+  WorkAvailable.notify_one();
+
+  return true;
+}
+
+void OmniConnectWriteQueue::Cancel(const char* filePath)
+{
+  std::string path(filePath);
+
+  std::unique_lock<std::mutex> lock(QueueMutex);
+
+  auto pendingIt = PendingWrites.find(path);
+  if (pendingIt != PendingWrites.end())
+  {
+    PendingBytes -= pendingIt->second.Data.size();
+    PendingWrites.erase(pendingIt);
+    PendingOrder.erase(std::find(PendingOrder.begin(), PendingOrder.end(), path));
+    WorkDone.notify_all();
+  }
+
+  WorkDone.wait(lock, [this, &path]() { return InFlightPaths.find(path) == InFlightPaths.end(); });
+}
+
+bool OmniConnectWriteQueue::WaitAll(std::vector<std::string>* failedPaths)
+{
+  std::unique_lock<std::mutex> lock(QueueMutex);
+
+  WorkDone.wait(lock, [this]() { return PendingOrder.empty() && InFlightPaths.empty(); });
+
+  bool success = FailedPaths.empty();
+  if (failedPaths)
+    failedPaths->insert(failedPaths->end(), FailedPaths.begin(), FailedPaths.end());
+  FailedPaths.clear();
+
+  return success;
+}
+
+void OmniConnectWriteQueue::Shutdown()
+{
+  {
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    if (Stopping)
+      return;
+    Stopping = true;
+  }
+  WorkAvailable.notify_all();
+  WorkDone.notify_all();
+
+  // Workers drain the remaining writes before exiting
+  for (std::thread& worker : Workers)
+    worker.join();
+  Workers.clear();
+}
+
+bool OmniConnectWriteQueue::PopNextWrite(std::string& filePath, PendingWrite& write)
+{
+  // Oldest pending write whose path is not currently being written
+  auto orderIt = std::find_if(PendingOrder.begin(), PendingOrder.end(),
+    [this](const std::string& path) { return InFlightPaths.find(path) == InFlightPaths.end(); });
+  if (orderIt == PendingOrder.end())
+    return false;
+
+  filePath = std::move(*orderIt);
+  PendingOrder.erase(orderIt);
+
+  auto pendingIt = PendingWrites.find(filePath);
+  write = std::move(pendingIt->second);
+  PendingWrites.erase(pendingIt);
+
+  InFlightPaths.insert(filePath);
+  return true;
+}
+
+void OmniConnectWriteQueue::WorkerLoop()
+{
+  std::string filePath;
+  PendingWrite write;
+
+  std::unique_lock<std::mutex> lock(QueueMutex);
+  while (true)
+  {
+    if (PopNextWrite(filePath, write))
+    {
+      lock.unlock();
+      bool success = false;
+      try
+      {
+        success = WriteFileFunc(write.Data.data(), write.Data.size(), filePath.c_str(), write.Binary);
+      }
+      catch (...)
+      {
+      }
+      lock.lock();
+
+      // Bytes are only released once written, so the budget bounds in-flight memory as well
+      PendingBytes -= write.Data.size();
+      InFlightPaths.erase(filePath);
+      if (!success)
+        FailedPaths.push_back(filePath);
+
+      write.Data.clear();
+      write.Data.shrink_to_fit();
+
+      WorkDone.notify_all();
+      WorkAvailable.notify_all(); // A write to the same path may have been waiting on this one
+      continue;
+    }
+
+    if (Stopping && PendingOrder.empty())
+      break;
+
+    WorkAvailable.wait(lock);
+  }
+}
@@ -0,0 +1,89 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#ifndef OmniConnectWriteQueue_h
+#define OmniConnectWriteQueue_h
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// Write-behind queue for file contents. Buffers are copied on enqueue, so callers may release them immediately.
+// Pending writes to the same path are coalesced (last write wins), and writes to one path are never issued concurrently.
+class OmniConnectWriteQueue
+{
+public:
+  using WriteFunc = std::function<bool(const char* data, size_t dataSize, const char* filePath, bool binary)>;
+
+  OmniConnectWriteQueue(WriteFunc writeFunc, size_t numThreads, size_t maxPendingBytes);
+  ~OmniConnectWriteQueue();
+
+  // Blocks while the pending byte budget is exhausted (back-pressure). Returns false if the queue is shut down.
+  bool Enqueue(const char* data, size_t dataSize, const char* filePath, bool binary);
+
+  // Drops a pending write to filePath and waits for an in-flight write to it to finish.
+  void Cancel(const char* filePath);
+
+  // Barrier; returns false if any write failed since the previous call, with the failed paths in failedPaths.
+  bool WaitAll(std::vector<std::string>* failedPaths = nullptr);
+
+  void Shutdown();
+
+  size_t GetNumThreads() const { return Workers.size(); }
+  size_t GetMaxPendingBytes() const { return MaxPendingBytes; }
+
+protected:
+  struct PendingWrite
+  {
+    std::vector<char> Data;
+    bool Binary = true;
+  };
+
+  void WorkerLoop();
+  bool PopNextWrite(std::string& filePath, PendingWrite& write);
+
+  WriteFunc WriteFileFunc;
+  size_t MaxPendingBytes;
+
+  std::mutex QueueMutex;
+  std::condition_variable WorkAvailable;
+  std::condition_variable WorkDone;
+
+  std::deque<std::string> PendingOrder;
+  std::unordered_map<std::string, PendingWrite> PendingWrites;
+  std::unordered_set<std::string> InFlightPaths;
+  size_t PendingBytes = 0;
+  std::vector<std::string> FailedPaths;
+  bool Stopping = false;
+
+  std::vector<std::thread> Workers;
+};
+
+#endif
@@ -33,6 +33,17 @@ PXR_NAMESPACE_USING_DIRECTIVE
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <set>
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+
+#include <tbb/task_arena.h>
 
 #include "OmniConnectConnection.h"
 #include "OmniConnectCaches.h"
@@ -42,6 +53,7 @@ PXR_NAMESPACE_USING_DIRECTIVE
 #include "OmniConnectLiveInterface.h"
 #include "OmniConnectDiagnosticMgrDelegate.h"
 #include "OmniConnectUtilsInternal.h"
+#include "OmniConnectProfiler.h"
 
 //#define FORCE_OMNI_CLIP_UPDATES_WITH_DUMMY
 //#define FORCE_OMNI_CLIP_UPDATES_WITH_SUBLAYERS
@@ -248,6 +260,152 @@ namespace
     return primvarRef;
   }
 
+  constexpr size_t ParallelConvertMinElements = 1 << 16;
+  constexpr size_t ParallelConvertGrainSize = 1 << 14;
+
+  template<class DstType, class SrcType>
+  void ConvertScalars(const SrcType* srcData, DstType* dstData, size_t numElements)
+  {
+    auto convertRange = [srcData, dstData](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+        dstData[i] = DstType(srcData[i]);
+    };
+
+    if (numElements < ParallelConvertMinElements)
+      convertRange(0, numElements);
+    else
+      WorkParallelForN(numElements, convertRange, ParallelConvertGrainSize);
+  }
+
+  // Gf vectors are converted as flat scalar arrays, so the inner loop vectorizes
+  template<class ElementType, class EltType>
+  typename std::enable_if<GfIsGfVec<ElementType>::value>::type ConvertElements(const EltType* srcData, ElementType* dstData, size_t numElements)
+  {
+    static_assert(ElementType::dimension == EltType::dimension, "Vector conversion requires equal dimensions");
+    ConvertScalars((const typename EltType::ScalarType*)srcData, (typename ElementType::ScalarType*)dstData, numElements * ElementType::dimension);
+  }
+
+  template<class ElementType, class EltType>
+  typename std::enable_if<!GfIsGfVec<ElementType>::value>::type ConvertElements(const EltType* srcData, ElementType* dstData, size_t numElements)
+  {
+    ConvertScalars(srcData, dstData, numElements);
+  }
+
+  // Half float output goes through ocutils::FloatToHalf, which clamps values beyond the half range instead of turning them into
+  // infinities; returns the number of clamped values
+  template<class EltType>
+  size_t ConvertScalarsToHalf(const EltType* srcData, GfHalf* dstData, size_t numElements)
+  {
+    static_assert(sizeof(GfHalf) == sizeof(uint16_t), "GfHalf is expected to hold the bare half bits");
+    uint16_t* halfData = reinterpret_cast<uint16_t*>(dstData);
+    if (numElements < ParallelConvertMinElements)
+      return ocutils::FloatToHalf(srcData, halfData, numElements);
+
+    std::atomic<size_t> numClamped(0);
+    auto convertRange = [srcData, halfData, &numClamped](size_t begin, size_t end)
+    {
+      numClamped += ocutils::FloatToHalf(srcData + begin, halfData + begin, end - begin);
+    };
+    WorkParallelForN(numElements, convertRange, ParallelConvertGrainSize);
+    return numClamped;
+  }
+
+  constexpr size_t ParallelBoundsGrainSize = 1 << 15;
+
+  // Points are visited in groups of 4, so the 12 interleaved coordinates map to fixed accumulator lanes and the min/max vectorizes.
+  // Same semantics as GfRange3f::UnionWith: nans are skipped, empty input results in an empty range.
+  template<class ScalarType>
+  void ComputePointsBoundsRange(const ScalarType* points, size_t begin, size_t end, ScalarType* boundsMin, ScalarType* boundsMax)
+  {
+    ScalarType laneMin[12], laneMax[12];
+    std::fill(laneMin, laneMin + 12, ScalarType(FLT_MAX));
+    std::fill(laneMax, laneMax + 12, ScalarType(-FLT_MAX));
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+      const ScalarType* pts = points + 3 * i;
+      for (int k = 0; k < 12; ++k)
+      {
+        laneMin[k] = (pts[k] < laneMin[k]) ? pts[k] : laneMin[k];
+        laneMax[k] = (pts[k] > laneMax[k]) ? pts[k] : laneMax[k];
+      }
+    }
+    for (; i < end; ++i)
+    {
+      const ScalarType* pt = points + 3 * i;
+      for (int k = 0; k < 3; ++k)
+      {
+        laneMin[k] = (pt[k] < laneMin[k]) ? pt[k] : laneMin[k];
+        laneMax[k] = (pt[k] > laneMax[k]) ? pt[k] : laneMax[k];
+      }
+    }
+
+    for (int k = 0; k < 12; ++k)
+    {
+      boundsMin[k % 3] = std::min(boundsMin[k % 3], laneMin[k]);
+      boundsMax[k % 3] = std::max(boundsMax[k % 3], laneMax[k]);
+    }
+  }
+
+  template<class ScalarType>
+  GfRange3f ComputePointsBounds(const ScalarType* points, size_t numPoints)
+  {
+    size_t numBlocks = (numPoints + ParallelBoundsGrainSize - 1) / ParallelBoundsGrainSize;
+    std::vector<ScalarType> blockBounds(numBlocks * 6);
+    auto computeBlocks = [points, numPoints, &blockBounds](size_t beginBlock, size_t endBlock)
+    {
+      for (size_t block = beginBlock; block < endBlock; ++block)
+      {
+        ScalarType* bounds = &blockBounds[6 * block];
+        std::fill(bounds, bounds + 3, ScalarType(FLT_MAX));
+        std::fill(bounds + 3, bounds + 6, ScalarType(-FLT_MAX));
+        ComputePointsBoundsRange(points, block * ParallelBoundsGrainSize, std::min(numPoints, (block + 1) * ParallelBoundsGrainSize),
+          bounds, bounds + 3);
+      }
+    };
+
+    if (numBlocks > 1)
+      WorkParallelForN(numBlocks, computeBlocks);
+    else
+      computeBlocks(0, numBlocks);
+
+    ScalarType boundsMin[3] = { ScalarType(FLT_MAX), ScalarType(FLT_MAX), ScalarType(FLT_MAX) };
+    ScalarType boundsMax[3] = { ScalarType(-FLT_MAX), ScalarType(-FLT_MAX), ScalarType(-FLT_MAX) };
+    for (size_t block = 0; block < numBlocks; ++block)
+    {
+      const ScalarType* bounds = &blockBounds[6 * block];
+      for (int k = 0; k < 3; ++k)
+      {
+        boundsMin[k] = std::min(boundsMin[k], bounds[k]);
+        boundsMax[k] = std::max(boundsMax[k], bounds[k + 3]);
+      }
+    }
+    return GfRange3f(GfVec3f((float)boundsMin[0], (float)boundsMin[1], (float)boundsMin[2]),
+      GfVec3f((float)boundsMax[0], (float)boundsMax[1], (float)boundsMax[2]));
+  }
+
+  template<typename GeomDataType>
+  GfRange3f GetPointsExtent(const GeomDataType& omniGeomData)
+  {
+    if (omniGeomData.HasPointsBounds)
+    {
+      const double* bounds = omniGeomData.PointsBounds;
+      return GfRange3f(GfVec3f((float)bounds[0], (float)bounds[2], (float)bounds[4]),
+        GfVec3f((float)bounds[1], (float)bounds[3], (float)bounds[5]));
+    }
+
+    switch (omniGeomData.PointsType)
+    {
+      case OmniConnectType::FLOAT3: return ComputePointsBounds((const float*)omniGeomData.Points, omniGeomData.NumPoints);
+      case OmniConnectType::DOUBLE3: return ComputePointsBounds((const double*)omniGeomData.Points, omniGeomData.NumPoints);
+      default: return GfRange3f();
+    }
+  }
+
+  // Generic array data is always copied. Referencing the vtk array from the VtArray would skip one copy, but VTK may modify
+  // the array in place after the update, and the values are still read when layers kept open are saved or re-exported later.
   template<class ArrayType>
   void AssignArrayToPrimvar(void* data, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
@@ -259,7 +417,7 @@ namespace
   template<class ArrayType>
   void AssignArrayToPrimvarFlatten(void* data, OmniConnectType dataType, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
-    int elementMultiplier = (int)dataType / OmniConnectNumFundamentalTypes;
+    int elementMultiplier = (int)dataType / OmniConnectNumFundamentalTypes + 1; // Number of components
     size_t numFlattenedElements = numElements * elementMultiplier;
 
     AssignArrayToPrimvar<ArrayType>(data, numFlattenedElements, primvar, timeCode, usdArray);
@@ -268,20 +426,16 @@ namespace
   template<class ArrayType, class EltType>
   void AssignArrayToPrimvarConvert(void* data, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
-    using ElementType = typename ArrayType::ElementType;
     EltType* typedData = (EltType*)data;
 
     usdArray->resize(numElements);
-    for (int i = 0; i < numElements; ++i)
-    {
-      (*usdArray)[i] = ElementType(typedData[i]);
-    }
+    ConvertElements(typedData, usdArray->data(), numElements);
   }
 
   template<class ArrayType, class EltType>
   void AssignArrayToPrimvarConvertFlatten(void* data, OmniConnectType dataType, size_t numElements, UsdAttribute& primvar, const UsdTimeCode& timeCode, ArrayType* usdArray)
   {
-    int elementMultiplier = (int)dataType / OmniConnectNumFundamentalTypes;
+    int elementMultiplier = (int)dataType / OmniConnectNumFundamentalTypes + 1; // Number of components
     size_t numFlattenedElements = numElements * elementMultiplier;
 
     AssignArrayToPrimvarConvert<ArrayType, EltType>(data, numFlattenedElements, primvar, timeCode, usdArray);
@@ -319,6 +473,171 @@ namespace
 
   template<>
   float GetShapeWidth<OmniConnectInstancerData>(const OmniConnectInstancerData& omniGeomData) { return omniGeomData.ShapeDims[0]*2.0f; }
+
+  template<typename EltType>
+  bool HashArrayValue(const VtValue& value, uint64_t hash[2])
+  {
+    if (!value.IsHolding<VtArray<EltType>>())
+      return false;
+    const VtArray<EltType>& valueArray = value.UncheckedGet<VtArray<EltType>>();
+    ocutils::HashBytes128(valueArray.cdata(), valueArray.size() * sizeof(EltType), hash);
+    return true;
+  }
+
+  void HashClipValue(const VtValue& value, uint64_t hash[2])
+  {
+    const std::string& typeName = value.GetTypeName();
+    ocutils::HashBytes128(typeName.data(), typeName.size(), hash);
+
+    // Raw bytes of the common geometry arrays, VtValue's own hash otherwise
+    bool hashed = HashArrayValue<GfVec3f>(value, hash) || HashArrayValue<int>(value, hash) || HashArrayValue<float>(value, hash) ||
+      HashArrayValue<GfVec2f>(value, hash) || HashArrayValue<GfVec4f>(value, hash) || HashArrayValue<GfQuath>(value, hash) ||
+      HashArrayValue<GfVec3d>(value, hash) || HashArrayValue<double>(value, hash) || HashArrayValue<int64_t>(value, hash) ||
+      HashArrayValue<unsigned int>(value, hash) || HashArrayValue<unsigned char>(value, hash) || HashArrayValue<GfHalf>(value, hash);
+    if (!hashed)
+    {
+      uint64_t valueHash = value.GetHash();
+      ocutils::HashBytes128(&valueHash, sizeof(valueHash), hash);
+    }
+  }
+
+  // Hashes all specs of geomPath in a clip layer, with sample times taken relative to clipTime 
+  // so the contents of clips at different timesteps can be compared.
+  OmniConnectContentHash HashGeomClip(const SdfLayerHandle& clipLayer, const SdfPath& geomPath, double clipTime)
+  {
+    uint64_t hash[2] = { 0, 0 };
+    clipLayer->Traverse(geomPath, [&clipLayer, clipTime, &hash](const SdfPath& specPath)
+    {
+      const std::string& pathStr = specPath.GetString();
+      ocutils::HashBytes128(pathStr.data(), pathStr.size(), hash);
+
+      for (const TfToken& field : clipLayer->ListFields(specPath))
+      {
+        if (field == SdfFieldKeys->TimeSamples)
+          continue;
+        ocutils::HashBytes128(field.GetText(), field.size(), hash);
+        HashClipValue(clipLayer->GetField(specPath, field), hash);
+      }
+
+      for (double sampleTime : clipLayer->ListTimeSamplesForPath(specPath))
+      {
+        double relTime = sampleTime - clipTime;
+        ocutils::HashBytes128(&relTime, sizeof(relTime), hash);
+
+        VtValue sample;
+        clipLayer->QueryTimeSample(specPath, sampleTime, &sample);
+        HashClipValue(sample, hash);
+      }
+    });
+
+    OmniConnectContentHash clipHash;
+    clipHash.Lo = hash[0];
+    clipHash.Hi = hash[1];
+    return clipHash;
+  }
+
+  std::string ContentHashToString(const OmniConnectContentHash& clipHash)
+  {
+    char hashStr[33];
+    snprintf(hashStr, sizeof(hashStr), "%016llx%016llx", (unsigned long long)clipHash.Hi, (unsigned long long)clipHash.Lo);
+    return hashStr;
+  }
+
+  bool ContentHashFromString(const std::string& hashStr, OmniConnectContentHash& clipHash)
+  {
+    if (hashStr.size() != 32)
+      return false;
+    clipHash.Hi = std::strtoull(hashStr.substr(0, 16).c_str(), nullptr, 16);
+    clipHash.Lo = std::strtoull(hashStr.substr(16).c_str(), nullptr, 16);
+    return true;
+  }
+
+  // Returns the index of the clip active of stageTime, or clipActives.size() if it isn't active
+  size_t FindClipActive(const OmniConnectClipArray<GfVec2d>& clipActives, double stageTime)
+  {
+    // Timesteps are mostly added in sequence, so search from the back
+    for (size_t i = clipActives.size(); i > 0; --i)
+    {
+      if (clipActives[i - 1][0] == stageTime)
+        return i - 1;
+    }
+    return clipActives.size();
+  }
+
+  size_t CountClipActiveRefs(const OmniConnectClipArray<GfVec2d>& clipActives, double assetPathIdx)
+  {
+    return std::count_if(clipActives.begin(), clipActives.end(),
+      [assetPathIdx](const GfVec2d& clipActive) { return clipActive[1] == assetPathIdx; });
+  }
+
+  // Removes an unreferenced clip asset path, shifting the indices of the clip actives and stored clips after it
+  void EraseClipAssetPath(OmniConnectGeomCache& geomCache, size_t assetPathIdx)
+  {
+    OmniConnectClipArray<SdfAssetPath>& assetPaths = geomCache.ClipAssetPaths;
+    if (assetPathIdx + 1 == assetPaths.size())
+    {
+      // Nothing refers beyond the last asset path, which is the common case of a deduplicated new timestep
+      assetPaths.pop_back();
+      return;
+    }
+    assetPaths.erase(assetPathIdx);
+
+    OmniConnectClipArray<GfVec2d>& clipActives = geomCache.ClipActives;
+    for (size_t i = 0; i < clipActives.size(); ++i)
+    {
+      if (clipActives[i][1] > (double)assetPathIdx)
+        clipActives.Edit(i)[1] -= 1.0;
+    }
+    for (auto& storeEntry : geomCache.ClipStore)
+    {
+      if (storeEntry.second.AssetPathIdx > assetPathIdx)
+        --storeEntry.second.AssetPathIdx;
+    }
+    geomCache.ClipStoreRewrite = true;
+  }
+
+  // Clip times are kept sorted on stage time, with an entry for every clip active
+  const GfVec2d* LowerBoundClipTime(const OmniConnectClipArray<GfVec2d>& clipTimes, double stageTime)
+  {
+    return std::lower_bound(clipTimes.cdata(), clipTimes.cdata() + clipTimes.size(), stageTime,
+      [](const GfVec2d& clipTime, double time) { return clipTime[0] < time; });
+  }
+
+  double GetClipTime(const OmniConnectClipArray<GfVec2d>& clipTimes, double stageTime)
+  {
+    const GfVec2d* clipTimeIt = LowerBoundClipTime(clipTimes, stageTime);
+    if (clipTimeIt != clipTimes.cdata() + clipTimes.size() && (*clipTimeIt)[0] == stageTime)
+      return (*clipTimeIt)[1];
+    return stageTime;
+  }
+
+  bool HasClipTime(const OmniConnectClipArray<GfVec2d>& clipTimes, double stageTime)
+  {
+    const GfVec2d* clipTimeIt = LowerBoundClipTime(clipTimes, stageTime);
+    return clipTimeIt != clipTimes.end() && (*clipTimeIt)[0] == stageTime;
+  }
+
+  void SetClipTime(OmniConnectClipArray<GfVec2d>& clipTimes, double stageTime, double clipTime)
+  {
+    size_t pos = LowerBoundClipTime(clipTimes, stageTime) - clipTimes.cdata();
+    if (pos < clipTimes.size() && clipTimes[pos][0] == stageTime)
+    {
+      if (clipTimes[pos][1] != clipTime)
+        clipTimes.Edit(pos)[1] = clipTime;
+      return;
+    }
+    if (pos == clipTimes.size())
+      clipTimes.push_back(GfVec2d(stageTime, clipTime));
+    else
+      clipTimes.insert(pos, GfVec2d(stageTime, clipTime));
+  }
+
+  void EraseClipTime(OmniConnectClipArray<GfVec2d>& clipTimes, double stageTime)
+  {
+    size_t pos = LowerBoundClipTime(clipTimes, stageTime) - clipTimes.cdata();
+    if (pos < clipTimes.size() && clipTimes[pos][0] == stageTime)
+      clipTimes.erase(pos);
+  }
 }
 
 #define GET_PRIMVAR_BY_NAME_MACRO(valueTypeName) \
@@ -333,6 +652,11 @@ namespace
   ArrayType usdArray; AssignArrayToPrimvarConvert<ArrayType, EltType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray); ASSIGN_SET_PRIMVAR
 #define ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_FLATTEN_MACRO(ArrayType, EltType) \
   ArrayType usdArray; AssignArrayToPrimvarConvertFlatten<ArrayType, EltType>(arrayData, dataType, arrayNumElements, arrayPrimvar, timeCode, &usdArray); ASSIGN_SET_PRIMVAR
+#define ASSIGN_ARRAY_TO_PRIMVAR_HALF_MACRO(EltType) \
+  VtHalfArray usdArray(arrayNumElements); \
+  size_t numClamped = ConvertScalarsToHalf(reinterpret_cast<const EltType*>(arrayData), usdArray.data(), arrayNumElements); \
+  if (numClamped) OmniConnectDebugMacro("Array " << primvarName << ": " << numClamped << " values beyond the half float range are clamped to +-65504"); \
+  ASSIGN_SET_PRIMVAR
 #define ASSIGN_ARRAY_TO_PRIMVAR_FIRST_COMPONENT_MACRO(ArrayType, EltType) \
   ArrayType usdArray; AssignArrayToPrimvarFirstComponent<ArrayType, EltType>(arrayData, arrayNumElements, arrayPrimvar, timeCode, &usdArray); ASSIGN_SET_PRIMVAR
 #define ASSIGN_CUSTOM_ARRAY_TO_PRIMVAR_MACRO(ArrayType, customArray) \
@@ -356,7 +680,7 @@ public:
     , OmniConnectConnection* connection
     , OmniConnectLogCallback logCallback)
     : Connection(connection)
-    , VolumeWriter(Create_VolumeWriter(), std::mem_fn(&OmniConnectVolumeWriterI::Release))
+    , VolumeWriter(Create_VolumeWriter(settings), std::mem_fn(&OmniConnectVolumeWriterI::Release))
     , Settings(settings)
     , Environment(environment)
   {
@@ -396,7 +720,14 @@ public:
   UsdShadeShader InitializeUsdTexture(OmniConnectActorCache& actorCache, OmniConnectSamplerData& samplerData, OmniConnectTexCache& texCache);
   void UpdateUsdTexture(OmniConnectTexCache& texCache, UsdShadeShader& textureReader, bool timeVarying, double animTimeStep);
   void UpdateTexture(OmniConnectActorCache& actorCache, size_t texId, OmniConnectSamplerData& samplerData, bool timeVarying, double animTimeStep);
-  void DeleteTexture(OmniConnectActorCache& actorCache, size_t texCacheIdx);
+  void DeleteTexture(OmniConnectActorCache& actorCache, OmniConnectTexCache& texCache);
+  const OmniConnectContentHash& AcquireStoredTexture(const OmniConnectSamplerData& samplerData, SdfAssetPath& storedTexPath);
+  void ReleaseStoredTexture(const OmniConnectContentHash& contentHash);
+  void SetStoredTexturePaths(const OmniConnectContentHash& contentHash, OmniConnectTexStoreEntry& storeEntry);
+  bool FindStoredTexture(const SdfAssetPath& texPath, OmniConnectContentHash& contentHash) const;
+  void RestoreTexStore();
+  void RestoreTextureContents(OmniConnectActorCache& actorCache, OmniConnectTexCache& texCache);
+  void FlushTexStore();
   void UpdateGenericArrays(UsdGeomPrimvarsAPI& actorPrimvarsApi, UsdGeomPrimvarsAPI& clipPrimvarsApi, UsdGeomPrimvarsAPI& topPrimvarsApi, OmniConnectGenericArray* genericArrays, size_t numGenericArrays, double animTimeStep);
   void DeleteGenericArrays(UsdGeomPrimvarsAPI& actorPrimvarsApi, UsdGeomPrimvarsAPI& clipPrimvarsApi, UsdGeomPrimvarsAPI& topPrimvarsApi, OmniConnectGenericArray* genericArrays, size_t numGenericArrays, double animTimeStep);
   template<typename CacheType> void UpdateGeom(OmniConnectActorCache* actorCache, double animTimeStep, typename CacheType::GeomDataType& geomData, size_t geomId, size_t materialId,
@@ -449,17 +780,75 @@ public:
   size_t RetrieveSceneToAnimTimesFromUsd(const UsdPrim& actorPrim);
   void CopySceneToAnimTimes(double* sceneToAnimTimes, size_t numSceneToAnimTimes);
   template<typename CacheType> void RestoreClipActivesAndPaths(const OmniConnectActorCache& actorCache, CacheType& geomCache);
-  void RetimeSceneToAnimClips(const VtVec2dArray& sceneClipTimes, const VtVec2dArray& animClipActives, VtVec2dArray& newAnimClipActives);
-  template<typename CacheType> void RetimeActorGeoms(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, const VtVec2dArray& sceneClipTimes, VtVec2dArray& newAnimClipActives);
-  void SetClipValues(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, UsdPrim& actorPrim, 
-    const double* sceneToAnimTimes, size_t numSceneToAnimTimes);
+  void RetimeSceneToAnimClips(const VtVec2dArray& sceneClipTimes, const VtVec2dArray& animClipActives, VtVec2dArray& sortedAnimClipActives, VtVec2dArray& newAnimClipActives);
+  template<typename CacheType> void RetimeActorGeoms(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, const VtVec2dArray& sceneClipTimes);
+  void SetGeomClipMetadata(const UsdPrim& geomPrim, OmniConnectGeomCache& geomCache);
+  void MarkGeomClipMetadataDirty(OmniConnectActorCache& actorCache, OmniConnectGeomCache& geomCache);
+  template<typename CacheType> void FlushGeomClipMetadata(OmniConnectActorCache& actorCache);
+  void FlushClipMetadata(OmniConnectActorCache& actorCache);
+  void FlushLodVariants(OmniConnectActorCache& actorCache);
+  void DeduplicateGeomClip(OmniConnectActorCache& actorCache, OmniConnectGeomCache& geomCache, UsdStageRefPtr& geomClipStage, double animTimeStep);
+  bool ReleaseStoredGeomClip(OmniConnectGeomCache& geomCache, double animTimeStep, bool removeTimeStep);
+  void SetClipValues(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, UsdPrim& actorPrim);
+  void AddPendingRetime(size_t actorId, OmniConnectActorCache& actorCache, double sceneTime, const double* sceneToAnimTimes, size_t numSceneToAnimTimes);
+  void RetimePendingActors();
 #ifdef FORCE_OMNI_CLIP_UPDATES_WITH_DUMMY
   void AttachAsSublayer(UsdStageRefPtr& stage, std::string& fileName, bool attach);
 #endif
   void SetActorVisibility(OmniConnectActorCache& actorCache, bool visible, double animTimeStep);
   template<typename CacheType> void SetGeomVisibility(OmniConnectActorCache& actorCache, size_t geomId, bool visible, double animTimeStep);
 
-  OmniConnectActorCache* GetCachedActorCache(size_t actorId);
+  OmniConnectActorCache* FindActorCache(size_t actorId);
+
+  // Locks the stage of an actor for a call that authors it, see ACTOR_STAGE_SCOPE
+  class ActorStageLock
+  {
+    public:
+      ActorStageLock(OmniConnectInternals* internals, size_t actorId)
+        : ActorCache(internals->FindActorCache(actorId))
+      {
+        if (ActorCache)
+          Lock = std::unique_lock<std::mutex>(ActorCache->StageMutex);
+      }
+
+      OmniConnectActorCache* ActorCache = nullptr;
+
+    private:
+      std::unique_lock<std::mutex> Lock;
+  };
+
+  // Waits for the calls of all actors to finish and keeps new ones from starting, for calls that create or remove actors,
+  // or author and save the scene and all actor stages. These are not made from within the parallel conversion of actors.
+  class SceneLock
+  {
+    public:
+      SceneLock(OmniConnectInternals* internals)
+        : MapLock(internals->ActorCacheMapMutex)
+      {
+        for (auto& actorCacheEntry : internals->ActorCacheMap)
+          StageLocks.emplace_back(actorCacheEntry.second.StageMutex);
+      }
+
+      // An actor is erased with its stage mutex
+      void UnlockActorStage(OmniConnectActorCache& actorCache)
+      {
+        for (std::unique_lock<std::mutex>& stageLock : StageLocks)
+        {
+          if (stageLock.mutex() == &actorCache.StageMutex)
+            stageLock.unlock();
+        }
+      }
+
+    private:
+      std::unique_lock<std::shared_mutex> MapLock;
+      std::vector<std::unique_lock<std::mutex>> StageLocks;
+  };
+
+  // Deferred layer saving
+  void MarkStageDirty(const UsdStageRefPtr& stage);
+  void UnmarkStageDirty(const UsdStageRefPtr& stage);
+  void UnmarkFileDirty(const char* filePath);
+  void SaveDirtyLayers();
 
   // Live workflow
   void SetLiveWorkflowEnabled(bool enable);
@@ -505,8 +894,8 @@ public:
   // Allow for writeback to usd/omniverse
   bool UsdSaveEnabled = true;
 
-  // Convert generic arrays from double to float
-  bool ConvertGenericArraysDoubleToFloat = false;
+  // Convert generic arrays from double to float (set by each converting thread right before its geom updates)
+  static thread_local bool ConvertGenericArraysDoubleToFloat;
 
   // Settings and caches
   OmniConnectSettings Settings;
@@ -542,13 +931,47 @@ public:
   OmniConnectMdlNames MdlNames;
 #endif
 
+  // Layers modified since the last flush, also keeps clip and topology layers alive until saved
+  std::set<SdfLayerRefPtr> DirtyLayers;
+
+  //Content-addressed texture files shared by all actors and timesteps of the session
+  std::map<OmniConnectContentHash, OmniConnectTexStoreEntry> TexStore;
+  bool TexStoreDirty = false; // Reference counts have changed since they were last written to the scene stage
+
+  // Actors are converted on multiple threads. Calls for an actor only lock its stage (OmniConnectActorCache::StageMutex),
+  // the state shared between actors is guarded by the mutexes below, which are held for short sections only.
+  std::shared_mutex ActorCacheMapMutex; // Shared for finding an actor, exclusive for calls that affect all actors, see SceneLock
+  std::mutex SceneStageMutex; // Scene prims of geoms, pending retimes
+  std::mutex DirtyLayersMutex;
+  mutable std::mutex TexStoreMutex;
+  std::mutex VolumeWriterMutex;
+
+  // Runs func with mutex locked, isolated from the tasks of other actors: USD and OpenVDB may wait on nested parallel work
+  // while the mutex is held, during which the waiting thread could otherwise pick up another actor's call that locks it again.
+  template<typename Func>
+  void RunIsolated(std::mutex& mutex, const Func& func)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    tbb::this_task_arena::isolate(func);
+  }
+
   // Temp arrays
   std::vector<size_t> TempIdVec;
   VtVec2dArray TempSceneToAnimTimes;
 
-  // Cached OmniConnectActorCache pointer
-  size_t CurrentCachedActorId = size_t(-1);
-  OmniConnectActorCache* CachedActorCache;
+  // Actors with a pending scene->anim retiming, and the range of scene times it was requested for
+  std::vector<size_t> RetimeActorIds;
+  double RetimeStartTime = 0.0;
+  double RetimeEndTime = 0.0;
+
+  // For scene->anim time arrays on scene prims, shared by all actors retimed in the same pass
+  VtVec2dArray TempNewClipActives;
+  VtVec2dArray TempGeomClipTimes;
+  VtVec2dArray TempSortedClipActives;
+  VtVec2dArray TempRetimedSceneClipTimes; // Scene clip times and geom clip actives from which TempNewClipActives has last been retimed
+  VtVec2dArray TempRetimedClipActives;
+  bool TempRetimedValid = false;
+
 
 #ifdef FORCE_OMNI_CLIP_UPDATES_WITH_DUMMY
   std::vector<UsdStageRefPtr> DummyStages;
@@ -560,6 +983,7 @@ public:
 };
 
 OmniConnectLogCallback OmniConnectInternals::LogCallback = nullptr;
+thread_local bool OmniConnectInternals::ConvertGenericArraysDoubleToFloat = false;
 
 #ifdef FORCE_OMNI_CLIP_UPDATES_WITH_DUMMY
 const int OmniConnectInternals::NumDummyStages = 11;
@@ -720,6 +1144,9 @@ void OmniConnectInternals::OpenSceneStage()
   this->SceneStage->SetDefaultPrim(rootPrim);
   UsdModelAPI(rootPrim).SetKind(KindTokens->assembly);
 
+  if(!this->Settings.CreateNewOmniSession)
+    RestoreTexStore();
+
   UsdGeomSetStageUpAxis(this->SceneStage,
     (this->Settings.UpAxis == OmniConnectAxis::Y) ? UsdGeomTokens->y : UsdGeomTokens->z);
 
@@ -855,16 +1282,76 @@ void OmniConnectInternals::OpenClipAndTopologyStage(const char* clipFilePath, co
   }
 }
 
-OmniConnectActorCache* OmniConnectInternals::GetCachedActorCache(size_t actorId)
+OmniConnectActorCache* OmniConnectInternals::FindActorCache(size_t actorId)
+{
+  // Entries stay in place while other actors are added, which only happens under SceneLock
+  std::shared_lock<std::shared_mutex> mapLock(this->ActorCacheMapMutex);
+  auto actorCacheIt = this->ActorCacheMap.find(actorId);
+  return (actorCacheIt != this->ActorCacheMap.end()) ? &actorCacheIt->second : nullptr;
+}
+
+void OmniConnectInternals::MarkStageDirty(const UsdStageRefPtr& stage)
+{
+  if (UsdSaveEnabled)
+  {
+    std::lock_guard<std::mutex> dirtyLock(this->DirtyLayersMutex);
+    this->DirtyLayers.insert(stage->GetRootLayer());
+  }
+}
+
+void OmniConnectInternals::UnmarkStageDirty(const UsdStageRefPtr& stage)
+{
+  if (stage)
+  {
+    std::lock_guard<std::mutex> dirtyLock(this->DirtyLayersMutex);
+    this->DirtyLayers.erase(stage->GetRootLayer());
+  }
+}
+
+void OmniConnectInternals::UnmarkFileDirty(const char* filePath)
+{
+  // Prevent a removed file from being written again at the next flush
+  std::lock_guard<std::mutex> dirtyLock(this->DirtyLayersMutex);
+  if (this->DirtyLayers.empty())
+    return;
+
+  SdfLayerHandle layer = SdfLayer::Find(this->Connection->GetUrl(filePath));
+  if (!layer)
+    return;
+
+  auto layerIt = std::find_if(this->DirtyLayers.begin(), this->DirtyLayers.end(),
+    [&layer](const SdfLayerRefPtr& dirtyLayer) { return get_pointer(dirtyLayer) == get_pointer(layer); });
+  if (layerIt != this->DirtyLayers.end())
+    this->DirtyLayers.erase(layerIt);
+}
+
+void OmniConnectInternals::SaveDirtyLayers()
 {
-  if (this->CurrentCachedActorId != actorId)
+  for (auto& actorCacheEntry : this->ActorCacheMap)
   {
-    auto actorCacheIt = this->ActorCacheMap.find(actorId);
-    assert(actorCacheIt != this->ActorCacheMap.end());
-    this->CachedActorCache = &actorCacheIt->second;
-    actorId = this->CurrentCachedActorId;
+    FlushClipMetadata(actorCacheEntry.second);
+    FlushLodVariants(actorCacheEntry.second);
   }
-  return this->CachedActorCache;
+  FlushTexStore();
+
+  if (this->DirtyLayers.empty())
+    return;
+
+  OMNICONNECT_PROFILE_SCOPE("SaveDirtyLayers");
+  OMNICONNECT_PROFILE_COUNT("SavedLayers", (int64_t)this->DirtyLayers.size());
+
+  std::vector<SdfLayerRefPtr> layers(this->DirtyLayers.begin(), this->DirtyLayers.end());
+  this->DirtyLayers.clear();
+
+  WorkParallelForN(layers.size(),
+    [&layers](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        OMNICONNECT_PROFILE_SCOPE("SaveLayer");
+        layers[i]->Save();
+      }
+    });
 }
 
 UsdShadeOutput OmniConnectInternals::CreateUsdPreviewSurface(OmniConnectActorCache& actorCache, OmniConnectMatCache& matCache, UsdShadeShader& shader, bool newMat)
@@ -1109,40 +1596,60 @@ void OmniConnectInternals::UpdateUsdTexture(OmniConnectTexCache& texCache, UsdSh
     // Only clear the attribute, leave files (with associated timesteps in cache) alone
     fileInput.GetAttr().Clear();
     texCache.TimeVarying = timeVarying;
-
-    if(!timeVarying)
-      fileInput.Set(texCache.SceneRelTexturePath); // filename doesn't change if content changes, so only has to be set once for the default timestep (it was initialized in InitializeUsdTexture())
   }
 
+  // Stored filenames follow the content, so the default timestep has to be set on every update as well
   if (timeVarying)
-  {
     fileInput.Set(texCache.TimedSceneRelTexturePath, animTimeStep);
-  }
+  else
+    fileInput.Set(texCache.SceneRelTexturePath);
 }
 
 void OmniConnectInternals::UpdateTexture(OmniConnectActorCache& actorCache, size_t texId, OmniConnectSamplerData& samplerData, bool timeVarying, double animTimeStep)
 {
-  auto texCachePair = actorCache.GetTexCache(texId);
-
-  OmniConnectTexCache& texCache = texCachePair.second;
-  bool newTexCache = texCachePair.first;
+  OmniConnectTexCache& texCache = actorCache.GetTexCache(texId).second;
 
-  // Can be moved to initialization, but this is fine too
-  if(newTexCache)
+  // The cache may already have been created by a material referring to it, so initialize on the first upload instead
+  bool firstUpload = !texCache.HasContent && texCache.TimeSteps.empty();
+  if(firstUpload)
   {
     texCache.WrapS = samplerData.WrapS;
     texCache.WrapT = samplerData.WrapT;
     texCache.TimeVarying = timeVarying;
+
+    // In case of reopening an existing scene, the texture may still hold references to stored files
+    if(!Settings.CreateNewOmniSession)
+      RestoreTextureContents(actorCache, texCache);
   }
 
+  // Acquire before releasing the previous contents, so an unchanged texture isn't removed and written again
+  SdfAssetPath storedTexPath;
+  const OmniConnectContentHash& contentHash = AcquireStoredTexture(samplerData, storedTexPath);
+
   if (timeVarying)
   {
-    texCache.ResetTimedTexPaths(animTimeStep);
-    if (std::find(texCache.TimeSteps.begin(), texCache.TimeSteps.end(), animTimeStep) == texCache.TimeSteps.end())
+    auto timeStepIt = std::find(texCache.TimeSteps.begin(), texCache.TimeSteps.end(), animTimeStep);
+    if (timeStepIt == texCache.TimeSteps.end())
+    {
       texCache.TimeSteps.push_back(animTimeStep);
+      texCache.TimeStepHashes.push_back(contentHash);
+    }
+    else
+    {
+      OmniConnectContentHash& timeStepHash = texCache.TimeStepHashes[timeStepIt - texCache.TimeSteps.begin()];
+      ReleaseStoredTexture(timeStepHash);
+      timeStepHash = contentHash;
+    }
+    texCache.TimedSceneRelTexturePath = storedTexPath;
+  }
+  else
+  {
+    if (texCache.HasContent)
+      ReleaseStoredTexture(texCache.ContentHash);
+    texCache.ContentHash = contentHash;
+    texCache.HasContent = true;
+    texCache.SceneRelTexturePath = storedTexPath;
   }
-  std::string& texTargetPath = timeVarying ? texCache.TimedAbsTexturePath : texCache.AbsTexturePath;
-  Connection->WriteFile(samplerData.TexData, samplerData.TexDataSize, texTargetPath.c_str());
 
   UsdShadeShader textureReader = UsdShadeShader::Get(actorCache.Stage, texCache.TexturePrimPath);
   if(!textureReader)
@@ -1159,24 +1666,165 @@ void OmniConnectInternals::UpdateTexture(OmniConnectActorCache& actorCache, size
 #endif
 }
 
-void OmniConnectInternals::DeleteTexture(OmniConnectActorCache& actorCache
-  , size_t texCacheIdx 
-)
+void OmniConnectInternals::DeleteTexture(OmniConnectActorCache& actorCache, OmniConnectTexCache& texCache)
 {
-  auto& texCacheEntry = actorCache.TexCaches[texCacheIdx];
-  OmniConnectTexCache& texCache = texCacheEntry.second;
+  // Release the default texture and each timestep-texture ever written; files are removed once no texture refers to them anymore
+  if (!Settings.CreateNewOmniSession && !texCache.HasContent && texCache.TimeSteps.empty())
+    RestoreTextureContents(actorCache, texCache);
+  if (texCache.HasContent)
+    ReleaseStoredTexture(texCache.ContentHash);
+  for (const OmniConnectContentHash& timeStepHash : texCache.TimeStepHashes)
+    ReleaseStoredTexture(timeStepHash);
+
+  texCache.HasContent = false;
+  texCache.TimeSteps.clear();
+  texCache.TimeStepHashes.clear();
 
-  // Remove the default texture file
-  Connection->RemoveFile(texCache.AbsTexturePath.c_str());
+  actorCache.Stage->RemovePrim(texCache.TexturePrimPath);
+}
 
-  // For each timestep-texture ever written, remove the file
-  for (double timeStep : texCache.TimeSteps)
+const OmniConnectContentHash& OmniConnectInternals::AcquireStoredTexture(const OmniConnectSamplerData& samplerData, SdfAssetPath& storedTexPath)
+{
+  // Encoded image data includes its format, which is further determined by the extension
+  uint64_t hash[2] = { 0, 0 };
+  ocutils::HashBytes128(OmniConnectTexCache::ImageExt, strlen(OmniConnectTexCache::ImageExt), hash);
+  ocutils::HashBytes128(samplerData.TexData, samplerData.TexDataSize, hash);
+
+  OmniConnectContentHash contentHash;
+  contentHash.Lo = hash[0];
+  contentHash.Hi = hash[1];
+
+  // The store is shared by the textures of all actors
+  std::lock_guard<std::mutex> texStoreLock(TexStoreMutex);
+
+  auto storeIt = TexStore.emplace(contentHash, OmniConnectTexStoreEntry()).first;
+  OmniConnectTexStoreEntry& storeEntry = storeIt->second;
+  if (storeEntry.RefCount == 0)
   {
-    texCache.ResetTimedTexPaths(timeStep);
-    Connection->RemoveFile(texCache.TimedAbsTexturePath.c_str());
+    SetStoredTexturePaths(contentHash, storeEntry);
+
+    Connection->WriteFile(samplerData.TexData, samplerData.TexDataSize, storeEntry.AbsTexturePath.c_str());
   }
+  ++storeEntry.RefCount;
+  TexStoreDirty = true;
 
-  actorCache.Stage->RemovePrim(texCache.TexturePrimPath);
+  storedTexPath = storeEntry.SceneRelTexturePath;
+  return storeIt->first; // Entry stays in place while referenced
+}
+
+void OmniConnectInternals::ReleaseStoredTexture(const OmniConnectContentHash& contentHash)
+{
+  std::lock_guard<std::mutex> texStoreLock(TexStoreMutex);
+
+  auto storeIt = TexStore.find(contentHash);
+  if (storeIt == TexStore.end())
+    return;
+
+  if (--storeIt->second.RefCount == 0)
+  {
+    Connection->RemoveFile(storeIt->second.AbsTexturePath.c_str());
+    TexStore.erase(storeIt);
+  }
+  TexStoreDirty = true;
+}
+
+void OmniConnectInternals::SetStoredTexturePaths(const OmniConnectContentHash& contentHash, OmniConnectTexStoreEntry& storeEntry)
+{
+  std::string texFile = OmniTextureRelativePath + ("t" + ContentHashToString(contentHash)) + OmniConnectTexCache::ImageExt;
+  storeEntry.AbsTexturePath = this->SceneDirectory + texFile;
+  storeEntry.SceneRelTexturePath = SdfAssetPath("./" + texFile);
+}
+
+bool OmniConnectInternals::FindStoredTexture(const SdfAssetPath& texPath, OmniConnectContentHash& contentHash) const
+{
+  // Stored files are named t<hash><ImageExt>, see SetStoredTexturePaths()
+  const std::string& path = texPath.GetAssetPath();
+  size_t nameStart = path.find_last_of('/') + 1;
+  size_t extLength = strlen(OmniConnectTexCache::ImageExt);
+  if (path.size() < nameStart + 1 + extLength || path[nameStart] != 't')
+    return false;
+
+  if (!ContentHashFromString(path.substr(nameStart + 1, path.size() - nameStart - 1 - extLength), contentHash))
+    return false;
+
+  std::lock_guard<std::mutex> texStoreLock(TexStoreMutex);
+  return TexStore.find(contentHash) != TexStore.end();
+}
+
+void OmniConnectInternals::RestoreTexStore()
+{
+  // The scene of an earlier session keeps the reference counts of all stored files, including those of textures that won't be updated again
+  UsdPrim rootPrim = this->SceneStage->GetPrimAtPath(this->SdfRootPrimName);
+  VtValue refCountsValue = rootPrim.GetCustomDataByKey(OmniConnectTokens->textureRefCounts);
+  if (!refCountsValue.IsHolding<VtDictionary>())
+    return;
+
+  for (const auto& refCountEntry : refCountsValue.UncheckedGet<VtDictionary>())
+  {
+    OmniConnectContentHash contentHash;
+    if (!ContentHashFromString(refCountEntry.first, contentHash) || !refCountEntry.second.IsHolding<uint64_t>())
+      continue;
+    uint64_t refCount = refCountEntry.second.UncheckedGet<uint64_t>();
+    if (refCount == 0)
+      continue;
+
+    OmniConnectTexStoreEntry& storeEntry = TexStore[contentHash];
+    SetStoredTexturePaths(contentHash, storeEntry);
+    storeEntry.RefCount = refCount;
+  }
+}
+
+void OmniConnectInternals::RestoreTextureContents(OmniConnectActorCache& actorCache, OmniConnectTexCache& texCache)
+{
+  // Take over the references the texture held in the earlier session (counted by RestoreTexStore), so they are released on update
+  UsdShadeShader textureReader = UsdShadeShader::Get(actorCache.Stage, texCache.TexturePrimPath);
+  UsdShadeInput fileInput = textureReader ? textureReader.GetInput(OmniConnectTokens->file) : UsdShadeInput();
+  if (!fileInput)
+    return;
+
+  UsdAttribute fileAttr = fileInput.GetAttr();
+  SdfAssetPath texPath;
+  OmniConnectContentHash contentHash;
+  if (fileAttr.Get(&texPath, UsdTimeCode::Default()) && FindStoredTexture(texPath, contentHash))
+  {
+    texCache.ContentHash = contentHash;
+    texCache.HasContent = true;
+    texCache.SceneRelTexturePath = texPath;
+  }
+
+  std::vector<double> timeSamples;
+  fileAttr.GetTimeSamples(&timeSamples);
+  for (double timeSample : timeSamples)
+  {
+    if (fileAttr.Get(&texPath, timeSample) && FindStoredTexture(texPath, contentHash))
+    {
+      texCache.TimeSteps.push_back(timeSample);
+      texCache.TimeStepHashes.push_back(contentHash);
+      texCache.TimedSceneRelTexturePath = texPath;
+    }
+  }
+  if (!texCache.TimeSteps.empty())
+    texCache.TimeVarying = true;
+}
+
+void OmniConnectInternals::FlushTexStore()
+{
+  if (!TexStoreDirty)
+    return;
+  TexStoreDirty = false;
+
+  // Kept with the scene, so a reopened session doesn't remove files still referred to by textures of earlier sessions
+  VtDictionary refCountsDict;
+  for (const auto& storeEntry : TexStore)
+    refCountsDict[ContentHashToString(storeEntry.first)] = VtValue((uint64_t)storeEntry.second.RefCount);
+
+  UsdPrim rootPrim = this->SceneStage->GetPrimAtPath(this->SdfRootPrimName);
+  if (refCountsDict.empty())
+    rootPrim.ClearCustomDataByKey(OmniConnectTokens->textureRefCounts);
+  else
+    rootPrim.SetCustomDataByKey(OmniConnectTokens->textureRefCounts, VtValue(refCountsDict));
+
+  MarkStageDirty(this->SceneStage);
 }
 
 void OmniConnectInternals::UpdateGenericArrays(UsdGeomPrimvarsAPI& actorPrimvarsApi, UsdGeomPrimvarsAPI& clipPrimvarsApi, UsdGeomPrimvarsAPI& topPrimvarsApi, 
@@ -1199,17 +1847,32 @@ void OmniConnectInternals::UpdateGenericArrays(UsdGeomPrimvarsAPI& actorPrimvars
     switch (dataType)
     {
       case OmniConnectType::UCHAR: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UCharArray); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtUCharArray); break; }
-      case OmniConnectType::CHAR: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UCharArray); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtUCharArray); break; }
-      case OmniConnectType::USHORT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UIntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_MACRO(VtUIntArray, short); break; }
-      case OmniConnectType::SHORT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_MACRO(VtIntArray, unsigned short); break; }
+      case OmniConnectType::CHAR: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_MACRO(VtIntArray, signed char); break; }
+      case OmniConnectType::USHORT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UIntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_MACRO(VtUIntArray, unsigned short); break; }
+      case OmniConnectType::SHORT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_MACRO(VtIntArray, short); break; }
       case OmniConnectType::UINT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UIntArray); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtUIntArray); break; }
       case OmniConnectType::INT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtIntArray); break; }
       case OmniConnectType::LONG: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->Int64Array); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtInt64Array); break; }
       case OmniConnectType::ULONG: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UInt64Array); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtUInt64Array); break; }
-      case OmniConnectType::FLOAT: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->FloatArray); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtFloatArray); break; }
+      case OmniConnectType::FLOAT: 
+      {
+        if(Settings.GenericArraysHalfFloat)
+        {
+          GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->HalfArray); ASSIGN_ARRAY_TO_PRIMVAR_HALF_MACRO(float);
+        }
+        else
+        {
+          GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->FloatArray); ASSIGN_ARRAY_TO_PRIMVAR_MACRO(VtFloatArray);
+        }
+        break;
+      }
       case OmniConnectType::DOUBLE: 
       {
-        if(ConvertGenericArraysDoubleToFloat)
+        if(Settings.GenericArraysHalfFloat)
+        {
+          GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->HalfArray); ASSIGN_ARRAY_TO_PRIMVAR_HALF_MACRO(double);
+        }
+        else if(ConvertGenericArraysDoubleToFloat)
         {
           GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->FloatArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_MACRO(VtFloatArray, double);
         }
@@ -1270,13 +1933,13 @@ void OmniConnectInternals::UpdateGenericArrays(UsdGeomPrimvarsAPI& actorPrimvars
       case OmniConnectType::UCHAR4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UCharArray); ASSIGN_ARRAY_TO_PRIMVAR_FLATTEN_MACRO(VtUCharArray); break; }
       case OmniConnectType::CHAR2:
       case OmniConnectType::CHAR3: 
-      case OmniConnectType::CHAR4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UCharArray); ASSIGN_ARRAY_TO_PRIMVAR_FLATTEN_MACRO(VtUCharArray); break; }
+      case OmniConnectType::CHAR4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_FLATTEN_MACRO(VtIntArray, signed char); break; }
       case OmniConnectType::USHORT2:
       case OmniConnectType::USHORT3:
-      case OmniConnectType::USHORT4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UIntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_FLATTEN_MACRO(VtUIntArray, short); break; }
+      case OmniConnectType::USHORT4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UIntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_FLATTEN_MACRO(VtUIntArray, unsigned short); break; }
       case OmniConnectType::SHORT2:
       case OmniConnectType::SHORT3: 
-      case OmniConnectType::SHORT4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_FLATTEN_MACRO(VtIntArray, unsigned short); break; }
+      case OmniConnectType::SHORT4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->IntArray); ASSIGN_ARRAY_TO_PRIMVAR_CONVERT_FLATTEN_MACRO(VtIntArray, short); break; }
       case OmniConnectType::UINT2:
       case OmniConnectType::UINT3: 
       case OmniConnectType::UINT4: {GET_PRIMVAR_BY_NAME_MACRO(SdfValueTypeNames->UIntArray); ASSIGN_ARRAY_TO_PRIMVAR_FLATTEN_MACRO(VtUIntArray); break; }
@@ -1424,12 +2087,15 @@ void OmniConnectInternals::UpdateGeom(OmniConnectActorCache* actorCache, double
     UsdGeomImageable geomIm = UsdGeomImageable::Get(actorCache->Stage, geomCache.SdfGeomPath);
     assert(geomIm);
     geomIm.CreateVisibilityAttr().Set(UsdGeomTokens->invisible, UsdTimeCode(0.0));
-
-    // Create the geometry in the scene stage too
-    this->CreateSceneGeom<CacheType>(this->SceneStage, geomCache);
   }
 
-  this->UpdateSceneGeom<CacheType>(this->SceneStage, geomCache, geomData);
+  // Create and update the geometry in the scene stage too
+  RunIsolated(SceneStageMutex, [&]()
+  {
+    if (newGeom)
+      this->CreateSceneGeom<CacheType>(this->SceneStage, geomCache);
+    this->UpdateSceneGeom<CacheType>(this->SceneStage, geomCache, geomData);
+  });
 
   if(!geomCache.HasPrivateMaterial)
     this->SetMaterialBinding<CacheType>(*actorCache, geomId, materialId);
@@ -1438,7 +2104,7 @@ void OmniConnectInternals::UpdateGeom(OmniConnectActorCache* actorCache, double
 template<typename CacheType>
 bool OmniConnectInternals::RemoveGeomAtTime(OmniConnectActorCache* actorCache, double animTimeStep, size_t geomId)
 {
-  std::map<size_t, CacheType>& geomCaches = actorCache->GetGeomCaches<CacheType>();
+  OmniConnectIdMap<CacheType>& geomCaches = actorCache->GetGeomCaches<CacheType>();
   
   auto geomCacheIt = geomCaches.find(geomId);
   if (geomCacheIt == geomCaches.end())
@@ -1449,7 +2115,7 @@ bool OmniConnectInternals::RemoveGeomAtTime(OmniConnectActorCache* actorCache, d
   bool geomDeleted = this->RemoveActorGeomAtTime<CacheType>(*actorCache, geomCache, animTimeStep);
   if (geomDeleted)
   {
-    this->RemoveSceneGeom(this->SceneStage, geomCache.SdfGeomPath);
+    RunIsolated(SceneStageMutex, [&]() { this->RemoveSceneGeom(this->SceneStage, geomCache.SdfGeomPath); });
     geomCaches.erase(geomCacheIt);
   }
   return geomDeleted;
@@ -1458,7 +2124,7 @@ bool OmniConnectInternals::RemoveGeomAtTime(OmniConnectActorCache* actorCache, d
 template<typename CacheType>
 void OmniConnectInternals::RemoveGeom(OmniConnectActorCache* actorCache, size_t geomId)
 {
-  std::map<size_t, CacheType>& geomCaches = actorCache->GetGeomCaches<CacheType>();
+  OmniConnectIdMap<CacheType>& geomCaches = actorCache->GetGeomCaches<CacheType>();
 
   auto geomCacheIt = geomCaches.find(geomId);
   if (geomCacheIt == geomCaches.end())
@@ -1467,7 +2133,7 @@ void OmniConnectInternals::RemoveGeom(OmniConnectActorCache* actorCache, size_t
   CacheType& geomCache = geomCacheIt->second;
 
   this->RemoveActorGeom<CacheType>(*actorCache, geomCache);
-  this->RemoveSceneGeom(this->SceneStage, geomCache.SdfGeomPath);
+  RunIsolated(SceneStageMutex, [&]() { this->RemoveSceneGeom(this->SceneStage, geomCache.SdfGeomPath); });
 
   geomCaches.erase(geomCacheIt);
 }
@@ -1489,80 +2155,383 @@ void OmniConnectInternals::GetActorGeomPrimsAndStages(OmniConnectActorCache& act
       // Make sure to signal the geom type change to connector externals to reset any parent stage properties such as derived clip values.
       geomCache.ClipAssetPaths.clear();
       geomCache.ClipActives.clear();
+      geomCache.ClipTimes.clear();
+      geomCache.ClipStore.clear();
+      geomCache.ClipStoreDirtyHashes.clear();
+      geomCache.ClipStoreRewrite = true;
+      geomCache.ClipHashes.clear();
       actorCache.GeomTypeChanged = true;
     }
-    actorGeom = DefineOnEmptyPrim<PrimType>(actorCache.Stage, geomPath);
+    actorGeom = DefineOnEmptyPrim<PrimType>(actorCache.Stage, geomPath);
+
+    // A new prim has none of the clip metadata authored yet
+    geomCache.ClipAssetPaths.MarkDirty();
+    geomCache.ClipActives.MarkDirty();
+    geomCache.ClipTimes.MarkDirty();
+    geomCache.ClipStoreRewrite = true;
+  }
+  geomPrim = actorGeom.GetPrim();
+
+  // Get the clip/topology files/paths
+  geomCache.ResetTopologyFile(actorCache, this->LiveInterface.GetLiveExtension());
+  geomCache.ResetTimedGeomClipFile(animTimeStep, this->LiveInterface.GetLiveExtension());
+  std::string& geomClipFile = geomCache.TimedSceneRelGeomClipFile;
+  std::string& geomTopologyFile = geomCache.SceneRelGeomTopologyFile;
+  std::string& geomClipStagePath = geomCache.TimedGeomClipStagePath;
+  std::string& geomTopologyStagePath = geomCache.GeomTopologyStagePath;
+
+  // Create/Open the geometry and topology stage for this timestep.
+  OpenClipAndTopologyStage(geomClipStagePath.c_str(), geomTopologyStagePath.c_str(),
+    geomClipStage, geomTopologyStage);
+
+  // Populate new timestep stage and add to the value clip
+  clipGeom = PrimType::Get(geomClipStage, geomPath);
+  topGeom = PrimType::Get(geomTopologyStage, geomPath);
+  newTimeStep = !clipGeom;
+  if (newTimeStep)
+  {
+    UsdClipsAPI clipsApi(geomPrim);
+    bool saveTopGeom = false;
+    if (!topGeom) // Either because of newGeom, or because of live stage
+    {
+      topGeom = DefineOnEmptyPrim<PrimType>(geomTopologyStage, geomPath);
+      saveTopGeom = true;
+    }
+
+    if (newGeom)
+    {
+      clipsApi.SetClipPrimPath(geomCache.GeomPath);
+      clipsApi.SetClipManifestAssetPath(SdfAssetPath(geomTopologyFile));
+
+      InitializeGeom(actorGeom, actorCache.Stage, geomCache, true);
+      InitializeGeom(topGeom, geomTopologyStage, geomCache, false);
+
+      saveTopGeom = true;
+
+#ifdef TOPOLOGY_AS_SUBLAYER
+      //Add topology as sublayer
+      actorCache.Stage->GetRootLayer()->InsertSubLayerPath(geomTopologyFile);
+#else
+      geomPrim.GetReferences().AddReference(geomTopologyFile, geomPath);
+#endif
+    }
+    assert(topGeom);
+    if(saveTopGeom)
+      MarkStageDirty(geomTopologyStage);
+
+#ifdef FORCE_OMNI_CLIP_UPDATES_WITH_SUBLAYER      
+    actorCache.Stage->GetRootLayer()->InsertSubLayerPath(geomClipFile);
+#endif
+
+    OmniConnectClipArray<SdfAssetPath>& assetPaths = geomCache.ClipAssetPaths;
+    LiveInterface.FilterAssetPaths(assetPaths, geomClipFile, geomClipStage);
+    size_t assetPathIdx = assetPaths.size();
+    assetPaths.push_back(SdfAssetPath(geomClipFile));
+
+    OmniConnectClipArray<GfVec2d>& clipActives = geomCache.ClipActives;
+    bool modified = LiveInterface.ModifyClipActives(clipActives, animTimeStep, (double)assetPathIdx);
+    if(!modified && HasClipTime(geomCache.ClipTimes, animTimeStep))
+    {
+      // Timesteps sharing a stored clip have no clip file of their own, so they may already be active
+      size_t activeIdx = FindClipActive(clipActives, animTimeStep);
+      if((modified = (activeIdx != clipActives.size())))
+        clipActives.Edit(activeIdx)[1] = (double)assetPathIdx;
+    }
+    if(!modified)
+      clipActives.push_back(GfVec2d(animTimeStep, (double)assetPathIdx));
+
+    if(!geomCache.ClipTimes.empty())
+      SetClipTime(geomCache.ClipTimes, animTimeStep, animTimeStep);
+
+    MarkGeomClipMetadataDirty(actorCache, geomCache);
+
+    //Define the standard geom prim.
+    clipGeom = DefineOnEmptyPrim<PrimType>(geomClipStage, geomPath);
+
+    InitializeGeom(clipGeom, geomClipStage, geomCache, false);
+  }
+  else if (!geomCache.ClipStore.empty() && ReleaseStoredGeomClip(geomCache, animTimeStep, false))
+  {
+    MarkGeomClipMetadataDirty(actorCache, geomCache);
+  }
+}
+
+void OmniConnectInternals::SetGeomClipMetadata(const UsdPrim& geomPrim, OmniConnectGeomCache& geomCache)
+{
+  // Only changed arrays are authored, as views of the cached arrays rather than copies (see OmniConnectClipArray)
+  UsdClipsAPI clipsApi(geomPrim);
+  if (geomCache.ClipAssetPaths.IsDirty())
+    clipsApi.SetClipAssetPaths(geomCache.ClipAssetPaths.GetAuthoringView());
+  if (geomCache.ClipActives.IsDirty())
+    clipsApi.SetClipActive(geomCache.ClipActives.GetAuthoringView());
+  if (geomCache.ClipTimes.IsDirty() && !geomCache.ClipTimes.empty())
+    clipsApi.SetClipTimes(geomCache.ClipTimes.GetAuthoringView());
+
+  // The clip store is kept with the actor stage, for resumed sessions
+  if (geomCache.ClipStoreRewrite)
+  {
+    geomCache.ClipStoreRewrite = false;
+    geomCache.ClipStoreDirtyHashes.clear();
+    if (geomCache.ClipStore.empty())
+    {
+      geomPrim.ClearCustomDataByKey(OmniConnectTokens->clipContentHashes);
+      return;
+    }
+    VtDictionary clipStoreDict;
+    for (const auto& storeEntry : geomCache.ClipStore)
+      clipStoreDict[ContentHashToString(storeEntry.first)] = VtValue(GfVec2d((double)storeEntry.second.AssetPathIdx, storeEntry.second.ClipTime));
+    geomPrim.SetCustomDataByKey(OmniConnectTokens->clipContentHashes, VtValue(clipStoreDict));
+    return;
+  }
+
+  // Otherwise only the entries added or erased since the last flush are edited within the authored dictionary
+  for (const OmniConnectContentHash& clipHash : geomCache.ClipStoreDirtyHashes)
+  {
+    TfToken hashKey(OmniConnectTokens->clipContentHashes.GetString() + ":" + ContentHashToString(clipHash));
+    auto storeIt = geomCache.ClipStore.find(clipHash);
+    if (storeIt == geomCache.ClipStore.end())
+      geomPrim.ClearCustomDataByKey(hashKey);
+    else
+      geomPrim.SetCustomDataByKey(hashKey, VtValue(GfVec2d((double)storeIt->second.AssetPathIdx, storeIt->second.ClipTime)));
+  }
+  geomCache.ClipStoreDirtyHashes.clear();
+}
+
+void OmniConnectInternals::MarkGeomClipMetadataDirty(OmniConnectActorCache& actorCache, OmniConnectGeomCache& geomCache)
+{
+  // Authoring is batched per flush, and only covers the clip state changed since the previous one
+  geomCache.ClipMetadataDirty = true;
+  actorCache.ClipMetadataDirty = true;
+}
+
+template<typename CacheType>
+void OmniConnectInternals::FlushGeomClipMetadata(OmniConnectActorCache& actorCache)
+{
+  for (auto& geomCacheEntry : actorCache.GetGeomCaches<CacheType>())
+  {
+    CacheType& geomCache = geomCacheEntry.second;
+    if (!geomCache.ClipMetadataDirty)
+      continue;
+    geomCache.ClipMetadataDirty = false;
+
+    // The geom prim has been removed along with its last timestep
+    UsdPrim geomPrim = actorCache.Stage->GetPrimAtPath(geomCache.SdfGeomPath);
+    if (geomPrim && !geomCache.ClipActives.empty())
+      SetGeomClipMetadata(geomPrim, geomCache);
+  }
+}
+
+void OmniConnectInternals::FlushClipMetadata(OmniConnectActorCache& actorCache)
+{
+  if (!actorCache.ClipMetadataDirty)
+    return;
+  actorCache.ClipMetadataDirty = false;
+
+  OMNICONNECT_PROFILE_SCOPE("FlushClipMetadata");
+
+  FlushGeomClipMetadata<OmniConnectMeshCache>(actorCache);
+  FlushGeomClipMetadata<OmniConnectInstancerCache>(actorCache);
+  FlushGeomClipMetadata<OmniConnectCurveCache>(actorCache);
+  FlushGeomClipMetadata<OmniConnectVolumeCache>(actorCache);
+
+  MarkStageDirty(actorCache.Stage);
+}
+
+void OmniConnectInternals::FlushLodVariants(OmniConnectActorCache& actorCache)
+{
+  if (!actorCache.LodVariantsDirty)
+    return;
+  actorCache.LodVariantsDirty = false;
+
+  UsdPrim actorPrim = actorCache.Stage->GetPrimAtPath(actorCache.SdfActorPrimPath);
+  SdfPrimSpecHandle actorPrimSpec = actorCache.Stage->GetRootLayer()->GetPrimAtPath(actorCache.SdfActorPrimPath);
+  if (!actorPrim || !actorPrimSpec)
+    return;
+
+  // Per mesh with levels of detail, its cache followed by those of its levels (if present)
+  std::map<size_t, std::vector<const OmniConnectMeshCache*>> meshLevels;
+  int maxLodLevel = 0;
+  for (const auto& meshCacheEntry : actorCache.MeshCaches)
+  {
+    const OmniConnectMeshCache& meshCache = meshCacheEntry.second;
+    if (meshCache.LodLevel == 0)
+      continue;
+
+    std::vector<const OmniConnectMeshCache*>& levels = meshLevels[meshCache.LodBaseMeshId];
+    levels.resize(std::max(levels.size(), size_t(meshCache.LodLevel + 1)), nullptr);
+    levels[meshCache.LodLevel] = &meshCache;
+    maxLodLevel = std::max(maxLodLevel, meshCache.LodLevel);
+  }
+  for (auto& levelsEntry : meshLevels)
+  {
+    auto baseCacheIt = actorCache.MeshCaches.find(levelsEntry.first);
+    if (baseCacheIt != actorCache.MeshCaches.end())
+      levelsEntry.second[0] = &baseCacheIt->second;
+  }
+
+  // The variant set is rebuilt as a whole, so no opinions remain for levels that have been removed
+  const std::string& lodSetName = OmniConnectTokens->lodVariantSet.GetString();
+  std::string selection = actorPrim.GetVariantSet(lodSetName).GetVariantSelection();
+  actorPrimSpec->RemoveVariantSet(lodSetName);
+  actorPrimSpec->GetVariantSetNameList().RemoveItemEdits(lodSetName);
+  actorPrimSpec->SetVariantSelection(lodSetName, std::string());
+
+  if (maxLodLevel > 0)
+  {
+    // Each variant deactivates all but one level per mesh: the requested one, or the coarsest one below it
+    UsdVariantSet lodVariantSet = actorPrim.GetVariantSets().AddVariantSet(lodSetName);
+    bool selectionExists = false;
+    for (int level = 0; level <= maxLodLevel; ++level)
+    {
+      std::string variantName = (level == 0) ? OmniConnectTokens->lodVariantFull.GetString() : "lod" + std::to_string(level);
+      lodVariantSet.AddVariant(variantName);
+      selectionExists = selectionExists || (variantName == selection);
+
+      SdfPath variantPath = actorCache.SdfActorPrimPath.AppendVariantSelection(lodSetName, variantName);
+      for (const auto& levelsEntry : meshLevels)
+      {
+        const std::vector<const OmniConnectMeshCache*>& levels = levelsEntry.second;
+        int shownLevel = std::min(level, int(levels.size()) - 1);
+        while (shownLevel > 0 && !levels[shownLevel])
+          --shownLevel;
+
+        for (int meshLevel = 0; meshLevel < int(levels.size()); ++meshLevel)
+        {
+          if (!levels[meshLevel] || meshLevel == shownLevel)
+            continue;
+          SdfPath inactivePath = levels[meshLevel]->SdfGeomPath.ReplacePrefix(actorCache.SdfActorPrimPath, variantPath);
+          SdfPrimSpecHandle inactiveSpec = SdfCreatePrimInLayer(actorCache.Stage->GetRootLayer(), inactivePath);
+          inactiveSpec->SetActive(false);
+        }
+      }
+    }
+    lodVariantSet.SetVariantSelection(selectionExists ? selection : OmniConnectTokens->lodVariantFull.GetString());
   }
-  geomPrim = actorGeom.GetPrim();
-
-  // Get the clip/topology files/paths
-  geomCache.ResetTopologyFile(actorCache, this->LiveInterface.GetLiveExtension());
-  geomCache.ResetTimedGeomClipFile(animTimeStep, this->LiveInterface.GetLiveExtension());
-  std::string& geomClipFile = geomCache.TimedSceneRelGeomClipFile;
-  std::string& geomTopologyFile = geomCache.SceneRelGeomTopologyFile;
-  std::string& geomClipStagePath = geomCache.TimedGeomClipStagePath;
-  std::string& geomTopologyStagePath = geomCache.GeomTopologyStagePath;
 
-  // Create/Open the geometry and topology stage for this timestep.
-  OpenClipAndTopologyStage(geomClipStagePath.c_str(), geomTopologyStagePath.c_str(),
-    geomClipStage, geomTopologyStage);
+  MarkStageDirty(actorCache.Stage);
+}
 
-  // Populate new timestep stage and add to the value clip
-  clipGeom = PrimType::Get(geomClipStage, geomPath);
-  topGeom = PrimType::Get(geomTopologyStage, geomPath);
-  newTimeStep = !clipGeom;
-  if (newTimeStep)
+void OmniConnectInternals::DeduplicateGeomClip(OmniConnectActorCache& actorCache, OmniConnectGeomCache& geomCache, UsdStageRefPtr& geomClipStage, double animTimeStep)
+{
+  // Live clips are edited in place and their asset paths filtered, see OmniConnectLiveInterface
+  if (LiveInterface.GetLiveWorkflowEnabled())
   {
-    UsdClipsAPI clipsApi(geomPrim);
-    bool saveTopGeom = false;
-    if (!topGeom) // Either because of newGeom, or because of live stage
+    if (!geomCache.ClipStore.empty())
     {
-      topGeom = DefineOnEmptyPrim<PrimType>(geomTopologyStage, geomPath);
-      saveTopGeom = true;
+      geomCache.ClipStore.clear();
+      geomCache.ClipStoreDirtyHashes.clear();
+      geomCache.ClipStoreRewrite = true;
     }
+    geomCache.ClipHashes.clear();
+    return;
+  }
 
-    if (newGeom)
-    {
-      clipsApi.SetClipPrimPath(geomCache.GeomPath);
-      clipsApi.SetClipManifestAssetPath(SdfAssetPath(geomTopologyFile));
+  OmniConnectClipArray<GfVec2d>& clipActives = geomCache.ClipActives;
+  size_t activeIdx = FindClipActive(clipActives, animTimeStep);
+  if (activeIdx == clipActives.size())
+    return;
+  size_t assetPathIdx = (size_t)clipActives[activeIdx][1];
+
+  // Clips that haven't been edited since they were last hashed keep their hash
+  SdfLayerHandle clipLayer = geomClipStage->GetRootLayer();
+  auto hashIt = geomCache.ClipHashes.find(animTimeStep);
+  if (hashIt == geomCache.ClipHashes.end())
+    hashIt = geomCache.ClipHashes.emplace(animTimeStep, HashGeomClip(clipLayer, geomCache.SdfGeomPath, animTimeStep)).first;
+  else if (clipLayer->IsDirty())
+    hashIt->second = HashGeomClip(clipLayer, geomCache.SdfGeomPath, animTimeStep);
+  const OmniConnectContentHash& clipHash = hashIt->second;
+
+  auto storeIt = geomCache.ClipStore.find(clipHash);
+  if (storeIt == geomCache.ClipStore.end())
+  {
+    geomCache.ClipStore.emplace(clipHash, OmniConnectClipStoreEntry{ assetPathIdx, animTimeStep });
+    geomCache.ClipStoreDirtyHashes.push_back(clipHash);
+    MarkGeomClipMetadataDirty(actorCache, geomCache);
+    return;
+  }
 
-      InitializeGeom(actorGeom, actorCache.Stage, geomCache, true);
-      InitializeGeom(topGeom, geomTopologyStage, geomCache, false);
+  const OmniConnectClipStoreEntry& storeEntry = storeIt->second;
+  if (storeEntry.AssetPathIdx == assetPathIdx)
+    return;
 
-      saveTopGeom = true;
+  // Identical contents have been stored before; refer to that clip at its sample time and drop the clip file of this timestep.
+  // A clip file of the timestep's own isn't referred to by others, as it gets moved out of the way once shared (see ReleaseStoredGeomClip).
+  clipActives.Edit(activeIdx)[1] = (double)storeEntry.AssetPathIdx;
+  geomCache.ResetTimedGeomClipFile(animTimeStep, this->LiveInterface.GetLiveExtension());
+  if (geomCache.ClipAssetPaths[assetPathIdx].GetAssetPath() == geomCache.TimedSceneRelGeomClipFile
+    || CountClipActiveRefs(clipActives, (double)assetPathIdx) == 0)
+    EraseClipAssetPath(geomCache, assetPathIdx);
 
-#ifdef TOPOLOGY_AS_SUBLAYER
-      //Add topology as sublayer
-      actorCache.Stage->GetRootLayer()->InsertSubLayerPath(geomTopologyFile);
-#else
-      geomPrim.GetReferences().AddReference(geomTopologyFile, geomPath);
-#endif
-    }
-    assert(topGeom);
-    if(UsdSaveEnabled && saveTopGeom)
-      geomTopologyStage->Save();
+  if (geomCache.ClipTimes.empty())
+  {
+    for (const GfVec2d& clipActive : clipActives)
+      SetClipTime(geomCache.ClipTimes, clipActive[0], clipActive[0]);
+  }
+  SetClipTime(geomCache.ClipTimes, animTimeStep, storeEntry.ClipTime);
 
-#ifdef FORCE_OMNI_CLIP_UPDATES_WITH_SUBLAYER      
-    actorCache.Stage->GetRootLayer()->InsertSubLayerPath(geomClipFile);
-#endif
+  MarkGeomClipMetadataDirty(actorCache, geomCache);
 
-    VtArray<SdfAssetPath>& assetPaths = geomCache.ClipAssetPaths;
-    LiveInterface.FilterAssetPaths(assetPaths, geomClipFile, geomClipStage);
-    size_t assetPathIdx = assetPaths.size();
-    assetPaths.push_back(SdfAssetPath(geomClipFile));
-    clipsApi.SetClipAssetPaths(assetPaths);
+  UnmarkStageDirty(geomClipStage);
+  geomClipStage = TfNullPtr;
+  Connection->RemoveFile(geomCache.TimedGeomClipStagePath.c_str());
+}
 
-    VtVec2dArray& clipActives = geomCache.ClipActives;
-    bool modified = LiveInterface.ModifyClipActives(clipActives, animTimeStep, (double)assetPathIdx);
-    if(!modified)
-      clipActives.push_back(GfVec2d(animTimeStep, (double)assetPathIdx));
-    clipsApi.SetClipActive(clipActives);
+bool OmniConnectInternals::ReleaseStoredGeomClip(OmniConnectGeomCache& geomCache, double animTimeStep, bool removeTimeStep)
+{
+  // The clip of animTimeStep is about to be rewritten or removed, so its contents can't stay in the clip store as they are.
+  // If other timesteps still share them, they move to a content-addressed clip file first.
+  // Expects the timed clip file members of geomCache to be set for animTimeStep, returns whether the clip metadata has changed.
+  OmniConnectClipArray<GfVec2d>& clipActives = geomCache.ClipActives;
+  size_t activeIdx = FindClipActive(clipActives, animTimeStep);
+  if (activeIdx == clipActives.size())
+    return false;
+  double assetPathIdx = clipActives[activeIdx][1];
+
+  auto storeIt = std::find_if(geomCache.ClipStore.begin(), geomCache.ClipStore.end(),
+    [assetPathIdx](const std::pair<const OmniConnectContentHash, OmniConnectClipStoreEntry>& storeEntry) { return (double)storeEntry.second.AssetPathIdx == assetPathIdx; });
+  if (storeIt == geomCache.ClipStore.end())
+    return false;
+
+  OmniConnectClipArray<SdfAssetPath>& assetPaths = geomCache.ClipAssetPaths;
+  const std::string& clipFile = assetPaths[(size_t)assetPathIdx].GetAssetPath();
+  bool ownsClipFile = (clipFile == geomCache.TimedSceneRelGeomClipFile);
+
+  if (CountClipActiveRefs(clipActives, assetPathIdx) == 1)
+  {
+    if (!ownsClipFile)
+    {
+      // Last reference to a content-addressed clip file
+      geomCache.ResetTempClipUrl(clipFile);
+      UnmarkFileDirty(geomCache.TempClipUrl.c_str());
+      Connection->RemoveFile(geomCache.TempClipUrl.c_str());
+    }
+    geomCache.ClipStoreDirtyHashes.push_back(storeIt->first);
+    geomCache.ClipStore.erase(storeIt);
+    return true;
+  }
 
-    //Define the standard geom prim.
-    clipGeom = DefineOnEmptyPrim<PrimType>(geomClipStage, geomPath);
+  if (!ownsClipFile)
+    return false;
 
-    InitializeGeom(clipGeom, geomClipStage, geomCache, false);
+  std::string sharedClipFile = OmniGeomRelativePath + geomCache.GeomStageBaseName + ".c" + ContentHashToString(storeIt->first) + this->LiveInterface.GetLiveExtension();
+  std::string clipUrl = Connection->GetUrl(geomCache.TimedGeomClipStagePath.c_str());
+  geomCache.ResetTempClipUrl(sharedClipFile);
+  std::string sharedClipUrl = Connection->GetUrl(geomCache.TempClipUrl.c_str());
+
+  SdfLayerRefPtr clipLayer = SdfLayer::FindOrOpen(clipUrl);
+  if (!clipLayer || !clipLayer->Export(sharedClipUrl))
+  {
+    OmniConnectErrorMacro("Failed to move shared clip contents from " << clipUrl << " to " << sharedClipUrl);
+    return false;
+  }
+  assetPaths.Edit((size_t)assetPathIdx) = SdfAssetPath(sharedClipFile);
+
+  if (!removeTimeStep)
+  {
+    clipActives.Edit(activeIdx)[1] = (double)assetPaths.size();
+    assetPaths.push_back(SdfAssetPath(geomCache.TimedSceneRelGeomClipFile));
   }
+  return true;
 }
 
 void OmniConnectInternals::InitializeGeom(UsdGeomMesh& mesh, UsdStageRefPtr& geomStage, OmniConnectMeshCache& meshCache, bool setDefaultValues)
@@ -1794,6 +2763,19 @@ namespace
       clipAttrib.ClearAtTime(timeCode);
   }
 
+  template<typename UsdGeomType, typename MemFncClassType>
+  void MoveStaticValueToManifest(const UsdAttribute& actAttrib, UsdGeomType& topGeom,
+    UsdAttribute (MemFncClassType::*topAttribCreateFun)(VtValue const&, bool) const)
+  {
+    // Clips written while the attribute wasn't timevarying carry no samples of it, so they fall back to the default value of the manifest.
+    // Only the actor layer itself is inspected, as the manifest is referenced by the actor prim as well.
+    SdfAttributeSpecHandle actAttribSpec = actAttrib.GetStage()->GetRootLayer()->GetAttributeAtPath(actAttrib.GetPath());
+    if (!actAttribSpec || !actAttribSpec->HasDefaultValue())
+      return;
+
+    (topGeom.*topAttribCreateFun)(VtValue(), false).Set(actAttribSpec->GetDefaultValue());
+  }
+
   void SyncTimeVaryingInput(UsdShadeShader& actShader, UsdShadeShader& clipShader, UsdShadeShader& topShader, 
     bool timeVarying, const UsdTimeCode& timeCode, const TfToken& inputName, const char* inputNameStr, const SdfValueTypeName& primvarType)
   {
@@ -1872,10 +2854,7 @@ namespace
       }
 
       // Usd requires extent.
-      GfRange3f extent;
-      for (const auto& pt : usdVerts) {
-        extent.UnionWith(pt);
-      }
+      GfRange3f extent = GetPointsExtent(omniGeomData);
       VtVec3fArray extentArray(2);
       extentArray[0] = extent.GetMin();
       extentArray[1] = extent.GetMax();
@@ -1885,14 +2864,101 @@ namespace
     }
   }
 
+  // Blocks the normals of the encodings other than normalsEncoding at timeCode, as written by an earlier session (or before a
+  // settings change): primvars:normals would override the normals attribute, and the normals attribute would remain next to normalsOct.
+  template<typename UsdGeomType>
+  void BlockStaleNormals(UsdGeomType& outGeom, const UsdTimeCode& timeCode, OmniConnectNormalsEncoding normalsEncoding)
+  {
+    UsdGeomPrimvarsAPI primvarsApi(outGeom);
+    UsdAttribute encodedNormals[3] = { // Indexed by OmniConnectNormalsEncoding
+      outGeom.GetNormalsAttr(),
+      primvarsApi.GetPrimvar(OmniConnectTokens->normals).GetAttr(),
+      primvarsApi.GetPrimvar(OmniConnectTokens->normalsOct).GetAttr() };
+
+    for (int encoding = 0; encoding < 3; ++encoding)
+    {
+      UsdAttribute& normalsAttr = encodedNormals[encoding];
+      if (encoding != (int)normalsEncoding && normalsAttr && normalsAttr.HasAuthoredValue())
+        normalsAttr.Set(SdfValueBlock(), timeCode);
+    }
+  }
+
+  template<typename UsdGeomType, typename GeomDataType>
+  void UpdateUsdGeomEncodedNormals(UsdGeomType& actGeom, UsdGeomType& clipGeom, UsdGeomType& topGeom, const GeomDataType& omniGeomData, uint64_t numPrims,
+    TimeEvaluator<GeomDataType>& timeEval, OmniConnectNormalsEncoding normalsEncoding)
+  {
+    // Encoded normals are primvars; primvars:normals takes precedence over the normals attribute, normalsOct has to be decoded by the consumer.
+    using DMI = typename GeomDataType::DataMemberId;
+    bool octahedral = (normalsEncoding == OmniConnectNormalsEncoding::OCTAHEDRAL);
+    const TfToken& primvarName = octahedral ? OmniConnectTokens->normalsOct : OmniConnectTokens->normals;
+    const SdfValueTypeName& primvarType = octahedral ? SdfValueTypeNames->IntArray : SdfValueTypeNames->Normal3hArray;
+
+    UsdGeomPrimvarsAPI actPrimvarsApi(actGeom), clipPrimvarsApi(clipGeom), topPrimvarsApi(topGeom);
+    TimeEvaluator<bool> primvarTimeEval(timeEval.IsTimeVarying(DMI::NORMALS), timeEval.TimeCode.GetValue());
+    const UsdTimeCode& timeCode = primvarTimeEval.Eval();
+
+    UsdAttribute arrayPrimvar = GetPrimvarByName(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, primvarName.GetText(), primvarTimeEval,
+      primvarType, omniGeomData.PerPrimNormals);
+    assert(arrayPrimvar);
+
+    BlockStaleNormals(primvarTimeEval.TimeVarying ? clipGeom : actGeom, timeCode, normalsEncoding);
+
+    if (omniGeomData.Normals == nullptr)
+    {
+      arrayPrimvar.Set(SdfValueBlock(), timeCode);
+      return;
+    }
+
+    void* arrayData = omniGeomData.Normals;
+    size_t arrayNumElements = omniGeomData.PerPrimNormals ? numPrims : omniGeomData.NumPoints;
+    bool setPrimvar = true;
+    if (octahedral)
+    {
+      VtIntArray usdArray(arrayNumElements);
+      switch (omniGeomData.NormalsType)
+      {
+      case OmniConnectType::FLOAT3: { ocutils::OctEncodeNormals(reinterpret_cast<const float*>(arrayData), usdArray.data(), arrayNumElements); break; }
+      case OmniConnectType::DOUBLE3: { ocutils::OctEncodeNormals(reinterpret_cast<const double*>(arrayData), usdArray.data(), arrayNumElements); break; }
+      default: { setPrimvar = false; break; }
+      }
+      ASSIGN_SET_PRIMVAR;
+
+      actPrimvarsApi.GetPrimvar(primvarName).GetAttr().SetCustomDataByKey(OmniConnectTokens->encoding, VtValue(OmniConnectTokens->octahedralSnorm16));
+    }
+    else
+    {
+      VtVec3hArray usdArray(arrayNumElements);
+      switch (omniGeomData.NormalsType)
+      {
+      case OmniConnectType::FLOAT3: { ConvertScalarsToHalf(reinterpret_cast<const float*>(arrayData), usdArray.data()->data(), 3 * arrayNumElements); break; }
+      case OmniConnectType::DOUBLE3: { ConvertScalarsToHalf(reinterpret_cast<const double*>(arrayData), usdArray.data()->data(), 3 * arrayNumElements); break; }
+      default: { setPrimvar = false; break; }
+      }
+      ASSIGN_SET_PRIMVAR;
+    }
+
+    if (!setPrimvar)
+    {
+      arrayPrimvar.ClearAtTime(timeCode);
+      OmniConnectErrorMacro("Encoded normals do not support type: " << omniGeomData.NormalsType);
+    }
+  }
+
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomNormals(UsdGeomType& actGeom, UsdGeomType& clipGeom, UsdGeomType& topGeom, const GeomDataType& omniGeomData, uint64_t numPrims,
-    OmniConnectUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval)
+    OmniConnectUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval, OmniConnectNormalsEncoding normalsEncoding)
   {
     using DMI = typename GeomDataType::DataMemberId;
     bool performsUpdate = updateEval.PerformsUpdate(DMI::NORMALS);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::NORMALS);
 
+    if (normalsEncoding != OmniConnectNormalsEncoding::FLOAT)
+    {
+      if (performsUpdate)
+        UpdateUsdGeomEncodedNormals(actGeom, clipGeom, topGeom, omniGeomData, numPrims, timeEval, normalsEncoding);
+      return;
+    }
+
     SyncTimeVaryingAttribute(actGeom.GetNormalsAttr(), clipGeom.GetNormalsAttr(), topGeom,
       timeVaryingUpdate, timeEval.TimeCode, OmniConnectTokens->normals, &UsdGeomType::CreateNormalsAttr);
       
@@ -1905,6 +2971,8 @@ namespace
       UsdAttribute normalsAttr = outGeom.GetNormalsAttr();
       assert(normalsAttr);
 
+      BlockStaleNormals(outGeom, timeCode, normalsEncoding);
+
       if (omniGeomData.Normals != nullptr)
       {
         void* arrayData = omniGeomData.Normals;
@@ -1976,7 +3044,8 @@ namespace
 
   template<typename GeomDataType>
   void UpdateUsdGeomColors(UsdGeomPrimvarsAPI& actorPrimvarsApi, UsdGeomPrimvarsAPI& clipPrimvarsApi, UsdGeomPrimvarsAPI& topPrimvarsApi, 
-    const GeomDataType& omniGeomData, uint64_t numPrims, OmniConnectUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval
+    const GeomDataType& omniGeomData, uint64_t numPrims, OmniConnectUpdateEvaluator<const GeomDataType>& updateEval, TimeEvaluator<GeomDataType>& timeEval,
+    OmniConnectGeomCache& geomCache
 #if defined(USE_MDL_MATERIALS) && USE_CUSTOM_POINT_SHADER
     , bool isPointsGeom = false
 #endif
@@ -2046,18 +3115,24 @@ namespace
       if (colors != nullptr)
       {
         uint64_t numColorEntries = omniGeomData.PerPrimColors ? numPrims : omniGeomData.NumPoints;
-        VtArray<GfVec3f> usdVertColors(numColorEntries);
-        VtFloatArray usdVertOpacities(numColorEntries);
-
         int ccM = omniGeomData.ColorComponents;
-        const float* srgbTable = ocutils::SrgbToLinearTable();
-        for (uint64_t i = 0; i < numColorEntries; ++i)
+
+        // Unchanged colors share the converted arrays of the previous update (and with that, their memory across timesamples)
+        size_t colorsSize = numColorEntries * ccM;
+        if (geomCache.LinearColors.size() != numColorEntries || geomCache.LinearColorsSource.size() != colorsSize ||
+          memcmp(geomCache.LinearColorsSource.data(), colors, colorsSize) != 0)
         {
-          usdVertColors[i] = GfVec3f(srgbTable[colors[ccM * i]], srgbTable[colors[ccM * i + 1]], srgbTable[colors[ccM * i + 2]]);
-          if(ccM > 3)
-            usdVertOpacities[i] = (float)colors[ccM * i + 3]/255.0f;
+          geomCache.LinearColors = VtVec3fArray(numColorEntries);
+          geomCache.LinearOpacities = (ccM > 3) ? VtFloatArray(numColorEntries) : VtFloatArray();
+
+          ocutils::SrgbToLinearBatch(colors, geomCache.LinearColors.data()->data(), numColorEntries, ccM,
+            (ccM > 3) ? geomCache.LinearOpacities.data() : nullptr);
+          geomCache.LinearColorsSource.assign(colors, colors + colorsSize);
         }
 
+        const VtVec3fArray& usdVertColors = geomCache.LinearColors;
+        const VtFloatArray& usdVertOpacities = geomCache.LinearOpacities;
+
         colorPrimvar.Set(usdVertColors, timeCode);
 
         if(ccM > 3)
@@ -2145,6 +3220,13 @@ namespace
     bool performsUpdate = updateEval.PerformsUpdate(DMI::INDICES);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::INDICES);
 
+    if (timeVaryingUpdate)
+    {
+      // Connectivity may have been written once for all timesteps up to now, see OmniConnectMeshData::TimeVarying
+      MoveStaticValueToManifest(actGeom.GetFaceVertexIndicesAttr(), topGeom, &UsdGeomType::CreateFaceVertexIndicesAttr);
+      MoveStaticValueToManifest(actGeom.GetFaceVertexCountsAttr(), topGeom, &UsdGeomType::CreateFaceVertexCountsAttr);
+    }
+
     SyncTimeVaryingAttribute(actGeom.GetFaceVertexIndicesAttr(), clipGeom.GetFaceVertexIndicesAttr(), topGeom,
       timeVaryingUpdate, timeEval.TimeCode, OmniConnectTokens->faceVertexIndices, &UsdGeomType::CreateFaceVertexIndicesAttr);
     SyncTimeVaryingAttribute(actGeom.GetFaceVertexCountsAttr(), clipGeom.GetFaceVertexCountsAttr(), topGeom,
@@ -2707,19 +3789,18 @@ bool OmniConnectInternals::UpdateActorGeom(OmniConnectActorCache& actorCache, Om
   uint64_t numPrims = int(omniMeshData.NumIndices) / 3;
 
   UPDATE_USDGEOM_MESH(UpdateUsdGeomPoints);
-  UPDATE_USDGEOM_MESH(UpdateUsdGeomNormals);
+  UpdateUsdGeomNormals(meshActorGeom, meshClipGeom, meshTopGeom, omniMeshData, numPrims, updateEval, timeEval, Settings.NormalsEncoding);
   UPDATE_USDGEOM_MESH_PRIMVARS(UpdateUsdGeomTexCoords);
-  UPDATE_USDGEOM_MESH_PRIMVARS(UpdateUsdGeomColors);
+  UpdateUsdGeomColors(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, omniMeshData, numPrims, updateEval, timeEval, meshCache);
   UPDATE_USDGEOM_MESH(UpdateUsdGeomIndices);
 
   UpdateGenericArrays(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, updatedGenericArrays, numUga, animTimeStep);
   DeleteGenericArrays(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, deletedGenericArrays, numDga, animTimeStep);
 
-  if (UsdSaveEnabled)
-  {
-    geomTopologyStage->Save();
-    geomClipStage->Save();
-  }
+  MarkStageDirty(geomTopologyStage);
+  MarkStageDirty(geomClipStage);
+
+  DeduplicateGeomClip(actorCache, meshCache, geomClipStage, animTimeStep);
 
   return newMesh;
 }
@@ -2762,7 +3843,7 @@ bool OmniConnectInternals::UpdateActorGeom(OmniConnectActorCache& actorCache, Om
     UPDATE_USDGEOM_POINTS(UpdateUsdGeomOrientNormals);
     UPDATE_USDGEOM_POINTS_PRIMVARS(UpdateUsdGeomTexCoords);
 
-    UpdateUsdGeomColors(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, omniInstancerData, numPrims, updateEval, timeEval
+    UpdateUsdGeomColors(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, omniInstancerData, numPrims, updateEval, timeEval, instancerCache
 #if defined(USE_MDL_MATERIALS) && USE_CUSTOM_POINT_SHADER
       , true
 #endif
@@ -2794,7 +3875,7 @@ bool OmniConnectInternals::UpdateActorGeom(OmniConnectActorCache& actorCache, Om
     UPDATE_USDGEOM_POINTS(UpdateUsdGeomScales);
     UPDATE_USDGEOM_POINTS(UpdateUsdGeomOrientations);
     UPDATE_USDGEOM_POINTS_PRIMVARS(UpdateUsdGeomTexCoords);
-    UPDATE_USDGEOM_POINTS_PRIMVARS(UpdateUsdGeomColors);
+    UpdateUsdGeomColors(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, omniInstancerData, numPrims, updateEval, timeEval, instancerCache);
     UPDATE_USDGEOM_POINTS(UpdateUsdGeomShapeIndices);
     UPDATE_USDGEOM_POINTS(UpdateUsdGeomLinearVelocities);
     UPDATE_USDGEOM_POINTS(UpdateUsdGeomAngularVelocities);
@@ -2804,11 +3885,10 @@ bool OmniConnectInternals::UpdateActorGeom(OmniConnectActorCache& actorCache, Om
     DeleteGenericArrays(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, deletedGenericArrays, numDga, animTimeStep);
   }
 
-  if (UsdSaveEnabled)
-  {
-    geomTopologyStage->Save();
-    geomClipStage->Save();
-  }
+  MarkStageDirty(geomTopologyStage);
+  MarkStageDirty(geomClipStage);
+
+  DeduplicateGeomClip(actorCache, instancerCache, geomClipStage, animTimeStep);
 
   return newInstancer;
 }
@@ -2840,20 +3920,19 @@ bool OmniConnectInternals::UpdateActorGeom(OmniConnectActorCache & actorCache, O
   uint64_t numPrims = omniCurveData.NumCurveLengths;
 
   UPDATE_USDGEOM_CURVE(UpdateUsdGeomPoints);
-  UPDATE_USDGEOM_CURVE(UpdateUsdGeomNormals);
+  UpdateUsdGeomNormals(curveActorGeom, curveClipGeom, curveTopGeom, omniCurveData, numPrims, updateEval, timeEval, Settings.NormalsEncoding);
   UPDATE_USDGEOM_CURVE_PRIMVARS(UpdateUsdGeomTexCoords);
-  UPDATE_USDGEOM_CURVE_PRIMVARS(UpdateUsdGeomColors);
+  UpdateUsdGeomColors(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, omniCurveData, numPrims, updateEval, timeEval, curveCache);
   UPDATE_USDGEOM_CURVE(UpdateUsdGeomWidths);
   UPDATE_USDGEOM_CURVE(UpdateUsdGeomCurveLengths);
 
   UpdateGenericArrays(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, updatedGenericArrays, numUga, animTimeStep);
   DeleteGenericArrays(actPrimvarsApi, clipPrimvarsApi, topPrimvarsApi, deletedGenericArrays, numDga, animTimeStep);
 
-  if (UsdSaveEnabled)
-  {
-    geomTopologyStage->Save();
-    geomClipStage->Save();
-  }
+  MarkStageDirty(geomTopologyStage);
+  MarkStageDirty(geomClipStage);
+
+  DeduplicateGeomClip(actorCache, curveCache, geomClipStage, animTimeStep);
 
   return newCurve;
 }
@@ -3003,28 +4082,36 @@ bool OmniConnectInternals::UpdateActorGeom(OmniConnectActorCache& actorCache, Om
 
     geomOutPrim.GetExtentAttr().Set(extentArray, timeCode); // Always timevarying
 
-    // Write VDB data 
-    VolumeWriter->ToVDB(omniVolumeData,
-      updatedGenericArrays, numUga);
+    // Write VDB data, directly into the file if the connection allows for it
+    std::string& ovdbFile = volumeCache.TimedOvdbFile;
+    const char* directWritePath = Connection->GetDirectWritePath(ovdbFile.c_str());
+    bool fileWritten = false;
+    RunIsolated(VolumeWriterMutex, [&]() // One writer and serialization buffer for all actors
+    {
+      VolumeWriter->SetConvertDoubleToFloat(ConvertGenericArraysDoubleToFloat);
+      {
+        OMNICONNECT_PROFILE_SCOPE("SerializeVolume");
+        fileWritten = VolumeWriter->ToVDB(omniVolumeData,
+          updatedGenericArrays, numUga, directWritePath);
+      }
 
-    // Get serialized data
-    const char* volumeStreamData; size_t volumeStreamDataSize;
-    VolumeWriter->GetSerializedVolumeData(volumeStreamData, volumeStreamDataSize);
+      if (fileWritten && !directWritePath)
+      {
+        // Get serialized data and write to file
+        const char* volumeStreamData; size_t volumeStreamDataSize;
+        VolumeWriter->GetSerializedVolumeData(volumeStreamData, volumeStreamDataSize);
 
-    // Write to file
-    std::string& ovdbFile = volumeCache.TimedOvdbFile;
-    bool fileWritten = Connection->WriteFile(volumeStreamData, volumeStreamDataSize, ovdbFile.c_str());
+        fileWritten = Connection->WriteFile(volumeStreamData, volumeStreamDataSize, ovdbFile.c_str());
+      }
+    });
     if(!fileWritten)
     {
       OmniConnectErrorMacro("Cannot write volume file " << ovdbFile.c_str());
     }
   }
 
-  if (UsdSaveEnabled)
-  {
-    geomTopologyStage->Save();
-    geomClipStage->Save();
-  }
+  MarkStageDirty(geomTopologyStage);
+  MarkStageDirty(geomClipStage);
 
   return newVolume;
 }
@@ -3114,6 +4201,7 @@ void OmniConnectInternals::RemovePrimAndTopology(
 #endif
 
   // Delete the topology file
+  UnmarkFileDirty(geomTopologyFilePath.c_str());
   Connection->RemoveFile(geomTopologyFilePath.c_str());
 }
 
@@ -3147,17 +4235,28 @@ bool OmniConnectInternals::RemoveActorGeomAtTime(OmniConnectActorCache& actorCac
   std::string& geomClipStagePath = geomCache.TimedGeomClipStagePath;
   std::string& geomTopologyStagePath = geomCache.GeomTopologyStagePath;
 
-  // Clear timestep from actor geom clipsapi
-  UsdClipsAPI clipsApi(geomPrim);
+  // Clear timestep from actor geom clip state, authored on the next flush
+  OmniConnectClipArray<GfVec2d>& clipActives = geomCache.ClipActives;
 
-  VtVec2dArray& clipActives = geomCache.ClipActives;
+  // Timesteps sharing a stored clip don't have a clip file of their own
+  bool ownsClipFile = true;
+  if (!geomCache.ClipTimes.empty())
+  {
+    size_t activeIdx = FindClipActive(clipActives, animTimeStep);
+    ownsClipFile = (activeIdx == clipActives.size()) ||
+      geomCache.ClipAssetPaths[(size_t)clipActives[activeIdx][1]].GetAssetPath() == geomCache.TimedSceneRelGeomClipFile;
+  }
+  if (!geomCache.ClipStore.empty())
+    ReleaseStoredGeomClip(geomCache, animTimeStep, true);
+  EraseClipTime(geomCache.ClipTimes, animTimeStep);
+  geomCache.ClipHashes.erase(animTimeStep);
 
   for (int timeIndex = 0; timeIndex < clipActives.size(); ++timeIndex)
   {
     if (clipActives[timeIndex][0] == animTimeStep)
     {
       GfVec2d lastElt = clipActives[clipActives.size() - 1];
-      clipActives[timeIndex] = lastElt;
+      clipActives.Edit(timeIndex) = lastElt;
       clipActives.pop_back();
       break;
     }
@@ -3174,12 +4273,16 @@ bool OmniConnectInternals::RemoveActorGeomAtTime(OmniConnectActorCache& actorCac
   }
   else
   {
-    clipsApi.SetClipActive(clipActives);
+    MarkGeomClipMetadataDirty(actorCache, geomCache);
   }
 
   // Remove both the clip file and time-varying geom-specific data associated with it
   RemoveActorGeomVaryingData(actorCache, geomCache, animTimeStep);
-  Connection->RemoveFile(geomClipStagePath.c_str());
+  if (ownsClipFile)
+  {
+    UnmarkFileDirty(geomClipStagePath.c_str());
+    Connection->RemoveFile(geomClipStagePath.c_str());
+  }
 
   return geomDeleted;
 }
@@ -3205,8 +4308,8 @@ void OmniConnectInternals::RemoveActorGeom(OmniConnectActorCache& actorCache, Ca
   }
 
   // gather geom files for all timesteps
-  VtVec2dArray& clipActives = geomCache.ClipActives;
-  VtArray<SdfAssetPath>& assetPaths = geomCache.ClipAssetPaths;
+  const OmniConnectClipArray<GfVec2d>& clipActives = geomCache.ClipActives;
+  const OmniConnectClipArray<SdfAssetPath>& assetPaths = geomCache.ClipAssetPaths;
 
   // Remove uniform geom-specific data
   RemoveActorGeomUniformData(actorCache, geomCache);
@@ -3215,10 +4318,18 @@ void OmniConnectInternals::RemoveActorGeom(OmniConnectActorCache& actorCache, Ca
   geomCache.ResetTopologyFile(actorCache, this->LiveInterface.GetLiveExtension());
   RemovePrimAndTopology(actorCache, geomCache.GeomTopologyStagePath, geomPath);
 
-  // Remove the geometry files for all timesteps
+  // Remove the geometry files for all timesteps, which may share clip files
+  std::vector<bool> removedClipFiles(assetPaths.size(), false);
   for (int timeIndex = 0; timeIndex < clipActives.size(); ++timeIndex)
   {
     int clipIndex = int(clipActives[timeIndex][1]);
+    if (removedClipFiles[clipIndex])
+    {
+      RemoveActorGeomVaryingData(actorCache, geomCache, clipActives[timeIndex][0]);
+      continue;
+    }
+    removedClipFiles[clipIndex] = true;
+
     std::string geomFilePath = this->SceneDirectory + assetPaths[clipIndex].GetAssetPath();
 
 #ifdef FORCE_OMNI_CLIP_UPDATES_WITH_SUBLAYER
@@ -3230,6 +4341,7 @@ void OmniConnectInternals::RemoveActorGeom(OmniConnectActorCache& actorCache, Ca
 
     // Remove both the clip file and time-varying geom-specific data associated with it
     RemoveActorGeomVaryingData(actorCache, geomCache, clipActives[timeIndex][0]);
+    UnmarkFileDirty(geomFilePath.c_str());
     Connection->RemoveFile(geomFilePath.c_str());
 
     // Don't delete the assetpath (variable), as it will invalidate the clip indices of other geometries
@@ -3239,7 +4351,7 @@ void OmniConnectInternals::RemoveActorGeom(OmniConnectActorCache& actorCache, Ca
 template<typename CacheType>
 void OmniConnectInternals::RemoveAllActorGeoms(OmniConnectActorCache& actorCache)
 {
-  std::map<size_t, CacheType>& geomCaches = actorCache.GetGeomCaches<CacheType>();
+  OmniConnectIdMap<CacheType>& geomCaches = actorCache.GetGeomCaches<CacheType>();
   for (auto& geomCache : geomCaches)
   {
     RemoveActorGeom<CacheType>(actorCache, geomCache.second);
@@ -3383,6 +4495,10 @@ size_t OmniConnectInternals::RetrieveSceneToAnimTimesFromUsd(const UsdPrim& acto
   UsdClipsAPI actorClipsApi(actorPrim);
   actorClipsApi.GetClipTimes(&TempSceneToAnimTimes);
 
+  // Scene times are kept sorted by the caller for binary searches
+  std::stable_sort(TempSceneToAnimTimes.begin(), TempSceneToAnimTimes.end(),
+    [](const GfVec2d& lhs, const GfVec2d& rhs) { return lhs[0] < rhs[0]; });
+
   return TempSceneToAnimTimes.size();
 }
 
@@ -3404,8 +4520,28 @@ void OmniConnectInternals::RestoreClipActivesAndPaths(const OmniConnectActorCach
   {
     UsdClipsAPI actorClipsApi(actorGeomPrim);
 
-    actorClipsApi.GetClipAssetPaths(&geomCache.ClipAssetPaths);
-    actorClipsApi.GetClipActive(&geomCache.ClipActives);
+    VtArray<SdfAssetPath> assetPaths;
+    VtVec2dArray clipActives, clipTimes;
+    actorClipsApi.GetClipAssetPaths(&assetPaths);
+    actorClipsApi.GetClipActive(&clipActives);
+    actorClipsApi.GetClipTimes(&clipTimes);
+    geomCache.ClipAssetPaths.Assign(assetPaths);
+    geomCache.ClipActives.Assign(clipActives);
+    geomCache.ClipTimes.Assign(clipTimes);
+
+    VtValue clipStoreValue = actorGeomPrim.GetCustomDataByKey(OmniConnectTokens->clipContentHashes);
+    if (clipStoreValue.IsHolding<VtDictionary>())
+    {
+      for (const auto& storeEntry : clipStoreValue.UncheckedGet<VtDictionary>())
+      {
+        OmniConnectContentHash clipHash;
+        if (!ContentHashFromString(storeEntry.first, clipHash) || !storeEntry.second.IsHolding<GfVec2d>())
+          continue;
+        const GfVec2d& assetTime = storeEntry.second.UncheckedGet<GfVec2d>();
+        if (assetTime[0] < geomCache.ClipAssetPaths.size())
+          geomCache.ClipStore.emplace(clipHash, OmniConnectClipStoreEntry{ (size_t)assetTime[0], assetTime[1] });
+      }
+    }
   }
 }
 
@@ -3415,26 +4551,38 @@ void OmniConnectInternals::RetimeSceneToAnimClips(const VtVec2dArray& sceneClipT
   // Find for every entry s{stagetime, cliptime} in sceneClipTimes the tuple a{stagetime, assetindex} in animClipActives with s.cliptime == a.stagetime, and take its assetindex.
   // Note that to make sure that for every s{}, there is an a{} such that s.cliptime == a.stagetime, invidual anim geometry should have already been updated accordingly.
   // However, if geometry is not updated due to it being empty or removed for a timestep, we just point to asset 0 and thereby defer to other mechanisms (such as visibility, see actornodebase).
-  for (int clipIdx = 0; clipIdx < sceneClipTimes.size(); ++clipIdx)
+  // Clip actives are mostly appended in time order; otherwise a copy is sorted, after which all lookups are binary searches.
+  auto lessStageTime = [](const GfVec2d& lhs, const GfVec2d& rhs) { return lhs[0] < rhs[0]; };
+  const GfVec2d* activesBegin = animClipActives.cdata();
+  const GfVec2d* activesEnd = activesBegin + animClipActives.size();
+  if (!std::is_sorted(activesBegin, activesEnd, lessStageTime))
+  {
+    sortedAnimClipActives.assign(activesBegin, activesEnd);
+    std::stable_sort(sortedAnimClipActives.begin(), sortedAnimClipActives.end(), lessStageTime);
+    activesBegin = sortedAnimClipActives.cdata();
+    activesEnd = activesBegin + sortedAnimClipActives.size();
+  }
+
+  for (size_t clipIdx = 0; clipIdx < sceneClipTimes.size(); ++clipIdx)
   {
     double clipTime = sceneClipTimes[clipIdx][1];
-    double assetIndex = 0; 
-    for (int activeIdx = 0; activeIdx < animClipActives.size(); ++activeIdx)
-    {
-      if (clipTime == animClipActives[activeIdx][0])
-        assetIndex = animClipActives[activeIdx][1];
-    }
+    double assetIndex = 0;
+    // In case of duplicate stage times, the last one takes precedence
+    const GfVec2d* activeIt = std::upper_bound(activesBegin, activesEnd, clipTime,
+      [](double time, const GfVec2d& clipActive) { return time < clipActive[0]; });
+    if (activeIt != activesBegin && (*(activeIt - 1))[0] == clipTime)
+      assetIndex = (*(activeIt - 1))[1];
     newAnimClipActives[clipIdx] = GfVec2d(sceneClipTimes[clipIdx][0], assetIndex);
   }
 }
 
 template<typename CacheType>
-void OmniConnectInternals::RetimeActorGeoms(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, const VtVec2dArray& sceneClipTimes, VtVec2dArray& newAnimClipActives)
+void OmniConnectInternals::RetimeActorGeoms(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, const VtVec2dArray& sceneClipTimes)
 {
   typedef typename UsdTypeFromCache<CacheType>::UsdPrimType UsdPrimType;
   typedef typename UsdTypeFromCache<CacheType>::AltUsdPrimType AltUsdPrimType;
 
-  std::map<size_t, CacheType>& geomCaches = actorCache.GetGeomCaches<CacheType>();
+  OmniConnectIdMap<CacheType>& geomCaches = actorCache.GetGeomCaches<CacheType>();
 
   for (auto& geomCachePair : geomCaches)
   {
@@ -3454,25 +4602,44 @@ void OmniConnectInternals::RetimeActorGeoms(OmniConnectActorCache& actorCache, U
       geomPrim = geom.GetPrim();
     }
 
-    VtVec2dArray& animClipActives = geomCache.ClipActives;
-    RetimeSceneToAnimClips(sceneClipTimes, animClipActives, newAnimClipActives);
+    // Geoms updated at the same timesteps often have equal clip actives, in which case the retimed actives carry over,
+    // also to the geoms of other actors that follow the same scene->anim times
+    VtVec2dArray animClipActives = geomCache.ClipActives.GetView();
+    VtVec2dArray& newAnimClipActives = TempNewClipActives;
+    if (!TempRetimedValid || animClipActives != TempRetimedClipActives || sceneClipTimes != TempRetimedSceneClipTimes)
+    {
+      newAnimClipActives.resize(sceneClipTimes.size());
+      RetimeSceneToAnimClips(sceneClipTimes, animClipActives, TempSortedClipActives, newAnimClipActives);
+      TempRetimedClipActives = animClipActives;
+      TempRetimedSceneClipTimes = sceneClipTimes;
+      TempRetimedValid = true;
+    }
 
     UsdClipsAPI geomClipsApi(geomPrim);
     geomClipsApi.SetClipActive(newAnimClipActives);
-    geomClipsApi.SetClipTimes(sceneClipTimes);
+    if (geomCache.ClipTimes.empty())
+    {
+      geomClipsApi.SetClipTimes(sceneClipTimes);
+    }
+    else
+    {
+      // Shared clips are sampled at their own time, so compose scenetime->animtime->cliptime
+      VtVec2dArray& geomClipTimes = TempGeomClipTimes;
+      geomClipTimes.resize(sceneClipTimes.size());
+      for (size_t clipIdx = 0; clipIdx < sceneClipTimes.size(); ++clipIdx)
+        geomClipTimes[clipIdx] = GfVec2d(sceneClipTimes[clipIdx][0], GetClipTime(geomCache.ClipTimes, sceneClipTimes[clipIdx][1]));
+      geomClipsApi.SetClipTimes(geomClipTimes);
+    }
   }
 }
 
-void OmniConnectInternals::SetClipValues(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, UsdPrim& actorPrim, 
-  const double* sceneToAnimTimes, size_t numSceneToAnimTimes)
+void OmniConnectInternals::SetClipValues(OmniConnectActorCache& actorCache, UsdStageRefPtr& scenestage, UsdPrim& actorPrim)
 {
   //WITHIN THE SCENE STAGE ONLY; defines a value clip around mesh/instancer GROUPS, in combination with overriding the "actives" attribute of the individual mesh/instancer PRIM value clips,
   //to enforce a different timing according to "sceneToAnimTimes" for a particular ACTOR. Value clips within the ACTOR STAGE are left unchanged, 
   //and only used for reading actor-space timing information, required for composing the scene-based retiming in the SCENE STAGE.
 
-  const GfVec2d* gfSceneAnimTimes = reinterpret_cast<const GfVec2d*>(sceneToAnimTimes);
-  VtVec2dArray& sceneClipTimes = actorCache.TempClipTimes;
-  sceneClipTimes.assign(gfSceneAnimTimes, gfSceneAnimTimes + numSceneToAnimTimes);
+  const VtVec2dArray& sceneClipTimes = actorCache.PendingSceneToAnimTimes;
 
   // Set timing for mesh/instancer groups in the scene stage for this actor. Only one clip is active at all times, which has already been set; 
   // the retiming takes care of all the NON-mesh/instancer attributes in that clip.  
@@ -3487,13 +4654,74 @@ void OmniConnectInternals::SetClipValues(OmniConnectActorCache& actorCache, UsdS
   // in the actor stage to scenetime->actortime->assetindex = scenetime->assetindex in the scene stage.
   // Given a scenetime->actortime pair, one requirement is that the mesh/instancer clip information at actortime 
   // has already been added to the actor stage.
-  VtVec2dArray& newAnimClipActives = actorCache.TempNewClipActives;
-  newAnimClipActives.resize(sceneClipTimes.size());
-  
-  RetimeActorGeoms<OmniConnectMeshCache>(actorCache, scenestage, sceneClipTimes, newAnimClipActives);
-  RetimeActorGeoms<OmniConnectInstancerCache>(actorCache, scenestage, sceneClipTimes, newAnimClipActives);
-  RetimeActorGeoms<OmniConnectCurveCache>(actorCache, scenestage, sceneClipTimes, newAnimClipActives);
-  RetimeActorGeoms<OmniConnectVolumeCache>(actorCache, scenestage, sceneClipTimes, newAnimClipActives);
+  RetimeActorGeoms<OmniConnectMeshCache>(actorCache, scenestage, sceneClipTimes);
+  RetimeActorGeoms<OmniConnectInstancerCache>(actorCache, scenestage, sceneClipTimes);
+  RetimeActorGeoms<OmniConnectCurveCache>(actorCache, scenestage, sceneClipTimes);
+  RetimeActorGeoms<OmniConnectVolumeCache>(actorCache, scenestage, sceneClipTimes);
+}
+
+void OmniConnectInternals::AddPendingRetime(size_t actorId, OmniConnectActorCache& actorCache, double sceneTime, const double* sceneToAnimTimes, size_t numSceneToAnimTimes)
+{
+  // Only the last scene->anim times of an actor before a flush are retimed
+  const GfVec2d* gfSceneAnimTimes = reinterpret_cast<const GfVec2d*>(sceneToAnimTimes);
+  actorCache.PendingSceneToAnimTimes.assign(gfSceneAnimTimes, gfSceneAnimTimes + numSceneToAnimTimes);
+
+  std::lock_guard<std::mutex> sceneStageLock(SceneStageMutex);
+
+  if (RetimeActorIds.empty())
+  {
+    RetimeStartTime = sceneTime;
+    RetimeEndTime = sceneTime;
+  }
+  RetimeStartTime = std::min(RetimeStartTime, sceneTime);
+  RetimeEndTime = std::max(RetimeEndTime, sceneTime);
+
+  if (!actorCache.RetimePending)
+  {
+    actorCache.RetimePending = true;
+    RetimeActorIds.push_back(actorId);
+  }
+}
+
+void OmniConnectInternals::RetimePendingActors()
+{
+  // All actors share the scene stage, so their retiming is authored in a single pass before it is saved,
+  // which also lets actors with equal scene->anim times and clip actives share the retimed actives.
+  if (RetimeActorIds.empty())
+    return;
+
+  OMNICONNECT_PROFILE_SCOPE("RetimeActors");
+
+  for (double sceneTime : { RetimeStartTime, RetimeEndTime })
+  {
+    if (MultiSceneStage)
+      SetTimeStepCodes(MultiSceneStage, sceneTime);
+    SetTimeStepCodes(SceneStage, sceneTime);
+  }
+
+  TempRetimedValid = false;
+  for (size_t actorId : RetimeActorIds)
+  {
+    // Actors may have been deleted since their retiming was requested
+    auto it = ActorCacheMap.find(actorId);
+    if (it == ActorCacheMap.end() || !it->second.RetimePending)
+      continue;
+    OmniConnectActorCache& actorCache = it->second;
+    actorCache.RetimePending = false;
+
+    UsdPrim actorPrim = SceneStage->GetPrimAtPath(actorCache.SdfActorPrimPath);
+    assert(actorPrim);
+
+    SetClipValues(actorCache, SceneStage, actorPrim);
+  }
+  RetimeActorIds.clear();
+
+  // Don't keep viewing the geoms' clip actives, which would make in-place edits of them copy the array
+  TempRetimedClipActives = VtVec2dArray();
+  TempRetimedSceneClipTimes = VtVec2dArray();
+  TempRetimedValid = false;
+
+  MarkStageDirty(SceneStage);
 }
 
 #ifdef FORCE_OMNI_CLIP_UPDATES_WITH_DUMMY
@@ -3573,6 +4801,10 @@ void OmniConnectInternals::SetLiveWorkflowEnabled(bool enable)
     }
   }
 
+  // The live interface reopens and copies stages from the server
+  RetimePendingActors();
+  SaveDirtyLayers();
+
   LiveInterface.SetLiveWorkflow(enable,
     this->MultiSceneStage, this->SceneStage,
     this->MultiSceneStageUrl, this->SceneStageUrl,
@@ -3581,13 +4813,19 @@ void OmniConnectInternals::SetLiveWorkflowEnabled(bool enable)
 }
 
 #define LIVE_WORKFLOW_DISABLED_SCOPE OmniConnectInternals::ForceLiveWorkflowDisabled lwfDisabled(Internals)
+#define SCENE_SCOPE OmniConnectInternals::SceneLock sceneLock(Internals)
+#define ACTOR_STAGE_SCOPE(actorId) OmniConnectInternals::ActorStageLock actorStageLock(Internals, actorId); \
+  OmniConnectActorCache* actorCache = actorStageLock.ActorCache; \
+  assert(actorCache)
 
 OmniConnect::OmniConnect(const OmniConnectSettings& settings
   , const OmniConnectEnvironment& environment
   , OmniConnectLogCallback logCallback
 )
 {
-  if (settings.OutputLocal)
+  if (settings.OutputLocal && settings.DiscardAssetWrites)
+    Connection = new OmniConnectNullConnection();
+  else if (settings.OutputLocal)
     Connection = new OmniConnectLocalConnection();
   else
     Connection = new OmniConnectRemoteConnection();
@@ -3684,7 +4922,9 @@ OmniConnect::~OmniConnect()
 
 bool OmniConnect::CreateActor(size_t actorId, const char* actorName)
 {
-  auto itSuccessPair = Internals->ActorCacheMap.emplace(actorId, OmniConnectActorCache());
+  SCENE_SCOPE;
+
+  auto itSuccessPair = Internals->ActorCacheMap.emplace(actorId);
   OmniConnectActorCache& actorCache = (*itSuccessPair.first).second;
   if (itSuccessPair.second)
   {
@@ -3707,6 +4947,7 @@ bool OmniConnect::CreateActor(size_t actorId, const char* actorName)
 
 void OmniConnect::DeleteActor(size_t actorId)
 {
+  SCENE_SCOPE;
   LIVE_WORKFLOW_DISABLED_SCOPE;
 
   auto cacheIt = Internals->ActorCacheMap.find(actorId);
@@ -3738,8 +4979,8 @@ void OmniConnect::DeleteActor(size_t actorId)
     }
 
     // Remove Textures
-    for (int i = 0; i < actorCache.TexCaches.size(); ++i)
-      Internals->DeleteTexture(actorCache, i);
+    for (auto& texCacheEntry : actorCache.TexCaches)
+      Internals->DeleteTexture(actorCache, texCacheEntry.second);
     actorCache.TexCaches.clear();
 
     // Remove Geometry
@@ -3753,7 +4994,9 @@ void OmniConnect::DeleteActor(size_t actorId)
     //rootLayer->Clear(); //No way to explicitly destroy the layer, so we just clear and handle reopening in OpenActorStage.
     //rootLayer->Save();
 
+    Internals->UnmarkStageDirty(actorCache.Stage);
     actorCache.Stage.Reset(); // Clean up the stage refptr manually (maybe not required due to next step)
+    sceneLock.UnlockActorStage(actorCache);
     Internals->ActorCacheMap.erase(cacheIt); // erase the stage pointer before removing the physical file    
 
     //Explicitly remove usd file, but only do this in case a stage can truly be unloaded (see CreateNew() in OpenActorStage)
@@ -3763,14 +5006,14 @@ void OmniConnect::DeleteActor(size_t actorId)
 
 void OmniConnect::SetActorVisibility(size_t actorId, bool visible, double animTimeStep)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->SetActorVisibility(*actorCache, visible, animTimeStep);
 }
 
 void OmniConnect::SetGeomVisibility(size_t actorId, size_t geomId, OmniConnectGeomType geomType, bool visible, double animTimeStep)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   switch (geomType)
   {
@@ -3794,14 +5037,14 @@ void OmniConnect::SetGeomVisibility(size_t actorId, size_t geomId, OmniConnectGe
 
 void OmniConnect::AddTimeStep(size_t actorId, double animTimeStep)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->SetTimeStepCodes(actorCache->Stage, animTimeStep);
 }
 
 void OmniConnect::SetActorTransform(size_t actorId, double animTimeStep, double* transform)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
   assert(transform);
 
   this->Internals->UpdateTransform(*actorCache, transform, animTimeStep);
@@ -3809,44 +5052,50 @@ void OmniConnect::SetActorTransform(size_t actorId, double animTimeStep, double*
 
 void OmniConnect::UpdateMaterial(size_t actorId, const OmniConnectMaterialData& omniBaseMatData, double animTimeStep)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->UpdateActorMaterial(*actorCache, omniBaseMatData, animTimeStep);
 }
 
 void OmniConnect::DeleteMaterial(size_t actorId, size_t materialId)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->RemoveActorMaterial(*actorCache, materialId);
 }
 
 void OmniConnect::UpdateTexture(size_t actorId, size_t texId, OmniConnectSamplerData& samplerData, bool timeVarying, double animTimeStep)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  OMNICONNECT_PROFILE_SCOPE("UpdateTexture");
+
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->UpdateTexture(*actorCache, texId, samplerData, timeVarying, animTimeStep);
 }
 
 void OmniConnect::DeleteTexture(size_t actorId, size_t texId)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
-  auto pred = [texId](const std::pair<size_t, OmniConnectTexCache>& entry) -> bool { return entry.first == texId; };
-  auto it = std::find_if(actorCache->TexCaches.begin(), actorCache->TexCaches.end(), pred);
+  auto it = actorCache->TexCaches.find(texId);
   if (it == actorCache->TexCaches.end())
     return;
 
-  this->Internals->DeleteTexture(*actorCache, texId);
+  this->Internals->DeleteTexture(*actorCache, it->second);
 
-  *it = std::move(actorCache->TexCaches.back());
-  actorCache->TexCaches.pop_back();
+  actorCache->TexCaches.erase(it);
 }
 
 void OmniConnect::UpdateMesh(size_t actorId, double animTimeStep, OmniConnectMeshData& meshData, size_t materialId, 
   OmniConnectGenericArray* updatedGenericArrays, size_t numUga, OmniConnectGenericArray* deletedGenericArrays, size_t numDga)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  OMNICONNECT_PROFILE_SCOPE("UpdateMesh");
+
+  ACTOR_STAGE_SCOPE(actorId);
+
+  // The LOD variant set is authored again whenever a level of detail appears or disappears
+  if (OmniConnectIsLodMeshId(meshData.MeshId) && actorCache->MeshCaches.find(meshData.MeshId) == actorCache->MeshCaches.end())
+    actorCache->LodVariantsDirty = true;
 
   this->Internals->UpdateGeom<OmniConnectMeshCache>(actorCache, animTimeStep, meshData, meshData.MeshId, materialId, 
     updatedGenericArrays, numUga, deletedGenericArrays, numDga);
@@ -3855,7 +5104,9 @@ void OmniConnect::UpdateMesh(size_t actorId, double animTimeStep, OmniConnectMes
 void OmniConnect::UpdateInstancer(size_t actorId, double animTimeStep, OmniConnectInstancerData& instancerData, size_t materialId, 
   OmniConnectGenericArray* updatedGenericArrays, size_t numUga, OmniConnectGenericArray* deletedGenericArrays, size_t numDga)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  OMNICONNECT_PROFILE_SCOPE("UpdateInstancer");
+
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->UpdateGeom<OmniConnectInstancerCache>(actorCache, animTimeStep, instancerData, instancerData.InstancerId, materialId,
     updatedGenericArrays, numUga, deletedGenericArrays, numDga);
@@ -3864,7 +5115,9 @@ void OmniConnect::UpdateInstancer(size_t actorId, double animTimeStep, OmniConne
 void OmniConnect::UpdateCurve(size_t actorId, double animTimeStep, OmniConnectCurveData & curveData, size_t materialId, 
   OmniConnectGenericArray * updatedGenericArrays, size_t numUga, OmniConnectGenericArray * deletedGenericArrays, size_t numDga)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  OMNICONNECT_PROFILE_SCOPE("UpdateCurve");
+
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->UpdateGeom<OmniConnectCurveCache>(actorCache, animTimeStep, curveData, curveData.CurveId, materialId,
     updatedGenericArrays, numUga, deletedGenericArrays, numDga);
@@ -3873,7 +5126,9 @@ void OmniConnect::UpdateCurve(size_t actorId, double animTimeStep, OmniConnectCu
 void OmniConnect::UpdateVolume(size_t actorId, double animTimeStep, OmniConnectVolumeData & volumeData, size_t materialId, 
   OmniConnectGenericArray * updatedGenericArrays, size_t numUga, OmniConnectGenericArray* deletedGenericArrays, size_t numDga)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  OMNICONNECT_PROFILE_SCOPE("UpdateVolume");
+
+  ACTOR_STAGE_SCOPE(actorId);
 
   this->Internals->UpdateGeom<OmniConnectVolumeCache>(actorCache, animTimeStep, volumeData, volumeData.VolumeId, materialId,
     updatedGenericArrays, numUga, deletedGenericArrays, numDga);
@@ -3881,13 +5136,14 @@ void OmniConnect::UpdateVolume(size_t actorId, double animTimeStep, OmniConnectV
 
 bool OmniConnect::DeleteGeomAtTime(size_t actorId, double animTimeStep, size_t geomId, OmniConnectGeomType geomType)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   bool geomDeleted = false;
   switch (geomType)
   {
   case OmniConnectGeomType::MESH:
     geomDeleted = this->Internals->RemoveGeomAtTime<OmniConnectMeshCache>(actorCache, animTimeStep, geomId);
+    actorCache->LodVariantsDirty = actorCache->LodVariantsDirty || (geomDeleted && OmniConnectIsLodMeshId(geomId));
     break;
   case OmniConnectGeomType::INSTANCER:
     geomDeleted = this->Internals->RemoveGeomAtTime<OmniConnectInstancerCache>(actorCache, animTimeStep, geomId);
@@ -3908,12 +5164,13 @@ bool OmniConnect::DeleteGeomAtTime(size_t actorId, double animTimeStep, size_t g
 
 void OmniConnect::DeleteGeom(size_t actorId, size_t geomId, OmniConnectGeomType geomType)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   switch (geomType)
   {
   case OmniConnectGeomType::MESH:
     this->Internals->RemoveGeom<OmniConnectMeshCache>(actorCache, geomId);
+    actorCache->LodVariantsDirty = actorCache->LodVariantsDirty || OmniConnectIsLodMeshId(geomId);
     break;
   case OmniConnectGeomType::INSTANCER:
     this->Internals->RemoveGeom<OmniConnectInstancerCache>(actorCache, geomId);
@@ -3932,7 +5189,7 @@ void OmniConnect::DeleteGeom(size_t actorId, size_t geomId, OmniConnectGeomType
 
 void OmniConnect::SetMaterialBinding(size_t actorId, size_t geomId, size_t materialId, OmniConnectGeomType geomType)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
   switch (geomType)
   {
@@ -3956,11 +5213,17 @@ void OmniConnect::SetMaterialBinding(size_t actorId, size_t geomId, size_t mater
 
 size_t OmniConnect::GetNumSceneToAnimTimes(size_t actorId)
 {
-  auto it = Internals->ActorCacheMap.find(actorId);
-  assert(it != Internals->ActorCacheMap.end());
-  OmniConnectActorCache& actorCache = it->second;
+  ACTOR_STAGE_SCOPE(actorId);
+  std::lock_guard<std::mutex> sceneStageLock(Internals->SceneStageMutex); // Also guards TempSceneToAnimTimes
+
+  if (actorCache->RetimePending)
+  {
+    // Not authored yet
+    Internals->TempSceneToAnimTimes = actorCache->PendingSceneToAnimTimes;
+    return Internals->TempSceneToAnimTimes.size();
+  }
 
-  UsdPrim actorPrim = Internals->SceneStage->GetPrimAtPath(actorCache.SdfActorPrimPath);
+  UsdPrim actorPrim = Internals->SceneStage->GetPrimAtPath(actorCache->SdfActorPrimPath);
   assert(actorPrim);
 
   return Internals->RetrieveSceneToAnimTimesFromUsd(actorPrim);
@@ -3968,45 +5231,41 @@ size_t OmniConnect::GetNumSceneToAnimTimes(size_t actorId)
   
 void OmniConnect::RestoreSceneToAnimTimes(double* sceneToAnimTimes, size_t numSceneToAnimTimes)
 {
+  std::lock_guard<std::mutex> sceneStageLock(Internals->SceneStageMutex);
   Internals->CopySceneToAnimTimes(sceneToAnimTimes, numSceneToAnimTimes);
 }
 
 void OmniConnect::SetSceneToAnimTime(size_t actorId, double sceneTime, const double* sceneToAnimTimes, size_t numSceneToAnimTimes)
 {
   //Uses scene times to actor anim times to retime actors within a scene, but ONLY makes changes to the scene stage.
+  //The retiming of all actors is authored in one pass on the next FlushSceneUpdates.
+  ACTOR_STAGE_SCOPE(actorId);
 
-  auto it = Internals->ActorCacheMap.find(actorId);
-  assert(it != Internals->ActorCacheMap.end());
-  OmniConnectActorCache& actorCache = it->second;
-
-  if(Internals->MultiSceneStage)
-    Internals->SetTimeStepCodes(Internals->MultiSceneStage, sceneTime);
-  Internals->SetTimeStepCodes(Internals->SceneStage, sceneTime);
-
-  UsdPrim actorPrim = Internals->SceneStage->GetPrimAtPath(actorCache.SdfActorPrimPath);
-  assert(actorPrim);
-
-  Internals->SetClipValues(actorCache, Internals->SceneStage, actorPrim, sceneToAnimTimes, numSceneToAnimTimes);
-
-  if (UsdSaveEnabled)
-  {
-    Internals->SceneStage->Save();
-  }
+  Internals->AddPendingRetime(actorId, *actorCache, sceneTime, sceneToAnimTimes, numSceneToAnimTimes);
 }
 
 void OmniConnect::FlushActorUpdates(size_t actorId)
 {
-  OmniConnectActorCache* actorCache = this->Internals->GetCachedActorCache(actorId);
+  ACTOR_STAGE_SCOPE(actorId);
 
-  if (UsdSaveEnabled)
-  {
-    actorCache->Stage->Save();
-  }
+  this->Internals->FlushClipMetadata(*actorCache);
+  this->Internals->FlushLodVariants(*actorCache);
+
+  // Saved together with all other modified layers in FlushSceneUpdates
+  this->Internals->MarkStageDirty(actorCache->Stage);
 }
 
 
 void OmniConnect::FlushSceneUpdates()
 {
+  SCENE_SCOPE;
+  OMNICONNECT_PROFILE_SCOPE("FlushSceneUpdates");
+
+  Internals->RetimePendingActors();
+
+  // Make sure all asset files referenced by the scene have arrived
+  this->Connection->Flush();
+
   if (UsdSaveEnabled)
   {
 #ifdef FORCE_OMNI_CLIP_UPDATES_WITH_DUMMY
@@ -4018,7 +5277,8 @@ void OmniConnect::FlushSceneUpdates()
     Internals->RunningDummyIndex = newDummyIdx;
 #endif
 
-    Internals->SceneStage->Save();
+    Internals->MarkStageDirty(Internals->SceneStage);
+    Internals->SaveDirtyLayers();
 
     this->Connection->ProcessUpdates();
   }
@@ -4039,17 +5299,19 @@ void OmniConnect::DeleteActorFromScene(size_t actorId)
   // Delete both the prim and the sublayer reference
   Internals->DeleteSceneActor(actorCache, Internals->SceneStage);
 
-  if (UsdSaveEnabled)
-  {
-    Internals->SceneStage->Save();
-  }
+  Internals->MarkStageDirty(Internals->SceneStage);
 }
 
 void OmniConnect::SetUpdateOmniContents(bool update)
 {
+  SCENE_SCOPE;
+
   if (!ConnectionValid || UsdSaveEnabled == update)
     return;
 
+  Internals->RetimePendingActors();
+  Internals->SaveDirtyLayers();
+
   // In case the results should be synchronized with the omniverse again, 
   // flush contents of all actor stages created so far and the session stage to omniverse.
   if (update)
@@ -4060,6 +5322,7 @@ void OmniConnect::SetUpdateOmniContents(bool update)
     }
     Internals->SceneStage->Save();
 
+    Connection->Flush();
     Connection->ProcessUpdates();
   }
   Internals->UsdSaveEnabled = UsdSaveEnabled = update;
@@ -4068,22 +5331,22 @@ void OmniConnect::SetUpdateOmniContents(bool update)
 void OmniConnect::SetConvertGenericArraysDoubleToFloat(bool convert) 
 { 
   Internals->ConvertGenericArraysDoubleToFloat = convert; 
-  Internals->VolumeWriter->SetConvertDoubleToFloat(convert);
 }
 
 void OmniConnect::SetLiveWorkflowEnabled(bool enable)
 {
+  SCENE_SCOPE;
   Internals->SetLiveWorkflowEnabled(enable);
 }
 
 bool OmniConnect::GetAndResetGeomTypeChanged(size_t actorId)
 {
   bool result = false;
-  auto cacheIt = Internals->ActorCacheMap.find(actorId);
-  if(cacheIt != Internals->ActorCacheMap.end())
+  OmniConnectInternals::ActorStageLock actorStageLock(Internals, actorId);
+  if(OmniConnectActorCache* actorCache = actorStageLock.ActorCache)
   {
-    result = cacheIt->second.GeomTypeChanged;
-    cacheIt->second.GeomTypeChanged = false;
+    result = actorCache->GeomTypeChanged;
+    actorCache->GeomTypeChanged = false;
   }
   return result;
 }
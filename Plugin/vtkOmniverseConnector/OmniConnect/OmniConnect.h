@@ -64,6 +64,8 @@ public:
 
   //
   // USD interface
+  // Calls for different actors may be made concurrently; creating or deleting actors, flushing the scene and the
+  // update and live workflow settings wait for all other calls to finish.
   //
 
   bool CreateActor(size_t actorId, const char* actorName);
@@ -105,7 +107,7 @@ public:
   void SetUpdateOmniContents(bool update);
   bool GetUpdateOmniContents() const { return UsdSaveEnabled; }
 
-  // Convert generic arrays of double type to float before uploading
+  // Convert generic arrays of double type to float before uploading (applies to subsequent updates from the calling thread)
   void SetConvertGenericArraysDoubleToFloat(bool convert);
 
   // Enable/disable live behavior
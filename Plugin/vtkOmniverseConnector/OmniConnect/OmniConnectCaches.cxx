@@ -47,16 +47,16 @@ namespace constring
 }
 
 template<>
-std::map <size_t, OmniConnectMeshCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectMeshCache>() { return MeshCaches; }
+OmniConnectIdMap<OmniConnectMeshCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectMeshCache>() { return MeshCaches; }
 
 template<>
-std::map <size_t, OmniConnectInstancerCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectInstancerCache>() { return InstancerCaches; }
+OmniConnectIdMap<OmniConnectInstancerCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectInstancerCache>() { return InstancerCaches; }
 
 template<>
-std::map <size_t, OmniConnectCurveCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectCurveCache>() { return CurveCaches; }
+OmniConnectIdMap<OmniConnectCurveCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectCurveCache>() { return CurveCaches; }
 
 template<>
-std::map <size_t, OmniConnectVolumeCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectVolumeCache>() { return VolumeCaches; }
+OmniConnectIdMap<OmniConnectVolumeCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectVolumeCache>() { return VolumeCaches; }
 
 void OmniConnectActorCache::SetPathsAndNames(size_t, const char* actorName, std::string& sceneDirectory, 
   std::string& rootPrimName, std::string& actScopeName, const std::string& matScopeName, const std::string& texScopeName,
@@ -82,9 +82,6 @@ void OmniConnectActorCache::SetPathsAndNames(size_t, const char* actorName, std:
 
   this->OutputFile = this->UniqueName + this->FileExtension;
   this->UsdOutputFilePath = this->OutputPath + this->OutputFile;
-
-  this->SceneRelTexturePathBase = "./" + (OmniTextureRelativePath + this->UniqueName + "_");
-  this->TexturePathBase = this->OutputPath + this->SceneRelTexturePathBase.substr(2);
 }
 
 void OmniConnectMatCache::SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t matId)
@@ -131,11 +128,6 @@ void OmniConnectMatCache::SetPathsAndNames(const OmniConnectActorCache& actorCac
 void OmniConnectTexCache::SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t texId)
 {
   std::string idStr = std::to_string(texId);
-  this->AbsTexturePathBase = actorCache.TexturePathBase + idStr;
-  this->AbsTexturePath = this->AbsTexturePathBase + ImageExt;
-
-  this->SceneRelTexturePathBase = actorCache.SceneRelTexturePathBase + idStr;
-  this->SceneRelTexturePath = SdfAssetPath(this->SceneRelTexturePathBase + ImageExt);
   std::string texPrimPath = actorCache.TexBaseName + idStr;
   this->TexturePrimPath = SdfPath(texPrimPath);
 #if !USE_CUSTOM_MDL
@@ -143,13 +135,6 @@ void OmniConnectTexCache::SetPathsAndNames(const OmniConnectActorCache& actorCac
 #endif
 }
 
-void OmniConnectTexCache::ResetTimedTexPaths(double animTimeStep)
-{
-  std::string timedExt = "." + std::to_string(animTimeStep) + OmniConnectTexCache::ImageExt;
-  TimedAbsTexturePath = this->AbsTexturePathBase + timedExt;
-  TimedSceneRelTexturePath = SdfAssetPath(this->SceneRelTexturePathBase + timedExt);
-}
-
 void OmniConnectGeomCache::ResetTopologyFile(const OmniConnectActorCache& actorCache, const std::string& fileExtension)
 {
   this->SceneRelGeomTopologyFile = this->SceneRelGeomTopologyFileBase + fileExtension;
@@ -167,20 +152,28 @@ void OmniConnectGeomCache::ResetTempClipUrl(const std::string& clipAssetPath)
   this->TempClipUrl = this->ActorCache->OutputPath + clipAssetPath;
 }
 
-void OmniConnectGeomCache::SetPathsAndNamesBase(const OmniConnectActorCache& actorCache, size_t geomId, const std::string& geomBaseName, const char* stagePostFix)
+void OmniConnectGeomCache::SetPathsAndNamesBase(const OmniConnectActorCache& actorCache, const std::string& geomName, const std::string& geomBaseName, const char* stagePostFix)
 {
   this->ActorCache = &actorCache;
   size_t postfixLength = STRNLEN_PORTABLE(this->ActorCache->FileExtension, MAX_USER_STRLEN);
 
-  this->GeomPath = geomBaseName + std::to_string(geomId);
+  this->GeomPath = geomBaseName + geomName;
   this->SdfGeomPath = SdfPath(this->GeomPath);
-  this->GeomStageBaseName = actorCache.OutputFile.substr(0, actorCache.OutputFile.length() - postfixLength) + "_" + std::to_string(geomId) + stagePostFix;
+  this->GeomStageBaseName = actorCache.OutputFile.substr(0, actorCache.OutputFile.length() - postfixLength) + "_" + geomName + stagePostFix;
   this->SceneRelGeomTopologyFileBase = OmniTopologyRelativePath + this->GeomStageBaseName + "Topology";
 }
 
 void OmniConnectMeshCache::SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t meshId)
 {
-  SetPathsAndNamesBase(actorCache, meshId, actorCache.MeshBaseName, "_MeshGeom_");
+  std::string meshName = std::to_string(meshId);
+  if (OmniConnectIsLodMeshId(meshId))
+  {
+    this->LodBaseMeshId = (meshId - OmniConnectLodMeshIdBase) / OmniConnectMaxLodLevels;
+    this->LodLevel = int((meshId - OmniConnectLodMeshIdBase) % OmniConnectMaxLodLevels) + 1;
+    meshName = std::to_string(this->LodBaseMeshId) + "_LOD" + std::to_string(this->LodLevel);
+  }
+
+  SetPathsAndNamesBase(actorCache, meshName, actorCache.MeshBaseName, "_MeshGeom_");
 
   /*
   this->MeshName = actorCache.MeshBaseName + std::to_string(meshId);
@@ -193,7 +186,7 @@ void OmniConnectMeshCache::SetPathsAndNames(const OmniConnectActorCache& actorCa
 
 void OmniConnectInstancerCache::SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t instancerId)
 {
-  SetPathsAndNamesBase(actorCache, instancerId, actorCache.InstancerBaseName, "_InstancerGeom_");
+  SetPathsAndNamesBase(actorCache, std::to_string(instancerId), actorCache.InstancerBaseName, "_InstancerGeom_");
 
   this->ProtoPath = this->GeomPath + "/Prototypes";
   this->SdfProtoPath = SdfPath(this->ProtoPath);
@@ -207,12 +200,12 @@ void OmniConnectInstancerCache::SetPathsAndNames(const OmniConnectActorCache& ac
 
 void OmniConnectCurveCache::SetPathsAndNames(const OmniConnectActorCache & actorCache, size_t curveId)
 {
-  SetPathsAndNamesBase(actorCache, curveId, actorCache.CurveBaseName, "_CurveGeom_");
+  SetPathsAndNamesBase(actorCache, std::to_string(curveId), actorCache.CurveBaseName, "_CurveGeom_");
 }
 
 void OmniConnectVolumeCache::SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t volumeId)
 {
-  SetPathsAndNamesBase(actorCache, volumeId, actorCache.VolumeBaseName, "_VolumeGeom_");
+  SetPathsAndNamesBase(actorCache, std::to_string(volumeId), actorCache.VolumeBaseName, "_VolumeGeom_");
 
   this->OvdbDensityFieldPath = this->SdfGeomPath.AppendPath(SdfPath("ovdbdensityfield"));
   this->OvdbDiffuseFieldPath = this->SdfGeomPath.AppendPath(SdfPath("ovdbdiffusefield"));
@@ -26,11 +26,37 @@
 
 #include <string>
 #include <map>
+#include <mutex>
+#include <vector>
 
 #include "OmniConnectData.h"
+#include "OmniConnectIdMap.h"
+#include "OmniConnectClipArray.h"
 
 struct OmniConnectActorCache;
 
+struct OmniConnectContentHash
+{
+  uint64_t Lo = 0;
+  uint64_t Hi = 0;
+
+  bool operator<(const OmniConnectContentHash& other) const { return Lo < other.Lo || (Lo == other.Lo && Hi < other.Hi); }
+  bool operator==(const OmniConnectContentHash& other) const { return Lo == other.Lo && Hi == other.Hi; }
+};
+
+struct OmniConnectClipStoreEntry
+{
+  size_t AssetPathIdx; // Index into ClipAssetPaths of the clip file holding the contents
+  double ClipTime;     // Time at which the contents are sampled in that file
+};
+
+struct OmniConnectTexStoreEntry
+{
+  std::string AbsTexturePath;
+  SdfAssetPath SceneRelTexturePath;
+  size_t RefCount = 0; // Number of texture caches (default or timestep) referencing the file
+};
+
 struct OmniConnectMatCache
 {
   const OmniConnectActorCache* ActorCache;
@@ -76,26 +102,26 @@ struct OmniConnectTexCache
 {
   static const char* ImageExt;
 
-  std::string AbsTexturePathBase; //abstexturepath without extension
-  std::string AbsTexturePath; //abstexturepath
-  std::string SceneRelTexturePathBase; //reltexpath without extension
-  SdfAssetPath SceneRelTexturePath; //reltexturepath
+  SdfAssetPath SceneRelTexturePath; //reltexturepath of the stored texture for the default timestep
   SdfPath TexturePrimPath;
 #if !USE_CUSTOM_MDL
   SdfPath TexturePrimPath_mdl;
 #endif
 
-  std::string TimedAbsTexturePath;
-  SdfAssetPath TimedSceneRelTexturePath;
+  SdfAssetPath TimedSceneRelTexturePath; //reltexturepath of the stored texture for the last updated timestep
 
   bool TimeVarying = false;
   std::vector<double> TimeSteps;
 
+  //Texture store entries referenced by the default timestep and by each of TimeSteps
+  OmniConnectContentHash ContentHash;
+  bool HasContent = false;
+  std::vector<OmniConnectContentHash> TimeStepHashes;
+
   OmniConnectSamplerData::WrapMode WrapS = OmniConnectSamplerData::WrapMode::BLACK;
   OmniConnectSamplerData::WrapMode WrapT = OmniConnectSamplerData::WrapMode::BLACK;
 
   void SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t texId);
-  void ResetTimedTexPaths(double animTimeStep);
 };
 
 struct OmniConnectGeomCache
@@ -115,14 +141,29 @@ struct OmniConnectGeomCache
   std::string TempClipUrl;
 
   //Persistently keeps track of this geom's clip state in actor stage
-  VtArray<SdfAssetPath> ClipAssetPaths;
-  VtArray<GfVec2d> ClipActives;
+  OmniConnectClipArray<SdfAssetPath> ClipAssetPaths;
+  OmniConnectClipArray<GfVec2d> ClipActives;
+  OmniConnectClipArray<GfVec2d> ClipTimes; // Sorted by stage time; only authored once timesteps share clip files, empty otherwise
+
+  //Content-addressed clip store, so timesteps with identical clip contents share a single clip file
+  std::map<OmniConnectContentHash, OmniConnectClipStoreEntry> ClipStore;
+  std::vector<OmniConnectContentHash> ClipStoreDirtyHashes; // Store entries added or erased since the clip store was last authored
+  bool ClipStoreRewrite = false; // The authored clip store has to be replaced as a whole, instead of per dirty hash
+  std::map<double, OmniConnectContentHash> ClipHashes; // Per timestep, the content hash of its clip as of the last time the clip was edited
+
+  //Clip state above has changed since the actor geom prim's clip metadata was last authored
+  bool ClipMetadataDirty = false;
 
   //Tracks whether the AltUsdPrimType has been chosen as prim
   bool UsesAltUsdPrimType = false;
   bool HasPrivateMaterial = false;
 
-  void SetPathsAndNamesBase(const OmniConnectActorCache& actorCache, size_t geomId, 
+  //Linear display colors/opacities of the last color update, reused as long as the input colors stay byte-identical to LinearColorsSource
+  std::vector<unsigned char> LinearColorsSource;
+  VtVec3fArray LinearColors;
+  VtFloatArray LinearOpacities;
+
+  void SetPathsAndNamesBase(const OmniConnectActorCache& actorCache, const std::string& geomName, 
     const std::string& geomBaseName, const char* stagePostFix);
   void ResetTopologyFile(const OmniConnectActorCache& actorCache, const std::string& fileExtension);
   void ResetTimedGeomClipFile(double animTimeStep, const std::string& fileExtension);
@@ -134,6 +175,10 @@ struct OmniConnectMeshCache : public OmniConnectGeomCache
 {
   typedef OmniConnectMeshData GeomDataType;
 
+  //For decimated levels of detail, the mesh of which this is a level (see OmniConnectLodMeshId)
+  size_t LodBaseMeshId = 0;
+  int LodLevel = 0;
+
   void SetPathsAndNames(const OmniConnectActorCache& actorCache, size_t meshId);
 };
 
@@ -184,6 +229,8 @@ struct OmniConnectVolumeCache : public OmniConnectGeomCache
 
 struct OmniConnectActorCache
 {
+  std::mutex StageMutex; // Held by every call that authors this actor, see OmniConnectInternals::ActorStageLock
+
   const char* FileExtension = nullptr;
 
   UsdStageRefPtr Stage;
@@ -205,33 +252,33 @@ struct OmniConnectActorCache
   std::string UsdOutputFilePath; // full path name of actor usd file
   std::string UsdOutputFileUrl; // full path name of actor usd file
 
-  std::map < size_t, OmniConnectMatCache > MatCaches;
-  std::map < size_t, OmniConnectMeshCache > MeshCaches;
-  std::map < size_t, OmniConnectInstancerCache > InstancerCaches;
-  std::map < size_t, OmniConnectCurveCache > CurveCaches;
-  std::map < size_t, OmniConnectVolumeCache > VolumeCaches;
+  OmniConnectIdMap<OmniConnectMatCache> MatCaches;
+  OmniConnectIdMap<OmniConnectMeshCache> MeshCaches;
+  OmniConnectIdMap<OmniConnectInstancerCache> InstancerCaches;
+  OmniConnectIdMap<OmniConnectCurveCache> CurveCaches;
+  OmniConnectIdMap<OmniConnectVolumeCache> VolumeCaches;
 
-  std::vector<std::pair<size_t, OmniConnectTexCache>> TexCaches;
-  std::string SceneRelTexturePathBase; //reltexturepathbase
-  std::string TexturePathBase; //abstexturepathbase
+  OmniConnectIdMap<OmniConnectTexCache> TexCaches;
 
   bool GeomTypeChanged = false;
+  bool ClipMetadataDirty = false; // Any of the geom caches has ClipMetadataDirty set
+  bool LodVariantsDirty = false; // Mesh levels of detail have been added or removed since the LOD variant set was authored
 
-  //For scene->anim time arrays on scene prims
-  VtVec2dArray TempNewClipActives;
-  VtVec2dArray TempClipTimes;
+  //Scene->anim times of the last SetSceneToAnimTime, retimed on the scene stage along with all other actors on the next scene flush
+  VtVec2dArray PendingSceneToAnimTimes;
+  bool RetimePending = false;
 
   void SetPathsAndNames(size_t actorId, const char* actorName, std::string& sceneDirectory, 
     std::string& rootPrimName, std::string& actScopeName, const std::string& matScopeName, const std::string& texScopeName,
     const char* fileExt, const OmniConnectEnvironment& omniEnv);
 
   template<typename CacheType>
-  std::map <size_t, CacheType>& GetGeomCaches() {}
+  OmniConnectIdMap<CacheType>& GetGeomCaches() {}
 
   using MatCachePair = std::pair<bool, OmniConnectMatCache&>;
   MatCachePair GetMatCache(size_t matId)
   {
-    auto itSuccessPair = MatCaches.emplace(matId, OmniConnectMatCache());
+    auto itSuccessPair = MatCaches.emplace(matId);
     bool isNew = itSuccessPair.second;
     OmniConnectMatCache& matCache = (*itSuccessPair.first).second;
     if (isNew)
@@ -244,20 +291,18 @@ struct OmniConnectActorCache
   using TexCachePair = std::pair<bool, OmniConnectTexCache&>;
   TexCachePair GetTexCache(size_t texId)
   {
-    for (auto& x : TexCaches)
-    {
-      if (x.first == texId)
-        return TexCachePair(false, x.second);
-    }
-    TexCaches.emplace_back(std::make_pair(texId,OmniConnectTexCache()));
-    TexCaches.back().second.SetPathsAndNames(*this, texId);
-    return TexCachePair(true, TexCaches.back().second);
+    auto itSuccessPair = TexCaches.emplace(texId);
+    bool isNew = itSuccessPair.second;
+    OmniConnectTexCache& texCache = (*itSuccessPair.first).second;
+    if (isNew)
+      texCache.SetPathsAndNames(*this, texId);
+    return TexCachePair(isNew, texCache);
   }
 
   template<typename CacheType>
   std::pair<bool, CacheType&> GetGeomCache(size_t geomId)
   {
-    auto itSuccessPair = GetGeomCaches<CacheType>().emplace(geomId, CacheType());
+    auto itSuccessPair = GetGeomCaches<CacheType>().emplace(geomId);
     bool isNew = itSuccessPair.second;
     CacheType& geomCache = (*itSuccessPair.first).second;
     if (isNew)
@@ -268,18 +313,18 @@ struct OmniConnectActorCache
   }
 };
 
-using ActorCacheMapType = std::map<size_t, OmniConnectActorCache>;
+using ActorCacheMapType = OmniConnectIdMap<OmniConnectActorCache>;
 
 template<>
-std::map <size_t, OmniConnectMeshCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectMeshCache>();
+OmniConnectIdMap<OmniConnectMeshCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectMeshCache>();
 
 template<>
-std::map <size_t, OmniConnectInstancerCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectInstancerCache>();
+OmniConnectIdMap<OmniConnectInstancerCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectInstancerCache>();
 
 template<>
-std::map <size_t, OmniConnectCurveCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectCurveCache>();
+OmniConnectIdMap<OmniConnectCurveCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectCurveCache>();
 
 template<>
-std::map <size_t, OmniConnectVolumeCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectVolumeCache>();
+OmniConnectIdMap<OmniConnectVolumeCache>& OmniConnectActorCache::GetGeomCaches<OmniConnectVolumeCache>();
 
 #endif
\ No newline at end of file
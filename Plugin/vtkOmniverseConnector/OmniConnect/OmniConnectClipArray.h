@@ -0,0 +1,177 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+#ifndef OmniConnectClipArray_h
+#define OmniConnectClipArray_h
+
+#include "usd.h"
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+// Clip metadata array of a geom, which mostly grows by one element per timestep.
+// Authoring hands out a VtArray viewing the storage instead of a copy of it, so a layer holding on to the authored
+// value doesn't make the next append copy the whole array. Appends stay in place while the storage has spare capacity,
+// as views never look beyond their own size; edits within the viewed range first move the array to storage of its own.
+template<typename T>
+class OmniConnectClipArray
+{
+public:
+  OmniConnectClipArray() : Storage(std::make_shared<std::vector<T>>()) {}
+  OmniConnectClipArray(const OmniConnectClipArray& other) : Storage(std::make_shared<std::vector<T>>(*other.Storage)), Dirty(other.Dirty) {}
+  OmniConnectClipArray& operator=(const OmniConnectClipArray& other)
+  {
+    if (this != &other)
+    {
+      Storage = std::make_shared<std::vector<T>>(*other.Storage);
+      ViewedSize = 0;
+      Dirty = other.Dirty;
+    }
+    return *this;
+  }
+
+  size_t size() const { return Storage->size(); }
+  bool empty() const { return Storage->empty(); }
+  const T& operator[](size_t idx) const { return (*Storage)[idx]; }
+  const T* cdata() const { return Storage->data(); }
+  const T* begin() const { return Storage->data(); }
+  const T* end() const { return Storage->data() + Storage->size(); }
+
+  // Whether the array has changed since it was last authored
+  bool IsDirty() const { return Dirty; }
+  void MarkDirty() { Dirty = true; }
+
+  T& Edit(size_t idx)
+  {
+    Modify(idx);
+    return (*Storage)[idx];
+  }
+
+  void push_back(const T& value)
+  {
+    size_t numElts = Storage->size();
+    if (Storage->capacity() == numElts && IsViewed(0))
+    {
+      // Reallocating would pull the data from under the views
+      std::shared_ptr<std::vector<T>> grownStorage = std::make_shared<std::vector<T>>();
+      grownStorage->reserve(std::max<size_t>(2 * numElts, 16));
+      grownStorage->assign(Storage->begin(), Storage->end());
+      Storage = grownStorage;
+      ViewedSize = 0;
+    }
+    Storage->push_back(value);
+    Dirty = true;
+  }
+
+  void insert(size_t pos, const T& value)
+  {
+    Modify(pos);
+    Storage->insert(Storage->begin() + pos, value);
+  }
+
+  void erase(size_t pos)
+  {
+    Modify(pos);
+    Storage->erase(Storage->begin() + pos);
+  }
+
+  void pop_back()
+  {
+    Modify(Storage->size() - 1);
+    Storage->pop_back();
+  }
+
+  void clear()
+  {
+    if (IsViewed(0))
+      Storage = std::make_shared<std::vector<T>>();
+    else
+      Storage->clear();
+    ViewedSize = 0;
+    Dirty = true;
+  }
+
+  // Takes over values read back from a layer, which are considered authored
+  void Assign(const VtArray<T>& values)
+  {
+    Storage = std::make_shared<std::vector<T>>(values.cbegin(), values.cend());
+    ViewedSize = 0;
+    Dirty = false;
+  }
+
+  // O(1) view of the current contents, which stays valid and unchanged after further modification of the array
+  VtArray<T> GetView()
+  {
+    if (Storage->empty())
+      return VtArray<T>();
+    ViewedSize = std::max(ViewedSize, Storage->size());
+    return VtArray<T>(new ViewSource(Storage), Storage->data(), Storage->size());
+  }
+
+  // View for authoring the array, after which it is no longer dirty
+  VtArray<T> GetAuthoringView()
+  {
+    Dirty = false;
+    return GetView();
+  }
+
+protected:
+  // Keeps the storage alive for as long as any VtArray viewing it exists
+  struct ViewSource : public Vt_ArrayForeignDataSource
+  {
+    explicit ViewSource(const std::shared_ptr<std::vector<T>>& storage)
+      : Vt_ArrayForeignDataSource(&ViewSource::Detached)
+      , Storage(storage)
+    {}
+
+    static void Detached(Vt_ArrayForeignDataSource* source) { delete static_cast<ViewSource*>(source); }
+
+    std::shared_ptr<std::vector<T>> Storage;
+  };
+
+  bool IsViewed(size_t pos)
+  {
+    if (Storage.use_count() == 1)
+      ViewedSize = 0; // All views have been released
+    return pos < ViewedSize;
+  }
+
+  void Modify(size_t pos)
+  {
+    if (IsViewed(pos))
+    {
+      Storage = std::make_shared<std::vector<T>>(*Storage);
+      ViewedSize = 0;
+    }
+    Dirty = true;
+  }
+
+  std::shared_ptr<std::vector<T>> Storage;
+  size_t ViewedSize = 0; // Size of the largest view handed out of the current storage
+  bool Dirty = false;
+};
+
+#endif
@@ -0,0 +1,199 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+#ifndef OmniConnectIdMap_h
+#define OmniConnectIdMap_h
+
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+
+// Map from ids to cache entries, for lookups which happen for every update of every frame.
+// An open-addressing (linear probing) index points into a dense list of entries, which is also what is iterated over.
+// Entries are allocated individually, so references to them stay valid until they are erased themselves.
+// Iteration is not ordered on id, erase moves the last entry into the place of the erased one.
+template<typename ValueType>
+class OmniConnectIdMap
+{
+public:
+  using KeyType = size_t;
+  using EntryType = std::pair<const KeyType, ValueType>;
+
+protected:
+  using EntryList = std::vector<std::unique_ptr<EntryType>>;
+
+  template<typename ListIterator, typename EntryRef, typename EntryPtr>
+  class IteratorBase
+  {
+  public:
+    IteratorBase() = default;
+    explicit IteratorBase(ListIterator listIt) : ListIt(listIt) {}
+
+    EntryRef operator*() const { return **ListIt; }
+    EntryPtr operator->() const { return ListIt->get(); }
+    IteratorBase& operator++() { ++ListIt; return *this; }
+    bool operator==(const IteratorBase& other) const { return ListIt == other.ListIt; }
+    bool operator!=(const IteratorBase& other) const { return ListIt != other.ListIt; }
+
+    ListIterator ListIt;
+  };
+
+public:
+  using iterator = IteratorBase<typename EntryList::iterator, EntryType&, EntryType*>;
+  using const_iterator = IteratorBase<typename EntryList::const_iterator, const EntryType&, const EntryType*>;
+
+  iterator begin() { return iterator(Entries.begin()); }
+  iterator end() { return iterator(Entries.end()); }
+  const_iterator begin() const { return const_iterator(Entries.cbegin()); }
+  const_iterator end() const { return const_iterator(Entries.cend()); }
+
+  size_t size() const { return Entries.size(); }
+  bool empty() const { return Entries.empty(); }
+
+  iterator find(KeyType id)
+  {
+    size_t slot = FindSlot(id);
+    return (slot == NoSlot) ? end() : iterator(Entries.begin() + (Slots[slot] - 1));
+  }
+
+  const_iterator find(KeyType id) const
+  {
+    size_t slot = FindSlot(id);
+    return (slot == NoSlot) ? end() : const_iterator(Entries.cbegin() + (Slots[slot] - 1));
+  }
+
+  template<typename... ArgTypes>
+  std::pair<iterator, bool> emplace(KeyType id, ArgTypes&&... args)
+  {
+    iterator it = find(id);
+    if (it != end())
+      return std::make_pair(it, false);
+
+    // Keep the load factor at or below one half, so probe sequences stay short
+    if ((Entries.size() + 1) * 2 > Slots.size())
+      Rehash(Slots.empty() ? 16 : Slots.size() * 2);
+
+    Entries.emplace_back(new EntryType(std::piecewise_construct, std::forward_as_tuple(id), std::forward_as_tuple(std::forward<ArgTypes>(args)...)));
+    Slots[FindFreeSlot(id)] = (uint32_t)Entries.size();
+
+    return std::make_pair(iterator(Entries.end() - 1), true);
+  }
+
+  // Returns the iterator to the entry that has taken the place of the erased one, so iteration can continue from there.
+  iterator erase(iterator it)
+  {
+    size_t entryIdx = it.ListIt - Entries.begin();
+    RemoveSlot(FindSlot(Entries[entryIdx]->first));
+
+    size_t lastIdx = Entries.size() - 1;
+    if (entryIdx != lastIdx)
+    {
+      Slots[FindSlot(Entries[lastIdx]->first)] = (uint32_t)(entryIdx + 1);
+      Entries[entryIdx] = std::move(Entries[lastIdx]);
+    }
+    Entries.pop_back();
+
+    return iterator(Entries.begin() + entryIdx);
+  }
+
+  size_t erase(KeyType id)
+  {
+    iterator it = find(id);
+    if (it == end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+
+  void clear()
+  {
+    Entries.clear();
+    Slots.clear();
+  }
+
+protected:
+  static constexpr size_t NoSlot = ~size_t(0);
+
+  size_t HomeSlot(KeyType id) const
+  {
+    // Fibonacci hashing, as ids are often consecutive
+    return size_t((uint64_t(id) * 0x9E3779B97F4A7C15ull) >> SlotShift);
+  }
+
+  size_t FindSlot(KeyType id) const
+  {
+    if (Slots.empty())
+      return NoSlot;
+    size_t mask = Slots.size() - 1;
+    for (size_t slot = HomeSlot(id); Slots[slot] != 0; slot = (slot + 1) & mask)
+    {
+      if (Entries[Slots[slot] - 1]->first == id)
+        return slot;
+    }
+    return NoSlot;
+  }
+
+  size_t FindFreeSlot(KeyType id) const
+  {
+    size_t mask = Slots.size() - 1;
+    size_t slot = HomeSlot(id);
+    while (Slots[slot] != 0)
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  void RemoveSlot(size_t slot)
+  {
+    // Backward shift deletion; entries further along the probe sequence move into the hole if their home slot allows it
+    size_t mask = Slots.size() - 1;
+    for (size_t next = (slot + 1) & mask; Slots[next] != 0; next = (next + 1) & mask)
+    {
+      size_t home = HomeSlot(Entries[Slots[next] - 1]->first);
+      if (((next - home) & mask) >= ((next - slot) & mask))
+      {
+        Slots[slot] = Slots[next];
+        slot = next;
+      }
+    }
+    Slots[slot] = 0;
+  }
+
+  void Rehash(size_t numSlots)
+  {
+    SlotShift = 64;
+    for (size_t n = numSlots; n > 1; n >>= 1)
+      --SlotShift;
+
+    Slots.assign(numSlots, 0);
+    for (size_t entryIdx = 0; entryIdx < Entries.size(); ++entryIdx)
+      Slots[FindFreeSlot(Entries[entryIdx]->first)] = (uint32_t)(entryIdx + 1);
+  }
+
+  EntryList Entries;
+  std::vector<uint32_t> Slots; // Index into Entries plus one, zero for empty slots. Size is a power of two.
+  unsigned int SlotShift = 64;
+};
+
+#endif
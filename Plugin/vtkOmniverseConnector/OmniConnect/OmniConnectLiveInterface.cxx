@@ -126,7 +126,7 @@ void OmniConnectLiveInterface::SetLiveWorkflow(bool enable, UsdStageRefPtr& mult
   }
 }
 
-void OmniConnectLiveInterface::FilterAssetPaths(VtArray<SdfAssetPath>& assetPaths, std::string& liveAssetPath, UsdStageRefPtr& liveClipStage) const
+void OmniConnectLiveInterface::FilterAssetPaths(OmniConnectClipArray<SdfAssetPath>& assetPaths, std::string& liveAssetPath, UsdStageRefPtr& liveClipStage) const
 {
   // Make sure assetPaths doesn't contain the .usd version of liveAssetPath
   if(LiveWorkflowEnabled)
@@ -134,34 +134,34 @@ void OmniConnectLiveInterface::FilterAssetPaths(VtArray<SdfAssetPath>& assetPath
     assert(IsInitialized());
 
     size_t basePathLength = liveAssetPath.size()-LiveExtension.size(); // Live asset path, so basePathLength >= 0
-    VtArray<SdfAssetPath>::iterator assetIter = assetPaths.begin();
-    while(assetIter != assetPaths.end())
+    size_t assetIdx = 0;
+    while(assetIdx < assetPaths.size())
     {
-      if(assetIter->GetAssetPath().compare(0, basePathLength, liveAssetPath, 0, basePathLength) == 0)
+      if(assetPaths[assetIdx].GetAssetPath().compare(0, basePathLength, liveAssetPath, 0, basePathLength) == 0)
       {
         // Copy contents of the associated .usd layer into the .live layer
         CopyClipToLive(liveClipStage);
 
         // Erase the original asset path from the list
-        assetIter = assetPaths.erase(assetIter);
+        assetPaths.erase(assetIdx);
       }
       else
-        assetIter++;
+        assetIdx++;
     }
   }
 }
 
-bool OmniConnectLiveInterface::ModifyClipActives(VtVec2dArray& clipActives, double animTimeStep, double assetPathIdx) const
+bool OmniConnectLiveInterface::ModifyClipActives(OmniConnectClipArray<GfVec2d>& clipActives, double animTimeStep, double assetPathIdx) const
 {
   assert(IsInitialized());
   
   if(LiveWorkflowEnabled)
   {
-    for(GfVec2d& clipActive : clipActives)
+    for(size_t activeIdx = 0; activeIdx < clipActives.size(); ++activeIdx)
     {
-      if(clipActive[0] == animTimeStep)
+      if(clipActives[activeIdx][0] == animTimeStep)
       {
-        clipActive[1] = assetPathIdx;
+        clipActives.Edit(activeIdx)[1] = assetPathIdx;
         return true;
       }
     }
@@ -298,11 +298,9 @@ void OmniConnectLiveInterface::CopyClipsToUsd(OmniConnectActorCache& actorCache)
 
     bool pathChanged = false;
 
-    for(auto assetIter = geomCache.ClipAssetPaths.begin(); 
-      assetIter != geomCache.ClipAssetPaths.end(); 
-      ++assetIter)
+    for(size_t assetIdx = 0; assetIdx < geomCache.ClipAssetPaths.size(); ++assetIdx)
     {
-      const std::string& assetStr = assetIter->GetAssetPath();
+      const std::string assetStr = geomCache.ClipAssetPaths[assetIdx].GetAssetPath();
       
       // Check whether assetpath has .live extension
       size_t compareOffset = BaseAssetPathLength(assetStr, LiveExtension);
@@ -336,7 +334,7 @@ void OmniConnectLiveInterface::CopyClipsToUsd(OmniConnectActorCache& actorCache)
         }
 
         // Change the entry into the clip asset paths
-        *assetIter = SdfAssetPath(newAssetStr);
+        geomCache.ClipAssetPaths.Edit(assetIdx) = SdfAssetPath(newAssetStr);
         pathChanged = true;
       }
     }
@@ -348,7 +346,7 @@ void OmniConnectLiveInterface::CopyClipsToUsd(OmniConnectActorCache& actorCache)
       assert(geomPrim);
 
       UsdClipsAPI clipsApi(geomPrim);
-      clipsApi.SetClipAssetPaths(geomCache.ClipAssetPaths);
+      clipsApi.SetClipAssetPaths(geomCache.ClipAssetPaths.GetAuthoringView());
       clipsChanged = true;
     }
   }
@@ -45,8 +45,8 @@ class OmniConnectLiveInterface
     bool GetLiveWorkflowEnabled() const { return LiveWorkflowEnabled; }
 
     // Filter usd asset paths matching a live asset path. Sideeffect: if a match is found, it's contents are copied over to liveClipStage.
-    void FilterAssetPaths(VtArray<SdfAssetPath>& assetPaths, std::string& liveAssetPath, UsdStageRefPtr& liveClipStage) const; 
-    bool ModifyClipActives(VtVec2dArray& clipActives, double animTimeStep, double assetPathIdx) const;
+    void FilterAssetPaths(OmniConnectClipArray<SdfAssetPath>& assetPaths, std::string& liveAssetPath, UsdStageRefPtr& liveClipStage) const; 
+    bool ModifyClipActives(OmniConnectClipArray<GfVec2d>& clipActives, double animTimeStep, double assetPathIdx) const;
     
     const std::string& GetLiveExtension() const { return LiveWorkflowEnabled ? LiveExtension : *UsdExtension; }
 
@@ -0,0 +1,279 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#include "OmniConnectProfiler.h"
+
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <fstream>
+#include <algorithm>
+
+namespace
+{
+  struct ProfileEvent
+  {
+    const char* Name;
+    int64_t StartTime;
+    int64_t Value; // Duration in nanoseconds for timers
+    bool IsCounter;
+  };
+
+  struct ThreadProfile
+  {
+    static constexpr size_t RingSize = size_t(1) << 14;
+
+    std::mutex Mutex; // Only contended while statistics or traces are retrieved
+    std::vector<ProfileEvent> Ring;
+    size_t NumEvents = 0;
+    size_t ThreadIndex = 0;
+    std::unordered_map<const char*, OmniConnectProfiler::Statistic> Statistics;
+  };
+
+  struct ExitedEvent
+  {
+    ProfileEvent Event;
+    size_t ThreadIndex;
+  };
+
+  struct ProfileRegistry
+  {
+    std::mutex Mutex;
+    std::vector<std::shared_ptr<ThreadProfile>> Threads; // Of running threads
+    size_t NumThreadsStarted = 0;
+
+    // Threads that exit merge their statistics and events in here, so their rings are freed
+    std::unordered_map<const char*, OmniConnectProfiler::Statistic> ExitedStatistics;
+    std::vector<ExitedEvent> ExitedEvents; // Ring of ThreadProfile::RingSize, shared by all exited threads
+    size_t NumExitedEvents = 0;
+  };
+
+  ProfileRegistry& GetRegistry()
+  {
+    static ProfileRegistry registry;
+    return registry;
+  }
+
+  const std::chrono::steady_clock::time_point ProcessStartTime = std::chrono::steady_clock::now();
+
+  void MergeStatistic(OmniConnectProfiler::Statistic& stat, const OmniConnectProfiler::Statistic& threadStat)
+  {
+    stat.Name = threadStat.Name;
+    stat.IsCounter = threadStat.IsCounter;
+    stat.Count += threadStat.Count;
+    stat.Total += threadStat.Total;
+    stat.Max = std::max(stat.Max, threadStat.Max);
+  }
+
+  // Registers the profile of a thread on its first event, and unregisters it when the thread exits
+  struct ThreadProfileOwner
+  {
+    ~ThreadProfileOwner()
+    {
+      if (!Profile)
+        return;
+
+      ProfileRegistry& registry = GetRegistry();
+      std::lock_guard<std::mutex> registryLock(registry.Mutex);
+      {
+        std::lock_guard<std::mutex> threadLock(Profile->Mutex);
+        for (auto& statEntry : Profile->Statistics)
+          MergeStatistic(registry.ExitedStatistics[statEntry.first], statEntry.second);
+
+        if (registry.ExitedEvents.empty() && Profile->NumEvents)
+          registry.ExitedEvents.resize(ThreadProfile::RingSize);
+        size_t numEvents = std::min(Profile->NumEvents, ThreadProfile::RingSize);
+        size_t firstEventIdx = Profile->NumEvents - numEvents;
+        for (size_t i = 0; i < numEvents; ++i)
+        {
+          registry.ExitedEvents[registry.NumExitedEvents++ % ThreadProfile::RingSize] =
+            { Profile->Ring[(firstEventIdx + i) % ThreadProfile::RingSize], Profile->ThreadIndex };
+        }
+      }
+
+      registry.Threads.erase(std::find(registry.Threads.begin(), registry.Threads.end(), Profile));
+    }
+
+    std::shared_ptr<ThreadProfile> Profile;
+  };
+
+  ThreadProfile& GetThreadProfile()
+  {
+    thread_local ThreadProfileOwner threadProfileOwner;
+    std::shared_ptr<ThreadProfile>& threadProfile = threadProfileOwner.Profile;
+    if (!threadProfile)
+    {
+      threadProfile = std::make_shared<ThreadProfile>();
+      threadProfile->Ring.resize(ThreadProfile::RingSize);
+
+      ProfileRegistry& registry = GetRegistry();
+      std::lock_guard<std::mutex> registryLock(registry.Mutex);
+      threadProfile->ThreadIndex = registry.NumThreadsStarted++;
+      registry.Threads.push_back(threadProfile);
+    }
+    return *threadProfile;
+  }
+
+  void RecordEvent(const char* name, int64_t startTime, int64_t value, bool isCounter)
+  {
+    ThreadProfile& threadProfile = GetThreadProfile();
+    std::lock_guard<std::mutex> threadLock(threadProfile.Mutex);
+
+    threadProfile.Ring[threadProfile.NumEvents++ % ThreadProfile::RingSize] = { name, startTime, value, isCounter };
+
+    OmniConnectProfiler::Statistic& stat = threadProfile.Statistics[name];
+    double statValue = isCounter ? (double)value : (double)value * 1.0e-6;
+    stat.Name = name;
+    stat.IsCounter = isCounter;
+    ++stat.Count;
+    stat.Total += statValue;
+    stat.Max = std::max(stat.Max, statValue);
+  }
+
+  void WriteJsonString(std::ostream& out, const char* str)
+  {
+    out << '"';
+    for (; *str; ++str)
+    {
+      if (*str == '"' || *str == '\\')
+        out << '\\';
+      out << *str;
+    }
+    out << '"';
+  }
+
+  void WriteTraceEvent(std::ostream& out, const ProfileEvent& event, size_t threadIndex, bool& firstEvent)
+  {
+    out << (firstEvent ? "\n" : ",\n") << "{\"name\":";
+    WriteJsonString(out, event.Name);
+    out << ",\"cat\":\"OmniConnect\",\"pid\":0,\"tid\":" << threadIndex
+      << ",\"ts\":" << (double)event.StartTime * 1.0e-3;
+    if (event.IsCounter)
+      out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.Value << "}}";
+    else
+      out << ",\"ph\":\"X\",\"dur\":" << (double)event.Value * 1.0e-3 << "}";
+    firstEvent = false;
+  }
+}
+
+std::atomic<bool> OmniConnectProfiler::Enabled(false);
+
+void OmniConnectProfiler::SetEnabled(bool enable)
+{
+  Enabled.store(enable, std::memory_order_relaxed);
+}
+
+int64_t OmniConnectProfiler::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ProcessStartTime).count();
+}
+
+void OmniConnectProfiler::RecordScope(const char* name, int64_t startTime)
+{
+  RecordEvent(name, startTime, Now() - startTime, false);
+}
+
+void OmniConnectProfiler::AddCount(const char* name, int64_t value)
+{
+  RecordEvent(name, Now(), value, true);
+}
+
+void OmniConnectProfiler::GetStatistics(std::vector<Statistic>& statistics)
+{
+  // Identical names from different translation units may not share their address
+  std::map<std::string, Statistic> mergedStats;
+
+  ProfileRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> registryLock(registry.Mutex);
+  for (auto& threadProfile : registry.Threads)
+  {
+    std::lock_guard<std::mutex> threadLock(threadProfile->Mutex);
+    for (auto& statEntry : threadProfile->Statistics)
+      MergeStatistic(mergedStats[statEntry.second.Name], statEntry.second);
+  }
+  for (auto& statEntry : registry.ExitedStatistics)
+    MergeStatistic(mergedStats[statEntry.second.Name], statEntry.second);
+
+  statistics.resize(0);
+  for (auto& statEntry : mergedStats)
+    statistics.push_back(statEntry.second);
+}
+
+void OmniConnectProfiler::ResetStatistics()
+{
+  ProfileRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> registryLock(registry.Mutex);
+  for (auto& threadProfile : registry.Threads)
+  {
+    std::lock_guard<std::mutex> threadLock(threadProfile->Mutex);
+    threadProfile->Statistics.clear();
+  }
+  registry.ExitedStatistics.clear();
+}
+
+bool OmniConnectProfiler::WriteChromeTrace(const char* fileName)
+{
+  std::ofstream traceFile(fileName, std::ios_base::out | std::ios_base::trunc);
+  if (!traceFile.is_open())
+    return false;
+
+  traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  bool firstEvent = true;
+  std::vector<ProfileEvent> events;
+
+  ProfileRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> registryLock(registry.Mutex);
+  for (auto& threadProfile : registry.Threads)
+  {
+    size_t threadIndex = 0;
+    {
+      // Copy, so recording threads are not held up by the file output
+      std::lock_guard<std::mutex> threadLock(threadProfile->Mutex);
+      size_t numEvents = std::min(threadProfile->NumEvents, ThreadProfile::RingSize);
+      size_t firstEventIdx = threadProfile->NumEvents - numEvents;
+      events.resize(numEvents);
+      for (size_t i = 0; i < numEvents; ++i)
+        events[i] = threadProfile->Ring[(firstEventIdx + i) % ThreadProfile::RingSize];
+      threadIndex = threadProfile->ThreadIndex;
+    }
+
+    for (const ProfileEvent& event : events)
+      WriteTraceEvent(traceFile, event, threadIndex, firstEvent);
+  }
+
+  size_t numExitedEvents = std::min(registry.NumExitedEvents, ThreadProfile::RingSize);
+  size_t firstExitedEventIdx = registry.NumExitedEvents - numExitedEvents;
+  for (size_t i = 0; i < numExitedEvents; ++i)
+  {
+    const ExitedEvent& exitedEvent = registry.ExitedEvents[(firstExitedEventIdx + i) % ThreadProfile::RingSize];
+    WriteTraceEvent(traceFile, exitedEvent.Event, exitedEvent.ThreadIndex, firstEvent);
+  }
+
+  traceFile << "\n]}\n";
+  return traceFile.good();
+}
@@ -0,0 +1,92 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#ifndef OmniConnectProfiler_h
+#define OmniConnectProfiler_h
+
+#include "OmniConnectUtilsExternal.h" // For OmniConnect_INTERFACE
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+// Scoped timers and counters, recorded into per-thread ring buffers.
+// When disabled, a timer costs a single relaxed atomic load. Names have to outlive the profiler (string literals).
+class OmniConnect_INTERFACE OmniConnectProfiler
+{
+public:
+  struct Statistic
+  {
+    const char* Name = nullptr;
+    bool IsCounter = false;
+    size_t Count = 0;     // Number of timed scopes or counter increments
+    double Total = 0.0;   // Milliseconds for timers, summed values for counters
+    double Max = 0.0;
+  };
+
+  static void SetEnabled(bool enable);
+  static bool IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+
+  static int64_t Now(); // Nanoseconds since the start of the process
+  static void RecordScope(const char* name, int64_t startTime);
+  static void AddCount(const char* name, int64_t value);
+
+  // Aggregated over all threads since the last reset, sorted by name
+  static void GetStatistics(std::vector<Statistic>& statistics);
+  static void ResetStatistics();
+
+  // Writes the events still held in the ring buffers in the Chrome trace event format
+  static bool WriteChromeTrace(const char* fileName);
+
+protected:
+  static std::atomic<bool> Enabled;
+};
+
+class OmniConnectProfileScope
+{
+public:
+  OmniConnectProfileScope(const char* name)
+    : Name(OmniConnectProfiler::IsEnabled() ? name : nullptr)
+  {
+    if (Name)
+      StartTime = OmniConnectProfiler::Now();
+  }
+
+  ~OmniConnectProfileScope()
+  {
+    if (Name)
+      OmniConnectProfiler::RecordScope(Name, StartTime);
+  }
+
+protected:
+  const char* Name;
+  int64_t StartTime = 0;
+};
+
+#define OMNICONNECT_PROFILE_CONCAT_INNER(a, b) a##b
+#define OMNICONNECT_PROFILE_CONCAT(a, b) OMNICONNECT_PROFILE_CONCAT_INNER(a, b)
+#define OMNICONNECT_PROFILE_SCOPE(name) OmniConnectProfileScope OMNICONNECT_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define OMNICONNECT_PROFILE_COUNT(name, value) do { if(OmniConnectProfiler::IsEnabled()) OmniConnectProfiler::AddCount(name, value); } while(0)
+
+#endif
@@ -89,6 +89,7 @@ TF_DEFINE_PRIVATE_TOKENS(
   (points)
   (positions)
   (normals)
+  (normalsOct)
   (st)
   (result)
   (ids)
@@ -156,6 +157,12 @@ TF_DEFINE_PRIVATE_TOKENS(
 
   //OmniConnect
   (MatId)
+  ((clipContentHashes, "omniConnect:clipContentHashes"))
+  ((textureRefCounts, "omniConnect:textureRefCounts"))
+  ((encoding, "omniConnect:encoding"))
+  ((octahedralSnorm16, "octahedral_snorm16x2"))
+  ((lodVariantSet, "LOD"))
+  ((lodVariantFull, "full"))
 );
 
 namespace
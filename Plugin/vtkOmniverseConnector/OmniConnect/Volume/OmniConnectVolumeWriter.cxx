@@ -31,13 +31,13 @@ class OmniConnectVolumeWriterInternals;
 class OmniConnectVolumeWriter : public OmniConnectVolumeWriterI
 {
   public:
-    OmniConnectVolumeWriter();
+    OmniConnectVolumeWriter(const OmniConnectSettings& settings);
     ~OmniConnectVolumeWriter();
 
     bool Initialize(OmniConnectLogCallback logCallback, void* logUserData) override;
 
-    void ToVDB(const OmniConnectVolumeData& volumeData,
-      OmniConnectGenericArray* updatedGenericArrays, size_t numUga) override;
+    bool ToVDB(const OmniConnectVolumeData& volumeData,
+      OmniConnectGenericArray* updatedGenericArrays, size_t numUga, const char* outputFile) override;
 
     void GetSerializedVolumeData(const char*& data, size_t& size) override;
 
@@ -52,14 +52,18 @@ class OmniConnectVolumeWriter : public OmniConnectVolumeWriterI
 
     bool ConvertDoubleToFloat = true;
 
+    OmniConnectVolumeCompression Compression;
+    bool SaveHalfFloat;
+    float QuantizationTolerance;
+
 #ifdef USE_OPENVDB
     std::unique_ptr<OmniConnectVolumeWriterInternals> Internals;
 #endif
 };
 
-extern "C" OmniConnectVolumeWriterI* OmniConnect_Vol_DECL Create_VolumeWriter()
+extern "C" OmniConnectVolumeWriterI* OmniConnect_Vol_DECL Create_VolumeWriter(const OmniConnectSettings& settings)
 {
-  return new OmniConnectVolumeWriter();
+  return new OmniConnectVolumeWriter(settings);
 }
 
 void OmniConnectVolumeWriter::Release()
@@ -82,13 +86,23 @@ void OmniConnectVolumeWriter::Release()
 
 #include "openvdb/openvdb.h"
 #include "openvdb/io/Stream.h"
-#include "openvdb/tools/Dense.h"
 #include "openvdb/tools/GridTransformer.h"
 #include "openvdb/tree/ValueAccessor.h"
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include <assert.h>
 #include <limits>
+#include <climits>
+#include <cstring>
 #include <sstream>
+#include <fstream>
+#include <streambuf>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 #define OmniConnectErrorMacro(x) \
   { std::stringstream logStream; \
@@ -112,105 +126,284 @@ using ColorGridOutType = openvdb::Vec3fGrid;
 #endif
 using OpacityGridOutType = openvdb::FloatGrid;
 
-class OmniConnectVolumeWriterInternals
+// Growable output buffer that keeps its memory across frames, so serialization doesn't reallocate and the result can be passed on without copies
+class OmniConnectVolumeStreamBuf : public std::streambuf
 {
   public:
-    OmniConnectVolumeWriterInternals()
-      //: GridStream(std::ios::in | std::ios::out)
-    {}
-    ~OmniConnectVolumeWriterInternals()
+    void Reset()
+    {
+      // Give back memory of an exceptionally large previous frame
+      if (Buffer.size() > ShrinkMinSize && Size() < Buffer.size() / 4)
+        std::vector<char>().swap(Buffer);
+
+      HighWater = 0;
+      SetPutPos(0);
+    }
+
+    const char* Data() const { return Buffer.data(); }
+    size_t Size() const { return std::max(HighWater, PutPos()); }
+
+  protected:
+    int_type overflow(int_type ch) override
+    {
+      if (traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+
+      Grow(PutPos() + 1);
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+      return ch;
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override
+    {
+      size_t newPos = PutPos() + size_t(count);
+      if (newPos > Buffer.size())
+        Grow(newPos);
+      std::memcpy(pptr(), data, size_t(count));
+      SetPutPos(newPos);
+      return count;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
     {
-      delete GridStream;
+      off_type basePos = (dir == std::ios_base::beg) ? 0 : 
+        ((dir == std::ios_base::cur) ? off_type(PutPos()) : off_type(Size()));
+      return seekpos(pos_type(basePos + off), which);
     }
 
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+      off_type newPos = off_type(pos);
+      if (!(which & std::ios_base::out) || newPos < 0)
+        return pos_type(off_type(-1));
+
+      HighWater = Size();
+      if (size_t(newPos) > Buffer.size())
+        Grow(size_t(newPos));
+      SetPutPos(size_t(newPos));
+      return pos;
+    }
+
+    size_t PutPos() const { return size_t(pptr() - pbase()); }
+
+    void SetPutPos(size_t pos)
+    {
+      setp(Buffer.data(), Buffer.data() + Buffer.size());
+      for (; pos > size_t(INT_MAX); pos -= size_t(INT_MAX)) // pbump only takes an int
+        pbump(INT_MAX);
+      pbump(int(pos));
+    }
+
+    void Grow(size_t minSize)
+    {
+      size_t pos = PutPos();
+      Buffer.resize(std::max(minSize, std::max(Buffer.size() * 2, InitialSize)));
+      SetPutPos(pos);
+    }
+
+    static constexpr size_t InitialSize = size_t(1) << 20;
+    static constexpr size_t ShrinkMinSize = size_t(64) << 20;
+
+    std::vector<char> Buffer;
+    size_t HighWater = 0;
+};
+
+class OmniConnectVolumeWriterInternals
+{
+  public:
     std::ostream& ResetStream()
     {
-      //GridStream.clear(); // Bug in OpenVDB prevents reuse of stream
-      delete GridStream;
-      GridStream = new std::stringstream(std::ios::in | std::ios::out);
+      // OpenVDB leaves state behind on the stream, so it is recreated for every frame (the buffer is not)
+      StreamBuf.Reset();
+      GridStream = std::make_unique<std::ostream>(&StreamBuf);
       return *GridStream;
     }
 
     const char* GetStreamData()
     {
-      if(!GridStream)
-        return nullptr;
-
-      StreamData = GridStream->str();
-      return StreamData.c_str();
+      return StreamBuf.Data();
     }
 
     size_t GetStreamDataSize()
     {
-      return StreamData.length();
+      return StreamBuf.Size();
     }
 
   protected:
-    std::stringstream* GridStream = nullptr;
-    std::string StreamData;
+    OmniConnectVolumeStreamBuf StreamBuf;
+    std::unique_ptr<std::ostream> GridStream;
 };
 
+// Lossy quantization of grid values to multiples of 2*tolerance, values within tolerance of the background snap to it.
+// Integer grids (scalar or vector) are left untouched.
+template<typename ValueType, typename Enable = void>
+struct GridValueQuantizer
+{
+  static ValueType Apply(const ValueType& value, const ValueType& background, float tolerance) { return value; }
+};
+
+template<typename ValueType>
+struct GridValueQuantizer<ValueType, typename std::enable_if<std::is_floating_point<ValueType>::value>::type>
+{
+  static ValueType Apply(ValueType value, ValueType background, float tolerance)
+  {
+    if (std::abs(value - background) <= ValueType(tolerance))
+      return background;
+    ValueType step = ValueType(2) * ValueType(tolerance);
+    return std::round(value / step) * step;
+  }
+};
+
+template<typename CompType>
+struct GridValueQuantizer<openvdb::math::Vec3<CompType>, typename std::enable_if<std::is_floating_point<CompType>::value>::type>
+{
+  using ValueType = openvdb::math::Vec3<CompType>;
+  using CompQuantizer = GridValueQuantizer<CompType>;
+
+  static ValueType Apply(const ValueType& value, const ValueType& background, float tolerance)
+  {
+    if (std::abs(value[0] - background[0]) <= CompType(tolerance) &&
+      std::abs(value[1] - background[1]) <= CompType(tolerance) &&
+      std::abs(value[2] - background[2]) <= CompType(tolerance))
+      return background;
+    return ValueType(CompQuantizer::Apply(value[0], background[0], tolerance),
+      CompQuantizer::Apply(value[1], background[1], tolerance),
+      CompQuantizer::Apply(value[2], background[2], tolerance));
+  }
+};
+
+// Builds the grid directly from leaf-sized blocks of the dense XYZ-ordered input, in parallel.
+// Voxels equal to the background stay inactive, blocks without active voxels are skipped and uniform blocks become tiles.
+// A positive quantTolerance quantizes the values first (see GridValueQuantizer), which increases both sparsity and compressibility.
+template<typename GridType, typename ValueFunc>
+typename GridType::Ptr CreateSparseGrid(const openvdb::CoordBBox& bBox, const typename GridType::ValueType& background, const ValueFunc& valueFunc,
+  float quantTolerance)
+{
+  using TreeType = typename GridType::TreeType;
+  using LeafType = typename TreeType::LeafNodeType;
+  using ValueType = typename GridType::ValueType;
+  constexpr int LeafDim = int(LeafType::DIM);
+
+  struct BlockResult
+  {
+    LeafType* Leaf = nullptr;
+    bool IsTile = false;
+    ValueType TileValue = openvdb::zeroVal<ValueType>();
+  };
+
+  assert(bBox.min() == openvdb::Coord(0, 0, 0));
+  const openvdb::Coord dims = bBox.dim();
+  const size_t numBlocksX = (dims.x() + LeafDim - 1) / LeafDim;
+  const size_t numBlocksY = (dims.y() + LeafDim - 1) / LeafDim;
+  const size_t numBlocksZ = (dims.z() + LeafDim - 1) / LeafDim;
+  const size_t numBlocks = numBlocksX * numBlocksY * numBlocksZ;
+  const size_t rowSize = size_t(dims.x());
+  const size_t sliceSize = rowSize * size_t(dims.y());
+  const bool quantize = quantTolerance > 0.0f;
+
+  auto blockOrigin = [numBlocksX, numBlocksY](size_t blockIdx)
+  {
+    return openvdb::Coord(int(blockIdx % numBlocksX) * LeafDim,
+      int((blockIdx / numBlocksX) % numBlocksY) * LeafDim,
+      int(blockIdx / (numBlocksX * numBlocksY)) * LeafDim);
+  };
+
+  std::vector<BlockResult> blockResults(numBlocks);
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks),
+    [&](const tbb::blocked_range<size_t>& range)
+  {
+    ValueType values[LeafType::SIZE];
+
+    for (size_t blockIdx = range.begin(); blockIdx != range.end(); ++blockIdx)
+    {
+      openvdb::Coord origin = blockOrigin(blockIdx);
+      int xEnd = std::min(LeafDim, dims.x() - origin.x());
+      int yEnd = std::min(LeafDim, dims.y() - origin.y());
+      int zEnd = std::min(LeafDim, dims.z() - origin.z());
+
+      // Rows are contiguous in the source, so x is iterated innermost
+      typename LeafType::NodeMaskType activeMask;
+      for (int z = 0; z < zEnd; ++z)
+      {
+        for (int y = 0; y < yEnd; ++y)
+        {
+          size_t srcIdx = size_t(origin.z() + z) * sliceSize + size_t(origin.y() + y) * rowSize + size_t(origin.x());
+          for (int x = 0; x < xEnd; ++x)
+          {
+            ValueType value = valueFunc(srcIdx + x);
+            if (quantize)
+              value = GridValueQuantizer<ValueType>::Apply(value, background, quantTolerance);
+            if (!(value == background))
+            {
+              openvdb::Index offset = LeafType::coordToOffset(openvdb::Coord(x, y, z));
+              values[offset] = value;
+              activeMask.setOn(offset);
+            }
+          }
+        }
+      }
+
+      if (activeMask.isOff())
+        continue;
+
+      BlockResult& result = blockResults[blockIdx];
+      if (activeMask.isOn() && std::all_of(values + 1, values + LeafType::SIZE, [&values](const ValueType& value) { return value == values[0]; }))
+      {
+        result.IsTile = true;
+        result.TileValue = values[0];
+      }
+      else
+      {
+        result.Leaf = new LeafType(origin, background, false);
+        for (auto iter = activeMask.beginOn(); iter; ++iter)
+          result.Leaf->setValueOn(iter.pos(), values[iter.pos()]);
+      }
+    }
+  });
+
+  typename GridType::Ptr grid = GridType::create(background);
+  openvdb::tree::ValueAccessor<TreeType> accessor(grid->tree());
+  for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+  {
+    BlockResult& result = blockResults[blockIdx];
+    if (result.Leaf)
+      accessor.addLeaf(result.Leaf); // Tree takes ownership
+    else if (result.IsTile)
+      accessor.addTile(1, blockOrigin(blockIdx), result.TileValue, true);
+  }
+
+  return grid;
+}
+
 struct TfTransformInput
 {
   ColorGridOutType::Ptr colorGrid;
   OpacityGridOutType::Ptr opacityGrid;
   const OmniConnectVolumeData& volumeData;
   const openvdb::CoordBBox& bBox;
+  float quantTolerance;
 };
 
-template<typename DataType, typename OpType, typename TransformerType>
-struct TfTransform
+template<typename DataType, typename OpType>
+struct TfNormalize
 {
 public:
-  TfTransform(const OmniConnectVolumeData& volumeData, const openvdb::CoordBBox& bBox, const TransformerType& transformer)
-    : Transformer(transformer)
-    , VolData(static_cast<const DataType*>(volumeData.Data))
-    , Dims(bBox.max() + openvdb::math::Coord(1, 1, 1)) //Bbox is inclusive, dims are exclusive
+  TfNormalize(const OmniConnectVolumeData& volumeData)
+    : VolData(static_cast<const DataType*>(volumeData.Data))
     , InvValueRangeMag(OpType(1.0) / (OpType)(volumeData.TfData.TfValueRange[1] - volumeData.TfData.TfValueRange[0]))
     , ValueRangeMin((OpType)(volumeData.TfData.TfValueRange[0]))
   {
   }
 
-  inline void operator()(const typename TransformerType::Iter& iter) const
+  inline float operator()(size_t linearIndex) const
   {
-    openvdb::math::Coord coord = iter.getCoord();
-
-    assert(coord.x() >= 0 && coord.x() < Dims.x() &&
-      coord.y() >= 0 && coord.y() < Dims.y() &&
-      coord.z() >= 0 && coord.z() < Dims.z());
-    size_t linearIndex = Dims.y() * Dims.x() * coord.z() + Dims.x() * coord.y() + coord.x();
-    const DataType* curVal = VolData + linearIndex;
-
-    OpType ucVal = (((OpType)(*curVal)) - this->ValueRangeMin) * this->InvValueRangeMag;
-    float normValue = (float)((ucVal < (OpType)0.0) ? (OpType)0.0 : ((ucVal > (OpType)1.0) ? (OpType)1.0 : ucVal));
-
-    Transformer.Transform(normValue, iter);
-  }
-
-  /*
-  inline void operator()(
-    const openvdb::FloatGrid::ValueOnCIter& iter,
-    openvdb::tree::ValueAccessor<TreeOutType>& accessor)
-  {
-    openvdb::Vec4f transformedColor;
-    transformColor(*iter, transformedColor);
-
-    if (iter.isVoxelValue())
-    { // set a single voxel
-      accessor.setValue(iter.getCoord(), transformedColor);
-    }
-    else
-    { // fill an entire tile
-      openvdb::CoordBBox bbox;
-      iter.getBoundingBox(bbox);
-      accessor.getTree()->fill(bbox, transformedColor);
-    }
+    OpType ucVal = (((OpType)VolData[linearIndex]) - this->ValueRangeMin) * this->InvValueRangeMag;
+    return (float)((ucVal < (OpType)0.0) ? (OpType)0.0 : ((ucVal > (OpType)1.0) ? (OpType)1.0 : ucVal));
   }
-  */
 
-  const TransformerType& Transformer;
   const DataType* VolData;
-  openvdb::math::Coord Dims;
   OpType InvValueRangeMag;
   OpType ValueRangeMin;
 };
@@ -218,15 +411,13 @@ public:
 struct TfColorTransformer
 {
 public:
-  typedef ColorGridOutType::ValueOnIter Iter;
-
   TfColorTransformer(const OmniConnectVolumeData& volumeData)
     : TfColors(static_cast<const float*>(volumeData.TfData.TfColors))
     , NumTfColors(volumeData.TfData.TfNumValues)
   {                                               
   }
 
-  inline void Transform(float normValue, const Iter& iter) const
+  inline ColorGridOutType::ValueType Transform(float normValue) const
   {
     openvdb::Vec3f transformedColor;
 
@@ -245,9 +436,9 @@ public:
     transformedColor[2] = fracColor * color1[2] + OneMinFracColor * color0[2];
 
 #ifdef FLOAT1_OUTPUT
-    iter.setValue(transformedColor.length());
+    return transformedColor.length();
 #else
-    iter.setValue(transformedColor);
+    return transformedColor;
 #endif
   }
    
@@ -258,15 +449,13 @@ public:
 struct TfOpacityTransformer
 {
 public:
-  typedef OpacityGridOutType::ValueOnIter Iter;
-
   TfOpacityTransformer(const OmniConnectVolumeData& volumeData)
     : TfOpacities(static_cast<const float*>(volumeData.TfData.TfOpacities))
     , NumTfOpacities(volumeData.TfData.TfNumValues)
   {
   }
 
-  inline void Transform(float normValue, const Iter& iter) const
+  inline OpacityGridOutType::ValueType Transform(float normValue) const
   {
     float opacityIndexF = normValue * (this->NumTfOpacities - 1);
     float floorOpacity;
@@ -274,10 +463,8 @@ public:
     int opacityIdx0 = int(floorOpacity);
     int opacityIdx1 = opacityIdx0 + (opacityIdx0 != (this->NumTfOpacities - 1));
 
-    float finalOpacity = fracOpacity * this->TfOpacities[opacityIdx1] +
+    return fracOpacity * this->TfOpacities[opacityIdx1] +
       (1.0f - fracOpacity) * this->TfOpacities[opacityIdx0];
-
-    iter.setValue(finalOpacity);
   }
 
   const float* TfOpacities;
@@ -287,13 +474,17 @@ public:
 template<typename DataType, typename OpType>
 void TfTransformCall(TfTransformInput& tfTransformInput)
 {
+  TfNormalize<DataType, OpType> tfNormalize(tfTransformInput.volumeData);
+
   TfColorTransformer colorTransformer(tfTransformInput.volumeData);
-  TfTransform<DataType, OpType, TfColorTransformer> tfColorTransform(tfTransformInput.volumeData, tfTransformInput.bBox, colorTransformer);
-  openvdb::tools::foreach(tfTransformInput.colorGrid->beginValueOn(), tfColorTransform);
+  tfTransformInput.colorGrid = CreateSparseGrid<ColorGridOutType>(tfTransformInput.bBox, openvdb::zeroVal<ColorGridOutType::ValueType>(),
+    [&tfNormalize, &colorTransformer](size_t linearIndex) { return colorTransformer.Transform(tfNormalize(linearIndex)); },
+    tfTransformInput.quantTolerance);
   
   TfOpacityTransformer opacityTransformer(tfTransformInput.volumeData);
-  TfTransform<DataType, OpType, TfOpacityTransformer> tfOpacityTransform(tfTransformInput.volumeData, tfTransformInput.bBox, opacityTransformer);
-  openvdb::tools::foreach(tfTransformInput.opacityGrid->beginValueOn(), tfOpacityTransform);
+  tfTransformInput.opacityGrid = CreateSparseGrid<OpacityGridOutType>(tfTransformInput.bBox, openvdb::zeroVal<OpacityGridOutType::ValueType>(),
+    [&tfNormalize, &opacityTransformer](size_t linearIndex) { return opacityTransformer.Transform(tfNormalize(linearIndex)); },
+    tfTransformInput.quantTolerance);
 }
 
 static void SelectTfTransform(TfTransformInput& tfTransformInput)
@@ -346,143 +537,33 @@ struct CopyToGridInput
 {
   const OmniConnectVolumeData& volumeData;
   const openvdb::CoordBBox& bBox;
-};
-
-struct DoublePH // placeholder for double type to implicitly convert to float without warnings
-{
-  public:
-    DoublePH(double val) : v(val) {}
-    ~DoublePH() {}
-    operator float() const { return static_cast<float>(v); }
-  protected:
-    double v;
-};
-
-template<typename InDataType, typename OutGridType>
-struct GridConvert
-{
-  GridConvert(const OmniConnectVolumeData& volumeData, const openvdb::CoordBBox& bBox, bool normalize = true)
-    : VolData(static_cast<const InDataType*>(volumeData.Data))
-    , Dims(bBox.max() + openvdb::math::Coord(1, 1, 1)) //Bbox is inclusive, dims are exclusive
-    , BackgroundIdx(volumeData.BackgroundIdx)
-  {
-  }
-
-  inline void operator()(const typename OutGridType::ValueOnIter& iter) const
-  {
-    openvdb::math::Coord coord = iter.getCoord();
-
-    assert(coord.x() >= 0 && coord.x() < Dims.x() &&
-      coord.y() >= 0 && coord.y() < Dims.y() &&
-      coord.z() >= 0 && coord.z() < Dims.z());
-    size_t linearIndex = Dims.y() * Dims.x() * coord.z() + Dims.x() * coord.y() + coord.x();
-    const InDataType* curVal = VolData + linearIndex;
-
-    typename OutGridType::ValueType outVal(*curVal); 
-
-    iter.setValue(outVal);
-  }
-
-  typename OutGridType::ValueType BackgroundValue()
-  {
-    if(BackgroundIdx == -1)
-    {
-      return typename OutGridType::ValueType(0);
-    }
-
-    const InDataType* backVal = VolData + BackgroundIdx;
-    typename OutGridType::ValueType outVal(*backVal); 
-
-    return outVal;
-  }
-
-  const InDataType* VolData;
-  openvdb::math::Coord Dims;
-  long long BackgroundIdx;
-};
-
-template<typename DataType>
-struct NormalizedToGridConvert
-{
-  NormalizedToGridConvert(const OmniConnectVolumeData& volumeData, const openvdb::CoordBBox& bBox)
-    : VolData(static_cast<const DataType*>(volumeData.Data))
-    , Dims(bBox.max() + openvdb::math::Coord(1, 1, 1)) //Bbox is inclusive, dims are exclusive
-    , MaxValue(static_cast<float>(std::numeric_limits<DataType>::max()))
-    , MinValue(static_cast<float>(std::numeric_limits<DataType>::min()))
-    , BackgroundIdx(volumeData.BackgroundIdx)
-  {
-    InvRange = 1.0f / (MaxValue - MinValue);
-  }
-
-  inline void operator()(const openvdb::FloatGrid::ValueOnIter& iter) const
-  {
-    openvdb::math::Coord coord = iter.getCoord();
-
-    assert(coord.x() >= 0 && coord.x() < Dims.x() &&
-      coord.y() >= 0 && coord.y() < Dims.y() &&
-      coord.z() >= 0 && coord.z() < Dims.z());
-    size_t linearIndex = Dims.y() * Dims.x() * coord.z() + Dims.x() * coord.y() + coord.x();
-    const DataType* curVal = VolData + linearIndex;
-
-    iter.setValue(((static_cast<float>(*curVal)) - MinValue) * InvRange);
-  }
-
-  float BackgroundValue()
-  {
-    return (BackgroundIdx == -1) ? 0.0f : 
-      (static_cast<float>(*(VolData + BackgroundIdx)) - MinValue) * InvRange;
-  }
-
-  const DataType* VolData;
-  openvdb::math::Coord Dims;
-  float MaxValue;
-  float MinValue;
-  float InvRange;
-  long long BackgroundIdx;
+  float quantTolerance;
 };
 
 template<typename InDataType, typename OutGridType>
-openvdb::GridBase::Ptr ConvertAndCopyToGridTemplate(const CopyToGridInput& copyInput)
+openvdb::GridBase::Ptr CopyToGridTemplate(const CopyToGridInput& copyInput)
 {
-  GridConvert<InDataType, OutGridType> gridConverter(copyInput.volumeData, copyInput.bBox);
-
-  typename OutGridType::Ptr outGrid = OutGridType::create(gridConverter.BackgroundValue());
-  typename OutGridType::ValueType defaultValue(0);
-  outGrid->denseFill(copyInput.bBox, defaultValue, true);
-
-  openvdb::tools::foreach(outGrid->beginValueOn(), gridConverter);
+  using OutValueType = typename OutGridType::ValueType;
+  const InDataType* volData = static_cast<const InDataType*>(copyInput.volumeData.Data);
+  long long backgroundIdx = copyInput.volumeData.BackgroundIdx;
+  OutValueType backgroundValue = (backgroundIdx == -1) ? OutValueType(0) : OutValueType(volData[backgroundIdx]);
 
-  return outGrid;
+  return CreateSparseGrid<OutGridType>(copyInput.bBox, backgroundValue,
+    [volData](size_t linearIndex) { return OutValueType(volData[linearIndex]); }, copyInput.quantTolerance);
 }
 
 template<typename DataType>
 openvdb::GridBase::Ptr NormalizedCopyToGridTemplate(const CopyToGridInput& copyInput)
 {
-  NormalizedToGridConvert<DataType> gridConverter(copyInput.volumeData, copyInput.bBox);
-
-  openvdb::FloatGrid::Ptr floatGrid = openvdb::FloatGrid::create(gridConverter.BackgroundValue());
-  floatGrid->denseFill(copyInput.bBox, 0.0f, true);
+  const DataType* volData = static_cast<const DataType*>(copyInput.volumeData.Data);
+  float minValue = static_cast<float>(std::numeric_limits<DataType>::min());
+  float invRange = 1.0f / (static_cast<float>(std::numeric_limits<DataType>::max()) - minValue);
+  auto normalize = [volData, minValue, invRange](size_t linearIndex) { return (static_cast<float>(volData[linearIndex]) - minValue) * invRange; };
 
-  openvdb::tools::foreach(floatGrid->beginValueOn(), gridConverter);
-
-  return floatGrid;
-}
-
-template<typename DataType, typename GridType>
-openvdb::GridBase::Ptr CopyToGridTemplate(const CopyToGridInput& copyInput)
-{
-  const DataType* typedData = static_cast<const DataType*>(copyInput.volumeData.Data);
   long long backgroundIdx = copyInput.volumeData.BackgroundIdx;
-  typename GridType::ValueType backGroundValue( (backgroundIdx == -1) ? 
-    static_cast<DataType>(0) : *(typedData + backgroundIdx)
-    );
-
-  typename GridType::Ptr scalarGrid = GridType::create(backGroundValue);
-
-  openvdb::tools::Dense<const DataType, openvdb::tools::LayoutXYZ> valArray(copyInput.bBox, typedData);
-  openvdb::tools::copyFromDense(valArray, *scalarGrid, (DataType)0); // No tolerance set to clamp values to background value for sparsity.
+  float backgroundValue = (backgroundIdx == -1) ? 0.0f : normalize(size_t(backgroundIdx));
 
-  return scalarGrid;
+  return CreateSparseGrid<openvdb::FloatGrid>(copyInput.bBox, backgroundValue, normalize, copyInput.quantTolerance);
 }
 
 static openvdb::GridBase::Ptr CopyToGrid(const CopyToGridInput& copyInput, bool convertDoubleToFloat)
@@ -520,7 +601,7 @@ static openvdb::GridBase::Ptr CopyToGrid(const CopyToGridInput& copyInput, bool
     break;
   case OmniConnectType::DOUBLE:
     if(convertDoubleToFloat)
-      scalarGrid = ConvertAndCopyToGridTemplate<DoublePH, openvdb::FloatGrid>(copyInput);
+      scalarGrid = CopyToGridTemplate<double, openvdb::FloatGrid>(copyInput);
     else
       scalarGrid = CopyToGridTemplate<double, openvdb::DoubleGrid>(copyInput);
     break;
@@ -529,7 +610,7 @@ static openvdb::GridBase::Ptr CopyToGrid(const CopyToGridInput& copyInput, bool
     break;
   case OmniConnectType::DOUBLE3:
     if(convertDoubleToFloat)
-      scalarGrid = ConvertAndCopyToGridTemplate<openvdb::Vec3d, openvdb::Vec3fGrid>(copyInput);
+      scalarGrid = CopyToGridTemplate<openvdb::Vec3d, openvdb::Vec3fGrid>(copyInput);
     else
       scalarGrid = CopyToGridTemplate<openvdb::Vec3d, openvdb::Vec3dGrid>(copyInput);
     break;
@@ -544,9 +625,9 @@ static openvdb::GridBase::Ptr CopyToGrid(const CopyToGridInput& copyInput, bool
 }
 
 static void CreateGridAndAdd(const OmniConnectVolumeData& volumeData, const openvdb::CoordBBox& bBox, const char* gridName,
-  openvdb::math::Transform::Ptr linTrans, bool convertDoubleToFloat, openvdb::GridPtrVecPtr grids)
+  openvdb::math::Transform::Ptr linTrans, bool convertDoubleToFloat, float quantTolerance, openvdb::GridPtrVecPtr grids)
 {
-  CopyToGridInput copyToGridInput = { volumeData, bBox };
+  CopyToGridInput copyToGridInput = { volumeData, bBox, quantTolerance };
   openvdb::GridBase::Ptr outGrid = CopyToGrid(copyToGridInput, convertDoubleToFloat);
 
   if (outGrid)
@@ -560,8 +641,33 @@ static void CreateGridAndAdd(const OmniConnectVolumeData& volumeData, const open
   }
 }
 
-OmniConnectVolumeWriter::OmniConnectVolumeWriter()
-  : Internals(std::make_unique<OmniConnectVolumeWriterInternals>())
+static uint32_t GetCompressionFlags(OmniConnectVolumeCompression compression)
+{
+  switch (compression)
+  {
+  case OmniConnectVolumeCompression::NONE:
+    return openvdb::io::COMPRESS_NONE;
+  case OmniConnectVolumeCompression::BLOSC:
+    if (openvdb::io::Archive::hasBloscCompression())
+      return openvdb::io::COMPRESS_BLOSC | openvdb::io::COMPRESS_ACTIVE_MASK;
+    [[fallthrough]]; // Fall back to zip
+  default:
+    return openvdb::io::COMPRESS_ZIP | openvdb::io::COMPRESS_ACTIVE_MASK;
+  }
+}
+
+static void WriteGrids(std::ostream& outStream, const openvdb::GridPtrVec& grids, uint32_t compressionFlags)
+{
+  openvdb::io::Stream vdbStream(outStream);
+  vdbStream.setCompression(compressionFlags);
+  vdbStream.write(grids);
+}
+
+OmniConnectVolumeWriter::OmniConnectVolumeWriter(const OmniConnectSettings& settings)
+  : Compression(settings.VolumeCompression)
+  , SaveHalfFloat(settings.VolumeHalfFloat)
+  , QuantizationTolerance(settings.VolumeQuantizationTolerance)
+  , Internals(std::make_unique<OmniConnectVolumeWriterInternals>())
 {
   
 }
@@ -581,8 +687,8 @@ bool OmniConnectVolumeWriter::Initialize(OmniConnectLogCallback logCallback, voi
   return true;
 }
 
-void OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData& volumeData,
-  OmniConnectGenericArray* updatedGenericArrays, size_t numUga)
+bool OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData& volumeData,
+  OmniConnectGenericArray* updatedGenericArrays, size_t numUga, const char* outputFile)
 {
   const char* densityGridName = "density";
   const char* colorGridName = "diffuse";
@@ -606,22 +712,13 @@ void OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData& volumeData,
 
   if(volumeData.preClassified)
   {
-    OpacityGridOutType::Ptr opacityGrid = OpacityGridOutType::create();
-    ColorGridOutType::Ptr colorGrid = ColorGridOutType::create();
-    
-    opacityGrid->denseFill(bBox, 0.0f, true);
-    colorGrid->denseFill(bBox, 
-#ifdef FLOAT1_OUTPUT
-      0.0f,
-#else
-      openvdb::Vec3f(0, 0, 0), 
-#endif
-      true);
-    
-    // Transform the volumedata and output into color grid
-    TfTransformInput tfTransformInput = { colorGrid, opacityGrid, volumeData, bBox };
+    // Transform the volumedata and output into color and opacity grids
+    TfTransformInput tfTransformInput = { ColorGridOutType::create(), OpacityGridOutType::create(), volumeData, bBox, QuantizationTolerance };
     SelectTfTransform(tfTransformInput);
 
+    OpacityGridOutType::Ptr opacityGrid = tfTransformInput.opacityGrid;
+    ColorGridOutType::Ptr colorGrid = tfTransformInput.colorGrid;
+
     // Set grid names
     opacityGrid->setName(densityGridName);
     colorGrid->setName(colorGridName);
@@ -638,7 +735,7 @@ void OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData& volumeData,
   {
     if(numUga == 0)
     {
-      CreateGridAndAdd(volumeData, bBox, densityGridName, linTrans, ConvertDoubleToFloat, grids);
+      CreateGridAndAdd(volumeData, bBox, densityGridName, linTrans, ConvertDoubleToFloat, QuantizationTolerance, grids);
     }
     else
     {
@@ -654,14 +751,35 @@ void OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData& volumeData,
 
         if(numVolCells == genArr.NumElements)
         {
-          CreateGridAndAdd(genVolData, bBox, genArr.Name, linTrans, ConvertDoubleToFloat, grids);
+          CreateGridAndAdd(genVolData, bBox, genArr.Name, linTrans, ConvertDoubleToFloat, QuantizationTolerance, grids);
         }
       }
     }
   }
 
+  // Only affects grids with floating point values
+  for (openvdb::GridBase::Ptr& grid : *grids)
+    grid->setSaveFloatAsHalf(SaveHalfFloat);
+
+  uint32_t compressionFlags = GetCompressionFlags(Compression);
+
   // Must write all grids at once
-  openvdb::io::Stream(Internals->ResetStream()).write(*grids);
+  std::ostream& gridStream = Internals->ResetStream();
+  if (outputFile)
+  {
+    std::ofstream fileStream(outputFile, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!fileStream.is_open())
+    {
+      OmniConnectErrorMacro("Volume writer cannot open output file: " << outputFile);
+      return false;
+    }
+    WriteGrids(fileStream, *grids, compressionFlags);
+    fileStream.close();
+    return !fileStream.fail();
+  }
+
+  WriteGrids(gridStream, *grids, compressionFlags);
+  return true;
 }
 
 void OmniConnectVolumeWriter::GetSerializedVolumeData(const char*& data, size_t& size)
@@ -672,7 +790,10 @@ void OmniConnectVolumeWriter::GetSerializedVolumeData(const char*& data, size_t&
 
 #else //USE_OPENVDB
 
-OmniConnectVolumeWriter::OmniConnectVolumeWriter()
+OmniConnectVolumeWriter::OmniConnectVolumeWriter(const OmniConnectSettings& settings)
+  : Compression(settings.VolumeCompression)
+  , SaveHalfFloat(settings.VolumeHalfFloat)
+  , QuantizationTolerance(settings.VolumeQuantizationTolerance)
 {
 
 }
@@ -687,10 +808,10 @@ bool OmniConnectVolumeWriter::Initialize(OmniConnectLogCallback logCallback, voi
   return true;
 }
 
-void OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData & volumeData,
-  OmniConnectGenericArray* updatedGenericArrays, size_t numUga)
+bool OmniConnectVolumeWriter::ToVDB(const OmniConnectVolumeData & volumeData,
+  OmniConnectGenericArray* updatedGenericArrays, size_t numUga, const char* outputFile)
 {
-
+  return true;
 }
 
 void OmniConnectVolumeWriter::GetSerializedVolumeData(const char*& data, size_t& size)
@@ -44,9 +44,11 @@ class OmniConnectVolumeWriterI
 
     virtual bool Initialize(OmniConnectLogCallback logCallback, void* logUserData) = 0;
 
-    virtual void ToVDB(const OmniConnectVolumeData& volumeData,
-      OmniConnectGenericArray* updatedGenericArrays, size_t numUga) = 0;
+    // Serializes the volume into an internal buffer, or streams it directly into outputFile if set. Returns false if outputFile cannot be written.
+    virtual bool ToVDB(const OmniConnectVolumeData& volumeData,
+      OmniConnectGenericArray* updatedGenericArrays, size_t numUga, const char* outputFile = nullptr) = 0;
 
+    // Data of the last in-memory ToVDB call, valid until the next ToVDB call
     virtual void GetSerializedVolumeData(const char*& data, size_t& size) = 0;
 
     virtual void SetConvertDoubleToFloat(bool convert) = 0;
@@ -54,7 +56,8 @@ class OmniConnectVolumeWriterI
     virtual void Release() = 0; // Accommodate change of CRT
 };
 
-extern "C" OmniConnect_Vol_INTERFACE OmniConnectVolumeWriterI* OmniConnect_Vol_DECL Create_VolumeWriter();
+// Only the Volume* output options of settings are used
+extern "C" OmniConnect_Vol_INTERFACE OmniConnectVolumeWriterI* OmniConnect_Vol_DECL Create_VolumeWriter(const OmniConnectSettings& settings);
 
 
 
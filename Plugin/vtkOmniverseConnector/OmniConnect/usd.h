@@ -36,8 +36,10 @@
 #include <pxr/base/tf/token.h>
 #include <pxr/base/trace/reporter.h>
 #include <pxr/base/trace/trace.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/base/vt/array.h>
 #include <pxr/base/gf/range3f.h>
+#include <pxr/base/gf/traits.h>
 #include <pxr/base/gf/quaternion.h>
 #include <pxr/base/gf/rotation.h>
 #include <pxr/usd/usd/attribute.h>
@@ -46,6 +48,7 @@
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/clipsAPI.h>
+#include <pxr/usd/usd/variantSets.h>
 #include <pxr/usd/usdGeom/mesh.h>
 #include <pxr/usd/usdGeom/sphere.h>
 #include <pxr/usd/usdGeom/cylinder.h>
@@ -63,7 +66,9 @@
 #include <pxr/usd/usdLux/distantLight.h>
 #include <pxr/usd/usdLux/shapingAPI.h>
 #include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/attributeSpec.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/primSpec.h>
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 #include <pxr/usd/kind/registry.h>
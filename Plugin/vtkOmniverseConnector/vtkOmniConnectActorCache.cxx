@@ -275,6 +275,32 @@ void vtkOmniConnectActorCache::DeleteTransferredGeometry(int i)
   OmniGeometriesTransferred.pop_back();
 }
 
+bool vtkOmniConnectActorCache::GetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, vtkOmniConnectMeshTopology& topology) const
+{
+  for (const auto& entry : OmniGeometriesTransferred)
+  {
+    if (entry.GeomId == geomId && entry.GeomType == geomType)
+    {
+      topology = entry.Topology;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool vtkOmniConnectActorCache::SetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, const vtkOmniConnectMeshTopology& topology)
+{
+  for (auto& entry : OmniGeometriesTransferred)
+  {
+    if (entry.GeomId == geomId && entry.GeomType == geomType)
+    {
+      entry.Topology = topology;
+      return true;
+    }
+  }
+  return false;
+}
+
 void vtkOmniConnectActorCache::ResetTextureCacheStatus()
 {
   for (auto& cacheEntry : OmniTextureCaches)
@@ -389,7 +415,13 @@ int vtkOmniConnectActorCache::NewTextureId()
 
 vtkOmniConnectTimeStep* vtkOmniConnectActorCache::GetTimeStep(double timeStep)
 {
-  return &OmniTimeSteps[timeStep];
+  // Requested for every block of a dataset, mostly for the same timestep in a row
+  if (!LastTimeStep || LastTimeStepKey != timeStep)
+  {
+    LastTimeStep = &OmniTimeSteps[timeStep];
+    LastTimeStepKey = timeStep;
+  }
+  return LastTimeStep;
 }
 
 void vtkOmniConnectActorCache::ResetSceneToAnimationTimes()
@@ -399,19 +431,23 @@ void vtkOmniConnectActorCache::ResetSceneToAnimationTimes()
 
 bool vtkOmniConnectActorCache::UpdateSceneToAnimationTime(double sceneTime, double animTime)
 {
-  int keyIdx = 0;
-  //Find entry with same scenetime
-  while (keyIdx < SceneToAnimationTimes.size())
+  //Find entry with same scenetime, records are kept sorted on scenetime
+  size_t numRecords = SceneToAnimationTimes.size() / 2;
+  size_t lowIdx = 0, highIdx = numRecords;
+  while (lowIdx < highIdx)
   {
-    if (SceneToAnimationTimes[keyIdx] == sceneTime)
-      break;
-    keyIdx+=2;
+    size_t midIdx = (lowIdx + highIdx) / 2;
+    if (SceneToAnimationTimes[midIdx*2] < sceneTime)
+      lowIdx = midIdx + 1;
+    else
+      highIdx = midIdx;
   }
+  size_t keyIdx = lowIdx*2;
   //if there is no such entry, insert scene->anim record and return true
-  if (keyIdx == SceneToAnimationTimes.size())
+  if (keyIdx == SceneToAnimationTimes.size() || SceneToAnimationTimes[keyIdx] != sceneTime)
   {
-    SceneToAnimationTimes.push_back(sceneTime);
-    SceneToAnimationTimes.push_back(animTime);
+    double record[2] = { sceneTime, animTime };
+    SceneToAnimationTimes.insert(SceneToAnimationTimes.begin() + keyIdx, record, record + 2);
     return true;
   }
   //if the past animtime doesn't belong to the scenetime, change existing record and return true
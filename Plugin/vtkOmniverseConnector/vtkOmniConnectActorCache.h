@@ -43,6 +43,7 @@ public:
     size_t GeomId = 0;
     OmniConnectGeomType GeomType = OmniConnectGeomType::MESH;
     OmniConnectStatusType Status = OmniConnectStatusType::REMOVE;
+    vtkOmniConnectMeshTopology Topology; // Only used by meshes
   };
 
   vtkOmniConnectActorCache(); 
@@ -72,6 +73,9 @@ public:
   size_t GetNumTransferredGeometries() const { return OmniGeometriesTransferred.size(); }
   const TransferredGeomInfo& GetTransferredGeometry(int i) const { return OmniGeometriesTransferred[i]; }
   void DeleteTransferredGeometry(int i);
+  // Topology is copied in and out by geometry id, as entries move with AddTransferredGeometry/DeleteTransferredGeometry
+  bool GetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, vtkOmniConnectMeshTopology& topology) const;
+  bool SetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, const vtkOmniConnectMeshTopology& topology);
 
   void ResetTextureCacheStatus();
   vtkOmniConnectTextureCache* UpdateTextureCache(vtkImageData* texData, size_t materialId, bool isColorTextureMap);
@@ -114,7 +118,9 @@ protected:
   std::vector<std::pair<size_t, int>> MatToTextureRefs;
   std::vector<TransferredGeomInfo> OmniGeometriesTransferred; //All mesh/instancer ids currently added to OmniConnect, over all timesteps
   std::map<double, vtkOmniConnectTimeStep> OmniTimeSteps; // Per-timestep cache
-  std::vector<double> SceneToAnimationTimes; // Mapping of scene times to this actor's animation times
+  vtkOmniConnectTimeStep* LastTimeStep = nullptr; // Result of the last GetTimeStep, entries of OmniTimeSteps are never removed
+  double LastTimeStepKey = 0.0;
+  std::vector<double> SceneToAnimationTimes; // Mapping of scene times to this actor's animation times, as (scene, anim) pairs sorted on scene time
 
 private:
   int RunningTextureId = 0;
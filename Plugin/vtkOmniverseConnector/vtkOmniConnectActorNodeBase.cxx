@@ -39,7 +39,6 @@
 #include "vtkTexture.h"
 #include "vtkImageData.h"
 #include "vtkMatrix4x4.h"
-#include "vtkDataObjectTree.h"
 
 #define SUB_GEOM_PROGRESS_WEIGHTING 0.5
 
@@ -181,13 +180,20 @@ void vtkOmniConnectActorNodeBaseInternals::CountNumberOfSubGeoms(vtkProp3D* prop
     }
     else if (vtkMultiBlockVolumeMapper* mapper = vtkMultiBlockVolumeMapper::SafeDownCast(volume->GetMapper()))
     {
-      // Ideally we'd just force-load the submappers and count those
-      vtkObject* input = mapper->GetDataSetInput();
-      if (vtkDataObjectTree* inputTree = vtkDataObjectTree::SafeDownCast(input))
+      // GetDataSetInput() is null for composite input, so count the image leaves of the input data object itself
+      vtkDataObject* input = mapper->GetNumberOfInputPorts() > 0 ? mapper->GetInputDataObject(0, 0) : nullptr;
+      if (vtkCompositeDataSet* comp = vtkCompositeDataSet::SafeDownCast(input))
       {
-        // Not handled yet, can iterate over the dataobjecttree if no mappers available
+        vtkCompositeDataIterator* dit = comp->NewIterator();
+        dit->SkipEmptyNodesOn();
+        for (dit->InitTraversal(); !dit->IsDoneWithTraversal(); dit->GoToNextItem())
+        {
+          if (vtkImageData::SafeDownCast(dit->GetCurrentDataObject()))
+            this->NumberOfSubGeoms++;
+        }
+        dit->Delete();
       }
-      else if (vtkImageData* currentIm = vtkImageData::SafeDownCast(input))
+      else if (vtkImageData::SafeDownCast(input))
       {
         this->NumberOfSubGeoms = 1;
       }
@@ -233,6 +239,18 @@ bool vtkOmniConnectActorNodeBase::AddTransferredGeometry(size_t geomId, OmniConn
   return this->Internals->ConnectActorCache->AddTransferredGeometry(geomId, geomType);
 }
 
+//----------------------------------------------------------------------------
+bool vtkOmniConnectActorNodeBase::GetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, vtkOmniConnectMeshTopology& topology) const
+{
+  return this->Internals->ConnectActorCache->GetTransferredTopology(geomId, geomType, topology);
+}
+
+//----------------------------------------------------------------------------
+bool vtkOmniConnectActorNodeBase::SetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, const vtkOmniConnectMeshTopology& topology)
+{
+  return this->Internals->ConnectActorCache->SetTransferredTopology(geomId, geomType, topology);
+}
+
 //----------------------------------------------------------------------------
 vtkOmniConnectTextureCache* vtkOmniConnectActorNodeBase::UpdateTextureCache(vtkImageData* texData, size_t materialId, bool isColorTextureMap)
 {
@@ -34,6 +34,7 @@ class vtkOmniConnectActorNodeBaseInternals;
 class vtkOmniConnectRendererNode;
 struct vtkOmniConnectTimeStep;
 struct vtkOmniConnectTextureCache;
+struct vtkOmniConnectMeshTopology;
 
 class vtkOmniConnectActorNodeBase
 {
@@ -48,6 +49,8 @@ public:
   void SetInputDataChanged() { this->InputDataChanged = true; } // Any input data changes are recorded here. Written by MapperNode to Actor.
   void KeepTransferredGeometries();
   bool AddTransferredGeometry(size_t geomId, OmniConnectGeomType geomType); // Returns whether added geometry is new
+  bool GetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, vtkOmniConnectMeshTopology& topology) const; // Returns false if the geometry hasn't been added
+  bool SetTransferredTopology(size_t geomId, OmniConnectGeomType geomType, const vtkOmniConnectMeshTopology& topology);
   vtkOmniConnectTextureCache* UpdateTextureCache(vtkImageData* texData, size_t materialId, bool isColorTextureMap);
 
   size_t GetActorId();
@@ -0,0 +1,494 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Conversion of vtkPolyData cell arrays into the flat index buffers written to the connector, with a per-index
+// cell id (reverse array) to look up cell quantities. Kept apart from the mapper node so the output can be tested on its own.
+
+#ifndef vtkOmniConnectConnectivity_h
+#define vtkOmniConnectConnectivity_h
+
+#include "OmniConnectProfiler.h"
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace vtkOmniConnectConnectivity
+{
+  template<typename T>
+  class EmptyVector
+  {
+  public:
+    inline size_t size() const { return 0; };
+    inline void resize(size_t) {};
+    inline void push_back(const T&) {}
+  };
+
+  inline void SetUsedVertexBuffer(vtkCellArray *cells,
+    std::vector<int> &vertexToCell)
+  {
+    const vtkIdType* indices = nullptr;
+    vtkIdType npts(0);
+    if (!cells->GetNumberOfCells())
+    {
+      return;
+    }
+
+    int cell_id = 0;
+    for (cells->InitTraversal(); cells->GetNextCell(npts, indices); )
+    {
+      for (int i = 0; i < npts; ++i)
+      {
+        unsigned int vi = (static_cast<unsigned int>(*(indices++)));
+        vertexToCell[vi] = cell_id;
+      }
+      cell_id++;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  //Description:
+  //Per-cell index generators for CreateCellIndexBuffer. NumIndices has to match the number of indices written by Fill.
+
+  //Homogenizes lines into a flat list of line segments, each containing two point indexes
+  struct LineSegmentIndexer
+  {
+    static vtkIdType NumIndices(vtkIdType npts) { return npts > 1 ? 2 * (npts - 1) : 0; }
+
+    static void Fill(const vtkIdType* indices, vtkIdType npts, unsigned int* outIdx)
+    {
+      for (vtkIdType i = 0; i < npts - 1; ++i)
+      {
+        *(outIdx++) = static_cast<unsigned int>(indices[i]);
+        *(outIdx++) = static_cast<unsigned int>(indices[i + 1]);
+      }
+    }
+  };
+
+  //Homogenizes polygons into a flat list of line segments, each containing two point indexes.
+  //This differs from LineSegmentIndexer in that it closes loops, making a segment from last point
+  //back to first.
+  struct PolygonSegmentIndexer
+  {
+    static vtkIdType NumIndices(vtkIdType npts) { return 2 * npts; }
+
+    static void Fill(const vtkIdType* indices, vtkIdType npts, unsigned int* outIdx)
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        *(outIdx++) = static_cast<unsigned int>(indices[i]);
+        *(outIdx++) = static_cast<unsigned int>(indices[i < npts - 1 ? i + 1 : 0]);
+      }
+    }
+  };
+
+  //Triangle strips as a flat list of triangles, with alternating winding order
+  struct StripTriangleIndexer
+  {
+    static vtkIdType NumIndices(vtkIdType npts) { return npts > 2 ? 3 * (npts - 2) : 0; }
+
+    static void Fill(const vtkIdType* indices, vtkIdType npts, unsigned int* outIdx)
+    {
+      for (vtkIdType j = 0; j < npts - 2; ++j)
+      {
+        *(outIdx++) = static_cast<unsigned int>(indices[j]);
+        *(outIdx++) = static_cast<unsigned int>(indices[j + 1 + j % 2]);
+        *(outIdx++) = static_cast<unsigned int>(indices[j + 1 + (j + 1) % 2]);
+      }
+    }
+  };
+
+  //Triangle strips as a flat list of line segments along the strip edges
+  struct StripSegmentIndexer
+  {
+    static vtkIdType NumIndices(vtkIdType npts) { return npts > 1 ? 2 + 4 * std::max<vtkIdType>(npts - 2, 0) : 0; }
+
+    static void Fill(const vtkIdType* indices, vtkIdType npts, unsigned int* outIdx)
+    {
+      *(outIdx++) = static_cast<unsigned int>(indices[0]);
+      *(outIdx++) = static_cast<unsigned int>(indices[1]);
+      for (vtkIdType j = 0; j < npts - 2; ++j)
+      {
+        *(outIdx++) = static_cast<unsigned int>(indices[j]);
+        *(outIdx++) = static_cast<unsigned int>(indices[j + 2]);
+        *(outIdx++) = static_cast<unsigned int>(indices[j + 1]);
+        *(outIdx++) = static_cast<unsigned int>(indices[j + 2]);
+      }
+    }
+  };
+
+  // Parallel fill of presized index/reverse arrays, with CellOffsets holding the exclusive prefix sum of the index counts per cell.
+  template<typename CellIndexer>
+  class CellIndexFunctor
+  {
+  public:
+    CellIndexFunctor(vtkCellArray* cells, const std::vector<vtkIdType>& cellOffsets,
+      unsigned int* indexOut, unsigned int* reverseOut)
+      : Cells(cells), CellOffsets(cellOffsets), IndexOut(indexOut), ReverseOut(reverseOut)
+    {}
+
+    void Initialize()
+    {
+    }
+
+    void operator()(vtkIdType beginCell, vtkIdType endCell)
+    {
+      vtkIdList* cellPts = this->CellPts.Local();
+
+      for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+      {
+        vtkIdType numIndices = this->CellOffsets[cellId + 1] - this->CellOffsets[cellId];
+        if (numIndices == 0)
+          continue;
+
+        this->Cells->GetCellAtId(cellId, cellPts);
+        CellIndexer::Fill(cellPts->GetPointer(0), cellPts->GetNumberOfIds(), this->IndexOut + this->CellOffsets[cellId]);
+
+        if (this->ReverseOut)
+        {
+          unsigned int* outRev = this->ReverseOut + this->CellOffsets[cellId];
+          std::fill(outRev, outRev + numIndices, static_cast<unsigned int>(cellId));
+        }
+      }
+    }
+
+    void Reduce()
+    {
+    }
+
+  protected:
+    vtkCellArray* Cells;
+    const std::vector<vtkIdType>& CellOffsets;
+    unsigned int* IndexOut;
+    unsigned int* ReverseOut;
+
+    vtkSMPThreadLocalObject<vtkIdList> CellPts;
+  };
+
+  inline unsigned int* GetReverseArrayPtr(std::vector<unsigned int>& reverseArray, size_t offset)
+  {
+    return reverseArray.data() + offset;
+  }
+
+  inline unsigned int* GetReverseArrayPtr(EmptyVector<unsigned int>&, size_t)
+  {
+    return nullptr;
+  }
+
+  // Parallel triangulation of a polygon cell array into presized index/reverse arrays.
+  // TriOffsets holds the exclusive prefix sum of the triangle counts per cell.
+  class TriangulatePolysFunctor
+  {
+  public:
+    TriangulatePolysFunctor(vtkCellArray* cells, vtkPoints* points, const std::vector<vtkIdType>& triOffsets,
+      unsigned int* indexOut, unsigned int* reverseOut)
+      : Cells(cells), Points(points), TriOffsets(triOffsets), IndexOut(indexOut), ReverseOut(reverseOut)
+    {}
+
+    void Initialize()
+    {
+    }
+
+    void operator()(vtkIdType beginCell, vtkIdType endCell)
+    {
+      vtkIdList* cellPts = this->CellPts.Local();
+
+      for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+      {
+        vtkIdType numTris = this->TriOffsets[cellId + 1] - this->TriOffsets[cellId];
+        if (numTris == 0)
+          continue; // ignore degenerate polygons
+
+        this->Cells->GetCellAtId(cellId, cellPts);
+        const vtkIdType* indices = cellPts->GetPointer(0);
+        vtkIdType npts = cellPts->GetNumberOfIds();
+
+        unsigned int* outIdx = this->IndexOut + 3 * this->TriOffsets[cellId];
+
+        //Could just always make a triangle fan such as the simple cases, or as in AppendTrianglesWorker in vtkOpenGLIndexBufferObject.cxx
+        if (npts < 7)
+        {
+          // Fans for tris, quads, penta and hex, which are most common
+          static const int fanIdx[4][12] = {
+            { 0, 1, 2 },
+            { 0, 1, 2, 0, 2, 3 },
+            { 0, 1, 2, 0, 2, 3, 0, 3, 4 },
+            { 0, 1, 2, 0, 2, 3, 0, 3, 5, 3, 4, 5 } };
+          const int* cellFanIdx = fanIdx[npts - 3];
+          for (vtkIdType i = 0; i < 3 * numTris; ++i)
+            outIdx[i] = static_cast<unsigned int>(indices[cellFanIdx[i]]);
+        }
+        else
+        {
+          this->TriangulateLarge(indices, npts, outIdx);
+        }
+
+        if (this->ReverseOut)
+        {
+          unsigned int* outRev = this->ReverseOut + 3 * this->TriOffsets[cellId];
+          std::fill(outRev, outRev + 3 * numTris, static_cast<unsigned int>(cellId));
+        }
+      }
+    }
+
+    void Reduce()
+    {
+    }
+
+  protected:
+    // 7 sided polygon or higher, do a full smart triangulation
+    void TriangulateLarge(const vtkIdType* indices, vtkIdType npts, unsigned int* outIdx)
+    {
+      vtkPolygon* polygon = this->Polygon.Local();
+      vtkIdList* tris = this->Tris.Local();
+      vtkPoints* triPoints = this->TriPoints.Local();
+      std::vector<vtkIdType>& triIndices = this->TriIndices.Local();
+
+      triIndices.resize(npts);
+      triPoints->SetNumberOfPoints(npts);
+      double pt[3];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        this->Points->GetPoint(indices[i], pt);
+        triPoints->SetPoint(i, pt);
+        triIndices[i] = i;
+      }
+      polygon->Initialize(npts, triIndices.data(), triPoints);
+      polygon->TriangulateLocalIds(0, tris);
+
+      vtkIdType numTriIds = 3 * (npts - 2);
+      if (tris->GetNumberOfIds() == numTriIds)
+      {
+        for (vtkIdType j = 0; j < numTriIds; ++j)
+          outIdx[j] = static_cast<unsigned int>(indices[tris->GetId(j)]);
+      }
+      else
+      {
+        // Failed triangulation (degenerate polygon), fall back to a fan to keep the presized layout
+        for (vtkIdType j = 0; j < npts - 2; ++j)
+        {
+          outIdx[3 * j] = static_cast<unsigned int>(indices[0]);
+          outIdx[3 * j + 1] = static_cast<unsigned int>(indices[j + 1]);
+          outIdx[3 * j + 2] = static_cast<unsigned int>(indices[j + 2]);
+        }
+      }
+    }
+
+    vtkCellArray* Cells;
+    vtkPoints* Points;
+    const std::vector<vtkIdType>& TriOffsets;
+    unsigned int* IndexOut;
+    unsigned int* ReverseOut;
+
+    vtkSMPThreadLocalObject<vtkIdList> CellPts;
+    vtkSMPThreadLocalObject<vtkPolygon> Polygon;
+    vtkSMPThreadLocalObject<vtkIdList> Tris;
+    vtkSMPThreadLocalObject<vtkPoints> TriPoints;
+    vtkSMPThreadLocal<std::vector<vtkIdType>> TriIndices;
+  };
+
+  // Converts a cell array into a flat index buffer in two parallel passes; per-cell index counts are turned into offsets
+  // (cellOffsets, reused between calls), after which every cell writes its own range of the presized arrays.
+  template<typename CellIndexer, typename T>
+  void CreateCellIndexBuffer(vtkCellArray* cells,
+    std::vector<vtkIdType>& cellOffsets,
+    std::vector<unsigned int>& indexArray,
+    T& reverseArray)
+  {
+    vtkIdType numCells = cells->GetNumberOfCells();
+    if (!numCells)
+    {
+      return;
+    }
+
+    // First pass: index count per cell, turned into an exclusive prefix sum
+    cellOffsets.resize(numCells + 1);
+    cellOffsets[0] = 0;
+    vtkSMPTools::For(0, numCells, [cells, &cellOffsets](vtkIdType beginCell, vtkIdType endCell)
+    {
+      for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+        cellOffsets[cellId + 1] = CellIndexer::NumIndices(cells->GetCellSize(cellId));
+    });
+    std::partial_sum(cellOffsets.begin(), cellOffsets.end(), cellOffsets.begin());
+
+    // Second pass: fill the presized arrays
+    size_t indexOffset = indexArray.size();
+    size_t reverseOffset = reverseArray.size();
+    size_t numIndices = (size_t)cellOffsets[numCells];
+    indexArray.resize(indexOffset + numIndices);
+    reverseArray.resize(reverseOffset + numIndices);
+
+    CellIndexFunctor<CellIndexer> cellIndexFunctor(cells, cellOffsets,
+      indexArray.data() + indexOffset, GetReverseArrayPtr(reverseArray, reverseOffset));
+    vtkSMPTools::For(0, numCells, cellIndexFunctor);
+  }
+
+  template<typename T>
+  void CreateTriangleIndexBuffer(vtkCellArray* cells, vtkPoints* points,
+    std::vector<vtkIdType>& triOffsets,
+    std::vector<unsigned int>& indexArray,
+    T& reverseArray)
+  {
+    OMNICONNECT_PROFILE_SCOPE("Triangulate");
+
+    vtkIdType numCells = cells->GetNumberOfCells();
+    if (!numCells)
+    {
+      return;
+    }
+
+    // First pass: triangle count per cell, turned into an exclusive prefix sum
+    triOffsets.resize(numCells + 1);
+    triOffsets[0] = 0;
+    vtkSMPTools::For(0, numCells, [cells, &triOffsets](vtkIdType beginCell, vtkIdType endCell)
+    {
+      for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+      {
+        vtkIdType npts = cells->GetCellSize(cellId);
+        triOffsets[cellId + 1] = (npts < 3) ? 0 : npts - 2;
+      }
+    });
+    std::partial_sum(triOffsets.begin(), triOffsets.end(), triOffsets.begin());
+
+    // Second pass: fill the presized arrays
+    size_t indexOffset = indexArray.size();
+    size_t reverseOffset = reverseArray.size();
+    size_t numTriIndices = 3 * (size_t)triOffsets[numCells];
+    indexArray.resize(indexOffset + numTriIndices);
+    reverseArray.resize(reverseOffset + numTriIndices);
+
+    TriangulatePolysFunctor triangulateFunctor(cells, points, triOffsets,
+      indexArray.data() + indexOffset, GetReverseArrayPtr(reverseArray, reverseOffset));
+    vtkSMPTools::For(0, numCells, triangulateFunctor);
+  }
+
+  template<typename T>
+  void MakeConnectivity(vtkPolyData *poly,
+    int representation,
+    size_t numVerts,
+    std::vector<unsigned int>& indexArray,
+    T& indexToCell,
+    std::vector<int>* vertexToCell,
+    std::vector<vtkIdType>& cellOffsets,
+    int filterPrim, //0 for points, 1 for lines, 2 for triangles
+    bool stickLinesEnabled = false,
+    bool stickWireframeEnabled = false,
+    bool isSticks = false // connectivity is created for stick geometry, or for curve geometry
+  )
+  {
+    indexArray.resize(0);
+    //faceVertCounts.resize(0);
+    indexToCell.resize(0);
+    if (vertexToCell != nullptr)
+    {
+      vertexToCell->resize(numVerts);
+      memset(&(*vertexToCell)[0], -1, sizeof(int)*numVerts);
+    }
+
+    vtkCellArray *prims[4];
+    prims[0] = poly->GetVerts();
+    prims[1] = poly->GetLines();
+    prims[2] = poly->GetPolys();
+    prims[3] = poly->GetStrips();
+
+    switch (representation)
+    {
+    case VTK_POINTS:
+    {
+      if (filterPrim == 0)
+      {
+        SetUsedVertexBuffer(prims[0], *vertexToCell);
+        SetUsedVertexBuffer(prims[1], *vertexToCell);
+        SetUsedVertexBuffer(prims[2], *vertexToCell);
+        SetUsedVertexBuffer(prims[3], *vertexToCell);
+      }
+      break;
+    }
+    case VTK_WIREFRAME:
+    {
+      if (filterPrim == 0)
+        SetUsedVertexBuffer(prims[0], *vertexToCell);
+      if (filterPrim == 1)
+      {
+        if(isSticks == stickLinesEnabled) // Get line data if building sticks with sticks enabled (for lines) or building curves with curves enabled
+          CreateCellIndexBuffer<LineSegmentIndexer>(prims[1], cellOffsets, indexArray, indexToCell);
+        if (isSticks == stickWireframeEnabled) // Get wireframe data if building sticks with sticks enabled (for wireframe) or building curves with curves enabled
+          CreateCellIndexBuffer<PolygonSegmentIndexer>(prims[2], cellOffsets, indexArray, indexToCell);
+          CreateCellIndexBuffer<StripSegmentIndexer>(prims[3], cellOffsets, indexArray, indexToCell);
+      }
+      break;
+    }
+    default:
+    {
+      if (filterPrim == 0)
+        SetUsedVertexBuffer(prims[0], *vertexToCell);
+      if (filterPrim == 1)
+      {
+        if (isSticks == stickLinesEnabled)
+          CreateCellIndexBuffer<LineSegmentIndexer>(prims[1], cellOffsets, indexArray, indexToCell);
+      }
+      if (filterPrim == 2)
+      {
+        CreateTriangleIndexBuffer(prims[2], poly->GetPoints(), cellOffsets, indexArray, indexToCell);
+        CreateCellIndexBuffer<StripTriangleIndexer>(prims[3], cellOffsets, indexArray, indexToCell);
+      }
+      break;
+    }
+    }
+  }
+
+  // Copies the tuple of the cell each primitive (numPrimIdx consecutive indices) belongs to into perPrimTuples,
+  // with indexToCell as produced by MakeConnectivity.
+  template<typename ValueType>
+  void ScatterCellTuples(const std::vector<unsigned int>& indexToCell, int numPrimIdx,
+    const ValueType* cellTuples, vtkIdType numCellTuples, int numComps,
+    std::vector<ValueType>& perPrimTuples)
+  {
+    vtkIdType numPrims = (vtkIdType)(indexToCell.size() / numPrimIdx);
+    perPrimTuples.resize(numPrims * numComps);
+
+    ValueType* dest = perPrimTuples.data();
+    vtkSMPTools::For(0, numPrims, [&indexToCell, numPrimIdx, cellTuples, numCellTuples, numComps, dest](vtkIdType beginPrim, vtkIdType endPrim)
+    {
+      (void)numCellTuples; // Only checked in debug builds
+      for (vtkIdType primIdx = beginPrim; primIdx < endPrim; ++primIdx)
+      {
+        vtkIdType cellIdx = indexToCell[primIdx * numPrimIdx];
+        assert(cellIdx < numCellTuples);
+        memcpy(dest + primIdx * numComps, cellTuples + cellIdx * numComps, sizeof(ValueType) * numComps);
+      }
+    });
+  }
+}
+
+#endif
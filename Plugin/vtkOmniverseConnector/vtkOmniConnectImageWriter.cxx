@@ -38,6 +38,26 @@ vtkOmniConnectImageWriter::~vtkOmniConnectImageWriter()
   Writer->Delete();
 }
 
+void vtkOmniConnectImageWriter::SetEncoding(Encoding encoding, bool frequentlyRewritten)
+{
+  if (encoding == Encoding::AUTOMATIC)
+    encoding = frequentlyRewritten ? Encoding::FAST : Encoding::DEFAULT;
+
+  // All encodings are lossless png, so only the deflate effort differs
+  switch (encoding)
+  {
+  case Encoding::STORED:
+    Writer->SetCompressionLevel(0);
+    break;
+  case Encoding::FAST:
+    Writer->SetCompressionLevel(1);
+    break;
+  default:
+    Writer->SetCompressionLevel(5);
+    break;
+  }
+}
+
 bool vtkOmniConnectImageWriter::WriteData(void* omniImage)
 {
   vtkImageData* vtkImage = (vtkImageData*)omniImage;
@@ -24,10 +24,11 @@
 #ifndef vtkOmniConnectImageWriter_h
 #define vtkOmniConnectImageWriter_h
 
+#include "vtkOmniverseConnectorModule.h" // For export macro
 #include "OmniConnectData.h"
 #include "vtkPNGWriter.h"
 
-class vtkOmniConnectImageWriter : public OmniConnectImageWriter
+class VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectImageWriter : public OmniConnectImageWriter
 {
 public:
   vtkOmniConnectImageWriter();
@@ -40,6 +41,15 @@ public:
 
   void SetModifyBorder(bool enable) { ModifyBorder = enable; }
 
+  enum class Encoding
+  {
+    AUTOMATIC = 0, // FAST for frequently rewritten textures (such as color maps), DEFAULT otherwise
+    STORED,        // Uncompressed deflate blocks
+    FAST,          // Lowest deflate level
+    DEFAULT        // Standard png compression
+  };
+  void SetEncoding(Encoding encoding, bool frequentlyRewritten);
+
 protected:
   vtkPNGWriter* Writer;
   bool ModifyBorder = false;
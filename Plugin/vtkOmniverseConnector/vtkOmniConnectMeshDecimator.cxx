@@ -0,0 +1,435 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+#include "vtkOmniConnectMeshDecimator.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <tuple>
+
+namespace
+{
+  constexpr int MaxCellSizeIterations = 16; // After which the cell size is doubled until the budget is met
+  constexpr double ClusterAreaFactor = 3.0; // Approximate surface area per output triangle, in squared cell sizes
+  constexpr uint64_t MaxGridDivisions = 1 << 20;
+  constexpr size_t TriangleChunkSize = 1 << 16;
+
+  bool IsSupportedType(OmniConnectType type, int numComponents)
+  {
+    return (numComponents == 3 && (type == OmniConnectType::FLOAT3 || type == OmniConnectType::DOUBLE3)) ||
+      (numComponents == 2 && (type == OmniConnectType::FLOAT2 || type == OmniConnectType::DOUBLE2));
+  }
+
+  inline void ReadElement(const void* data, OmniConnectType type, size_t idx, int numComponents, double* out)
+  {
+    if (type == OmniConnectType::DOUBLE3 || type == OmniConnectType::DOUBLE2)
+    {
+      const double* src = reinterpret_cast<const double*>(data) + idx * numComponents;
+      for (int i = 0; i < numComponents; ++i)
+        out[i] = src[i];
+    }
+    else
+    {
+      const float* src = reinterpret_cast<const float*>(data) + idx * numComponents;
+      for (int i = 0; i < numComponents; ++i)
+        out[i] = src[i];
+    }
+  }
+
+  void ComputeBounds(const OmniConnectMeshData& meshData, double bounds[6])
+  {
+    std::array<double, 6> emptyBounds = { DBL_MAX, -DBL_MAX, DBL_MAX, -DBL_MAX, DBL_MAX, -DBL_MAX };
+    vtkSMPThreadLocal<std::array<double, 6>> localBounds(emptyBounds);
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(meshData.NumPoints), [&meshData, &localBounds](vtkIdType begin, vtkIdType end)
+      {
+        std::array<double, 6>& b = localBounds.Local();
+        double p[3];
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          ReadElement(meshData.Points, meshData.PointsType, i, 3, p);
+          for (int d = 0; d < 3; ++d)
+          {
+            b[2 * d] = std::min(b[2 * d], p[d]);
+            b[2 * d + 1] = std::max(b[2 * d + 1], p[d]);
+          }
+        }
+      });
+
+    std::copy(emptyBounds.begin(), emptyBounds.end(), bounds);
+    for (const std::array<double, 6>& b : localBounds)
+    {
+      for (int d = 0; d < 3; ++d)
+      {
+        bounds[2 * d] = std::min(bounds[2 * d], b[2 * d]);
+        bounds[2 * d + 1] = std::max(bounds[2 * d + 1], b[2 * d + 1]);
+      }
+    }
+  }
+
+  double ComputeSurfaceArea(const OmniConnectMeshData& meshData)
+  {
+    vtkSMPThreadLocal<double> localArea(0.0);
+    const unsigned int* indices = meshData.Indices;
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(meshData.NumIndices / 3), [&meshData, &localArea, indices](vtkIdType begin, vtkIdType end)
+      {
+        double& area = localArea.Local();
+        double p[3][3];
+        for (vtkIdType t = begin; t < end; ++t)
+        {
+          for (int v = 0; v < 3; ++v)
+            ReadElement(meshData.Points, meshData.PointsType, indices[3 * t + v], 3, p[v]);
+
+          double e0[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+          double e1[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+          double cross[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+          area += 0.5 * std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+        }
+      });
+
+    double area = 0.0;
+    for (double threadArea : localArea)
+      area += threadArea;
+    return area;
+  }
+
+  inline uint64_t GridCoord(double val, double minVal, double cellSize, uint64_t divisions)
+  {
+    double coord = (val - minVal) / cellSize;
+    if (!(coord > 0.0)) // Includes nans
+      return 0;
+    return std::min(divisions - 1, static_cast<uint64_t>(coord));
+  }
+}
+
+bool vtkOmniConnectMeshDecimator::Decimate(const OmniConnectMeshData& meshData, size_t maxTriangles, OmniConnectMeshData& lodData)
+{
+  size_t numTriangles = meshData.NumIndices / 3;
+  if (numTriangles <= maxTriangles || meshData.NumPoints == 0 || meshData.Points == nullptr || meshData.Indices == nullptr ||
+    !IsSupportedType(meshData.PointsType, 3))
+    return false;
+
+  double bounds[6];
+  if (meshData.HasPointsBounds)
+    std::copy(meshData.PointsBounds, meshData.PointsBounds + 6, bounds);
+  else
+    ComputeBounds(meshData, bounds);
+
+  // Start from the cell size at which the surface is expected to meet the budget, then only grow it,
+  // as the triangle count drops about quadratically with the cell size.
+  double diagonal = std::sqrt((bounds[1] - bounds[0]) * (bounds[1] - bounds[0]) +
+    (bounds[3] - bounds[2]) * (bounds[3] - bounds[2]) + (bounds[5] - bounds[4]) * (bounds[5] - bounds[4]));
+  double cellSize = std::sqrt(ClusterAreaFactor * ComputeSurfaceArea(meshData) / std::max(maxTriangles, size_t(1)));
+  if (!(cellSize > 0.0))
+    cellSize = (diagonal > 0.0) ? diagonal : 1.0;
+
+  size_t numClusters = 0;
+  for (int iteration = 0; ; ++iteration)
+  {
+    numClusters = this->ClusterPoints(meshData, bounds, cellSize);
+    size_t numLodTriangles = this->ClusterTriangles(meshData);
+    if (numLodTriangles <= maxTriangles)
+      break;
+
+    // A single cell collapses all triangles, so doubling is guaranteed to terminate
+    double growth = (iteration < MaxCellSizeIterations) ? 1.02 * std::sqrt((double)numLodTriangles / std::max(maxTriangles, size_t(1))) : 2.0;
+    cellSize *= std::max(growth, 1.05);
+  }
+
+  this->AverageClusterAttributes(meshData, numClusters);
+  this->CopyTriangleAttributes(meshData);
+
+  lodData.NumPoints = numClusters;
+  lodData.Points = this->Points.data();
+  lodData.PointsType = OmniConnectType::FLOAT3;
+  lodData.HasPointsBounds = false;
+
+  bool hasNormals = !this->Normals.empty();
+  lodData.Normals = hasNormals ? this->Normals.data() : nullptr;
+  lodData.NormalsType = hasNormals ? OmniConnectType::FLOAT3 : OmniConnectType::UNDEFINED;
+  lodData.PerPrimNormals = hasNormals && meshData.PerPrimNormals;
+
+  bool hasTexCoords = !this->TexCoords.empty();
+  lodData.TexCoords = hasTexCoords ? this->TexCoords.data() : nullptr;
+  lodData.TexCoordsType = hasTexCoords ? OmniConnectType::FLOAT2 : OmniConnectType::UNDEFINED;
+  lodData.PerPrimTexCoords = hasTexCoords && meshData.PerPrimTexCoords;
+
+  bool hasColors = !this->Colors.empty();
+  lodData.Colors = hasColors ? this->Colors.data() : nullptr;
+  lodData.PerPrimColors = hasColors && meshData.PerPrimColors;
+  lodData.ColorComponents = hasColors ? meshData.ColorComponents : 0;
+
+  lodData.NumIndices = this->Indices.size();
+  lodData.Indices = this->Indices.empty() ? nullptr : this->Indices.data();
+
+  return true;
+}
+
+size_t vtkOmniConnectMeshDecimator::ClusterPoints(const OmniConnectMeshData& meshData, const double bounds[6], double cellSize)
+{
+  uint64_t divisions[3];
+  for (int d = 0; d < 3; ++d)
+  {
+    double extent = std::max(0.0, bounds[2 * d + 1] - bounds[2 * d]);
+    divisions[d] = std::min(MaxGridDivisions, static_cast<uint64_t>(extent / cellSize) + 1);
+  }
+
+  size_t numPoints = meshData.NumPoints;
+  this->PointCells.resize(numPoints);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numPoints), [this, &meshData, bounds, cellSize, &divisions](vtkIdType begin, vtkIdType end)
+    {
+      double p[3];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        ReadElement(meshData.Points, meshData.PointsType, i, 3, p);
+        uint64_t x = GridCoord(p[0], bounds[0], cellSize, divisions[0]);
+        uint64_t y = GridCoord(p[1], bounds[2], cellSize, divisions[1]);
+        uint64_t z = GridCoord(p[2], bounds[4], cellSize, divisions[2]);
+        this->PointCells[i] = std::make_pair(x + divisions[0] * (y + divisions[1] * z), static_cast<unsigned int>(i));
+      }
+    });
+
+  vtkSMPTools::Sort(this->PointCells.begin(), this->PointCells.end());
+
+  // Each occupied cell becomes a cluster, numbered in cell order
+  this->PointToCluster.resize(numPoints);
+  this->ClusterOffsets.clear();
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    if (i == 0 || this->PointCells[i].first != this->PointCells[i - 1].first)
+      this->ClusterOffsets.push_back(i);
+    this->PointToCluster[this->PointCells[i].second] = static_cast<unsigned int>(this->ClusterOffsets.size() - 1);
+  }
+  size_t numClusters = this->ClusterOffsets.size();
+  this->ClusterOffsets.push_back(numPoints);
+
+  return numClusters;
+}
+
+size_t vtkOmniConnectMeshDecimator::ClusterTriangles(const OmniConnectMeshData& meshData)
+{
+  const unsigned int* indices = meshData.Indices;
+  const unsigned int* pointToCluster = this->PointToCluster.data();
+
+  // Maps a triangle to its clusters, rotated to start at the lowest cluster id while keeping the winding
+  auto clusterTriangle = [indices, pointToCluster](size_t tri, ClusterTriangle& out) -> bool
+  {
+    unsigned int a = pointToCluster[indices[3 * tri]];
+    unsigned int b = pointToCluster[indices[3 * tri + 1]];
+    unsigned int c = pointToCluster[indices[3 * tri + 2]];
+    if (a == b || b == c || a == c)
+      return false;
+
+    if (b < a && b < c)
+      out = ClusterTriangle{ { b, c, a }, tri };
+    else if (c < a && c < b)
+      out = ClusterTriangle{ { c, a, b }, tri };
+    else
+      out = ClusterTriangle{ { a, b, c }, tri };
+    return true;
+  };
+
+  // Two passes over chunks of triangles: count the remaining triangles, then write them at their chunk's offset
+  size_t numTriangles = meshData.NumIndices / 3;
+  size_t numChunks = (numTriangles + TriangleChunkSize - 1) / TriangleChunkSize;
+  std::vector<size_t> chunkOffsets(numChunks + 1, 0);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [&clusterTriangle, &chunkOffsets, numTriangles](vtkIdType beginChunk, vtkIdType endChunk)
+    {
+      ClusterTriangle clusterTri;
+      for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+      {
+        size_t count = 0;
+        size_t beginTri = static_cast<size_t>(chunk) * TriangleChunkSize;
+        size_t endTri = std::min(numTriangles, beginTri + TriangleChunkSize);
+        for (size_t tri = beginTri; tri < endTri; ++tri)
+          count += clusterTriangle(tri, clusterTri);
+        chunkOffsets[chunk + 1] = count;
+      }
+    });
+
+  for (size_t chunk = 0; chunk < numChunks; ++chunk)
+    chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+
+  this->Triangles.resize(chunkOffsets[numChunks]);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [this, &clusterTriangle, &chunkOffsets, numTriangles](vtkIdType beginChunk, vtkIdType endChunk)
+    {
+      for (vtkIdType chunk = beginChunk; chunk < endChunk; ++chunk)
+      {
+        size_t outIdx = chunkOffsets[chunk];
+        size_t beginTri = static_cast<size_t>(chunk) * TriangleChunkSize;
+        size_t endTri = std::min(numTriangles, beginTri + TriangleChunkSize);
+        for (size_t tri = beginTri; tri < endTri; ++tri)
+          outIdx += clusterTriangle(tri, this->Triangles[outIdx]);
+      }
+    });
+
+  // Triangles that collapse onto the same clusters are kept once, as the first of them in input order
+  auto triangleLess = [](const ClusterTriangle& t0, const ClusterTriangle& t1)
+  {
+    return std::tie(t0.Vertices[0], t0.Vertices[1], t0.Vertices[2], t0.SourceTriangle) <
+      std::tie(t1.Vertices[0], t1.Vertices[1], t1.Vertices[2], t1.SourceTriangle);
+  };
+  auto triangleEqual = [](const ClusterTriangle& t0, const ClusterTriangle& t1)
+  {
+    return t0.Vertices[0] == t1.Vertices[0] && t0.Vertices[1] == t1.Vertices[1] && t0.Vertices[2] == t1.Vertices[2];
+  };
+  vtkSMPTools::Sort(this->Triangles.begin(), this->Triangles.end(), triangleLess);
+  this->Triangles.erase(std::unique(this->Triangles.begin(), this->Triangles.end(), triangleEqual), this->Triangles.end());
+
+  return this->Triangles.size();
+}
+
+void vtkOmniConnectMeshDecimator::AverageClusterAttributes(const OmniConnectMeshData& meshData, size_t numClusters)
+{
+  bool averageNormals = meshData.Normals && !meshData.PerPrimNormals && IsSupportedType(meshData.NormalsType, 3);
+  bool averageTexCoords = meshData.TexCoords && !meshData.PerPrimTexCoords && IsSupportedType(meshData.TexCoordsType, 2);
+  bool averageColors = meshData.Colors && !meshData.PerPrimColors && meshData.ColorComponents > 0 && meshData.ColorComponents <= 4;
+  int colorComponents = meshData.ColorComponents;
+
+  this->Points.resize(numClusters * 3);
+  this->Normals.resize(averageNormals ? numClusters * 3 : 0);
+  this->TexCoords.resize(averageTexCoords ? numClusters * 2 : 0);
+  this->Colors.resize(averageColors ? numClusters * colorComponents : 0);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numClusters),
+    [this, &meshData, averageNormals, averageTexCoords, averageColors, colorComponents](vtkIdType beginCluster, vtkIdType endCluster)
+    {
+      double val[3];
+      for (vtkIdType cluster = beginCluster; cluster < endCluster; ++cluster)
+      {
+        size_t beginPoint = this->ClusterOffsets[cluster], endPoint = this->ClusterOffsets[cluster + 1];
+        double invNumPoints = 1.0 / (double)(endPoint - beginPoint);
+
+        double pointSum[3] = { 0.0, 0.0, 0.0 }, normalSum[3] = { 0.0, 0.0, 0.0 }, texCoordSum[2] = { 0.0, 0.0 };
+        unsigned int colorSum[4] = { 0, 0, 0, 0 };
+        for (size_t i = beginPoint; i < endPoint; ++i)
+        {
+          unsigned int pointIdx = this->PointCells[i].second;
+
+          ReadElement(meshData.Points, meshData.PointsType, pointIdx, 3, val);
+          for (int d = 0; d < 3; ++d)
+            pointSum[d] += val[d];
+
+          if (averageNormals)
+          {
+            ReadElement(meshData.Normals, meshData.NormalsType, pointIdx, 3, val);
+            for (int d = 0; d < 3; ++d)
+              normalSum[d] += val[d];
+          }
+          if (averageTexCoords)
+          {
+            ReadElement(meshData.TexCoords, meshData.TexCoordsType, pointIdx, 2, val);
+            texCoordSum[0] += val[0];
+            texCoordSum[1] += val[1];
+          }
+          if (averageColors)
+          {
+            const unsigned char* color = meshData.Colors + (size_t)pointIdx * colorComponents;
+            for (int c = 0; c < colorComponents; ++c)
+              colorSum[c] += color[c];
+          }
+        }
+
+        for (int d = 0; d < 3; ++d)
+          this->Points[3 * cluster + d] = (float)(pointSum[d] * invNumPoints);
+
+        if (averageNormals)
+        {
+          double length = std::sqrt(normalSum[0] * normalSum[0] + normalSum[1] * normalSum[1] + normalSum[2] * normalSum[2]);
+          if (length > 0.0)
+          {
+            for (int d = 0; d < 3; ++d)
+              this->Normals[3 * cluster + d] = (float)(normalSum[d] / length);
+          }
+          else // Opposing normals cancel out, fall back to one of them
+          {
+            ReadElement(meshData.Normals, meshData.NormalsType, this->PointCells[beginPoint].second, 3, val);
+            for (int d = 0; d < 3; ++d)
+              this->Normals[3 * cluster + d] = (float)val[d];
+          }
+        }
+        if (averageTexCoords)
+        {
+          this->TexCoords[2 * cluster] = (float)(texCoordSum[0] * invNumPoints);
+          this->TexCoords[2 * cluster + 1] = (float)(texCoordSum[1] * invNumPoints);
+        }
+        if (averageColors)
+        {
+          for (int c = 0; c < colorComponents; ++c)
+            this->Colors[cluster * colorComponents + c] = (unsigned char)std::lround(colorSum[c] * invNumPoints);
+        }
+      }
+    });
+}
+
+void vtkOmniConnectMeshDecimator::CopyTriangleAttributes(const OmniConnectMeshData& meshData)
+{
+  bool copyNormals = meshData.Normals && meshData.PerPrimNormals && IsSupportedType(meshData.NormalsType, 3);
+  bool copyTexCoords = meshData.TexCoords && meshData.PerPrimTexCoords && IsSupportedType(meshData.TexCoordsType, 2);
+  bool copyColors = meshData.Colors && meshData.PerPrimColors && meshData.ColorComponents > 0;
+  int colorComponents = meshData.ColorComponents;
+
+  size_t numTriangles = this->Triangles.size();
+  this->Indices.resize(numTriangles * 3);
+  if (copyNormals)
+    this->Normals.resize(numTriangles * 3);
+  if (copyTexCoords)
+    this->TexCoords.resize(numTriangles * 2);
+  if (copyColors)
+    this->Colors.resize(numTriangles * colorComponents);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numTriangles),
+    [this, &meshData, copyNormals, copyTexCoords, copyColors, colorComponents](vtkIdType begin, vtkIdType end)
+    {
+      double val[3];
+      for (vtkIdType tri = begin; tri < end; ++tri)
+      {
+        const ClusterTriangle& clusterTri = this->Triangles[tri];
+        size_t srcTri = clusterTri.SourceTriangle;
+        for (int v = 0; v < 3; ++v)
+          this->Indices[3 * tri + v] = clusterTri.Vertices[v];
+
+        if (copyNormals)
+        {
+          ReadElement(meshData.Normals, meshData.NormalsType, srcTri, 3, val);
+          for (int d = 0; d < 3; ++d)
+            this->Normals[3 * tri + d] = (float)val[d];
+        }
+        if (copyTexCoords)
+        {
+          ReadElement(meshData.TexCoords, meshData.TexCoordsType, srcTri, 2, val);
+          this->TexCoords[2 * tri] = (float)val[0];
+          this->TexCoords[2 * tri + 1] = (float)val[1];
+        }
+        if (copyColors)
+          std::copy(meshData.Colors + srcTri * colorComponents, meshData.Colors + (srcTri + 1) * colorComponents,
+            this->Colors.begin() + tri * colorComponents);
+      }
+    });
+}
@@ -0,0 +1,66 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+#ifndef vtkOmniConnectMeshDecimator_h
+#define vtkOmniConnectMeshDecimator_h
+
+#include "OmniConnectData.h"
+
+#include <vector>
+#include <cstdint>
+
+// Decimates triangle meshes by vertex clustering on a uniform grid, similar to vtkQuadricClustering but with averaged cluster
+// attributes instead of quadrics, so all passes over the input can run in parallel with vtkSMPTools.
+// Output arrays are owned by the decimator and stay valid until its next call to Decimate().
+class vtkOmniConnectMeshDecimator
+{
+public:
+  // Fills out the geometry members of lodData with at most maxTriangles triangles of meshData.
+  // Returns false if meshData already fits within maxTriangles or has no triangles to decimate.
+  bool Decimate(const OmniConnectMeshData& meshData, size_t maxTriangles, OmniConnectMeshData& lodData);
+
+protected:
+  struct ClusterTriangle
+  {
+    unsigned int Vertices[3];
+    size_t SourceTriangle;
+  };
+
+  size_t ClusterPoints(const OmniConnectMeshData& meshData, const double bounds[6], double cellSize);
+  size_t ClusterTriangles(const OmniConnectMeshData& meshData);
+  void AverageClusterAttributes(const OmniConnectMeshData& meshData, size_t numClusters);
+  void CopyTriangleAttributes(const OmniConnectMeshData& meshData);
+
+  std::vector<std::pair<uint64_t, unsigned int>> PointCells; // Grid cell and index of each point, sorted by cell
+  std::vector<unsigned int> PointToCluster;
+  std::vector<size_t> ClusterOffsets; // Ranges of PointCells per cluster
+  std::vector<ClusterTriangle> Triangles;
+
+  std::vector<float> Points;
+  std::vector<float> Normals;
+  std::vector<float> TexCoords;
+  std::vector<unsigned char> Colors;
+  std::vector<unsigned int> Indices;
+};
+
+#endif
@@ -23,9 +23,11 @@
 
 #include "vtkOmniConnectMultiBlockVolumeMapperNode.h"
 
-#include "vtkMultiBlockVolumeMapper.h"
 #include "vtkObjectFactory.h"
-#include "vtkCollection.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkImageData.h"
+#include "vtkSmartPointer.h"
 
 //============================================================================
 vtkStandardNewMacro(vtkOmniConnectMultiBlockVolumeMapperNode);
@@ -43,25 +45,30 @@ vtkOmniConnectMultiBlockVolumeMapperNode::~vtkOmniConnectMultiBlockVolumeMapperN
 //------------------------------------------------------------------------------
 void vtkOmniConnectMultiBlockVolumeMapperNode::PrintSelf(ostream& os, vtkIndent indent)
 {
+  this->Superclass::PrintSelf(os, indent);
 }
 
 //------------------------------------------------------------------------------
-void vtkOmniConnectMultiBlockVolumeMapperNode::Build(bool prepass)
+void vtkOmniConnectMultiBlockVolumeMapperNode::GatherVolumeInputs(vtkDataObject* dataInput, std::vector<VolumeInput>& volInputs)
 {
-  
-  if (prepass)
+  vtkCompositeDataSet* compDs = vtkCompositeDataSet::SafeDownCast(dataInput);
+  if (!compDs)
   {
-    
-    //vtkMultiBlockVolumeMapper* mbMapper = vtkMultiBlockVolumeMapper::SafeDownCast(this->GetRenderable());
-    //
-    //vtkCollection* subMappers = vtkCollection::New();
-    //for (vtkVolumeMapper* sm : mbMapper->GetMappers())
-    //  subMappers->AddItem(sm);
-    //
-    //this->PrepareNodes();
-    //this->AddMissingNodes(subMappers);
-    //this->RemoveUnusedNodes();
-    //
-    //subMappers->Delete();
+    this->Superclass::GatherVolumeInputs(dataInput, volInputs);
+    return;
+  }
+
+  // The flat index keeps the geometry of a block stable over timesteps, even if other blocks are empty
+  vtkSmartPointer<vtkCompositeDataIterator> dit = vtkSmartPointer<vtkCompositeDataIterator>::Take(compDs->NewIterator());
+  dit->SkipEmptyNodesOn();
+  for (dit->InitTraversal(); !dit->IsDoneWithTraversal(); dit->GoToNextItem())
+  {
+    if (vtkImageData* volData = vtkImageData::SafeDownCast(dit->GetCurrentDataObject()))
+    {
+      VolumeInput volInput;
+      volInput.VolData = volData;
+      volInput.DataEntryId = dit->GetCurrentFlatIndex();
+      volInputs.push_back(volInput);
+    }
   }
 }
@@ -25,23 +25,22 @@
 #define vtkOmniConnectMultiBlockVolumeMapperNode_h
 
 #include "vtkOmniverseConnectorModule.h" // For export macro
-#include "vtkVolumeMapperNode.h"
+#include "vtkOmniConnectVolumeMapperNode.h"
 
-#include "OmniConnectData.h"
-
-class VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectMultiBlockVolumeMapperNode : public vtkVolumeMapperNode
+class VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectMultiBlockVolumeMapperNode : public vtkOmniConnectVolumeMapperNode
 {
 public:
   static vtkOmniConnectMultiBlockVolumeMapperNode* New();
-  vtkTypeMacro(vtkOmniConnectMultiBlockVolumeMapperNode, vtkVolumeMapperNode);
+  vtkTypeMacro(vtkOmniConnectMultiBlockVolumeMapperNode, vtkOmniConnectVolumeMapperNode);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
-  virtual void Build(bool prepass) override;
-
 protected:
   vtkOmniConnectMultiBlockVolumeMapperNode();
   ~vtkOmniConnectMultiBlockVolumeMapperNode() override;
 
+  // Every vtkImageData leaf of the input tree is written as a separate volume, identified by its flat index
+  void GatherVolumeInputs(vtkDataObject* dataInput, std::vector<VolumeInput>& volInputs) override;
+
 private:
   vtkOmniConnectMultiBlockVolumeMapperNode(const vtkOmniConnectMultiBlockVolumeMapperNode&) = delete;
   void operator=(const vtkOmniConnectMultiBlockVolumeMapperNode&) = delete;
@@ -48,6 +48,12 @@ struct VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectSettings
   bool UseStickWireframe = false;   // Cylinder-based stick output for triangle wireframes (instead of curves)
   bool UseMeshVolume = false;       // Output textured UsdGeomMesh with MDL instead of UsdVolVolume with OpenVDBAsset fields
   bool CreateNewOmniSession = true; // Find a new Omniverse session directory on creation of the connector, or re-use the last opened one
+  OmniConnectVolumeCompression VolumeCompression = OmniConnectVolumeCompression::BLOSC; // Codec of the OpenVDB volume output
+  bool VolumeHalfFloat = false;     // Store floating point volume grids with 16-bit precision
+  float VolumeQuantizationTolerance = 0.0f; // Maximum absolute error of lossy volume value quantization, 0 to disable
+  OmniConnectNormalsEncoding NormalsEncoding = OmniConnectNormalsEncoding::FLOAT; // Float, half or octahedral (int) normals output
+  bool GenericArraysHalfFloat = false; // Store scalar floating point generic arrays with 16-bit precision, clamped to the half range
+  bool DiscardAssetWrites = false;  // With OutputLocal, only count asset file writes instead of performing them (for benchmarking)
 };
 
 class VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectPass : public vtkRenderPass
@@ -30,8 +30,12 @@
 #include "vtkOmniConnectActorCache.h"
 #include "vtkOmniConnectTextureCache.h"
 #include "vtkOmniConnectTimeStep.h"
-#include "vtkOmniConnectImageWriter.h"
+#include "vtkOmniConnectTextureEncoder.h"
 #include "vtkOmniConnectLogCallback.h"
+#include "vtkOmniConnectMeshDecimator.h"
+#include "vtkOmniConnectConnectivity.h"
+#include "OmniConnectUtilsInternal.h"
+#include "OmniConnectProfiler.h"
 #include "vtkActor.h"
 #include "vtkDataArray.h"
 #include "vtkFloatArray.h"
@@ -43,7 +47,6 @@
 #include "vtkCellData.h"
 #include "vtkPolyData.h"
 #include "vtkMapper.h"
-#include "vtkPolygon.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
 #include "vtkTexture.h"
@@ -58,19 +61,12 @@
 
 #include <map>
 #include <cstring>
+#include <algorithm>
+#include <mutex>
 
 //============================================================================
 namespace
 {
-  template<typename T>
-  class EmptyVector
-  {
-  public:
-    inline size_t size() const { return 0; };
-    inline void resize(size_t) {};
-    inline void push_back(const T&) {}
-  };
-
   void MapScalesThroughPWF(vtkDataArray* scaleArray,  vtkPiecewiseFunction* scaleFunction, vtkOmniConnectTempArrays& tempArrays)
   {
     tempArrays.ScalesArray.resize(scaleArray->GetNumberOfTuples());
@@ -81,373 +77,6 @@ namespace
     }
   }
 
-  void SetUsedVertexBuffer(vtkCellArray *cells,
-    std::vector<int> &vertexToCell)
-  {
-    const vtkIdType* indices = nullptr;
-    vtkIdType npts(0);
-    if (!cells->GetNumberOfCells())
-    {
-      return;
-    }
-
-    int cell_id = 0;
-    for (cells->InitTraversal(); cells->GetNextCell(npts, indices); )
-    {
-      for (int i = 0; i < npts; ++i)
-      {
-        unsigned int vi = (static_cast<unsigned int>(*(indices++)));
-        vertexToCell[vi] = cell_id;
-      }
-      cell_id++;
-    }
-  }
-
-  //----------------------------------------------------------------------------
-  //Description:
-  //Homogenizes lines into a flat list of line segments, each containing two point indexes
-  //At same time creates a reverse cell index array for obtaining cell quantities for points
-  template<typename T>
-  void CreateLineIndexBuffer(vtkCellArray *cells,
-    std::vector<unsigned int>& indexArray,
-    T& reverseArray)
-  {
-    //TODO: restore the preallocate and append to offset features I omitted
-    const vtkIdType* indices = nullptr;
-    vtkIdType npts(0);
-    if (!cells->GetNumberOfCells())
-    {
-      return;
-    }
-
-    unsigned int cell_id = 0;
-    for (cells->InitTraversal(); cells->GetNextCell(npts, indices); )
-    {
-      for (int i = 0; i < npts - 1; ++i)
-      {
-        indexArray.push_back(static_cast<unsigned int>(indices[i]));
-        indexArray.push_back(static_cast<unsigned int>(indices[i + 1]));
-        reverseArray.push_back(cell_id);
-        reverseArray.push_back(cell_id);
-      }
-      cell_id++;
-    }
-  }
-
-  //----------------------------------------------------------------------------
-  //Description:
-  //Homogenizes polygons into a flat list of line segments, each containing two point indexes.
-  //At same time creates a reverse cell index array for obtaining cell quantities for points
-  //This differs from CreateLineIndexBuffer in that it closes loops, making a segment from last point
-  //back to first.
-  template<typename T>
-  void CreateTriangleLineIndexBuffer(vtkCellArray *cells,
-    std::vector<unsigned int>& indexArray,
-    T& reverseArray)
-  {
-    //TODO: restore the preallocate and append to offset features I omitted
-    const vtkIdType* indices = nullptr;
-    vtkIdType npts(0);
-    if (!cells->GetNumberOfCells())
-    {
-      return;
-    }
-
-    unsigned int cell_id = 0;
-    for (cells->InitTraversal(); cells->GetNextCell(npts, indices); )
-    {
-      for (int i = 0; i < npts; ++i)
-      {
-        indexArray.push_back(static_cast<unsigned int>(indices[i]));
-        indexArray.push_back(static_cast<unsigned int>
-          (indices[i < npts - 1 ? i + 1 : 0]));
-        reverseArray.push_back(cell_id);
-        reverseArray.push_back(cell_id);
-      }
-      cell_id++;
-    }
-  }
-
-  template<typename T>
-  void CreateTriangleIndexBuffer(vtkCellArray* cells, vtkPoints* points,
-    std::vector<unsigned int>& indexArray,
-    T& reverseArray)
-  {
-    //TODO: restore the preallocate and append to offset features I omitted
-    const vtkIdType* indices = nullptr;
-    vtkIdType npts(0);
-    if (!cells->GetNumberOfCells())
-    {
-      return;
-    }
-    unsigned int cell_id = 0;
-    // the following are only used if we have to triangulate a polygon
-    // otherwise they just sit at NULL
-    vtkPolygon *polygon = NULL;
-    vtkIdList *tris = NULL;
-    vtkPoints *triPoints = NULL;
-
-    for (cells->InitTraversal(); cells->GetNextCell(npts, indices); )
-    {
-      // ignore degenerate triangles
-      if (npts < 3)
-      {
-        cell_id++;
-        continue;
-      }
-
-      //Instead of this whole construct, could just always make a triangle fan such as the simple cases, or as in AppendTrianglesWorker in vtkOpenGLIndexBufferObject.cxx
-
-      // triangulate needed
-      if (npts > 3)
-      {
-        // special case for quads, penta, hex which are common
-        if (npts == 4)
-        {
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[1]));
-          indexArray.push_back(static_cast<unsigned int>(indices[2]));
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[2]));
-          indexArray.push_back(static_cast<unsigned int>(indices[3]));
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-        }
-        else if (npts == 5)
-        {
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[1]));
-          indexArray.push_back(static_cast<unsigned int>(indices[2]));
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[2]));
-          indexArray.push_back(static_cast<unsigned int>(indices[3]));
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[3]));
-          indexArray.push_back(static_cast<unsigned int>(indices[4]));
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-        }
-        else if (npts == 6)
-        {
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[1]));
-          indexArray.push_back(static_cast<unsigned int>(indices[2]));
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[2]));
-          indexArray.push_back(static_cast<unsigned int>(indices[3]));
-          indexArray.push_back(static_cast<unsigned int>(indices[0]));
-          indexArray.push_back(static_cast<unsigned int>(indices[3]));
-          indexArray.push_back(static_cast<unsigned int>(indices[5]));
-          indexArray.push_back(static_cast<unsigned int>(indices[3]));
-          indexArray.push_back(static_cast<unsigned int>(indices[4]));
-          indexArray.push_back(static_cast<unsigned int>(indices[5]));
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-        }
-        else // 7 sided polygon or higher, do a full smart triangulation
-        {
-          if (!polygon)
-          {
-            polygon = vtkPolygon::New();
-            tris = vtkIdList::New();
-            triPoints = vtkPoints::New();
-          }
-
-          vtkIdType *triIndices = new vtkIdType[npts];
-          triPoints->SetNumberOfPoints(npts);
-          for (int i = 0; i < npts; ++i)
-          {
-            int idx = indices[i];
-            triPoints->SetPoint(i, points->GetPoint(idx));
-            triIndices[i] = i;
-          }
-          polygon->Initialize(npts, triIndices, triPoints);
-          polygon->TriangulateLocalIds(0, tris);
-          for (int j = 0; j < tris->GetNumberOfIds(); ++j)
-          {
-            indexArray.push_back(static_cast<unsigned int>
-              (indices[tris->GetId(j)]));
-            reverseArray.push_back(cell_id);
-          }
-          delete[] triIndices;
-        }
-      }
-      else
-      {
-        indexArray.push_back(static_cast<unsigned int>(*(indices++)));
-        indexArray.push_back(static_cast<unsigned int>(*(indices++)));
-        indexArray.push_back(static_cast<unsigned int>(*(indices++)));
-        reverseArray.push_back(cell_id);
-        reverseArray.push_back(cell_id);
-        reverseArray.push_back(cell_id);
-      }
-
-      cell_id++;
-    }
-    if (polygon)
-    {
-      polygon->Delete();
-      tris->Delete();
-      triPoints->Delete();
-    }
-  }
-
-  template<typename T>
-  void CreateStripIndexBuffer(vtkCellArray *cells,
-    std::vector<unsigned int>& indexArray,
-    T& reverseArray,
-    bool wireframeTriStrips)
-  {
-    if (!cells->GetNumberOfCells())
-    {
-      return;
-    }
-    unsigned int cell_id = 0;
-
-    const vtkIdType *pts = nullptr;
-    vtkIdType npts = 0;
-
-    size_t triCount = cells->GetNumberOfConnectivityEntries()
-      - 3 * cells->GetNumberOfCells();
-    size_t targetSize = wireframeTriStrips ? 2 * (triCount * 2 + 1)
-      : triCount * 3;
-    indexArray.reserve(indexArray.size() + targetSize);
-
-    if (wireframeTriStrips)
-    {
-      for (cells->InitTraversal(); cells->GetNextCell(npts, pts); )
-      {
-        indexArray.push_back(static_cast<unsigned int>(pts[0]));
-        indexArray.push_back(static_cast<unsigned int>(pts[1]));
-        reverseArray.push_back(cell_id);
-        reverseArray.push_back(cell_id);
-        for (int j = 0; j < npts - 2; ++j)
-        {
-          indexArray.push_back(static_cast<unsigned int>(pts[j]));
-          indexArray.push_back(static_cast<unsigned int>(pts[j + 2]));
-          indexArray.push_back(static_cast<unsigned int>(pts[j + 1]));
-          indexArray.push_back(static_cast<unsigned int>(pts[j + 2]));
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-        }
-        cell_id++;
-      }
-    }
-    else
-    {
-      for (cells->InitTraversal(); cells->GetNextCell(npts, pts); )
-      {
-        for (int j = 0; j < npts - 2; ++j)
-        {
-          indexArray.push_back(static_cast<unsigned int>(pts[j]));
-          indexArray.push_back(static_cast<unsigned int>(pts[j + 1 + j % 2]));
-          indexArray.push_back(static_cast<unsigned int>(pts[j + 1 + (j + 1) % 2]));
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-          reverseArray.push_back(cell_id);
-        }
-        cell_id++;
-      }
-    }
-  }
-
-  template<typename T>
-  void MakeConnectivity(vtkPolyData *poly,
-    int representation,
-    size_t numVerts,
-    std::vector<unsigned int>& indexArray,
-    T& indexToCell,
-    std::vector<int>* vertexToCell,
-    int filterPrim, //0 for points, 1 for lines, 2 for triangles
-    bool stickLinesEnabled = false,
-    bool stickWireframeEnabled = false,
-    bool isSticks = false // connectivity is created for stick geometry, or for curve geometry
-  )
-  {
-    indexArray.resize(0);
-    //faceVertCounts.resize(0);
-    indexToCell.resize(0);
-    if (vertexToCell != nullptr)
-    {
-      vertexToCell->resize(numVerts);
-      memset(&(*vertexToCell)[0], -1, sizeof(int)*numVerts);
-    }
-
-    vtkCellArray *prims[4];
-    prims[0] = poly->GetVerts();
-    prims[1] = poly->GetLines();
-    prims[2] = poly->GetPolys();
-    prims[3] = poly->GetStrips();
-
-    switch (representation)
-    {
-    case VTK_POINTS:
-    {
-      if (filterPrim == 0)
-      {
-        SetUsedVertexBuffer(prims[0], *vertexToCell);
-        SetUsedVertexBuffer(prims[1], *vertexToCell);
-        SetUsedVertexBuffer(prims[2], *vertexToCell);
-        SetUsedVertexBuffer(prims[3], *vertexToCell);
-      }
-      break;
-    }
-    case VTK_WIREFRAME:
-    {
-      if (filterPrim == 0)
-        SetUsedVertexBuffer(prims[0], *vertexToCell);
-      if (filterPrim == 1)
-      {
-        if(isSticks == stickLinesEnabled) // Get line data if building sticks with sticks enabled (for lines) or building curves with curves enabled
-          CreateLineIndexBuffer(prims[1], indexArray, indexToCell);
-        if (isSticks == stickWireframeEnabled) // Get wireframe data if building sticks with sticks enabled (for wireframe) or building curves with curves enabled
-          CreateTriangleLineIndexBuffer(prims[2], indexArray, indexToCell);
-          CreateStripIndexBuffer(prims[3], indexArray, indexToCell, true);
-      }
-      break;
-    }
-    default:
-    {
-      if (filterPrim == 0)
-        SetUsedVertexBuffer(prims[0], *vertexToCell);
-      if (filterPrim == 1)
-      {
-        if (isSticks == stickLinesEnabled)
-          CreateLineIndexBuffer(prims[1], indexArray, indexToCell);
-      }
-      if (filterPrim == 2)
-      {
-        CreateTriangleIndexBuffer(prims[2], poly->GetPoints(), indexArray, indexToCell);
-        CreateStripIndexBuffer(prims[3], indexArray, indexToCell, false);
-      }
-      break;
-    }
-    }
-  }
-
   vtkUnsignedCharArray* GetColorsAndInterpolation(vtkMapper* mapper, vtkPolyData* polyData, bool& isCellColors)
   {
     int cellFlag = 0;
@@ -580,7 +209,7 @@ namespace
     bool& useCellNormals, bool& useCellColors, bool& forceConsistentWinding,
     vtkOmniConnectTempArrays& tempArrays, vtkMapper* mapper, vtkProperty* prop, vtkPolyData* polyData, int representation, vtkPolyDataNormals* normalGenerator,
     bool hasTexture, int geomType, bool stickLinesEnabled = false, bool stickWireframeEnabled = false, bool isSticks = false,
-    OmniConnectGenericArray* updatedGenericArrays = nullptr, size_t numUga = 0)
+    OmniConnectGenericArray* updatedGenericArrays = nullptr, size_t numUga = 0, bool reuseIndices = false)
   {
     std::vector<unsigned int>& indexArray = tempArrays.IndexArray;
     std::vector<unsigned int>& indexToCell = tempArrays.IndexToCell;
@@ -630,14 +259,19 @@ namespace
     {
       if (useCellNormals || useCellColors || tempArrays.HasPerCellGenericArrays())
       {
-        MakeConnectivity(polyData, representation, numVerts, indexArray, indexToCell, nullptr, geomType, stickLinesEnabled, stickWireframeEnabled, isSticks);
+        vtkOmniConnectConnectivity::MakeConnectivity(polyData, representation, numVerts, indexArray, indexToCell, nullptr, tempArrays.CellIndexOffsets, geomType, stickLinesEnabled, stickWireframeEnabled, isSticks);
         assert(indexArray.size() == indexToCell.size());
       }
-      else
+      else if (!reuseIndices)
       {
         //indexToCell does not have to be generated
-        EmptyVector<unsigned int> emptyVec;
-        MakeConnectivity(polyData, representation, numVerts, indexArray, emptyVec, nullptr, geomType, stickLinesEnabled, stickWireframeEnabled, isSticks);
+        vtkOmniConnectConnectivity::EmptyVector<unsigned int> emptyVec;
+        vtkOmniConnectConnectivity::MakeConnectivity(polyData, representation, numVerts, indexArray, emptyVec, nullptr, tempArrays.CellIndexOffsets, geomType, stickLinesEnabled, stickWireframeEnabled, isSticks);
+      }
+      else
+      {
+        //Connectivity is unchanged from an earlier write and nothing else depends on it
+        indexArray.resize(0);
       }
 
       assert((indexArray.size() % numPrimIdx) == 0); // Index array size corresponds with primitive type
@@ -646,8 +280,8 @@ namespace
     else
     {
       //Connectivity information
-      EmptyVector<unsigned int> emptyVec;
-      MakeConnectivity(polyData, representation, numVerts, indexArray, emptyVec, &vertexToCell, 0);
+      vtkOmniConnectConnectivity::EmptyVector<unsigned int> emptyVec;
+      vtkOmniConnectConnectivity::MakeConnectivity(polyData, representation, numVerts, indexArray, emptyVec, &vertexToCell, tempArrays.CellIndexOffsets, 0);
 
       //Vertex from point array does not necessarily have to belong to a cell visited by makeconnectivity
       //The index array is still empty, only vertexToCell is filled.
@@ -681,15 +315,9 @@ namespace
       {
         if (useCellNormals)
         {
-          perPrimNormal.resize(numPrims * numNormalComps);
-          float* src = normals->GetPointer(0);
-          float* dest = &perPrimNormal[0];
-          for (int i = 0; i < numPrims; ++i)
-          {
-            int cellIdx = indexToCell[i * numPrimIdx];
-            assert(cellIdx < normals->GetNumberOfTuples());
-            memcpy(dest + i * numNormalComps, src + cellIdx * numNormalComps, sizeof(float) * numNormalComps);
-          }
+          assert(indexToCell.size() == numPrims * numPrimIdx);
+          vtkOmniConnectConnectivity::ScatterCellTuples(indexToCell, numPrimIdx,
+            normals->GetPointer(0), normals->GetNumberOfTuples(), numNormalComps, perPrimNormal);
         }
         else
         {
@@ -703,20 +331,10 @@ namespace
     {
       if (useCellColors)
       {
-        int numSrcComps = colors->GetNumberOfComponents();
-        perPrimColor.resize(numPrims * numSrcComps); //rgba bytes for every triangle
-
-        for (int i = 0; i < numPrims; ++i)
-        {
-          int cellIdx = indexToCell[i * numPrimIdx];
-          if (cellIdx != -1) // Vertex from point array does not necessarily have to belong to a cell visited by makeconnectivity.
-          {
-            unsigned char* dest = &perPrimColor[i * numSrcComps];
-            assert(cellIdx < colors->GetNumberOfTuples());
-            unsigned char* src = colors->GetPointer(cellIdx * numSrcComps);
-            memcpy(dest, src, numSrcComps);
-          }
-        }
+        //rgba bytes for every triangle
+        assert(indexToCell.size() == numPrims * numPrimIdx);
+        vtkOmniConnectConnectivity::ScatterCellTuples(indexToCell, numPrimIdx,
+          colors->GetPointer(0), colors->GetNumberOfTuples(), colors->GetNumberOfComponents(), perPrimColor);
       }
       else
       {
@@ -985,6 +603,8 @@ namespace
   void GatherPointData(OmniConnectInstancerData& instancerData, vtkOmniConnectTempArrays& tempArrays,
     vtkMapper* mapper, vtkProperty* prop, vtkPolyData* polyData, int representation, bool hasTexture)
   {
+    OMNICONNECT_PROFILE_SCOPE("Gather");
+
     bool useCellNormals = false;
     bool useCellColors = false;
     bool forceConsistentWinding = false;
@@ -1053,6 +673,8 @@ namespace
   void GatherStickData(OmniConnectInstancerData& instancerData, vtkOmniConnectTempArrays& tempArrays,
     vtkMapper* mapper, vtkProperty* prop, vtkPolyData* polyData, int representation, bool hasTexture, bool stickLinesEnabled, bool stickWireframeEnabled)
   {
+    OMNICONNECT_PROFILE_SCOPE("Gather");
+
     bool useCellNormals = false;
     bool useCellColors = false;
     bool forceConsistentWinding = false;
@@ -1111,6 +733,8 @@ namespace
   void GatherCurveData(OmniConnectCurveData& curveData, vtkOmniConnectTempArrays& tempArrays,
     vtkMapper* mapper, vtkProperty* prop, vtkPolyData* polyData, int representation, bool hasTexture, bool stickLinesEnabled, bool stickWireframeEnabled)
   {
+    OMNICONNECT_PROFILE_SCOPE("Gather");
+
     bool useCellNormals = false;
     bool useCellColors = false;
     bool forceConsistentWinding = false;
@@ -1175,8 +799,10 @@ namespace
   void GatherMeshData(OmniConnectMeshData& meshData, vtkOmniConnectTempArrays& tempArrays,
     vtkMapper* mapper, vtkProperty* prop, vtkPolyData* polyData, int representation, vtkPolyDataNormals* normalGenerator,
     bool hasTexture, bool forceConsistentWinding,
-    OmniConnectGenericArray* updatedGenericArrays, size_t numUga)
+    OmniConnectGenericArray* updatedGenericArrays, size_t numUga, const vtkOmniConnectMeshTopology* reusedTopology)
   {
+    OMNICONNECT_PROFILE_SCOPE("Gather");
+
     bool useCellNormals = false;
     bool useCellColors = false;
     size_t numVerts = 0;
@@ -1190,7 +816,7 @@ namespace
     GatherConnectedGeom(numVerts, points, normals, colors, texcoords, scaleArray, scaleFunction,
       useCellNormals, useCellColors, forceConsistentWinding,
       tempArrays, mapper, prop, polyData, representation, normalGenerator, hasTexture, 2,
-      false, false, false, updatedGenericArrays, numUga);
+      false, false, false, updatedGenericArrays, numUga, reusedTopology != nullptr);
 
     //Copy to points to meshdata
     meshData.NumPoints = numVerts;
@@ -1232,6 +858,11 @@ namespace
     meshData.PerPrimColors = useCellColors;
 
     // Copy indices
+    if (reusedTopology != nullptr && tempArrays.IndexArray.empty())
+    {
+      meshData.NumIndices = reusedTopology->NumIndices; // Keeps the face count consistent with the connectivity written earlier
+      return;
+    }
     meshData.NumIndices = tempArrays.IndexArray.size();
     if (meshData.NumIndices > 0)
     {
@@ -1241,6 +872,105 @@ namespace
     }
   }
 
+  void HashMeshTopology(vtkOmniConnectTimeStep* timeStep, size_t dataEntryId, vtkPolyData* polyData, vtkProperty* prop,
+    int representation, bool forceConsistentWinding, uint64_t topologyHash[2])
+  {
+    timeStep->UpdateConnectivityHash(dataEntryId, polyData, topologyHash);
+
+    // Regenerating normals triangulates strips and may reorient faces, see GatherConnectedGeom
+    bool useCellNormals = prop->GetInterpolation() == VTK_FLAT;
+    bool regeneratesNormals = !GetPolyDataNormals(polyData, useCellNormals) || forceConsistentWinding;
+    int topologyFlags[3] = { representation, regeneratesNormals, forceConsistentWinding };
+    ocutils::HashBytes128(topologyFlags, sizeof(topologyFlags), topologyHash);
+  }
+
+  bool TopologyHashEquals(const vtkOmniConnectMeshTopology& topology, const uint64_t topologyHash[2])
+  {
+    return topology.Written && topology.Hash[0] == topologyHash[0] && topology.Hash[1] == topologyHash[1];
+  }
+
+  // Decides whether mesh connectivity is timevarying and whether it has to be written at all; returns the topology to reuse, if any.
+  // Unless declared otherwise, connectivity is written as a single copy for all timesteps, until a timestep differs from it.
+  const vtkOmniConnectMeshTopology* SelectMeshTopology(OmniConnectMeshData& meshData,
+    vtkOmniConnectMeshTopology& geomTopology, vtkOmniConnectMeshTopology& stepTopology, const uint64_t topologyHash[2], bool forceUpdate)
+  {
+    using DMI = OmniConnectMeshData::DataMemberId;
+    OmniConnectUpdateEvaluator<OmniConnectMeshData> updateEval(meshData);
+
+    bool allowTimeVarying = (meshData.TimeVarying & DMI::INDICES) != DMI::NONE; // As declared by vtkOmniConnectTemporalArrays
+    if (allowTimeVarying && !geomTopology.TimeVarying && geomTopology.Written && !TopologyHashEquals(geomTopology, topologyHash))
+      geomTopology.TimeVarying = true; // Sticks for the lifetime of the geometry, as earlier timesteps keep referring to the single copy
+
+    bool timeVarying = allowTimeVarying && geomTopology.TimeVarying;
+    if (!timeVarying)
+      meshData.TimeVarying = meshData.TimeVarying & ~DMI::INDICES;
+
+    // Without timevarying connectivity, timesteps that carry no copy of their own resolve to the single copy
+    const vtkOmniConnectMeshTopology& writtenTopology = timeVarying ? stepTopology : geomTopology;
+    if (forceUpdate || !TopologyHashEquals(writtenTopology, topologyHash))
+      return nullptr;
+
+    stepTopology = writtenTopology;
+    updateEval.RemoveUpdate(DMI::INDICES);
+    return &stepTopology;
+  }
+
+  void RecordMeshTopology(const OmniConnectMeshData& meshData,
+    vtkOmniConnectMeshTopology& geomTopology, vtkOmniConnectMeshTopology& stepTopology, const uint64_t topologyHash[2])
+  {
+    using DMI = OmniConnectMeshData::DataMemberId;
+    if ((meshData.UpdatesToPerform & DMI::INDICES) == DMI::NONE)
+      return;
+
+    stepTopology.Hash[0] = topologyHash[0];
+    stepTopology.Hash[1] = topologyHash[1];
+    stepTopology.NumIndices = meshData.NumIndices;
+    stepTopology.Written = true;
+
+    if ((meshData.TimeVarying & DMI::INDICES) == DMI::NONE)
+    {
+      geomTopology.Hash[0] = topologyHash[0];
+      geomTopology.Hash[1] = topologyHash[1];
+      geomTopology.NumIndices = meshData.NumIndices;
+      geomTopology.Written = true;
+    }
+  }
+
+  // Tags the levels of detail written for a mesh for the actornode geom deletion, which removes the levels that are no longer required
+  void AddTransferredLods(vtkOmniConnectActorNodeBase* aNode, size_t meshGeomId, int lodLevels)
+  {
+    for (int lodLevel = 1; lodLevel <= OmniConnectMaxLodLevels; ++lodLevel)
+    {
+      if (lodLevels & (1 << (lodLevel-1)))
+        aNode->AddTransferredGeometry(OmniConnectLodMeshId(meshGeomId, lodLevel), OmniConnectGeomType::MESH);
+    }
+  }
+
+  // Returns the levels that have been written, see vtkOmniConnectMeshTopology::LodLevels
+  int UpdateMeshLods(OmniConnect* connector, vtkOmniConnectRendererNode* rNode, vtkOmniConnectActorNodeBase* aNode,
+    size_t actorId, double animTimeStep, const OmniConnectMeshData& meshData, size_t materialId)
+  {
+    // Levels are decimated from the full mesh with their own budget, and written in full for every update
+    const int* lodBudgets = rNode->GetLodTriangleBudgets();
+    vtkOmniConnectMeshDecimator& decimator = rNode->GetMeshDecimator();
+    int lodLevels = 0;
+    for (int lodLevel = 1; lodLevel <= OmniConnectMaxLodLevels; ++lodLevel)
+    {
+      OmniConnectMeshData lodData;
+      if (lodBudgets[lodLevel-1] <= 0 || !decimator.Decimate(meshData, lodBudgets[lodLevel-1], lodData))
+        continue;
+      lodLevels |= 1 << (lodLevel-1);
+
+      lodData.MeshId = OmniConnectLodMeshId(meshData.MeshId, lodLevel);
+      aNode->AddTransferredGeometry(lodData.MeshId, OmniConnectGeomType::MESH);
+
+      connector->UpdateMesh(actorId, animTimeStep, lodData, materialId,
+        nullptr, 0, nullptr, 0);
+      connector->SetGeomVisibility(actorId, lodData.MeshId, OmniConnectGeomType::MESH, true, animTimeStep);
+    }
+    return lodLevels;
+  }
+
   void ExtractGeomTypes(vtkPolyData* poly, int representation, bool stickLinesEnabled, bool stickWireframeEnabled,
     bool& hasPointGeom, bool& hasStickGeom, bool& hasLineGeom, bool& hasTriangleGeom)
   {
@@ -1373,8 +1103,10 @@ public:
     return scalars != nullptr && mapper->CanUseTextureMapForColoring(poly);
   }
 
-  vtkImageData* FindTextureForPoly(vtkActor* act, vtkMapper* mapper, vtkPolyData* poly)
+  vtkImageData* FindTextureForPoly(vtkActor* act, vtkMapper* mapper, vtkPolyData* poly, std::mutex& colorMappingMutex)
   {
+    std::lock_guard<std::mutex> colorMappingLock(colorMappingMutex);
+
     // MAPSCALARS CALL (efficiency)
     if (!MapScalarsCalled)
     {
@@ -1428,7 +1160,25 @@ public:
     return resultCtm;
   }
 
+  struct PendingTextureUpload
+  {
+    vtkOmniConnectTextureEncoder::Result EncodedImage;
+    int TexId = 0;
+    bool IsColorTextureMap = true;
+    double AnimTimeStep = 0.0;
+  };
+
+  struct PendingMaterialUpdate
+  {
+    OmniConnectMaterialData MaterialData;
+    double AnimTimeStep = 0.0;
+  };
+
   std::vector<size_t> MaterialIds;
+  // Textures are encoded by the renderer node's texture encoder while the geometry is gathered. They are uploaded after the gather,
+  // before the material referring to them, which in turn is updated before the geometry that binds it.
+  std::vector<PendingTextureUpload> PendingTextureUploads;
+  std::vector<PendingMaterialUpdate> PendingMaterialUpdates;
   bool MapScalarsCalled = false;
   vtkImageData* TempMappedTexture;
 };
@@ -1468,6 +1218,44 @@ void vtkOmniConnectPolyDataMapperNode::ResetMaterialIds()
   this->Internals->MaterialIds.resize(0);
 }
 
+//----------------------------------------------------------------------------
+void vtkOmniConnectPolyDataMapperNode::UpdatePendingMaterials(vtkOmniConnectRendererNode* rNode, vtkOmniConnectActorNodeBase* aNode)
+{
+  OmniConnect* connector = rNode->GetOmniConnector();
+
+  // Waits for the encoder, so called as late as possible: right before the first geometry update
+  for (auto& pendingUpload : this->Internals->PendingTextureUploads)
+  {
+    {
+      OMNICONNECT_PROFILE_SCOPE("TextureWait"); // Encoding not yet overlapped by the gather
+      pendingUpload.EncodedImage.wait();
+    }
+    const vtkOmniConnectTextureEncoder::EncodedImage& encodedImage = pendingUpload.EncodedImage.get();
+
+    if (!encodedImage.empty())
+    {
+      OmniConnectSamplerData samplerData;
+      samplerData.TexData = encodedImage.data();
+      samplerData.TexDataSize = encodedImage.size();
+      samplerData.WrapS = samplerData.WrapT = pendingUpload.IsColorTextureMap ? OmniConnectSamplerData::WrapMode::CLAMP : OmniConnectSamplerData::WrapMode::REPEAT;
+
+      // Upload the texture image data
+      connector->UpdateTexture(aNode->GetActorId(), pendingUpload.TexId, samplerData,
+        rNode->GetForceTimeVaryingTextures(), pendingUpload.AnimTimeStep);
+    }
+    else
+      vtkOmniConnectLogCallback::Callback(OmniConnectLogLevel::ERR, nullptr, "Texture image could not be written");
+  }
+
+  this->Internals->PendingTextureUploads.resize(0);
+
+  // The material refers to the texture's file and sampler settings, which the connector only knows after the upload
+  for (auto& pendingUpdate : this->Internals->PendingMaterialUpdates)
+    connector->UpdateMaterial(aNode->GetActorId(), pendingUpdate.MaterialData, pendingUpdate.AnimTimeStep);
+
+  this->Internals->PendingMaterialUpdates.resize(0);
+}
+
 //----------------------------------------------------------------------------
 void vtkOmniConnectPolyDataMapperNode::ExtractMapperProperties(vtkMapper* mapper)
 {
@@ -1509,12 +1297,10 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
 
     if (!materialProcessed)
     {
-      vtkOmniConnectImageWriter* imageWriter = rNode->GetImageWriter();
-
       // Update texture:
       // Pass on the texture data to the actor node, and update if necessary
       // Retrieve the texture cache in case it needs to be updated, and update immediately.
-      vtkImageData* texData = this->Internals->FindTextureForPoly(actor, mapper, polyData);
+      vtkImageData* texData = this->Internals->FindTextureForPoly(actor, mapper, polyData, rNode->GetColorMappingMutex());
       vtkOmniConnectTextureCache* texCache = nullptr;
       if (texData)
       {
@@ -1523,29 +1309,16 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
 
         if (texCache->Status == OmniConnectStatusType::UPDATE)
         {
-          // Data has to go through the image writer before it can be uploaded
-          bool modifyTextureBorder = texCache->IsColorTextureMap;
-          imageWriter->SetModifyBorder(modifyTextureBorder); //is a hack
-          bool imageWritten = imageWriter->WriteData(texData);
-
-          if (imageWritten)
-          {
-            char* imageData; int imageLength;
-            imageWriter->GetResult(imageData, imageLength);
-
-            OmniConnectSamplerData samplerData;
-            samplerData.TexData = imageData;
-            samplerData.TexDataSize = imageLength;
-            samplerData.WrapS = samplerData.WrapT = texCache->IsColorTextureMap ? OmniConnectSamplerData::WrapMode::CLAMP : OmniConnectSamplerData::WrapMode::REPEAT;
-
-            // Upload the texture image data
-            connector->UpdateTexture(actorId, texCache->TexId, samplerData,
-              rNode->GetForceTimeVaryingTextures(), animTimeStep);
-          }
-          else
-            vtkOmniConnectLogCallback::Callback(OmniConnectLogLevel::ERR, nullptr, "Texture image could not be written");
-
-          imageWriter->SetModifyBorder(false);
+          // Data has to go through the image writer before it can be uploaded, which happens on the encoder's threads until UpdatePendingMaterials()
+          bool modifyTextureBorder = texCache->IsColorTextureMap; //is a hack
+          vtkOmniConnectPolyDataMapperNodeInternals::PendingTextureUpload pendingUpload;
+          pendingUpload.EncodedImage = rNode->GetTextureEncoder()->Encode(texData, modifyTextureBorder,
+            (vtkOmniConnectImageWriter::Encoding)rNode->GetTextureEncoding(),
+            texCache->IsColorTextureMap || rNode->GetForceTimeVaryingTextures());
+          pendingUpload.TexId = texCache->TexId;
+          pendingUpload.IsColorTextureMap = texCache->IsColorTextureMap;
+          pendingUpload.AnimTimeStep = animTimeStep;
+          this->Internals->PendingTextureUploads.push_back(std::move(pendingUpload));
         }
         // Deletion of textures happens later on in vtkOmniConnectActorNodeBase
       }
@@ -1561,7 +1334,11 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
         SetUpdatesToPerform(omniMatData, rNode->GetForceTimeVaryingMaterialParams());
 
         bool useVertexColors = DetermineVertexColors(mapper, polyData); // Material-polydata dependency for vertexcolors, uncertain whether this evaluation can differ across polydatas in practice.
-        bool opacityMappingEnabled = !mapper->GetLookupTable()->IsOpaque();
+        bool opacityMappingEnabled = false;
+        {
+          std::lock_guard<std::mutex> colorMappingLock(rNode->GetColorMappingMutex());
+          opacityMappingEnabled = !mapper->GetLookupTable()->IsOpaque();
+        }
 
         GatherMaterialData(prop, texData ? texCache->TexId : -1, omniMatData,
           overrideAmbientColor,
@@ -1580,7 +1357,10 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
 #endif
           );
 
-        connector->UpdateMaterial(actorId, omniMatData, animTimeStep);
+        vtkOmniConnectPolyDataMapperNodeInternals::PendingMaterialUpdate pendingUpdate;
+        pendingUpdate.MaterialData = omniMatData;
+        pendingUpdate.AnimTimeStep = animTimeStep;
+        this->Internals->PendingMaterialUpdates.push_back(pendingUpdate);
         this->Internals->MaterialIds.push_back(materialId);
       }
       // Materials are not deleted because they are not stored per-timestep and they have no means of identification across timesteps; as such they are simply overwritten by all new materials generated within this timestep update.
@@ -1650,7 +1430,7 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
     OmniConnectGenericArray* updatedGenericArrays = tempArrays.UpdatedGenericArrays.data();
     OmniConnectGenericArray* deletedGenericArrays = tempArrays.DeletedGenericArrays.data();
 
-    vtkImageData* texData = this->Internals->FindTextureForPoly(actor, mapper, polyData);
+    vtkImageData* texData = this->Internals->FindTextureForPoly(actor, mapper, polyData, rNode->GetColorMappingMutex());
 
     // Extract the geometry data from vtk and upload to the connector along with generic data
     if (hasTriGeom)
@@ -1659,15 +1439,36 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
       omniMeshData.MeshId = meshGeomId;
       SetUpdatesToPerform(omniMeshData, polyData, forceArrayUpdate); // Fill out omniMeshData.UpdatesToPerform: which standard arrays of the OmniConnectMeshData type to perform updates on (for manual disabling of standard array updates over timesteps).
 
+      // Skip retriangulation and rewrites of connectivity that hasn't changed
+      uint64_t topologyHash[2];
+      HashMeshTopology(omniTimeStep, dataEntryId, polyData, prop, representation, rNode->GetForceConsistentWinding(), topologyHash);
+      // Copy of the per-geometry topology, written back before any other geometries are added for the actor
+      vtkOmniConnectMeshTopology geomTopology;
+      bool hasGeomTopology = aNode->GetTransferredTopology(meshGeomId, OmniConnectGeomType::MESH, geomTopology);
+      assert(hasGeomTopology); // Added above
+      (void)hasGeomTopology;
+      vtkOmniConnectMeshTopology& stepTopology = omniTimeStep->DataEntries[dataEntryId].Topology;
+      const vtkOmniConnectMeshTopology* reusedTopology = SelectMeshTopology(omniMeshData, geomTopology, stepTopology, topologyHash, forceArrayUpdate);
+
+      // Decimation requires the indices, even if the connectivity itself isn't rewritten
+      bool generateLods = rNode->HasLodTriangleBudgets();
+
       GatherMeshData(omniMeshData, tempArrays,
         mapper, prop, polyData, representation,
         rNode->GetNormalGenerator(), texData != nullptr, rNode->GetForceConsistentWinding(),
-        updatedGenericArrays, ugaLen); // Normalgenerator may regenerate generic arrays
+        updatedGenericArrays, ugaLen, generateLods ? nullptr : reusedTopology); // Normalgenerator may regenerate generic arrays
+
+      RecordMeshTopology(omniMeshData, geomTopology, stepTopology, topologyHash);
+      aNode->SetTransferredTopology(meshGeomId, OmniConnectGeomType::MESH, geomTopology);
+
+      this->UpdatePendingMaterials(rNode, aNode); // Bound by the geometry
 
       connector->UpdateMesh(actorId, animTimeStep, omniMeshData, materialId,
         updatedGenericArrays, ugaLen,
         deletedGenericArrays, dgaLen);
       connector->SetGeomVisibility(actorId, omniMeshData.MeshId, OmniConnectGeomType::MESH, true, animTimeStep); //Always set geom to visible (geometry that became invisible handled in vtkOmniConnectActorNodeBase)
+
+      stepTopology.LodLevels = generateLods ? UpdateMeshLods(connector, rNode, aNode, actorId, animTimeStep, omniMeshData, materialId) : 0;
     }
     if (hasLineGeom)
     {
@@ -1679,6 +1480,8 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
         mapper, prop, polyData, representation, texData != nullptr,
         stickLinesEnabled, stickWireframeEnabled);
 
+      this->UpdatePendingMaterials(rNode, aNode);
+
       connector->UpdateCurve(actorId, animTimeStep, omniCurveData, materialId,
         updatedGenericArrays, ugaLen,
         deletedGenericArrays, dgaLen);
@@ -1698,6 +1501,8 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
         mapper, prop, polyData, representation, texData != nullptr,
         stickLinesEnabled, stickWireframeEnabled);
 
+      this->UpdatePendingMaterials(rNode, aNode);
+
       connector->UpdateInstancer(actorId, animTimeStep, omniInstancerData, materialId,
         updatedGenericArrays, ugaLen,
         deletedGenericArrays, dgaLen);
@@ -1717,6 +1522,8 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
 
       GatherCustomPointAttributes(polyData, omniInstancerData);
 
+      this->UpdatePendingMaterials(rNode, aNode);
+
       connector->UpdateInstancer(actorId, animTimeStep, omniInstancerData, materialId,
         updatedGenericArrays, ugaLen,
         deletedGenericArrays, dgaLen);
@@ -1728,7 +1535,13 @@ void vtkOmniConnectPolyDataMapperNode::RenderPoly(vtkOmniConnectRendererNode* rN
     // Cleanup generic array cache (to match arrays that were deleted in call to connector->UpdateMesh())
     omniTimeStep->CleanupGenericArrayCache(dataEntryId);
   }
+  else if (hasTriGeom)
+  {
+    AddTransferredLods(aNode, meshGeomId, omniTimeStep->DataEntries[dataEntryId].Topology.LodLevels);
+  }
 
+  // Material changes without geometry updates
+  this->UpdatePendingMaterials(rNode, aNode);
 }
 
 //----------------------------------------------------------------------------
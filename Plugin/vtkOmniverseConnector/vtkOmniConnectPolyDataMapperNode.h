@@ -65,6 +65,7 @@ protected:
 
   void ResetMaterialIds();
   void ExtractMapperProperties(vtkMapper* mapper);
+  void UpdatePendingMaterials(vtkOmniConnectRendererNode* rNode, vtkOmniConnectActorNodeBase* aNode);
 
   bool GetNodeNeedsProcessing(vtkOmniConnectRendererNode* rNode, vtkOmniConnectActorNodeBase* aNode,
     vtkOmniConnectTimeStep* omniTimeStep, vtkDataObject* poly, vtkCompositeDataDisplayAttributes* cda = nullptr) const;
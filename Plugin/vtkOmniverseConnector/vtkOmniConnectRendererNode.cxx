@@ -25,20 +25,29 @@
 #include "vtkOmniConnectPass.h"
 #include "vtkOmniConnectActorNode.h"
 #include "vtkOmniConnectVolumeNode.h"
-#include "vtkOmniConnectImageWriter.h"
+#include "vtkOmniConnectTextureEncoder.h"
 #include "vtkOmniConnectLogCallback.h"
 #include "vtkOmniConnectTimeStep.h"
+#include "vtkOmniConnectMeshDecimator.h"
 #include "vtkObjectFactory.h"
 #include "vtkRenderer.h"
 #include "OmniConnect.h"
 #include "vtkInformationStringKey.h"
 #include "vtkPolyDataNormals.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLState.h"
 #include "vtk_glew.h"
 
 #include <sstream>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <functional>
 
 namespace
 {
@@ -71,10 +80,9 @@ namespace
   }
 }
 
-class vtkOmniConnectRendererNodeInternals
+struct vtkOmniConnectThreadHelpers
 {
-public:
-  vtkOmniConnectRendererNodeInternals()
+  vtkOmniConnectThreadHelpers()
   {
     this->NormalGenerator = vtkSmartPointer<vtkPolyDataNormals>::New();
     this->NormalGenerator->ComputePointNormalsOn();
@@ -86,6 +94,36 @@ public:
     this->NormalGenerator->FlipNormalsOff();
   }
 
+  vtkSmartPointer<vtkPolyDataNormals> NormalGenerator;
+
+  vtkOmniConnectTempArrays TempArrays;
+
+  vtkOmniConnectMeshDecimator MeshDecimator;
+};
+
+class vtkOmniConnectRendererNodeInternals
+{
+public:
+  vtkOmniConnectThreadHelpers& GetThreadHelpers()
+  {
+    // Created on first use, as the helpers cannot be copied from an exemplar
+    std::shared_ptr<vtkOmniConnectThreadHelpers>& helpers = this->ThreadHelpers.Local();
+    if (!helpers)
+      helpers = std::make_shared<vtkOmniConnectThreadHelpers>();
+    return *helpers;
+  }
+
+  vtkOmniConnectTextureEncoder* GetTextureEncoder()
+  {
+    // Actor nodes share one pool, which is started by the first texture that needs encoding
+    std::call_once(this->TextureEncoderCreated, [this]()
+      {
+        size_t numThreads = std::max(1u, std::thread::hardware_concurrency() / 2);
+        this->TextureEncoder = std::make_unique<vtkOmniConnectTextureEncoder>(numThreads);
+      });
+    return this->TextureEncoder.get();
+  }
+
   void ResetProgressState(const std::list<vtkViewNode*>& children)
   {
     this->NumActorNodes = 0;
@@ -112,16 +150,19 @@ public:
     this->DeferredSceneFlush = false;
   }
 
-  vtkSmartPointer<vtkPolyDataNormals> NormalGenerator;
+  vtkSMPThreadLocal<std::shared_ptr<vtkOmniConnectThreadHelpers>> ThreadHelpers;
+  std::mutex ColorMappingMutex;
+  std::unique_ptr<vtkOmniConnectTextureEncoder> TextureEncoder;
+  std::once_flag TextureEncoderCreated;
+  std::vector<vtkViewNode*> ParallelActorNodes;
 
-  vtkOmniConnectImageWriter ImageWriter;
-  vtkOmniConnectTempArrays TempArrays;
-  bool DeferredSceneFlush = false;
+  std::atomic<bool> DeferredSceneFlush{false};
   size_t RunningActorId = 0;
   char* DefaultProgressText = nullptr;
   int NumActorNodes = 0;
-  int NumActorsProcessed = -1;
+  std::atomic<int> NumActorsProcessed{-1};
   bool GuiUpdated = false;
+  std::thread::id GuiThreadId; // Progress is only reported to the gui from the thread that traverses the scene graph
 };
 
 //============================================================================
@@ -190,8 +231,37 @@ bool vtkOmniConnectRendererNode::Initialize(const vtkOmniConnectSettings& settin
 //----------------------------------------------------------------------------
 void vtkOmniConnectRendererNode::Traverse(int operation)
 {
-  // Standard visit prepass, traverse children, visit postpass
-  this->Superclass::Traverse(operation);
+  if (operation != render)
+  {
+    // Standard visit prepass, traverse children, visit postpass
+    this->Superclass::Traverse(operation);
+    return;
+  }
+
+  this->Internals->GuiThreadId = std::this_thread::get_id();
+
+  this->Apply(operation, true);
+
+  // Actors only share the connector, which locks the stage of each actor while authoring it, so actors are converted and authored in parallel.
+  // Volumes update their input pipelines, so those (and any other nodes) are traversed serially.
+  std::vector<vtkViewNode*>& parallelNodes = this->Internals->ParallelActorNodes;
+  parallelNodes.resize(0);
+  for (vtkViewNode* child : this->GetChildren())
+  {
+    if (vtkOmniConnectActorNode::SafeDownCast(child))
+      parallelNodes.push_back(child);
+    else
+      child->Traverse(operation);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(parallelNodes.size()), 1,
+    [&parallelNodes, operation](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+        parallelNodes[i]->Traverse(operation);
+    });
+
+  this->Apply(operation, false);
 }
 
 //----------------------------------------------------------------------------
@@ -249,6 +319,9 @@ void vtkOmniConnectRendererNode::Render(bool prepass)
         this->ResetOpenGLState();
     }
 
+    if (this->Internals->TextureEncoder)
+      this->Internals->TextureEncoder->ReleaseResults();
+
     this->ResetMaterialPolicyChanged();
     this->ResetPolyDataPolicyChanged();
   }
@@ -286,6 +359,20 @@ bool vtkOmniConnectRendererNode::GetForceTimeVaryingTextures() const
   return this->ForceTimeVaryingTextures;
 }
 
+//------------------------------------------------------------------------------
+void vtkOmniConnectRendererNode::SetTextureEncoding(int encoding)
+{
+  encoding = std::min(std::max(encoding, 0), 3);
+  this->MaterialPolicyChanged = this->TextureEncoding != encoding;
+  this->TextureEncoding = encoding;
+}
+
+//------------------------------------------------------------------------------
+int vtkOmniConnectRendererNode::GetTextureEncoding() const
+{
+  return this->TextureEncoding;
+}
+
 //------------------------------------------------------------------------------
 void vtkOmniConnectRendererNode::SetForceTimeVaryingMaterialParams(bool enable)
 {
@@ -312,6 +399,25 @@ bool vtkOmniConnectRendererNode::GetForceConsistentWinding() const
   return this->ForceConsistentWinding;
 }
 
+//------------------------------------------------------------------------------
+void vtkOmniConnectRendererNode::SetLodTriangleBudgets(int lod1, int lod2, int lod3)
+{
+  // Levels go from fine to coarse, as the lod variants fall back to the next finer level that exists:
+  // order the budgets decreasingly and disable those that wouldn't reduce the previous level
+  int budgets[3] = { std::max(lod1, 0), std::max(lod2, 0), std::max(lod3, 0) };
+  std::sort(budgets, budgets + 3, std::greater<int>());
+  for (int i = 1; i < 3; ++i)
+  {
+    if (budgets[i] >= budgets[i-1])
+      budgets[i] = 0;
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    this->PolyDataPolicyChanged = this->PolyDataPolicyChanged || (this->LodTriangleBudgets[i] != budgets[i]);
+    this->LodTriangleBudgets[i] = budgets[i];
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkOmniConnectRendererNode::SetAllowWidgetActors(bool enable)
 {
@@ -359,7 +465,7 @@ void vtkOmniConnectRendererNode::SetProgressNotifier(vtkAlgorithm* progressNotif
 //------------------------------------------------------------------------------
 void vtkOmniConnectRendererNode::SetProgressText(const char* progressText)
 {
-  if(this->ProgressNotifier)
+  if(this->ProgressNotifier && std::this_thread::get_id() == this->Internals->GuiThreadId)
     this->ProgressNotifier->SetProgressText(progressText);
 }
 
@@ -370,7 +476,7 @@ void vtkOmniConnectRendererNode::SetActorProgress(double actorPercentage, bool s
     this->Internals->NumActorsProcessed++;
   
   double percentageActorsComplete = (double)this->Internals->NumActorsProcessed / (double)this->Internals->NumActorNodes;
-  if (showInGui && this->ProgressNotifier)
+  if (showInGui && this->ProgressNotifier && std::this_thread::get_id() == this->Internals->GuiThreadId)
   {
     this->ProgressNotifier->UpdateProgress(percentageActorsComplete + actorPercentage);
     this->Internals->GuiUpdated = true;
@@ -378,21 +484,33 @@ void vtkOmniConnectRendererNode::SetActorProgress(double actorPercentage, bool s
 }
 
 //------------------------------------------------------------------------------
-vtkOmniConnectImageWriter* vtkOmniConnectRendererNode::GetImageWriter()
+vtkOmniConnectTextureEncoder* vtkOmniConnectRendererNode::GetTextureEncoder()
 {
-  return &this->Internals->ImageWriter;
+  return this->Internals->GetTextureEncoder();
 }
 
 //------------------------------------------------------------------------------
 vtkPolyDataNormals* vtkOmniConnectRendererNode::GetNormalGenerator()
 {
-  return this->Internals->NormalGenerator.Get();
+  return this->Internals->GetThreadHelpers().NormalGenerator.Get();
 }
 
 //------------------------------------------------------------------------------
 vtkOmniConnectTempArrays& vtkOmniConnectRendererNode::GetTempArrays()
 {
-  return this->Internals->TempArrays;
+  return this->Internals->GetThreadHelpers().TempArrays;
+}
+
+//------------------------------------------------------------------------------
+vtkOmniConnectMeshDecimator& vtkOmniConnectRendererNode::GetMeshDecimator()
+{
+  return this->Internals->GetThreadHelpers().MeshDecimator;
+}
+
+//------------------------------------------------------------------------------
+std::mutex& vtkOmniConnectRendererNode::GetColorMappingMutex()
+{
+  return this->Internals->ColorMappingMutex;
 }
 
 //------------------------------------------------------------------------------
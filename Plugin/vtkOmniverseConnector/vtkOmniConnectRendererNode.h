@@ -27,14 +27,17 @@
 #include "vtkOmniverseConnectorModule.h" // For export macro
 #include "vtkRendererNode.h"
 
+#include <mutex>
+
 class vtkRenderer;
 class vtkOpenGLRenderWindow;
 class OmniConnect;
 struct OmniConnectEnvironment;
 class vtkOmniConnectRendererNodeInternals;
-class vtkOmniConnectImageWriter;
+class vtkOmniConnectTextureEncoder;
 class vtkInformationStringKey;
 class vtkPolyDataNormals;
+class vtkOmniConnectMeshDecimator;
 class vtkAlgorithm;
 struct vtkOmniConnectSettings;
 struct vtkOmniConnectTempArrays;
@@ -102,10 +105,20 @@ public:
   void SetForceTimeVaryingMaterialParams(bool enable); // Material parameters are replicated for every timestep, instead of having one for all timesteps
   bool GetForceTimeVaryingMaterialParams() const;
 
+  // Texture image encoding, see vtkOmniConnectImageWriter::Encoding (0: automatic, 1: uncompressed, 2: fast, 3: default)
+  void SetTextureEncoding(int encoding);
+  int GetTextureEncoding() const;
+
   // PolyData policies
   void SetForceConsistentWinding(bool enable); // Forces correct winding order on polydata (via the normalgenerator)
   bool GetForceConsistentWinding() const;
 
+  // Triangle budgets of up to three decimated levels of detail per mesh, a budget of 0 disables the level.
+  // Budgets are sorted decreasingly over the levels, with duplicates disabled.
+  void SetLodTriangleBudgets(int lod1, int lod2, int lod3);
+  const int* GetLodTriangleBudgets() const { return LodTriangleBudgets; }
+  bool HasLodTriangleBudgets() const { return LodTriangleBudgets[0] > 0 || LodTriangleBudgets[1] > 0 || LodTriangleBudgets[2] > 0; }
+
   // Actor policies
   void SetAllowWidgetActors(bool enable);
   bool GetAllowWidgetActors() const;
@@ -140,11 +153,17 @@ public:
   void SetActorProgress(double actorPercentage, bool showInGui);
 
   /**
-   * Helper structures for common operations.
+   * Helper structures for common operations. The texture encoder is shared by all threads, the others are one set per thread.
    */
-  vtkOmniConnectImageWriter* GetImageWriter();
+  vtkOmniConnectTextureEncoder* GetTextureEncoder();
   vtkPolyDataNormals* GetNormalGenerator();
   vtkOmniConnectTempArrays& GetTempArrays();
+  vtkOmniConnectMeshDecimator& GetMeshDecimator();
+
+  /**
+   * Lookup tables can be shared between actors, which are rendered in parallel.
+   */
+  std::mutex& GetColorMappingMutex();
   
   static vtkInformationStringKey* ACTORNAME();
   static vtkInformationStringKey* ACTORINPUTNAME();
@@ -168,7 +187,9 @@ protected:
   bool MergeTfIntoVol = false;
   bool ForceTimeVaryingTextures = false;
   bool ForceTimeVaryingMaterialParams = false;
+  int TextureEncoding = 0;
   bool ForceConsistentWinding = false;
+  int LodTriangleBudgets[3] = { 0, 0, 0 };
   bool AllowWidgetActors = false;
   bool LiveWorkflowEnabled = false;
 
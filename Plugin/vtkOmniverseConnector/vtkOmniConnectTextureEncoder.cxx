@@ -0,0 +1,140 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#include "vtkOmniConnectTextureEncoder.h"
+#include "vtkImageData.h"
+
+vtkOmniConnectTextureEncoder::vtkOmniConnectTextureEncoder(size_t numThreads)
+{
+  for (size_t i = 0; i < numThreads; ++i)
+    Workers.emplace_back(&vtkOmniConnectTextureEncoder::WorkerLoop, this);
+}
+
+vtkOmniConnectTextureEncoder::~vtkOmniConnectTextureEncoder()
+{
+  {
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    Stopping = true;
+  }
+  WorkAvailable.notify_all();
+
+  // Workers finish the remaining tasks before exiting, so no result is left unfulfilled
+  for (std::thread& worker : Workers)
+    worker.join();
+}
+
+vtkOmniConnectTextureEncoder::Result vtkOmniConnectTextureEncoder::Encode(vtkImageData* image, bool modifyBorder,
+  vtkOmniConnectImageWriter::Encoding encoding, bool frequentlyRewritten)
+{
+  ResultKey key(image, image->GetMTime(), modifyBorder, encoding, frequentlyRewritten);
+
+  std::unique_lock<std::mutex> lock(QueueMutex);
+
+  auto resultIt = Results.find(key);
+  if (resultIt != Results.end())
+    return resultIt->second;
+
+  EncodeTask task;
+  task.ModifyBorder = modifyBorder;
+  task.Encoding = encoding;
+  task.FrequentlyRewritten = frequentlyRewritten;
+
+  // Register the result first, so identical requests from other threads wait on it instead of encoding again
+  Result result = task.Promise.get_future().share();
+  Results.emplace(key, result);
+  lock.unlock();
+
+  // The pixels are shared, only the border modification of color maps (two rows) writes to a copy of them
+  task.Image = vtkSmartPointer<vtkImageData>::New();
+  if (modifyBorder)
+    task.Image->DeepCopy(image);
+  else
+    task.Image->ShallowCopy(image);
+
+  if (Workers.empty())
+  {
+    // No worker threads, encode synchronously
+    vtkOmniConnectImageWriter writer;
+    EncodeImage(writer, task);
+    return result;
+  }
+
+  lock.lock();
+  PendingTasks.push_back(std::move(task));
+
+  lock.unlock();
+  WorkAvailable.notify_one();
+
+  return result;
+}
+
+void vtkOmniConnectTextureEncoder::ReleaseResults()
+{
+  std::unique_lock<std::mutex> lock(QueueMutex);
+  Results.clear();
+}
+
+void vtkOmniConnectTextureEncoder::EncodeImage(vtkOmniConnectImageWriter& writer, EncodeTask& task)
+{
+  EncodedImage encodedImage;
+
+  writer.SetModifyBorder(task.ModifyBorder); //is a hack, operates on the copy
+  writer.SetEncoding(task.Encoding, task.FrequentlyRewritten);
+  if (writer.WriteData(task.Image.Get()))
+  {
+    char* imageData; int imageLength;
+    writer.GetResult(imageData, imageLength);
+    encodedImage.assign(imageData, imageData + imageLength);
+  }
+  writer.SetModifyBorder(false);
+
+  // Release the copy before waking up the consumer
+  task.Image = nullptr;
+  task.Promise.set_value(std::move(encodedImage));
+}
+
+void vtkOmniConnectTextureEncoder::WorkerLoop()
+{
+  vtkOmniConnectImageWriter writer;
+
+  std::unique_lock<std::mutex> lock(QueueMutex);
+  while (true)
+  {
+    if (!PendingTasks.empty())
+    {
+      EncodeTask task = std::move(PendingTasks.front());
+      PendingTasks.pop_front();
+
+      lock.unlock();
+      EncodeImage(writer, task);
+      lock.lock();
+      continue;
+    }
+
+    if (Stopping)
+      break;
+
+    WorkAvailable.wait(lock);
+  }
+}
@@ -0,0 +1,85 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#ifndef vtkOmniConnectTextureEncoder_h
+#define vtkOmniConnectTextureEncoder_h
+
+#include "vtkOmniConnectImageWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkType.h"
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+class vtkImageData;
+
+// Encodes texture images on a pool of worker threads, each with its own image writer, so encoding overlaps with geometry authoring.
+// Requests for the same image at an unchanged MTime and with identical settings share a single encode until ReleaseResults().
+class vtkOmniConnectTextureEncoder
+{
+public:
+  using EncodedImage = std::vector<char>; // Empty if the image could not be written
+  using Result = std::shared_future<EncodedImage>;
+
+  vtkOmniConnectTextureEncoder(size_t numThreads);
+  ~vtkOmniConnectTextureEncoder();
+
+  // The image structure is copied before returning, so the caller may change or release it immediately,
+  // but its pixels are shared until the result is ready and must not be modified in place before then.
+  Result Encode(vtkImageData* image, bool modifyBorder, vtkOmniConnectImageWriter::Encoding encoding, bool frequentlyRewritten);
+
+  // Forgets earlier requests for deduplication; results that have been handed out remain valid.
+  void ReleaseResults();
+
+protected:
+  struct EncodeTask
+  {
+    vtkSmartPointer<vtkImageData> Image;
+    bool ModifyBorder = false;
+    vtkOmniConnectImageWriter::Encoding Encoding = vtkOmniConnectImageWriter::Encoding::AUTOMATIC;
+    bool FrequentlyRewritten = false;
+    std::promise<EncodedImage> Promise;
+  };
+  using ResultKey = std::tuple<vtkImageData*, vtkMTimeType, bool, vtkOmniConnectImageWriter::Encoding, bool>;
+
+  static void EncodeImage(vtkOmniConnectImageWriter& writer, EncodeTask& task);
+  void WorkerLoop();
+
+  std::mutex QueueMutex;
+  std::condition_variable WorkAvailable;
+
+  std::deque<EncodeTask> PendingTasks;
+  std::map<ResultKey, Result> Results;
+  bool Stopping = false;
+
+  std::vector<std::thread> Workers;
+};
+
+#endif
@@ -27,73 +27,121 @@
 #include "vtkOmniConnectPassArrays.h"
 #include "vtkOmniConnectTemporalArrays.h"
 #include "OmniConnectUtilsExternal.h"
+#include "OmniConnectUtilsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkPolyData.h"
+#include "vtkCellArray.h"
 #include "vtkFieldData.h"
 #include "vtkPointData.h"
 #include "vtkCellData.h"
 #include "vtkMatrix4x4.h"
 #include <cstring>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 
 const char* vtkOmniConnectGenericPointArrayPrefix = "pv_point_";
 const char* vtkOmniConnectGenericCellArrayPrefix = "pv_cell_";
 
 namespace
 {
+  // Formatted usd names of the generic arrays, interned so array entries can be identified by id.
+  // Prefixed source names map to the id of their formatted name, so FormatUsdName only runs once per distinct source name.
+  struct ArrayNameTable
+  {
+    std::mutex Mutex;
+    std::deque<std::string> Names; // Stable storage, as names are handed out to OmniConnectGenericArray
+    std::unordered_map<std::string, size_t> NameIds;
+    std::unordered_map<std::string, size_t> SourceNameIds;
+  };
+
+  ArrayNameTable& GetArrayNameTable()
+  {
+    static ArrayNameTable nameTable;
+    return nameTable;
+  }
+
+  size_t InternArrayName(const char* namePrefix, const char* sourceName)
+  {
+    thread_local std::string sourceKey;
+    sourceKey.assign(namePrefix);
+    sourceKey += sourceName;
+
+    ArrayNameTable& nameTable = GetArrayNameTable();
+    std::lock_guard<std::mutex> lock(nameTable.Mutex);
+
+    auto sourceIt = nameTable.SourceNameIds.find(sourceKey);
+    if (sourceIt != nameTable.SourceNameIds.end())
+      return sourceIt->second;
+
+    std::string arrayName(sourceKey);
+    ocutils::FormatUsdName(const_cast<char*>(arrayName.data())); // Could pass library boundaries, so char*
+
+    auto itSuccessPair = nameTable.NameIds.emplace(arrayName, nameTable.Names.size());
+    if (itSuccessPair.second)
+      nameTable.Names.push_back(arrayName);
+    size_t nameId = itSuccessPair.first->second;
+
+    nameTable.SourceNameIds.emplace(sourceKey, nameId);
+    return nameId;
+  }
+
   void UpdateArraysFromFieldData(vtkFieldData* fieldData, vtkOmniConnectTimeStep::DataEntry& dataEntry, bool cellArray, bool useNamePrefix, std::function< bool(vtkDataArray* arr)> AdmittedArrays)
   {
     const char* namePrefix = useNamePrefix ? 
       (cellArray ? vtkOmniConnectGenericCellArrayPrefix : vtkOmniConnectGenericPointArrayPrefix) :
       "";
 
+    std::vector<vtkOmniConnectTimeStep::ArrayEntry>& arrayEntries = dataEntry.GenericArrays;
+
     for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
     {
       vtkDataArray* genArray = fieldData->GetArray(i);
+      if (!genArray)
+        continue;
 
       // First try to trivially retrieve the array
-      auto arrayEntryIt = dataEntry.GenericArrays.begin();
-      for (; arrayEntryIt != dataEntry.GenericArrays.end(); ++arrayEntryIt)
-      {
-        if (arrayEntryIt->second.DataArray == genArray)
-          break;
-      }
+      auto arrayEntryIt = std::find_if(arrayEntries.begin(), arrayEntries.end(),
+        [genArray](const vtkOmniConnectTimeStep::ArrayEntry& entry) { return entry.DataArray == genArray; });
 
-      if (arrayEntryIt == dataEntry.GenericArrays.end())
+      if (arrayEntryIt == arrayEntries.end())
       {
         //Not trivially retrievable, so have to search by name
-        if (AdmittedArrays(genArray))
+        if (!AdmittedArrays(genArray))
+          continue;
+
+        size_t nameId = InternArrayName(namePrefix, genArray->GetName());
+        arrayEntryIt = std::find_if(arrayEntries.begin(), arrayEntries.end(),
+          [nameId](const vtkOmniConnectTimeStep::ArrayEntry& entry) { return entry.NameId == nameId; });
+
+        if (arrayEntryIt == arrayEntries.end())
         {
-          std::string arrayName(namePrefix);
-          arrayName += genArray->GetName();
-
-          ocutils::FormatUsdName(const_cast<char*>(arrayName.data())); // Could pass library boundaries, so char*
-
-          vtkOmniConnectTimeStep::ArrayEntry newEntry = { genArray, genArray->GetMTime(), cellArray, OmniConnectStatusType::UPDATE };
-          auto itSuccessPair = dataEntry.GenericArrays.emplace(arrayName, newEntry);
-
-          if (!itSuccessPair.second)
-          {
-            vtkOmniConnectTimeStep::ArrayEntry& arrayEntry = itSuccessPair.first->second; // The Entry-part (second) of the iterator (first) in the successPair
-            arrayEntry.DataArray = genArray;
-            arrayEntry.Status = (genArray->GetMTime() != arrayEntry.MTime) ? 
-              OmniConnectStatusType::UPDATE : 
-              OmniConnectStatusType::KEEP;
-            arrayEntry.MTime = genArray->GetMTime();
-          }
+          vtkOmniConnectTimeStep::ArrayEntry newEntry = { genArray, genArray->GetMTime(), cellArray, OmniConnectStatusType::UPDATE, nameId };
+          arrayEntries.push_back(newEntry);
+          continue;
         }
+        arrayEntryIt->DataArray = genArray;
       }
-      else
-      {
-        //Optimized path that doesn't have to perform a name search
-        vtkOmniConnectTimeStep::ArrayEntry& arrayEntry = arrayEntryIt->second;
-        arrayEntry.Status = (genArray->GetMTime() != arrayEntry.MTime) ?
-          OmniConnectStatusType::UPDATE :
-          OmniConnectStatusType::KEEP;
-        arrayEntry.MTime = genArray->GetMTime();
-      }
+
+      vtkOmniConnectTimeStep::ArrayEntry& arrayEntry = *arrayEntryIt;
+      arrayEntry.Status = (genArray->GetMTime() != arrayEntry.MTime) ?
+        OmniConnectStatusType::UPDATE :
+        OmniConnectStatusType::KEEP;
+      arrayEntry.MTime = genArray->GetMTime();
+    }
+  }
+
+  void HashCellArray(vtkCellArray* cells, uint64_t hash[2])
+  {
+    vtkDataArray* arrays[2] = { cells->GetOffsetsArray(), cells->GetConnectivityArray() };
+    for (vtkDataArray* arr : arrays)
+    {
+      size_t numBytes = (size_t)arr->GetNumberOfValues() * arr->GetDataTypeSize();
+      ocutils::HashBytes128(numBytes ? arr->GetVoidPointer(0) : nullptr, numBytes, hash);
     }
   }
 
@@ -115,30 +163,35 @@ namespace
 void vtkOmniConnectTimeStep::ResetDataEntryCache()
 {
   // Toggle all polyentries to be removed, from here on any polydata caches that should be kept have to be marked explicitly.
-  for (auto& dataEntry : this->DataEntryMap)
+  for (DataEntry& dataEntry : this->DataEntries)
   {
-    dataEntry.second.Active = false;
+    dataEntry.Active = false;
   }
 }
 
 void vtkOmniConnectTimeStep::KeepDataEntryCache()
 {
   // Keep polyentries
-  for (auto& dataEntry : this->DataEntryMap)
+  for (DataEntry& dataEntry : this->DataEntries)
   {
-    dataEntry.second.Active = true;
+    dataEntry.Active = true;
   }
 }
 
 void vtkOmniConnectTimeStep::CleanupDataEntryCache()
 {
-  // push all removed polydatas into the delete queue and remove them from map
-  for (auto it = this->DataEntryMap.begin(); it != this->DataEntryMap.end(); )
+  // Release all removed polydata entries; their slots (and array entry storage) are reused by later updates
+  for (DataEntry& dataEntry : this->DataEntries)
   {
-    if (it->second.Active)
-      ++it;
-    else
-      it = this->DataEntryMap.erase(it);
+    if (dataEntry.Present && !dataEntry.Active)
+    {
+      dataEntry.Present = false;
+      dataEntry.DataSet = nullptr;
+      dataEntry.GenericArrays.clear();
+      dataEntry.ConnectivityMTime[0] = dataEntry.ConnectivityMTime[1] = 0;
+      dataEntry.Topology = vtkOmniConnectMeshTopology();
+      --this->NumDataEntries;
+    }
   }
 }
 
@@ -183,12 +236,21 @@ bool vtkOmniConnectTimeStep::UpdateDataEntry(vtkDataSet* dataSet, size_t dataEnt
   vtkMTimeType fieldMTime = temporalArrays ? temporalArrays->GetMTime() : 0;
   forceArrayUpdate = false;
 
-  DataEntry newEntry = { dataSet, dataSet->GetMTime(), fieldMTime, true };
-  auto itSuccessPair = this->DataEntryMap.emplace(dataEntryId, newEntry);
+  if (dataEntryId >= this->DataEntries.size())
+    this->DataEntries.resize(dataEntryId + 1);
 
-  DataEntry& dataEntry = itSuccessPair.first->second;
-  bool entryUpdated = itSuccessPair.second;
-  if (!entryUpdated) // Entry was already present
+  DataEntry& dataEntry = this->DataEntries[dataEntryId];
+  bool entryUpdated = !dataEntry.Present;
+  if (entryUpdated)
+  {
+    dataEntry.DataSet = dataSet;
+    dataEntry.MTime = dataSet->GetMTime();
+    dataEntry.FieldMTime = fieldMTime;
+    dataEntry.Active = true;
+    dataEntry.Present = true;
+    ++this->NumDataEntries;
+  }
+  else // Entry was already present
   {
     forceArrayUpdate = dataEntry.FieldMTime != fieldMTime;
     dataEntry.FieldMTime = fieldMTime;
@@ -205,9 +267,9 @@ bool vtkOmniConnectTimeStep::UpdateDataEntry(vtkDataSet* dataSet, size_t dataEnt
   if (entryUpdated)
   {
     // Set all generic arrays to Remove, then update the status as they appear in the pass arrays filter
-    for (auto& entry : dataEntry.GenericArrays)
+    for (ArrayEntry& entry : dataEntry.GenericArrays)
     {
-      entry.second.Status = OmniConnectStatusType::REMOVE;
+      entry.Status = OmniConnectStatusType::REMOVE;
     }
 
     vtkDataArray* passArrays = dataSet->GetFieldData()->GetArray(vtkOmniConnectPassArrays::PassArraysFlagName);
@@ -220,6 +282,32 @@ bool vtkOmniConnectTimeStep::UpdateDataEntry(vtkDataSet* dataSet, size_t dataEnt
   return entryUpdated;
 }
 
+void vtkOmniConnectTimeStep::UpdateConnectivityHash(size_t dataEntryId, vtkPolyData* polyData, uint64_t connectivityHash[2])
+{
+  assert(dataEntryId < this->DataEntries.size());
+  DataEntry& dataEntry = this->DataEntries[dataEntryId];
+
+  vtkCellArray* polys = polyData->GetPolys();
+  vtkCellArray* strips = polyData->GetStrips();
+  vtkMTimeType polysMTime = polys->GetMTime();
+  vtkMTimeType stripsMTime = strips->GetMTime();
+
+  if (polysMTime != dataEntry.ConnectivityMTime[0] || stripsMTime != dataEntry.ConnectivityMTime[1])
+  {
+    dataEntry.ConnectivityMTime[0] = polysMTime;
+    dataEntry.ConnectivityMTime[1] = stripsMTime;
+
+    uint64_t hash[2] = { 0, 0 };
+    HashCellArray(polys, hash);
+    HashCellArray(strips, hash);
+    dataEntry.ConnectivityHash[0] = hash[0];
+    dataEntry.ConnectivityHash[1] = hash[1];
+  }
+
+  connectivityHash[0] = dataEntry.ConnectivityHash[0];
+  connectivityHash[1] = dataEntry.ConnectivityHash[1];
+}
+
 void vtkOmniConnectTimeStep::UpdateGenericArrayCache(DataEntry& dataEntry, int genericArrayFilter, bool useNamePrefix)
 {
   assert(genericArrayFilter < 2);
@@ -256,14 +344,13 @@ void vtkOmniConnectTimeStep::GetUpdatedDeletedGenericArrays(size_t dataEntryId,
   updatedArrays.resize(0);
   deletedArrays.resize(0);
 
-  DataEntry& dataEntry = DataEntryMap.find(dataEntryId)->second;
+  DataEntry& dataEntry = DataEntries[dataEntryId];
 
   vtkUnsignedLongLongArray* temporalArrays = vtkUnsignedLongLongArray::SafeDownCast(dataEntry.DataSet->GetFieldData()->GetArray(vtkOmniConnectTemporalArrays::TemporalArraysFlagName));
 
-  for (auto& x : dataEntry.GenericArrays)
+  for (ArrayEntry& arrayEntry : dataEntry.GenericArrays)
   {
-    ArrayEntry& arrayEntry = x.second;
-    const char* arrayName = x.first.c_str();
+    const char* arrayName = GetArrayName(arrayEntry.NameId);
 
     if ( arrayEntry.Status == OmniConnectStatusType::UPDATE ||
         (arrayEntry.Status == OmniConnectStatusType::KEEP && forceArrayUpdate) // Even though array is unchanged, its uniformity might have
@@ -292,7 +379,7 @@ void vtkOmniConnectTimeStep::GetUpdatedDeletedGenericArrays(size_t dataEntryId,
       else
       {
         std::string errorMsg("Array type not supported for ");
-        errorMsg.append(x.first.c_str());
+        errorMsg.append(arrayName);
         vtkOmniConnectLogCallback::Callback(OmniConnectLogLevel::ERR, nullptr, errorMsg.c_str());
       }
     }
@@ -311,21 +398,20 @@ void vtkOmniConnectTimeStep::GetUpdatedDeletedGenericArrays(size_t dataEntryId,
 
 void vtkOmniConnectTimeStep::CleanupGenericArrayCache(size_t dataEntryId)
 {
-  auto omniDataMapIt = this->DataEntryMap.find(dataEntryId);
-  DataEntry& dataEntry = omniDataMapIt->second;
+  DataEntry& dataEntry = this->DataEntries[dataEntryId];
 
   // delete all non-processed arrays
-  for (auto it = dataEntry.GenericArrays.begin(); it != dataEntry.GenericArrays.end(); )
-  {
-    if (it->second.Status != OmniConnectStatusType::REMOVE)
-    {
-      ++it;
-    }
-    else
-    {
-      it = dataEntry.GenericArrays.erase(it);
-    }
-  }
+  dataEntry.GenericArrays.erase(
+    std::remove_if(dataEntry.GenericArrays.begin(), dataEntry.GenericArrays.end(),
+      [](const ArrayEntry& entry) { return entry.Status == OmniConnectStatusType::REMOVE; }),
+    dataEntry.GenericArrays.end());
+}
+
+const char* vtkOmniConnectTimeStep::GetArrayName(size_t nameId)
+{
+  ArrayNameTable& nameTable = GetArrayNameTable();
+  std::lock_guard<std::mutex> lock(nameTable.Mutex);
+  return nameTable.Names[nameId].c_str();
 }
 
 bool vtkOmniConnectTimeStep::UpdateTransform(vtkMatrix4x4* mat)
@@ -24,6 +24,7 @@
 #ifndef vtkOmniConnectTimeStep_h
 #define vtkOmniConnectTimeStep_h
 
+#include "vtkOmniverseConnectorModule.h" // For export macro
 #include "OmniConnect.h"
 #include "vtkUnsignedLongLongArray.h"
 #include "vtkOmniConnectVtkToOmni.h"
@@ -33,6 +34,7 @@
 
 class vtkDataObject;
 class vtkDataSet;
+class vtkPolyData;
 class vtkMatrix4x4;
 class vtkCompositeDataDisplayAttributes;
 struct OmniConnectGenericArray;
@@ -47,6 +49,7 @@ struct vtkOmniConnectTempArrays
   std::vector<unsigned int> IndexArray;
   std::vector<unsigned int> IndexToCell;
   std::vector<int> VertexToCell;
+  std::vector<vtkIdType> CellIndexOffsets;
   std::vector<float> PerPrimNormal;
   std::vector<unsigned char> PerPrimColor;
   std::vector<int> CurveLengths;
@@ -147,7 +150,18 @@ struct vtkOmniConnectTempArrays
   }
 };
 
-struct vtkOmniConnectTimeStep
+// Mesh connectivity as written to the connector, either for a single timestep or for a geometry as a whole.
+// Per geometry, connectivity is written as a single non-timevarying copy, until a timestep turns out to differ (see vtkOmniConnectActorCache).
+struct vtkOmniConnectMeshTopology
+{
+  uint64_t Hash[2] = { 0, 0 };
+  size_t NumIndices = 0;
+  bool Written = false;
+  bool TimeVarying = false;
+  int LodLevels = 0; // Per timestep, bit (level-1) is set for every decimated level of detail that has been written
+};
+
+struct VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectTimeStep
 {
   struct ArrayEntry
   {
@@ -155,6 +169,7 @@ struct vtkOmniConnectTimeStep
     vtkMTimeType MTime = 0;
     bool CellArray = false;
     OmniConnectStatusType Status; 
+    size_t NameId = 0; // Interned, formatted usd name of the array, see GetArrayName()
   };
 
   struct DataEntry
@@ -163,7 +178,11 @@ struct vtkOmniConnectTimeStep
     vtkMTimeType MTime = 0;
     vtkMTimeType FieldMTime = 0;
     bool Active = true;
-    std::map<std::string, ArrayEntry> GenericArrays;
+    bool Present = false; // Whether the slot in DataEntries is in use
+    vtkMTimeType ConnectivityMTime[2] = { 0, 0 }; // MTimes of the polys and strips hashed into ConnectivityHash
+    uint64_t ConnectivityHash[2] = { 0, 0 };
+    vtkOmniConnectMeshTopology Topology; // Connectivity as last written for this timestep
+    std::vector<ArrayEntry> GenericArrays; // Searched linearly on array pointer or name id, as datasets carry few arrays
   };
  
   void ResetDataEntryCache();
@@ -173,15 +192,20 @@ struct vtkOmniConnectTimeStep
   bool HasInputChanged(vtkDataObject* dataInput, vtkCompositeDataDisplayAttributes* cda = nullptr); // Shortcut that evaluates whether any of the data entries or their composition could have changed
   bool UpdateDataEntry(vtkDataSet* dataSet, size_t dataEntryId, bool forceUpdate, bool& forceArrayUpdate, int genericArrayFilter = -1, bool useNamePrefix = true); // genericArrayFilter: 0==points, 1==cells, -1==all
 
+  void UpdateConnectivityHash(size_t dataEntryId, vtkPolyData* polyData, uint64_t connectivityHash[2]); // Hashes polys and strips, only when their MTime has changed since the last call
+
   void UpdateGenericArrayCache(DataEntry& dataEntry, int genericArrayFilter, bool useNamePrefix);
   void GetUpdatedDeletedGenericArrays(size_t dataEntryId, vtkOmniConnectGenericArrayList& updatedArrays, vtkOmniConnectGenericArrayList& deletedArrays, bool forceArrayUpdate);
   void CleanupGenericArrayCache(size_t dataEntryId);
 
   bool UpdateTransform(vtkMatrix4x4* mat);
 
-  size_t GetNumDataEntries() const { return DataEntryMap.size(); }
+  size_t GetNumDataEntries() const { return NumDataEntries; }
+
+  static const char* GetArrayName(size_t nameId); // Valid for the lifetime of the process
 
-  std::map< size_t, DataEntry > DataEntryMap; // Detect per-dataset/per array changes
+  std::vector<DataEntry> DataEntries; // Detect per-dataset/per array changes, indexed by dataEntryId (flat block index)
+  size_t NumDataEntries = 0;
   vtkMTimeType InputMTime = 0; // MTime over all data input (datasets) for the timestep together, including changes to the set/tree of datasets itself 
   vtkMTimeType VtkTransformMTime = 0; // Detect a change in transforms
   // ..material-related data
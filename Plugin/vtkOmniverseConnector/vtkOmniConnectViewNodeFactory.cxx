@@ -120,7 +120,7 @@ vtkOmniConnectViewNodeFactory::vtkOmniConnectViewNodeFactory()
   this->RegisterOverride("vtkOpenGLPolyDataMapper", pd_maker);
   this->RegisterOverride("vtkCompositePolyDataMapper", cpd_maker);
   this->RegisterOverride("vtkSmartVolumeMapper", vm_maker);
-  this->RegisterOverride("vtkMultiBlockVolumeMapper", vm_maker);
+  this->RegisterOverride("vtkMultiBlockVolumeMapper", mbvm_maker);
   this->RegisterOverride("vtkOSPRayVolumeMapper", vm_maker);
   this->RegisterOverride("vtkOpenGLGPUVolumeRayCastMapper", vm_maker);
   this->RegisterOverride("vtkPVImageSliceMapper", ism_maker);
@@ -30,6 +30,7 @@
 #include "vtkOmniConnectActorCache.h"
 #include "vtkOmniConnectTextureCache.h"
 #include "vtkOmniConnectTimeStep.h"
+#include "OmniConnectProfiler.h"
 #include "vtkVolume.h"
 #include "vtkFieldData.h"
 #include "vtkColorTransferFunction.h"
@@ -45,6 +46,10 @@
 #include "vtkCellData.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 namespace
 {
@@ -90,9 +95,48 @@ namespace
     return matchingIdx;
   }
 
-  void GatherVolumeData(OmniConnectVolumeData& omniVolumeData, vtkImageData* vtkVolData, vtkDataArray* volArray, vtkFloatArray* flattenedArray, vtkVolumeProperty* volProperty, int cellFlag,
+  // Copies volArray with the cells refined by a finer AMR level (or hidden) set to the value of least opacity, so they become
+  // background of the volume and only the finest level covering a region is visible. Returns the first blanked index, or -1.
+  vtkIdType BlankRefinedCells(vtkDataArray*& volArray, vtkDataArray* ghostData, vtkSmartPointer<vtkDataArray>& blankedArray,
+    const std::vector<float>& TfOValues, double* tfRange)
+  {
+    vtkUnsignedCharArray* ghostCharData = vtkUnsignedCharArray::SafeDownCast(ghostData);
+    vtkIdType numValues = volArray->GetNumberOfTuples();
+    const unsigned char blankMask = vtkDataSetAttributes::REFINEDCELL | vtkDataSetAttributes::HIDDENCELL;
+    if (!ghostCharData || ghostCharData->GetNumberOfTuples() != numValues || volArray->GetNumberOfComponents() != 1)
+      return -1;
+
+    vtkIdType firstBlankedIdx = -1;
+    for (vtkIdType i = 0; i < numValues && firstBlankedIdx == -1; ++i)
+    {
+      if (ghostCharData->GetValue(i) & vtkDataSetAttributes::REFINEDCELL)
+        firstBlankedIdx = i;
+    }
+    if (firstBlankedIdx == -1)
+      return -1;
+
+    size_t minOpacityIdx = std::min_element(TfOValues.begin(), TfOValues.end()) - TfOValues.begin();
+    double blankValue = tfRange[0] + (tfRange[1] - tfRange[0]) * minOpacityIdx / std::max(TfOValues.size() - 1, size_t(1));
+
+    if (!blankedArray || blankedArray->GetDataType() != volArray->GetDataType())
+      blankedArray = vtkSmartPointer<vtkDataArray>::Take(volArray->NewInstance());
+    blankedArray->DeepCopy(volArray);
+    for (vtkIdType i = firstBlankedIdx; i < numValues; ++i)
+    {
+      if (ghostCharData->GetValue(i) & blankMask)
+        blankedArray->SetTuple1(i, blankValue);
+    }
+
+    volArray = blankedArray;
+    return firstBlankedIdx;
+  }
+
+  void GatherVolumeData(OmniConnectVolumeData& omniVolumeData, vtkImageData* vtkVolData, vtkDataArray* volArray, vtkFloatArray* flattenedArray,
+    vtkSmartPointer<vtkDataArray>& blankedArray, vtkVolumeProperty* volProperty, int cellFlag,
     const std::vector<float>& TfValues, const std::vector<float>& TfOValues, double* tfRange)
   {
+    OMNICONNECT_PROFILE_SCOPE("Gather");
+
     // Find the background value
     vtkIdType backgroundIdx = -1;
     {
@@ -134,6 +178,15 @@ namespace
       volArray = flattenedArray;
     }
 
+    // Overlapping AMR levels mark the cells covered by finer levels, which are blanked instead of rendered twice
+    if (cellFlag == 1)
+    {
+      vtkDataArray* cellGhostData = vtkVolData->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName());
+      vtkIdType blankedIdx = cellGhostData ? BlankRefinedCells(volArray, cellGhostData, blankedArray, TfOValues, tfRange) : -1;
+      if (blankedIdx != -1)
+        backgroundIdx = blankedIdx;
+    }
+
     // Set the volume data from volArray
     omniVolumeData.Data = volArray->GetVoidPointer(0);
     omniVolumeData.DataType = GetOmniConnectType(volArray);
@@ -165,21 +218,26 @@ namespace
   }
 }
 
+//============================================================================
+struct vtkOmniConnectVolumeBlock
+{
+  vtkImageData* VolData = nullptr;
+  vtkDataArray* VolArray = nullptr;
+  int CellFlag = 0;
+  size_t DataEntryId = 0;
+  bool Updated = false;
+  vtkOmniConnectGenericArrayList UpdatedGenericArrays;
+  vtkOmniConnectGenericArrayList DeletedGenericArrays;
+  vtkSmartPointer<vtkFloatArray> FlattenedArray;
+  vtkSmartPointer<vtkDataArray> BlankedArray; // Copy of the (flattened) array with refined AMR cells blanked
+  OmniConnectVolumeData VolumeData;
+};
+
 //============================================================================
 class vtkOmniConnectVolumeMapperNodeInternals
 {
 public:
 
-  vtkOmniConnectVolumeMapperNodeInternals()
-  {
-    FlattenedArray = vtkFloatArray::New();
-  }
-
-  ~vtkOmniConnectVolumeMapperNodeInternals()
-  {
-    FlattenedArray->Delete();
-  }
-
   std::vector<size_t> MaterialIds;
   bool ScalarModeChanged = false;
   bool VectorModeChanged = false;
@@ -187,7 +245,7 @@ public:
   int LastScalarMode = -1;
   int LastVectorMode = -1;
   int LastVectorComponent = -1;
-  vtkFloatArray* FlattenedArray = nullptr;
+  std::vector<vtkOmniConnectVolumeBlock> Blocks; // Kept across renders, to reuse the flattened arrays
 };
 
 //============================================================================
@@ -219,6 +277,17 @@ void vtkOmniConnectVolumeMapperNode::Build(bool prepass)
 {
 }
 
+//------------------------------------------------------------------------------
+void vtkOmniConnectVolumeMapperNode::GatherVolumeInputs(vtkDataObject* dataInput, std::vector<VolumeInput>& volInputs)
+{
+  if (vtkImageData* volData = vtkImageData::SafeDownCast(dataInput))
+  {
+    VolumeInput volInput;
+    volInput.VolData = volData;
+    volInputs.push_back(volInput);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkOmniConnectVolumeMapperNode::ResetMaterialIds()
 {
@@ -267,25 +336,45 @@ void vtkOmniConnectVolumeMapperNode::UpdateVolSpecificChanges(vtkVolumeMapper* m
 
 
 //----------------------------------------------------------------------------
-void vtkOmniConnectVolumeMapperNode::RenderVolume(vtkOmniConnectActorNodeBase* aNode, vtkVolume* actor, vtkVolumeMapper* mapper, vtkImageData* volData, size_t dataEntryId, size_t materialId)
+void vtkOmniConnectVolumeMapperNode::RenderVolumes(vtkOmniConnectActorNodeBase* aNode, vtkVolume* actor, vtkVolumeMapper* mapper, const std::vector<VolumeInput>& volInputs, size_t materialId)
 {
   // Some standard stuff
   vtkOmniConnectRendererNode* rNode = vtkOmniConnectRendererNode::GetRendererNode(this);
   OmniConnect* connector = rNode->GetOmniConnector();
   size_t actorId = aNode->GetActorId();
-  size_t volGeomId = dataEntryId; // Usd geomId equivalent to vtk dataEntryId
   double animTimeStep = actor->GetPropertyKeys() ? actor->GetPropertyKeys()->Get(vtkDataObject::DATA_TIME_STEP()) : 0.0f;
   vtkOmniConnectTimeStep* omniTimeStep = aNode->GetTimeStep(animTimeStep);
   bool scalarModeChanged = this->Internals->ScalarModeChanged;
   bool vectorModeChanged = this->Internals->VectorModeChanged;
   bool vectorComponentChanged = this->Internals->VectorComponentChanged;
 
-  int cellFlag; // 0: per-points, 1: per-cell, 2: generic field arrays
-  vtkDataArray* volArray = vtkDataArray::SafeDownCast(this->GetArrayToProcess(volData, cellFlag));
-  if (!volArray || cellFlag >= 2)
+  // Find the arrays to process, all blocks share a single material
+  std::vector<vtkOmniConnectVolumeBlock>& blocks = this->Internals->Blocks;
+  size_t numBlocks = 0;
+  double volRange[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (const VolumeInput& volInput : volInputs)
+  {
+    int cellFlag; // 0: per-points, 1: per-cell, 2: generic field arrays
+    vtkDataArray* volArray = vtkDataArray::SafeDownCast(this->GetArrayToProcess(volInput.VolData, cellFlag));
+    if (!volArray || cellFlag >= 2)
+      continue;
+
+    if (numBlocks == blocks.size())
+      blocks.emplace_back();
+    vtkOmniConnectVolumeBlock& block = blocks[numBlocks++];
+    block.VolData = volInput.VolData;
+    block.VolArray = volArray;
+    block.CellFlag = cellFlag;
+    block.DataEntryId = volInput.DataEntryId;
+    block.Updated = false;
+
+    double* arrayRange = volArray->GetRange();
+    volRange[0] = std::min(volRange[0], arrayRange[0]);
+    volRange[1] = std::max(volRange[1], arrayRange[1]);
+  }
+  if (numBlocks == 0)
     return;
 
-  double* volRange = volArray->GetRange();
   vtkVolumeProperty* volProperty = actor->GetProperty(); // Required for GatherVolumeData() as well
 
   //
@@ -307,7 +396,7 @@ void vtkOmniConnectVolumeMapperNode::RenderVolume(vtkOmniConnectActorNodeBase* a
         OmniConnectMaterialData omniMatData;
         SetUpdatesToPerform(omniMatData, rNode->GetForceTimeVaryingMaterialParams());
 
-        GatherMaterialData(omniMatData, materialId, volArray, this->TfValues, this->TfOValues, this->TfRange);
+        GatherMaterialData(omniMatData, materialId, blocks[0].VolArray, this->TfValues, this->TfOValues, this->TfRange);
 
         connector->UpdateMaterial(actorId, omniMatData, animTimeStep);
         this->Internals->MaterialIds.push_back(materialId);
@@ -320,57 +409,79 @@ void vtkOmniConnectVolumeMapperNode::RenderVolume(vtkOmniConnectActorNodeBase* a
   aNode->SetSubGeomProgress(0.2);
 
   //
-  // Create/update material entry in cache and send to connector
+  // Create/update the volume data with corresponding id in cache and send to connector
   //
-  // Add usd geom entry (geomId)
-  bool newVolGeom = aNode->AddTransferredGeometry(volGeomId, OmniConnectGeomType::VOLUME); 
-
-  // Make sure the vtk cache entry is kept alive
   bool forceVolDataUpdate = aNode->GetMaterialsChanged() || vectorModeChanged || vectorComponentChanged || scalarModeChanged; // MaterialsChanged() can be removed once tf is separated out of volData update
-  bool forceArrayUpdate = false;
-  bool updateVolData = omniTimeStep->UpdateDataEntry(volData, volGeomId, forceVolDataUpdate, forceArrayUpdate, cellFlag, false); // Only add arrays which correspond in celltype to volArray
+  for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+  {
+    vtkOmniConnectVolumeBlock& block = blocks[blockIdx];
+    size_t volGeomId = block.DataEntryId; // Usd geomId equivalent to vtk dataEntryId
 
-  // Update double to float conversion setting specifically for the dataset currently processed
-  SetConvertGenericArraysDoubleToFloat(connector, volData, true);
+    // Add usd geom entry (geomId)
+    aNode->AddTransferredGeometry(volGeomId, OmniConnectGeomType::VOLUME);
 
-  if (updateVolData)
-  {
-    vtkOmniConnectTempArrays& tempArrays = rNode->GetTempArrays();
+    // Make sure the vtk cache entry is kept alive
+    bool forceArrayUpdate = false;
+    block.Updated = omniTimeStep->UpdateDataEntry(block.VolData, block.DataEntryId, forceVolDataUpdate, forceArrayUpdate, block.CellFlag, false); // Only add arrays which correspond in celltype to volArray
+    if (!block.Updated)
+      continue;
 
     forceArrayUpdate = true; // Always update, since the generic arrays are written into the VDBs, which are always completely rewritten anyway
       //forceArrayUpdate || newVolGeom || scalarModeChanged;
 
     // Extract updated and deleted generic arrays from vtk
-    omniTimeStep->GetUpdatedDeletedGenericArrays(dataEntryId,
-      tempArrays.UpdatedGenericArrays,
-      tempArrays.DeletedGenericArrays,
+    omniTimeStep->GetUpdatedDeletedGenericArrays(block.DataEntryId,
+      block.UpdatedGenericArrays,
+      block.DeletedGenericArrays,
       forceArrayUpdate);
 
-    aNode->SetSubGeomProgress(0.4);
+    block.VolumeData = OmniConnectVolumeData();
+    block.VolumeData.VolumeId = volGeomId;
+    block.VolumeData.preClassified = rNode->GetMergeTfIntoVol();
+    SetUpdatesToPerform(block.VolumeData, block.VolData, forceArrayUpdate); // Fill out VolumeData.UpdatesToPerform: which standard arrays of the OmniConnectVolumeData type to perform updates on (for manual disabling of standard array updates over timesteps).
+
+    if (!block.FlattenedArray)
+      block.FlattenedArray = vtkSmartPointer<vtkFloatArray>::New();
+  }
 
-    size_t ugaLen = tempArrays.UpdatedGenericArrays.size();
-    size_t dgaLen = tempArrays.DeletedGenericArrays.size();
-    OmniConnectGenericArray* updatedGenericArrays = (ugaLen > 0 ? &tempArrays.UpdatedGenericArrays[0] : nullptr);
-    OmniConnectGenericArray* deletedGenericArrays = (dgaLen > 0 ? &tempArrays.DeletedGenericArrays[0] : nullptr);
+  aNode->SetSubGeomProgress(0.4);
 
+  // Blocks are converted independently, the volume property is only read (its transfer functions exist after UpdateVolSpecificChanges())
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, [this, &blocks, volProperty](vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType blockIdx = beginBlock; blockIdx < endBlock; ++blockIdx)
     {
-      OmniConnectVolumeData omniVolumeData;
-      omniVolumeData.VolumeId = volGeomId;
-      omniVolumeData.preClassified = rNode->GetMergeTfIntoVol();
-      SetUpdatesToPerform(omniVolumeData, volData, forceArrayUpdate); // Fill out omniVolumeData.UpdatesToPerform: which standard arrays of the OmniConnectVolumeData type to perform updates on (for manual disabling of standard array updates over timesteps).
+      vtkOmniConnectVolumeBlock& block = blocks[blockIdx];
+      if (block.Updated)
+        GatherVolumeData(block.VolumeData, block.VolData, block.VolArray, block.FlattenedArray, block.BlankedArray, volProperty, block.CellFlag, this->TfValues, this->TfOValues, this->TfRange);
+    }
+  });
 
-      GatherVolumeData(omniVolumeData, volData, volArray, Internals->FlattenedArray, volProperty, cellFlag, this->TfValues, this->TfOValues, this->TfRange);
+  aNode->SetSubGeomProgress(0.6);
 
-      connector->UpdateVolume(actorId, animTimeStep, omniVolumeData, materialId, 
-        updatedGenericArrays, ugaLen, deletedGenericArrays, dgaLen);
-      connector->SetGeomVisibility(actorId, omniVolumeData.VolumeId, OmniConnectGeomType::VOLUME, true, animTimeStep); //Always set geom to visible (geometry that became invisible handled in vtkOmniConnectActorNodeBase)
-    }
-    
-    aNode->SetSubGeomProgress(0.9);
+  for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+  {
+    vtkOmniConnectVolumeBlock& block = blocks[blockIdx];
+    if (!block.Updated)
+      continue;
+
+    // Update double to float conversion setting specifically for the dataset currently processed
+    SetConvertGenericArraysDoubleToFloat(connector, block.VolData, true);
+
+    size_t ugaLen = block.UpdatedGenericArrays.size();
+    size_t dgaLen = block.DeletedGenericArrays.size();
+    OmniConnectGenericArray* updatedGenericArrays = (ugaLen > 0 ? &block.UpdatedGenericArrays[0] : nullptr);
+    OmniConnectGenericArray* deletedGenericArrays = (dgaLen > 0 ? &block.DeletedGenericArrays[0] : nullptr);
 
-    // Cleanup generic array cache (to match arrays that were deleted in call to connector->UpdateMesh())
-    omniTimeStep->CleanupGenericArrayCache(dataEntryId);
+    connector->UpdateVolume(actorId, animTimeStep, block.VolumeData, materialId, 
+      updatedGenericArrays, ugaLen, deletedGenericArrays, dgaLen);
+    connector->SetGeomVisibility(actorId, block.VolumeData.VolumeId, OmniConnectGeomType::VOLUME, true, animTimeStep); //Always set geom to visible (geometry that became invisible handled in vtkOmniConnectActorNodeBase)
+
+    // Cleanup generic array cache (to match arrays that were deleted in call to connector->UpdateVolume())
+    omniTimeStep->CleanupGenericArrayCache(block.DataEntryId);
   }
+
+  aNode->SetSubGeomProgress(0.9);
 }
 
 void vtkOmniConnectVolumeMapperNode::UpdateTransferFunctions(vtkVolumeProperty* volProperty, double* volRange)
@@ -422,18 +533,21 @@ void vtkOmniConnectVolumeMapperNode::Render(bool prepass)
     this->UpdateVolSpecificChanges(mapper, actor->GetProperty());
 
     //Check whether any input imagedatas changed
-    vtkImageData* volData = vtkImageData::SafeDownCast(mapper->GetDataSetInput());
+    vtkDataObject* dataInput = mapper->GetInputDataObject(0, 0);
 
-    if (volData)
+    if (dataInput)
     {
       aNode->SetSubGeomProgress(0.0);
 
       // Find out whether and (sub)images have changed
-      bool inputDataChanged = omniTimeStep->HasInputChanged(volData);
+      bool inputDataChanged = omniTimeStep->HasInputChanged(dataInput);
       bool processNode = aNode->GetMaterialsChanged() || inputDataChanged;
       if (processNode)
       {
-        RenderVolume(aNode, actor, mapper, volData, 0, 0);
+        std::vector<VolumeInput> volInputs;
+        this->GatherVolumeInputs(dataInput, volInputs);
+
+        RenderVolumes(aNode, actor, mapper, volInputs, 0);
       }
       else
       {
@@ -34,6 +34,7 @@ class vtkOmniConnectVolumeMapperNodeInternals;
 class vtkVolume;
 class vtkVolumeProperty;
 class vtkImageData;
+class vtkDataObject;
 
 class VTKOMNIVERSECONNECTOR_EXPORT vtkOmniConnectVolumeMapperNode : public vtkVolumeMapperNode
 {
@@ -52,9 +53,18 @@ protected:
   vtkOmniConnectVolumeMapperNode();
   ~vtkOmniConnectVolumeMapperNode() override;
 
+  struct VolumeInput
+  {
+    vtkImageData* VolData = nullptr;
+    size_t DataEntryId = 0;
+  };
+
+  // Finds the image data of the mapper input, each to be written as a volume of its own
+  virtual void GatherVolumeInputs(vtkDataObject* dataInput, std::vector<VolumeInput>& volInputs);
+
   void ResetMaterialIds();
   void UpdateVolSpecificChanges(vtkVolumeMapper* mapper, vtkVolumeProperty* volProperty);
-  void RenderVolume(vtkOmniConnectActorNodeBase* aNode, vtkVolume* actor, vtkVolumeMapper* mapper, vtkImageData* volData, size_t dataEntryId, size_t materialId);
+  void RenderVolumes(vtkOmniConnectActorNodeBase* aNode, vtkVolume* actor, vtkVolumeMapper* mapper, const std::vector<VolumeInput>& volInputs, size_t materialId);
 
   void UpdateTransferFunctions(vtkVolumeProperty* volProperty, double* volRange);
 
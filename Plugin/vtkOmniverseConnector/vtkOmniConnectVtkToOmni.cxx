@@ -38,6 +38,12 @@ void GetOmniConnectSettings(const vtkOmniConnectSettings& vtkSettings, OmniConne
   omniConnectSettings.UsePointInstancer = vtkSettings.UsePointInstancer;
   omniConnectSettings.UseMeshVolume = vtkSettings.UseMeshVolume;
   omniConnectSettings.CreateNewOmniSession = vtkSettings.CreateNewOmniSession;
+  omniConnectSettings.VolumeCompression = vtkSettings.VolumeCompression;
+  omniConnectSettings.VolumeHalfFloat = vtkSettings.VolumeHalfFloat;
+  omniConnectSettings.VolumeQuantizationTolerance = vtkSettings.VolumeQuantizationTolerance;
+  omniConnectSettings.NormalsEncoding = vtkSettings.NormalsEncoding;
+  omniConnectSettings.GenericArraysHalfFloat = vtkSettings.GenericArraysHalfFloat;
+  omniConnectSettings.DiscardAssetWrites = vtkSettings.DiscardAssetWrites;
 }
 
 OmniConnectType GetOmniConnectType(vtkDataArray* dataArray)
@@ -136,4 +142,4 @@ size_t GetOmniConnectTypeSize(OmniConnectType type)
   }
 
   return result;
-}
\ No newline at end of file
+}
@@ -0,0 +1,153 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+#ifndef OmniConnectVolumeTestUtilities_h
+#define OmniConnectVolumeTestUtilities_h
+
+// Helpers of the volume writer tests, which drive OmniConnect_Volume directly and read its output back with OpenVDB.
+// Kept free of vtk, since these tests are compiled with the OpenVDB library ABI (see Testing/Cxx/CMakeLists.txt).
+
+#include "OmniConnectVolumeWriter.h"
+
+#include <openvdb/openvdb.h>
+#include <openvdb/io/Stream.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace OmniConnectVolumeTesting
+{
+  inline void LogCallback(OmniConnectLogLevel level, void* userData, const char* message)
+  {
+    std::cerr << (level == OmniConnectLogLevel::ERR ? "Error: " : "") << message << std::endl;
+  }
+
+  struct WriterRelease
+  {
+    void operator()(OmniConnectVolumeWriterI* writer) const { writer->Release(); }
+  };
+  using WriterPtr = std::unique_ptr<OmniConnectVolumeWriterI, WriterRelease>;
+
+  inline WriterPtr CreateWriter(const OmniConnectSettings& settings, bool convertDoubleToFloat = false)
+  {
+    WriterPtr writer(Create_VolumeWriter(settings));
+    if (writer)
+    {
+      writer->Initialize(LogCallback, nullptr);
+      writer->SetConvertDoubleToFloat(convertDoubleToFloat);
+    }
+    return writer;
+  }
+
+  // Parses -T <directory> from the test driver arguments (the directory exists, see Testing/CMakeLists.txt)
+  inline std::string GetOutputFileName(int argc, char* argv[], const char* fileName)
+  {
+    std::string baseDirectory = ".";
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+      if (strcmp(argv[i], "-T") == 0)
+        baseDirectory = argv[i + 1];
+    }
+    return baseDirectory + "/" + fileName;
+  }
+
+  inline bool ReadFile(const std::string& fileName, std::string& contents)
+  {
+    std::ifstream file(fileName, std::ios_base::in | std::ios_base::binary);
+    if (!file)
+      return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return true;
+  }
+
+  // Dense XYZ-ordered input of the writer, with element 0 as background unless backgroundIdx says otherwise
+  inline OmniConnectVolumeData MakeVolumeData(const void* data, OmniConnectType dataType, const size_t dims[3], long long backgroundIdx = 0)
+  {
+    OmniConnectVolumeData volumeData;
+    volumeData.Data = data;
+    volumeData.DataType = dataType;
+    volumeData.NumElements[0] = dims[0];
+    volumeData.NumElements[1] = dims[1];
+    volumeData.NumElements[2] = dims[2];
+    volumeData.BackgroundIdx = backgroundIdx;
+    return volumeData;
+  }
+
+  // Serializes into memory and decodes the result again
+  inline openvdb::GridPtrVecPtr WriteAndRead(OmniConnectVolumeWriterI* writer, const OmniConnectVolumeData& volumeData,
+    std::string* serialized = nullptr)
+  {
+    if (!writer->ToVDB(volumeData, nullptr, 0))
+      return nullptr;
+
+    const char* data = nullptr;
+    size_t size = 0;
+    writer->GetSerializedVolumeData(data, size);
+    std::string bytes(data, size);
+
+    std::istringstream inStream(bytes, std::ios_base::in | std::ios_base::binary);
+    openvdb::io::Stream vdbStream(inStream, false);
+    if (serialized)
+      *serialized = std::move(bytes);
+    return vdbStream.getGrids();
+  }
+
+  template<typename GridType>
+  typename GridType::Ptr FindGrid(const openvdb::GridPtrVecPtr& grids, const char* name)
+  {
+    if (!grids)
+      return nullptr;
+    for (const openvdb::GridBase::Ptr& grid : *grids)
+    {
+      if (grid->getName() == name)
+        return openvdb::gridPtrCast<GridType>(grid);
+    }
+    return nullptr;
+  }
+
+  inline openvdb::Coord LinearToCoord(size_t linearIndex, const size_t dims[3])
+  {
+    return openvdb::Coord(int(linearIndex % dims[0]), int((linearIndex / dims[0]) % dims[1]), int(linearIndex / (dims[0] * dims[1])));
+  }
+
+  template<typename ValueType>
+  bool BitwiseEqual(const ValueType& a, const ValueType& b)
+  {
+    return std::memcmp(&a, &b, sizeof(ValueType)) == 0;
+  }
+}
+
+// Test failure reporting in the style of the vtk test drivers
+#define OmniConnectVolumeTestAssert(condition, message) \
+  do { if (!(condition)) { std::cerr << "Test failure in " << __FILE__ << ":" << __LINE__ << ": " << message << std::endl; return EXIT_FAILURE; } } while(0)
+
+#endif
@@ -0,0 +1,314 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Content-hash deduplication of geometry clips: a mesh that stays the same over 1000 timesteps must end up with a single
+// clip file, a mesh that cycles between two states with two, and the clip metadata of the actor layer must still resolve
+// every timestep to a clip file and sample time that hold its contents, also after resuming the session.
+// Timesteps rewritten or deleted after many flushes edit the clip metadata in place instead of appending to it,
+// after which the composed clips and the stored content hashes have to be just as consistent.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const size_t NumTimeSteps = 1000;
+
+  std::unique_ptr<OmniConnect> OpenConnector(const std::string& outputDir, bool createNewSession)
+  {
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str(); // Has to outlive the connector
+    settings.RootLevelFileName = "Session";
+    settings.OutputLocal = true;
+    settings.OutputBinary = false;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = createNewSession;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      connector.reset();
+    return connector;
+  }
+
+  // Triangle whose first point identifies the state, so clip files can be told apart by their contents
+  void UploadTriangle(OmniConnect& connector, double animTimeStep, float stateCoord)
+  {
+    float points[9] = { stateCoord, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    unsigned int indices[3] = { 0, 1, 2 };
+    OmniConnectMeshData meshData;
+    meshData.MeshId = 0;
+    meshData.NumPoints = 3;
+    meshData.Points = points;
+    meshData.PointsType = OmniConnectType::FLOAT3;
+    meshData.Indices = indices;
+    meshData.NumIndices = 3;
+
+    connector.AddTimeStep(0, animTimeStep);
+    connector.UpdateMesh(0, animTimeStep, meshData, 0, nullptr, 0, nullptr, 0);
+    connector.FlushActorUpdates(0);
+  }
+
+  // Writes timesteps [begin, end), each with state stateCoords[timeStep % numStates]
+  bool WriteTimeSteps(const std::string& outputDir, bool createNewSession, size_t begin, size_t end, const std::vector<float>& stateCoords)
+  {
+    vtksys::SystemTools::MakeDirectory(outputDir);
+    std::unique_ptr<OmniConnect> connector = OpenConnector(outputDir, createNewSession);
+    if (!connector)
+      return false;
+    connector->CreateActor(0, "Actor");
+    for (size_t timeStep = begin; timeStep < end; ++timeStep)
+      UploadTriangle(*connector, (double)timeStep, stateCoords[timeStep % stateCoords.size()]);
+    connector->FlushSceneUpdates();
+    return true;
+  }
+
+  // Expected state per timestep of WriteTimeSteps
+  void AddExpectedCoords(size_t begin, size_t end, const std::vector<float>& stateCoords, std::map<double, float>& expectedCoords)
+  {
+    for (size_t timeStep = begin; timeStep < end; ++timeStep)
+      expectedCoords[(double)timeStep] = stateCoords[timeStep % stateCoords.size()];
+  }
+
+  std::vector<std::string> ListClipFiles(const std::string& outputDir)
+  {
+    std::vector<std::string> fileNames, clipFileNames;
+    vtkOmniConnectTesting::ListFiles(outputDir, fileNames);
+    for (const std::string& fileName : fileNames)
+    {
+      if (fileName.find("geometries/") != std::string::npos)
+        clipFileNames.push_back(fileName);
+    }
+    return clipFileNames;
+  }
+
+  // Finds the clip file of outputDir that an asset path of the clip metadata refers to
+  std::string FindClipFile(const std::vector<std::string>& clipFiles, const std::string& assetPath)
+  {
+    for (const std::string& fileName : clipFiles)
+    {
+      if (fileName.size() >= assetPath.size() &&
+        fileName.compare(fileName.size() - assetPath.size(), std::string::npos, assetPath) == 0)
+        return fileName;
+    }
+    return std::string();
+  }
+
+  // Every stored content hash has to refer to an existing clip asset, sampled at a time that asset holds
+  int CheckClipContentHashes(const std::string& outputDir, const std::string& actorLayer, const std::vector<std::string>& assetPaths,
+    const std::vector<std::string>& clipFiles)
+  {
+    size_t dictStart = actorLayer.find("dictionary clipContentHashes = {");
+    if (dictStart == std::string::npos)
+      return EXIT_SUCCESS;
+    size_t dictEnd = actorLayer.find('}', dictStart);
+    vtkOmniConnectTestAssert(dictEnd != std::string::npos, "Unterminated clipContentHashes dictionary");
+
+    std::vector<std::string> storedClips;
+    for (size_t entry = actorLayer.find("double2 ", dictStart); entry < dictEnd; entry = actorLayer.find("double2 ", entry + 1))
+    {
+      size_t valueStart = actorLayer.find('=', entry);
+      std::vector<double> assetTime = vtkOmniConnectTesting::ParseNumbers(actorLayer.substr(valueStart + 1, actorLayer.find(')', valueStart) - valueStart));
+      vtkOmniConnectTestAssert(assetTime.size() == 2 && assetTime[0] < assetPaths.size(),
+        "Stored content hash refers to missing asset: " << actorLayer.substr(entry, actorLayer.find('\n', entry) - entry));
+
+      std::string clipFile = FindClipFile(clipFiles, assetPaths[(size_t)assetTime[0]]);
+      vtkOmniConnectTestAssert(!clipFile.empty(), "Stored content hash refers to " << assetPaths[(size_t)assetTime[0]] << ", which is not a clip file");
+      std::string clipContents;
+      vtkOmniConnectTestAssert(vtkOmniConnectTesting::ReadFile(outputDir + clipFile, clipContents) &&
+        clipContents.find(std::to_string((long long)assetTime[1]) + ": [") != std::string::npos,
+        "Stored content hash refers to clip time " << assetTime[1] << ", which " << clipFile << " has no samples for");
+
+      std::string storedClip = clipFile + "@" + std::to_string(assetTime[1]);
+      vtkOmniConnectTestAssert(std::find(storedClips.begin(), storedClips.end(), storedClip) == storedClips.end(),
+        "Content hashes stored twice for " << storedClip);
+      storedClips.push_back(storedClip);
+    }
+    vtkOmniConnectTestAssert(!storedClips.empty(), "Empty clipContentHashes dictionary");
+    return EXIT_SUCCESS;
+  }
+
+  // Resolves every timestep through the clip metadata of the actor layer, as the usd clip composition does:
+  // clipActives picks the asset, clipTimes the sample time within it (identity without clipTimes).
+  // The asset has to be one of the clip files, with the state of the timestep at that sample time.
+  int CheckComposedClips(const std::string& outputDir, const std::map<double, float>& expectedCoords)
+  {
+    std::string actorLayer;
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(outputDir, fileNames);
+    for (const std::string& fileName : fileNames)
+    {
+      std::string contents;
+      if (vtkOmniConnectTesting::ReadFile(outputDir + fileName, contents) && contents.find("asset[] assetPaths") != std::string::npos)
+      {
+        vtkOmniConnectTestAssert(actorLayer.empty(), "Clip metadata authored in more than one layer");
+        actorLayer = contents;
+      }
+    }
+
+    std::vector<std::string> assetPathValues = vtkOmniConnectTesting::FindAttributeValues(actorLayer, "asset[] assetPaths");
+    std::vector<std::string> activeValues = vtkOmniConnectTesting::FindAttributeValues(actorLayer, "double2[] active");
+    std::vector<std::string> timesValues = vtkOmniConnectTesting::FindAttributeValues(actorLayer, "double2[] times");
+    vtkOmniConnectTestAssert(assetPathValues.size() == 1 && activeValues.size() == 1 && timesValues.size() <= 1,
+      "Expected a single clip set, got " << assetPathValues.size() << " asset path and " << activeValues.size() << " active values");
+
+    std::vector<std::string> assetPaths = vtkOmniConnectTesting::ParseAssetPaths(assetPathValues[0]);
+
+    std::vector<double> actives = vtkOmniConnectTesting::ParseNumbers(activeValues[0]);
+    std::vector<double> times = timesValues.empty() ? std::vector<double>() : vtkOmniConnectTesting::ParseNumbers(timesValues[0]);
+    vtkOmniConnectTestAssert(actives.size() == 2 * expectedCoords.size(), "Expected " << expectedCoords.size() << " clip actives, got " << actives.size() / 2);
+
+    std::vector<std::string> clipFiles = ListClipFiles(outputDir);
+    std::vector<double> activeTimes;
+    for (size_t activeIdx = 0; activeIdx < expectedCoords.size(); ++activeIdx)
+    {
+      double stageTime = actives[2 * activeIdx];
+      size_t assetIdx = (size_t)actives[2 * activeIdx + 1];
+      auto expectedIt = expectedCoords.find(stageTime);
+      vtkOmniConnectTestAssert(expectedIt != expectedCoords.end(), "Timestep " << stageTime << " should not be active");
+      vtkOmniConnectTestAssert(std::find(activeTimes.begin(), activeTimes.end(), stageTime) == activeTimes.end(), "Timestep " << stageTime << " is active twice");
+      activeTimes.push_back(stageTime);
+      vtkOmniConnectTestAssert(assetIdx < assetPaths.size(), "Timestep " << stageTime << " refers to missing asset " << assetIdx);
+
+      double clipTime = stageTime;
+      for (size_t timeIdx = 0; timeIdx + 1 < times.size(); timeIdx += 2)
+      {
+        if (times[timeIdx] == stageTime)
+          clipTime = times[timeIdx + 1];
+      }
+
+      std::string clipFile = FindClipFile(clipFiles, assetPaths[assetIdx]);
+      vtkOmniConnectTestAssert(!clipFile.empty(), "Timestep " << stageTime << " refers to " << assetPaths[assetIdx] << ", which is not a clip file");
+
+      std::string clipContents;
+      vtkOmniConnectTestAssert(vtkOmniConnectTesting::ReadFile(outputDir + clipFile, clipContents), "Cannot read " << clipFile);
+      std::vector<std::string> pointSamples = vtkOmniConnectTesting::FindAttributeValues(clipContents, "point3f[] points");
+      vtkOmniConnectTestAssert(pointSamples.size() == 1, clipFile << " should hold the points of a single timestep");
+      std::vector<double> points = vtkOmniConnectTesting::ParseNumbers(pointSamples[0]);
+      vtkOmniConnectTestAssert(points.size() == 9 && (float)points[0] == expectedIt->second,
+        "Timestep " << stageTime << " resolves to the points " << pointSamples[0] << " of " << clipFile);
+
+      vtkOmniConnectTestAssert(clipContents.find(std::to_string((long long)clipTime) + ": [") != std::string::npos,
+        "Timestep " << stageTime << " resolves to clip time " << clipTime << ", which " << clipFile << " has no samples for");
+    }
+    return CheckClipContentHashes(outputDir, actorLayer, assetPaths, clipFiles);
+  }
+}
+
+int TestOmniConnectClipDeduplication(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectClipDeduplication");
+
+  // Static mesh: a single clip file for all timesteps, which survives resuming the session
+  {
+    std::string staticDir = outputDir + "Static/";
+    std::vector<float> stateCoords = { 0.0f };
+    std::map<double, float> expectedCoords;
+    AddExpectedCoords(0, NumTimeSteps, stateCoords, expectedCoords);
+    vtkOmniConnectTestAssert(WriteTimeSteps(staticDir, true, 0, NumTimeSteps, stateCoords), "Cannot initialize local output");
+
+    std::vector<std::string> clipFiles = ListClipFiles(staticDir);
+    vtkOmniConnectTestAssert(clipFiles.size() == 1, "Expected a single clip file for a static mesh over " << NumTimeSteps << " timesteps, got " << clipFiles.size());
+    if (CheckComposedClips(staticDir, expectedCoords) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    AddExpectedCoords(NumTimeSteps, NumTimeSteps + 10, stateCoords, expectedCoords);
+    vtkOmniConnectTestAssert(WriteTimeSteps(staticDir, false, NumTimeSteps, NumTimeSteps + 10, stateCoords), "Cannot resume local output");
+    clipFiles = ListClipFiles(staticDir);
+    vtkOmniConnectTestAssert(clipFiles.size() == 1, "Resumed session did not reuse the stored clip, got " << clipFiles.size() << " clip files");
+    if (CheckComposedClips(staticDir, expectedCoords) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Mesh cycling between two states: one clip file per state
+  {
+    std::string cyclingDir = outputDir + "Cycling/";
+    std::vector<float> stateCoords = { 0.0f, 0.5f };
+    std::map<double, float> expectedCoords;
+    AddExpectedCoords(0, NumTimeSteps, stateCoords, expectedCoords);
+    vtkOmniConnectTestAssert(WriteTimeSteps(cyclingDir, true, 0, NumTimeSteps, stateCoords), "Cannot initialize local output");
+
+    std::vector<std::string> clipFiles = ListClipFiles(cyclingDir);
+    vtkOmniConnectTestAssert(clipFiles.size() == 2, "Expected a clip file per state of a cycling mesh, got " << clipFiles.size());
+    if (CheckComposedClips(cyclingDir, expectedCoords) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Rewrites and deletes of earlier timesteps, each flushed on its own
+  {
+    std::string editedDir = outputDir + "Edited/";
+    std::vector<float> stateCoords = { 0.0f, 0.5f, 0.75f };
+    std::map<double, float> expectedCoords;
+    AddExpectedCoords(0, NumTimeSteps, stateCoords, expectedCoords);
+    vtkOmniConnectTestAssert(WriteTimeSteps(editedDir, true, 0, NumTimeSteps, stateCoords), "Cannot initialize local output");
+    {
+      std::unique_ptr<OmniConnect> connector = OpenConnector(editedDir, false);
+      vtkOmniConnectTestAssert(connector, "Cannot resume local output");
+      connector->CreateActor(0, "Actor");
+
+      // A new state in the middle, and a timestep moving to the state stored by another one
+      UploadTriangle(*connector, 10.0, 0.25f);
+      expectedCoords[10.0] = 0.25f;
+      UploadTriangle(*connector, 11.0, 0.0f);
+      expectedCoords[11.0] = 0.0f;
+
+      // Timestep 0 holds the stored clip of its state, shared by a third of all timesteps
+      UploadTriangle(*connector, 0.0, 0.125f);
+      expectedCoords[0.0] = 0.125f;
+
+      for (double deletedTimeStep : { 20.0, 12.0, (double)(NumTimeSteps - 1) })
+      {
+        vtkOmniConnectTestAssert(!connector->DeleteGeomAtTime(0, deletedTimeStep, 0, OmniConnectGeomType::MESH),
+          "Deleting timestep " << deletedTimeStep << " should not delete the whole geometry");
+        connector->FlushActorUpdates(0);
+        expectedCoords.erase(deletedTimeStep);
+      }
+      connector->FlushSceneUpdates();
+    }
+    if (CheckComposedClips(editedDir, expectedCoords) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // The stored content hashes authored per edit still deduplicate into the existing clips after resuming
+    size_t numClipFiles = ListClipFiles(editedDir).size();
+    AddExpectedCoords(NumTimeSteps, NumTimeSteps + 3, stateCoords, expectedCoords);
+    vtkOmniConnectTestAssert(WriteTimeSteps(editedDir, false, NumTimeSteps, NumTimeSteps + 3, stateCoords), "Cannot resume local output");
+    vtkOmniConnectTestAssert(ListClipFiles(editedDir).size() == numClipFiles,
+      "Resumed session did not reuse the stored clips, got " << ListClipFiles(editedDir).size() << " clip files instead of " << numClipFiles);
+    if (CheckComposedClips(editedDir, expectedCoords) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
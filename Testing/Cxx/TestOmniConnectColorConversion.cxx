@@ -0,0 +1,103 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Checks the batched sRGB to linear conversion of display colors against the scalar reference, for 3 and 4 components
+// and for color counts that leave a tail after the vectorized part.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "OmniConnectUtilsInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  // Distance in units in the last place between two finite floats of equal sign
+  int64_t UlpDistance(float a, float b)
+  {
+    int32_t aBits, bBits;
+    std::memcpy(&aBits, &a, sizeof(float));
+    std::memcpy(&bBits, &b, sizeof(float));
+    return std::llabs((int64_t)aBits - (int64_t)bBits);
+  }
+
+  // Same formula as the scalar reference, evaluated in double precision
+  float SrgbToLinearDouble(int value)
+  {
+    double val = value / 255.0;
+    return (float)((val < 0.04045) ? val / 12.92 : std::pow((val + 0.055) / 1.055, 2.4));
+  }
+}
+
+int TestOmniConnectColorConversion(int, char*[])
+{
+  // The table agrees with the scalar reference, and stays within a few ulps of the double precision result
+  const float* table = ocutils::SrgbToLinearTable();
+  int64_t maxScalarUlps = 0, maxDoubleUlps = 0;
+  for (int value = 0; value < 256; ++value)
+  {
+    maxScalarUlps = std::max(maxScalarUlps, UlpDistance(table[value], ocutils::SrgbToLinear(value / 255.0f)));
+    maxDoubleUlps = std::max(maxDoubleUlps, UlpDistance(table[value], SrgbToLinearDouble(value)));
+  }
+  vtkOmniConnectTestAssert(maxScalarUlps <= 1, "Conversion table is " << maxScalarUlps << " ulps off the scalar reference");
+  vtkOmniConnectTestAssert(maxDoubleUlps <= 8, "Conversion table is " << maxDoubleUlps << " ulps off the double precision reference");
+
+  // The batch output (vectorized where available) has to equal the table exactly, including the tails
+  for (int components = 3; components <= 4; ++components)
+  {
+    for (size_t numColors : { size_t(0), size_t(1), size_t(2), size_t(3), size_t(7), size_t(255), size_t(1027) })
+    {
+      std::vector<uint8_t> srgb(components * numColors);
+      for (size_t i = 0; i < srgb.size(); ++i)
+        srgb[i] = (uint8_t)((i * 97 + numColors) % 256);
+
+      // Guard values past the end catch writes beyond 3 * numColors
+      const float guard = -1.0f;
+      std::vector<float> linearRgb(3 * numColors + 8, guard), linearAlpha(numColors + 1, guard);
+      ocutils::SrgbToLinearBatch(srgb.data(), linearRgb.data(), numColors, components, linearAlpha.data());
+
+      for (size_t i = 0; i < numColors; ++i)
+      {
+        for (int c = 0; c < 3; ++c)
+        {
+          float expected = table[srgb[components * i + c]];
+          vtkOmniConnectTestAssert(linearRgb[3 * i + c] == expected, "Color " << i << " of " << numColors << " with " << components
+            << " components converts to " << linearRgb[3 * i + c] << " instead of " << expected);
+        }
+        if (components == 4)
+          vtkOmniConnectTestAssert(linearAlpha[i] == srgb[4 * i + 3] / 255.0f, "Alpha " << i << " of " << numColors << " is not normalized");
+      }
+      for (size_t j = 3 * numColors; j < linearRgb.size(); ++j)
+        vtkOmniConnectTestAssert(linearRgb[j] == guard, "Conversion of " << numColors << " colors writes past the output");
+      vtkOmniConnectTestAssert(linearAlpha[numColors] == guard && (components == 4 || numColors == 0 || linearAlpha[0] == guard),
+        "Alpha written past the output, or for colors without alpha");
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
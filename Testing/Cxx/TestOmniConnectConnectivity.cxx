@@ -0,0 +1,280 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Checks that the parallel index buffer generation and cell data scatter of vtkOmniConnectConnectivity produce
+// the same output as a serial, cell by cell reference, for mixed polygon, line and strip input.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectConnectivity.h"
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  typedef std::vector<unsigned int> IndexVector;
+
+  // Copies of a small set of cells of every size, including degenerate ones, around an octagon of points
+  vtkSmartPointer<vtkPolyData> MakeMixedCells(int numCopies)
+  {
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkCellArray> lines;
+    vtkNew<vtkCellArray> polys;
+    vtkNew<vtkCellArray> strips;
+
+    const vtkIdType octagon[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    for (int copy = 0; copy < numCopies; ++copy)
+    {
+      vtkIdType base = points->GetNumberOfPoints();
+      for (int i = 0; i < 8; ++i)
+      {
+        double angle = 2.0 * 3.14159265358979 * i / 8.0;
+        points->InsertNextPoint(std::cos(angle), std::sin(angle), 0.01 * copy);
+      }
+
+      vtkIdType ids[8];
+      for (int i = 0; i < 8; ++i)
+        ids[i] = base + octagon[(i + copy) % 8];
+
+      verts->InsertNextCell(1, ids + 5);
+
+      lines->InsertNextCell(1, ids);
+      lines->InsertNextCell(2, ids);
+      lines->InsertNextCell(5, ids);
+
+      polys->InsertNextCell(3, ids);
+      polys->InsertNextCell(4, ids);
+      polys->InsertNextCell(5, ids);
+      polys->InsertNextCell(6, ids);
+      polys->InsertNextCell(8, ids);
+      polys->InsertNextCell(2, ids);
+      polys->InsertNextCell(1, ids + 3);
+
+      strips->InsertNextCell(3, ids);
+      strips->InsertNextCell(4, ids);
+      strips->InsertNextCell(7, ids);
+      strips->InsertNextCell(2, ids + 2);
+    }
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetVerts(verts);
+    polyData->SetLines(lines);
+    polyData->SetPolys(polys);
+    polyData->SetStrips(strips);
+    return polyData;
+  }
+
+  // Serial reference of the index buffers, appending cell by cell. Cell ids restart at 0 for every cell array.
+  void AppendLines(vtkCellArray* cells, bool closeLoops, IndexVector& indexArray, IndexVector& reverseArray)
+  {
+    vtkNew<vtkIdList> cellPts;
+    for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+    {
+      cells->GetCellAtId(cellId, cellPts);
+      vtkIdType npts = cellPts->GetNumberOfIds();
+      vtkIdType numSegments = closeLoops ? npts : npts - 1;
+      for (vtkIdType i = 0; i < numSegments; ++i)
+      {
+        indexArray.push_back((unsigned int)cellPts->GetId(i));
+        indexArray.push_back((unsigned int)cellPts->GetId(i < npts - 1 ? i + 1 : 0));
+        reverseArray.push_back((unsigned int)cellId);
+        reverseArray.push_back((unsigned int)cellId);
+      }
+    }
+  }
+
+  void AppendTriangles(vtkCellArray* cells, vtkPoints* points, IndexVector& indexArray, IndexVector& reverseArray)
+  {
+    vtkNew<vtkIdList> cellPts;
+    vtkNew<vtkPolygon> polygon;
+    vtkNew<vtkIdList> tris;
+    vtkNew<vtkPoints> triPoints;
+    for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+    {
+      cells->GetCellAtId(cellId, cellPts);
+      vtkIdType npts = cellPts->GetNumberOfIds();
+      std::vector<vtkIdType> triIds;
+      if (npts == 3)
+        triIds = { 0, 1, 2 };
+      else if (npts == 4)
+        triIds = { 0, 1, 2, 0, 2, 3 };
+      else if (npts == 5)
+        triIds = { 0, 1, 2, 0, 2, 3, 0, 3, 4 };
+      else if (npts == 6)
+        triIds = { 0, 1, 2, 0, 2, 3, 0, 3, 5, 3, 4, 5 };
+      else if (npts > 6)
+      {
+        std::vector<vtkIdType> localIds(npts);
+        triPoints->SetNumberOfPoints(npts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          triPoints->SetPoint(i, points->GetPoint(cellPts->GetId(i)));
+          localIds[i] = i;
+        }
+        polygon->Initialize(npts, localIds.data(), triPoints);
+        polygon->TriangulateLocalIds(0, tris);
+        for (vtkIdType j = 0; j < tris->GetNumberOfIds(); ++j)
+          triIds.push_back(tris->GetId(j));
+      }
+
+      for (vtkIdType triId : triIds)
+      {
+        indexArray.push_back((unsigned int)cellPts->GetId(triId));
+        reverseArray.push_back((unsigned int)cellId);
+      }
+    }
+  }
+
+  void AppendStrips(vtkCellArray* cells, bool wireframe, IndexVector& indexArray, IndexVector& reverseArray)
+  {
+    vtkNew<vtkIdList> cellPts;
+    for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+    {
+      cells->GetCellAtId(cellId, cellPts);
+      const vtkIdType* pts = cellPts->GetPointer(0);
+      vtkIdType npts = cellPts->GetNumberOfIds();
+      std::vector<vtkIdType> stripIds;
+      if (wireframe)
+      {
+        stripIds = { pts[0], pts[1] };
+        for (vtkIdType j = 0; j < npts - 2; ++j)
+          stripIds.insert(stripIds.end(), { pts[j], pts[j + 2], pts[j + 1], pts[j + 2] });
+      }
+      else
+      {
+        for (vtkIdType j = 0; j < npts - 2; ++j)
+          stripIds.insert(stripIds.end(), { pts[j], pts[j + 1 + j % 2], pts[j + 1 + (j + 1) % 2] });
+      }
+
+      for (vtkIdType id : stripIds)
+      {
+        indexArray.push_back((unsigned int)id);
+        reverseArray.push_back((unsigned int)cellId);
+      }
+    }
+  }
+
+  // Compares MakeConnectivity with the reference for one representation/primitive type, with and without reverse array
+  bool CompareConnectivity(vtkPolyData* polyData, int representation, int filterPrim, std::vector<vtkIdType>& cellOffsets,
+    IndexVector& indexArray, IndexVector& indexToCell)
+  {
+    IndexVector refIndexArray, refIndexToCell;
+    if (representation == VTK_WIREFRAME)
+    {
+      AppendLines(polyData->GetLines(), false, refIndexArray, refIndexToCell);
+      AppendLines(polyData->GetPolys(), true, refIndexArray, refIndexToCell);
+      AppendStrips(polyData->GetStrips(), true, refIndexArray, refIndexToCell);
+    }
+    else if (filterPrim == 1)
+    {
+      AppendLines(polyData->GetLines(), false, refIndexArray, refIndexToCell);
+    }
+    else
+    {
+      AppendTriangles(polyData->GetPolys(), polyData->GetPoints(), refIndexArray, refIndexToCell);
+      AppendStrips(polyData->GetStrips(), false, refIndexArray, refIndexToCell);
+    }
+
+    size_t numVerts = polyData->GetNumberOfPoints();
+    vtkOmniConnectConnectivity::MakeConnectivity(polyData, representation, numVerts, indexArray, indexToCell, nullptr, cellOffsets, filterPrim);
+    if (indexArray != refIndexArray || indexToCell != refIndexToCell)
+      return false;
+
+    vtkOmniConnectConnectivity::EmptyVector<unsigned int> emptyVec;
+    vtkOmniConnectConnectivity::MakeConnectivity(polyData, representation, numVerts, indexArray, emptyVec, nullptr, cellOffsets, filterPrim);
+    return indexArray == refIndexArray;
+  }
+
+  // Compares ScatterCellTuples with a serial copy of the cell tuple of every primitive
+  template<typename ValueType>
+  bool CompareScatter(const IndexVector& indexToCell, int numPrimIdx, vtkIdType numCellTuples, int numComps)
+  {
+    std::vector<ValueType> cellTuples(numCellTuples * numComps);
+    for (size_t i = 0; i < cellTuples.size(); ++i)
+      cellTuples[i] = static_cast<ValueType>(i % 251);
+
+    size_t numPrims = indexToCell.size() / numPrimIdx;
+    std::vector<ValueType> refPerPrim(numPrims * numComps);
+    for (size_t primIdx = 0; primIdx < numPrims; ++primIdx)
+    {
+      unsigned int cellIdx = indexToCell[primIdx * numPrimIdx];
+      for (int c = 0; c < numComps; ++c)
+        refPerPrim[primIdx * numComps + c] = cellTuples[cellIdx * numComps + c];
+    }
+
+    std::vector<ValueType> perPrim;
+    vtkOmniConnectConnectivity::ScatterCellTuples(indexToCell, numPrimIdx, cellTuples.data(), numCellTuples, numComps, perPrim);
+    return perPrim == refPerPrim;
+  }
+}
+
+int TestOmniConnectConnectivity(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> polyData = MakeMixedCells(5000);
+  vtkIdType numCellTuples = polyData->GetPolys()->GetNumberOfCells();
+
+  // Serial and default backend
+  const int numThreads[2] = { 1, 0 };
+  for (int threads : numThreads)
+  {
+    vtkSMPTools::Initialize(threads);
+
+    // Reused between calls, as by the mapper node
+    std::vector<vtkIdType> cellOffsets;
+    IndexVector indexArray, indexToCell;
+
+    vtkOmniConnectTestAssert(CompareConnectivity(polyData, VTK_SURFACE, 2, cellOffsets, indexArray, indexToCell),
+      "Triangle index buffer differs from the reference with " << threads << " threads");
+    vtkOmniConnectTestAssert(!indexArray.empty() && indexArray.size() % 3 == 0, "Triangle index buffer has an invalid size");
+    vtkOmniConnectTestAssert(CompareScatter<float>(indexToCell, 3, numCellTuples, 3), "Per-triangle normals differ from the reference");
+    vtkOmniConnectTestAssert(CompareScatter<unsigned char>(indexToCell, 3, numCellTuples, 4), "Per-triangle colors differ from the reference");
+
+    vtkOmniConnectTestAssert(CompareConnectivity(polyData, VTK_SURFACE, 1, cellOffsets, indexArray, indexToCell),
+      "Line index buffer differs from the reference with " << threads << " threads");
+    vtkOmniConnectTestAssert(CompareScatter<unsigned char>(indexToCell, 2, numCellTuples, 4), "Per-segment colors differ from the reference");
+
+    vtkOmniConnectTestAssert(CompareConnectivity(polyData, VTK_WIREFRAME, 1, cellOffsets, indexArray, indexToCell),
+      "Wireframe index buffer differs from the reference with " << threads << " threads");
+    vtkOmniConnectTestAssert(CompareScatter<unsigned char>(indexToCell, 2, numCellTuples, 3), "Per-segment wireframe colors differ from the reference");
+
+    // Empty input leaves the buffers empty
+    vtkNew<vtkPolyData> emptyPolyData;
+    emptyPolyData->SetPoints(polyData->GetPoints());
+    vtkOmniConnectTestAssert(CompareConnectivity(emptyPolyData, VTK_SURFACE, 2, cellOffsets, indexArray, indexToCell) && indexArray.empty(),
+      "Empty input produces indices");
+  }
+
+  vtkSMPTools::Initialize(0);
+
+  return EXIT_SUCCESS;
+}
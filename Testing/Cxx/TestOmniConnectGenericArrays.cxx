@@ -0,0 +1,204 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Uploads a generic array of every OmniConnectType and reads the values back from the usda output, with and without
+// conversion of double arrays to float. The source buffers are overwritten right after the update, as generic array data
+// is copied by the connector.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const int NumTriangles = 20;
+  const int NumPoints = 3 * NumTriangles;
+
+  const char* KindNames[OmniConnectNumFundamentalTypes] = { "UCHAR", "CHAR", "USHORT", "SHORT", "UINT", "INT", "ULONG", "LONG", "FLOAT", "DOUBLE" };
+
+  std::unique_ptr<OmniConnect> OpenConnector(const std::string& outputDir)
+  {
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str(); // Has to outlive the connector
+    settings.RootLevelFileName = "Session";
+    settings.OutputLocal = true;
+    settings.OutputBinary = false;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = true;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      connector.reset();
+    return connector;
+  }
+
+  // Values covering the range of each type, including the ones that don't fit a narrower or differently signed type
+  template<class T>
+  void FillValues(std::vector<char>& bytes, std::vector<double>& expected, size_t numValues, double (*value)(size_t))
+  {
+    bytes.resize(numValues * sizeof(T));
+    T* typed = reinterpret_cast<T*>(bytes.data());
+    for (size_t i = 0; i < numValues; ++i)
+    {
+      typed[i] = (T)value(i);
+      expected.push_back((double)typed[i]);
+    }
+  }
+
+  struct TypedArray
+  {
+    OmniConnectType Type;
+    std::string Name;
+    std::vector<char> Bytes;
+    std::vector<double> Expected;
+  };
+
+  TypedArray MakeArray(OmniConnectType type)
+  {
+    int kind = (int)type % OmniConnectNumFundamentalTypes;
+    int numComponents = (int)type / OmniConnectNumFundamentalTypes + 1;
+    size_t numValues = (size_t)NumPoints * numComponents;
+
+    TypedArray array;
+    array.Type = type;
+    array.Name = std::string(KindNames[kind]) + (numComponents > 1 ? std::to_string(numComponents) : "");
+    switch (kind)
+    {
+      case 0: FillValues<uint8_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return (double)(i * 7 % 256); }); break;
+      case 1: FillValues<int8_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return (double)(i * 7 % 256) - 128.0; }); break;
+      case 2: FillValues<uint16_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return 65535.0 - (double)(i * 271 % 65536); }); break;
+      case 3: FillValues<int16_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return (double)(i * 271 % 65536) - 32768.0; }); break;
+      case 4: FillValues<uint32_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return 4000000000.0 - (double)i; }); break;
+      case 5: FillValues<int32_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return -2000000000.0 + 3.0 * i; }); break;
+      case 6: FillValues<uint64_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return 1099511627776.0 + (double)i; }); break;
+      case 7: FillValues<int64_t>(array.Bytes, array.Expected, numValues, [](size_t i) { return -1099511627776.0 + (double)i; }); break;
+      case 8: FillValues<float>(array.Bytes, array.Expected, numValues, [](size_t i) { return 0.37 * i - 10.0; }); break;
+      default: FillValues<double>(array.Bytes, array.Expected, numValues, [](size_t i) { return 0.1 * i - 5.0 + 1.0e-9; }); break;
+    }
+    return array;
+  }
+
+  // Usda type of the primvar; only int, float and double tuples map to vector types, other tuples are flattened
+  std::string ExpectedTypeName(OmniConnectType type, bool doubleToFloat)
+  {
+    const char* scalarNames[OmniConnectNumFundamentalTypes] = { "uchar", "int", "uint", "int", "uint", "int", "uint64", "int64", "float", "double" };
+    int kind = (int)type % OmniConnectNumFundamentalTypes;
+    int numComponents = (int)type / OmniConnectNumFundamentalTypes + 1;
+
+    std::string typeName = (kind == 9 && doubleToFloat) ? "float" : scalarNames[kind];
+    if (numComponents > 1 && (kind == 5 || kind == 8 || kind == 9))
+      typeName += std::to_string(numComponents);
+    return typeName + "[]";
+  }
+
+  int RoundTrip(const std::string& outputDir, bool doubleToFloat)
+  {
+    std::vector<TypedArray> arrays;
+    for (int type = 0; type < (int)OmniConnectType::UNDEFINED; ++type)
+      arrays.push_back(MakeArray((OmniConnectType)type));
+
+    std::vector<float> points;
+    std::vector<unsigned int> indices;
+    for (int i = 0; i < NumPoints; ++i)
+    {
+      for (int c = 0; c < 3; ++c)
+        points.push_back((float)(i % 3 == c) + (float)(i / 3));
+      indices.push_back((unsigned int)i);
+    }
+
+    {
+      std::unique_ptr<OmniConnect> connector = OpenConnector(outputDir);
+      vtkOmniConnectTestAssert(connector, "Cannot initialize local output");
+      connector->SetConvertGenericArraysDoubleToFloat(doubleToFloat);
+      connector->CreateActor(0, "Actor");
+
+      std::vector<OmniConnectGenericArray> genericArrays;
+      for (TypedArray& array : arrays)
+        genericArrays.emplace_back(array.Name.c_str(), false, false, array.Bytes.data(), NumPoints, array.Type);
+
+      OmniConnectMeshData meshData;
+      meshData.MeshId = 0;
+      meshData.NumPoints = NumPoints;
+      meshData.Points = points.data();
+      meshData.PointsType = OmniConnectType::FLOAT3;
+      meshData.Indices = indices.data();
+      meshData.NumIndices = indices.size();
+      connector->UpdateMesh(0, 0.0, meshData, 0, genericArrays.data(), genericArrays.size(), nullptr, 0);
+
+      // The output may not refer to the source buffers anymore
+      for (TypedArray& array : arrays)
+        std::memset(array.Bytes.data(), 0x5a, array.Bytes.size());
+
+      connector->FlushActorUpdates(0);
+      connector->FlushSceneUpdates();
+    }
+
+    std::string layers = vtkOmniConnectTesting::ReadAllLayers(outputDir);
+    for (const TypedArray& array : arrays)
+    {
+      std::string declaration = ExpectedTypeName(array.Type, doubleToFloat) + " primvars:" + array.Name;
+      std::vector<std::string> values = vtkOmniConnectTesting::FindAttributeValues(layers, declaration);
+      vtkOmniConnectTestAssert(!values.empty(), "No primvar \"" << declaration << "\" written");
+
+      std::vector<double> readValues = vtkOmniConnectTesting::ParseNumbers(values.back());
+      vtkOmniConnectTestAssert(readValues.size() == array.Expected.size(),
+        array.Name << " read back with " << readValues.size() << " values instead of " << array.Expected.size());
+      // Float values are written with the shortest representation that reads back as the same float
+      int kind = (int)array.Type % OmniConnectNumFundamentalTypes;
+      bool isFloat = kind == 8 || (kind == 9 && doubleToFloat);
+      for (size_t i = 0; i < readValues.size(); ++i)
+      {
+        double expected = array.Expected[i];
+        bool matches = isFloat ? (float)readValues[i] == (float)expected : readValues[i] == expected;
+        vtkOmniConnectTestAssert(matches, array.Name << " value " << i << " read back as " << readValues[i] << " instead of " << expected);
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectGenericArrays(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectGenericArrays");
+
+  std::string nativeDir = outputDir + "Native/";
+  std::string convertedDir = outputDir + "DoubleToFloat/";
+  vtksys::SystemTools::MakeDirectory(nativeDir);
+  vtksys::SystemTools::MakeDirectory(convertedDir);
+
+  if (RoundTrip(nativeDir, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  return RoundTrip(convertedDir, true);
+}
@@ -0,0 +1,178 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+// Renders meshes, lines, glyphs and a volume headlessly, once into local files and once through the
+// null connection, which only counts the asset writes.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkActor.h"
+#include "vtkMapper.h"
+#include "vtkVolume.h"
+#include "vtkAbstractVolumeMapper.h"
+#include "vtkPolyData.h"
+#include "vtkImageData.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+
+namespace
+{
+  void BuildScene(vtkOmniConnectTestScene& scene, vtkActor*& mesh, vtkActor*& lines, vtkActor*& glyphs, vtkVolume*& volume)
+  {
+    mesh = scene.AddMesh("Mesh", vtkOmniConnectTesting::MakeMesh(16));
+    lines = scene.AddMesh("Lines", vtkOmniConnectTesting::MakeLines(8, 32));
+    glyphs = scene.AddGlyphs("Glyphs", vtkOmniConnectTesting::MakeGlyphPoints(100));
+    volume = scene.AddVolume("Volume", vtkOmniConnectTesting::MakeVolume(16));
+  }
+
+  void RenderFrames(vtkOmniConnectTestScene& scene, vtkActor* mesh, vtkActor* lines, vtkActor* glyphs, vtkVolume* volume, int numFrames)
+  {
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+      double phase = 0.5 * frame;
+      mesh->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(16, phase));
+      lines->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeLines(8, 32, phase));
+      glyphs->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeGlyphPoints(100, phase));
+      volume->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeVolume(16, phase));
+      for (vtkProp3D* prop : { (vtkProp3D*)mesh, (vtkProp3D*)lines, (vtkProp3D*)glyphs, (vtkProp3D*)volume })
+        scene.SetAnimTime(prop, frame);
+
+      scene.Render(frame);
+    }
+  }
+
+  bool HasFileWithExtension(const std::vector<std::string>& fileNames, const char* ext)
+  {
+    for (const std::string& fileName : fileNames)
+    {
+      if (vtksys::SystemTools::GetFilenameLastExtension(fileName) == ext)
+        return true;
+    }
+    return false;
+  }
+
+  const OmniConnectProfiler::Statistic* FindStatistic(const std::vector<OmniConnectProfiler::Statistic>& statistics, const char* name)
+  {
+    for (const OmniConnectProfiler::Statistic& stat : statistics)
+    {
+      if (strcmp(stat.Name, name) == 0)
+        return &stat;
+    }
+    return nullptr;
+  }
+}
+
+int TestOmniConnectHeadlessScene(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectHeadlessScene");
+  const int numFrames = 3;
+
+  // Local file output
+  std::string localDir = outputDir + "Local/";
+  vtksys::SystemTools::MakeDirectory(localDir);
+  {
+    vtkOmniConnectTestScene scene;
+    vtkOmniConnectTestAssert(scene.Initialize(vtkOmniConnectTestScene::MakeSettings(localDir)), "Cannot initialize local output");
+
+    vtkActor *mesh, *lines, *glyphs; vtkVolume* volume;
+    BuildScene(scene, mesh, lines, glyphs, volume);
+
+    OmniConnectProfiler::SetEnabled(true);
+    OmniConnectProfiler::ResetStatistics();
+
+    RenderFrames(scene, mesh, lines, glyphs, volume, numFrames);
+
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    OmniConnectProfiler::GetStatistics(statistics);
+    OmniConnectProfiler::SetEnabled(false);
+
+    for (const char* scope : { "Gather", "Triangulate", "UpdateMesh", "UpdateCurve", "UpdateInstancer", "UpdateVolume", "SerializeVolume", "SaveLayer" })
+    {
+      const OmniConnectProfiler::Statistic* stat = FindStatistic(statistics, scope);
+      vtkOmniConnectTestAssert(stat && stat->Count > 0, "No profiler scope " << scope << " recorded");
+    }
+    vtkOmniConnectTestAssert(!FindStatistic(statistics, "DiscardedWriteBytes"), "Local output is not supposed to discard writes");
+
+    std::string sessionDir = scene.GetSessionDirectory();
+    scene.Shutdown();
+
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(sessionDir, fileNames);
+    vtkOmniConnectTestAssert(vtksys::SystemTools::FileExists(sessionDir + "FullScene.usda"), "No scene layer written");
+    vtkOmniConnectTestAssert(vtksys::SystemTools::FileExists(localDir + "Session.usda"), "No root level layer written");
+#ifdef OMNICONNECT_TEST_USE_OPENVDB
+    vtkOmniConnectTestAssert(HasFileWithExtension(fileNames, ".vdb"), "No volume asset written");
+#endif
+
+    std::string layers = vtkOmniConnectTesting::ReadAllLayers(sessionDir);
+    for (const char* actorName : { "Mesh", "Lines", "Glyphs", "Volume" })
+      vtkOmniConnectTestAssert(layers.find(actorName) != std::string::npos, "Actor " << actorName << " missing from the output");
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+      std::string timeSample = std::to_string(frame) + ": ";
+      vtkOmniConnectTestAssert(layers.find(timeSample) != std::string::npos, "Time sample " << frame << " missing from the output");
+    }
+  }
+
+  // Null connection: same layers, no asset files
+  std::string nullDir = outputDir + "Null/";
+  vtksys::SystemTools::MakeDirectory(nullDir);
+  {
+    vtkOmniConnectSettings settings = vtkOmniConnectTestScene::MakeSettings(nullDir);
+    settings.DiscardAssetWrites = true;
+
+    vtkOmniConnectTestScene scene;
+    vtkOmniConnectTestAssert(scene.Initialize(settings), "Cannot initialize the null connection");
+
+    vtkActor *mesh, *lines, *glyphs; vtkVolume* volume;
+    BuildScene(scene, mesh, lines, glyphs, volume);
+
+    OmniConnectProfiler::SetEnabled(true);
+    OmniConnectProfiler::ResetStatistics();
+
+    RenderFrames(scene, mesh, lines, glyphs, volume, numFrames);
+
+    std::string sessionDir = scene.GetSessionDirectory();
+    scene.Shutdown();
+
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    OmniConnectProfiler::GetStatistics(statistics);
+    OmniConnectProfiler::SetEnabled(false);
+
+#ifdef OMNICONNECT_TEST_USE_OPENVDB
+    vtkOmniConnectStageTimings timings;
+    timings.Accumulate(statistics);
+    vtkOmniConnectTestAssert(timings.DiscardedWriteBytes > 0, "Null connection did not count any volume writes");
+#endif
+
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(sessionDir, fileNames);
+    vtkOmniConnectTestAssert(vtksys::SystemTools::FileExists(sessionDir + "FullScene.usda"), "Layers are supposed to be written with the null connection");
+    vtkOmniConnectTestAssert(!HasFileWithExtension(fileNames, ".vdb"), "Volume asset written despite the null connection");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+// Unit test of the open-addressing id map of the connector caches, against std::map as the reference: inserts,
+// erases by id and during iteration, reuse of the slots of erased entries without growing, and growth keeping
+// references to the entries valid.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "OmniConnectIdMap.h"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using ValueType = std::string;
+
+  class TestIdMap : public OmniConnectIdMap<ValueType>
+  {
+  public:
+    size_t NumSlots() const { return Slots.size(); }
+  };
+
+  std::string Value(size_t id, int version = 0)
+  {
+    return "Value" + std::to_string(id) + "." + std::to_string(version);
+  }
+
+  // Ids that are consecutive, spread out, or share their low bits, as actor and geom ids come from different sources
+  std::vector<size_t> MakeIds(size_t numIds, unsigned int seed)
+  {
+    std::mt19937_64 rng(seed);
+    std::set<size_t> used;
+    std::vector<size_t> ids;
+    for (size_t i = 0; ids.size() < numIds; ++i)
+    {
+      size_t id;
+      switch (i % 3)
+      {
+      case 0: id = i; break;
+      case 1: id = i << 32; break;
+      default: id = (size_t)rng(); break;
+      }
+      if (used.insert(id).second)
+        ids.push_back(id);
+    }
+    return ids;
+  }
+
+  int CheckEqual(const TestIdMap& idMap, const std::map<size_t, ValueType>& reference)
+  {
+    vtkOmniConnectTestAssert(idMap.size() == reference.size(), "Map has " << idMap.size() << " entries instead of " << reference.size());
+    vtkOmniConnectTestAssert(idMap.empty() == reference.empty(), "Map emptiness differs");
+
+    for (const auto& refEntry : reference)
+    {
+      auto it = idMap.find(refEntry.first);
+      vtkOmniConnectTestAssert(it != idMap.end(), "Id " << refEntry.first << " not found");
+      vtkOmniConnectTestAssert(it->first == refEntry.first && it->second == refEntry.second, "Id " << refEntry.first << " has the wrong entry");
+    }
+
+    // Iteration visits every entry once
+    std::set<size_t> visited;
+    for (const auto& entry : idMap)
+    {
+      vtkOmniConnectTestAssert(visited.insert(entry.first).second, "Id " << entry.first << " visited twice");
+      vtkOmniConnectTestAssert(reference.count(entry.first) != 0, "Erased id " << entry.first << " visited");
+    }
+    vtkOmniConnectTestAssert(visited.size() == reference.size(), "Iteration missed entries");
+
+    // At most half of the slots are used, in a power of two
+    size_t numSlots = idMap.NumSlots();
+    vtkOmniConnectTestAssert((numSlots & (numSlots - 1)) == 0 && idMap.size() * 2 <= numSlots, "Map of " << idMap.size() << " entries has " << numSlots << " slots");
+
+    return EXIT_SUCCESS;
+  }
+
+  int TestInsert()
+  {
+    TestIdMap idMap;
+    std::map<size_t, ValueType> reference;
+
+    vtkOmniConnectTestAssert(idMap.find(0) == idMap.end() && idMap.erase(size_t(0)) == 0, "Empty map finds an entry");
+
+    std::vector<size_t> ids = MakeIds(300, 1);
+    for (size_t id : ids)
+    {
+      auto result = idMap.emplace(id, Value(id));
+      vtkOmniConnectTestAssert(result.second && result.first->first == id && result.first->second == Value(id), "Insert of id " << id << " failed");
+      reference.emplace(id, Value(id));
+    }
+    if (CheckEqual(idMap, reference) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // Inserting an existing id returns its entry and keeps the value
+    for (size_t id : ids)
+    {
+      auto result = idMap.emplace(id, Value(id, 1));
+      vtkOmniConnectTestAssert(!result.second && result.first->first == id && result.first->second == Value(id), "Repeated insert of id " << id << " replaced the entry");
+    }
+
+    // Ids that were never inserted are not found
+    std::set<size_t> idSet(ids.begin(), ids.end());
+    for (size_t id : MakeIds(300, 2))
+    {
+      if (idSet.count(id) == 0)
+        vtkOmniConnectTestAssert(idMap.find(id) == idMap.end(), "Id " << id << " found without being inserted");
+    }
+
+    idMap.clear();
+    reference.clear();
+    if (CheckEqual(idMap, reference) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    vtkOmniConnectTestAssert(idMap.emplace(ids[0], Value(ids[0])).second, "Insert after clear failed");
+
+    return EXIT_SUCCESS;
+  }
+
+  int TestErase()
+  {
+    TestIdMap idMap;
+    std::map<size_t, ValueType> reference;
+
+    std::vector<size_t> ids = MakeIds(500, 3);
+    for (size_t id : ids)
+    {
+      idMap.emplace(id, Value(id));
+      reference.emplace(id, Value(id));
+    }
+
+    // Erase by id, including ids which are not in the map
+    for (size_t i = 0; i < ids.size(); i += 4)
+    {
+      vtkOmniConnectTestAssert(idMap.erase(ids[i]) == 1, "Erase of id " << ids[i] << " failed");
+      vtkOmniConnectTestAssert(idMap.erase(ids[i]) == 0, "Id " << ids[i] << " erased twice");
+      reference.erase(ids[i]);
+    }
+    if (CheckEqual(idMap, reference) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // Erase during iteration; the returned iterator points to the entry moved into the erased place, which is visited next
+    size_t numBefore = idMap.size();
+    std::set<size_t> visited;
+    for (auto it = idMap.begin(); it != idMap.end();)
+    {
+      vtkOmniConnectTestAssert(visited.insert(it->first).second, "Id " << it->first << " visited twice while erasing");
+      if (it->first % 2 == 0)
+      {
+        reference.erase(it->first);
+        it = idMap.erase(it);
+      }
+      else
+        ++it;
+    }
+    vtkOmniConnectTestAssert(visited.size() == numBefore, "Iteration while erasing visited " << visited.size() << " of " << numBefore << " entries");
+    if (CheckEqual(idMap, reference) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // Erased ids can be inserted again
+    for (size_t i = 0; i < ids.size(); i += 4)
+    {
+      vtkOmniConnectTestAssert(idMap.emplace(ids[i], Value(ids[i], 2)).second, "Reinsert of id " << ids[i] << " failed");
+      reference[ids[i]] = Value(ids[i], 2);
+    }
+    return CheckEqual(idMap, reference);
+  }
+
+  // Erasing leaves no tombstones behind: a map of constant size under a long churn of erases and inserts of new ids
+  // keeps its slot count, and lookups of every entry stay correct
+  int TestSlotReuse()
+  {
+    const size_t numEntries = 1000;
+    const size_t numRounds = 100000;
+
+    TestIdMap idMap;
+    std::map<size_t, ValueType> reference;
+    std::vector<size_t> liveIds;
+
+    std::mt19937_64 rng(4);
+    size_t nextId = 0;
+    for (; liveIds.size() < numEntries; ++nextId)
+    {
+      idMap.emplace(nextId, Value(nextId));
+      reference.emplace(nextId, Value(nextId));
+      liveIds.push_back(nextId);
+    }
+    size_t numSlots = idMap.NumSlots();
+
+    for (size_t round = 0; round < numRounds; ++round)
+    {
+      size_t liveIdx = (size_t)(rng() % liveIds.size());
+      size_t erasedId = liveIds[liveIdx];
+      vtkOmniConnectTestAssert(idMap.erase(erasedId) == 1, "Erase of id " << erasedId << " failed in round " << round);
+      reference.erase(erasedId);
+
+      // Half of the new ids are far apart, half follow on
+      size_t newId = (round % 2) ? (size_t)rng() : nextId++;
+      if (reference.count(newId))
+        newId = nextId++;
+      vtkOmniConnectTestAssert(idMap.emplace(newId, Value(newId)).second, "Insert of id " << newId << " failed in round " << round);
+      reference.emplace(newId, Value(newId));
+      liveIds[liveIdx] = newId;
+
+      vtkOmniConnectTestAssert(idMap.find(erasedId) == idMap.end(), "Erased id " << erasedId << " still found in round " << round);
+      vtkOmniConnectTestAssert(idMap.NumSlots() == numSlots, "Slots grew from " << numSlots << " to " << idMap.NumSlots() << " in round " << round);
+
+      if (round % 10000 == 0 && CheckEqual(idMap, reference) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+    return CheckEqual(idMap, reference);
+  }
+
+  // Growing rehashes the slots, but the entries themselves stay in place
+  int TestGrowth()
+  {
+    TestIdMap idMap;
+    std::map<size_t, ValueType> reference;
+    std::map<size_t, const ValueType*> addresses;
+
+    std::vector<size_t> ids = MakeIds(20000, 5);
+    size_t numSlots = idMap.NumSlots();
+    size_t numGrowths = 0;
+    for (size_t id : ids)
+    {
+      auto result = idMap.emplace(id, Value(id));
+      reference.emplace(id, Value(id));
+      addresses.emplace(id, &result.first->second);
+
+      if (idMap.NumSlots() != numSlots)
+      {
+        vtkOmniConnectTestAssert(idMap.NumSlots() == (numSlots ? numSlots * 2 : 16), "Slots grew from " << numSlots << " to " << idMap.NumSlots());
+        numSlots = idMap.NumSlots();
+        ++numGrowths;
+
+        for (const auto& address : addresses)
+          vtkOmniConnectTestAssert(&idMap.find(address.first)->second == address.second && *address.second == Value(address.first),
+            "Entry of id " << address.first << " moved when growing to " << numSlots << " slots");
+      }
+    }
+    vtkOmniConnectTestAssert(numGrowths > 10, "Map only grew " << numGrowths << " times");
+
+    // Erasing moves the last entry into the erased place in the iteration order, but not in memory
+    for (size_t i = 0; i < ids.size(); i += 3)
+    {
+      idMap.erase(ids[i]);
+      reference.erase(ids[i]);
+      addresses.erase(ids[i]);
+    }
+    for (const auto& address : addresses)
+      vtkOmniConnectTestAssert(&idMap.find(address.first)->second == address.second, "Entry of id " << address.first << " moved when erasing");
+
+    return CheckEqual(idMap, reference);
+  }
+}
+
+int TestOmniConnectIdMap(int argc, char* argv[])
+{
+  if (TestInsert() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (TestErase() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (TestSlotReuse() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (TestGrowth() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Writes decimated levels of detail of meshes with unsorted triangle budgets, and checks that every level written stays
+// within its budget and that each variant of the LOD variant set shows exactly one level of the mesh.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectRendererNode.h"
+#include "vtkActor.h"
+#include "vtkCellArray.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // Largest number of ints in the faceVertexIndices values of a layer, either as default or as time samples
+  size_t CountFaceVertexIndices(const std::string& layer)
+  {
+    const std::string declaration = "int[] faceVertexIndices";
+    size_t numIndices = 0;
+    for (size_t pos = layer.find(declaration); pos != std::string::npos; pos = layer.find(declaration, pos + 1))
+    {
+      size_t valueStart = pos + declaration.size();
+      size_t valueEnd = std::string::npos;
+      if (layer.compare(valueStart, 3, " = ") == 0)
+        valueEnd = layer.find('\n', valueStart);
+      else if (layer.compare(valueStart, 16, ".timeSamples = {") == 0)
+        valueEnd = layer.find('}', valueStart);
+
+      for (size_t arrayStart = layer.find('[', valueStart); arrayStart < valueEnd; arrayStart = layer.find('[', arrayStart + 1))
+      {
+        size_t arrayEnd = layer.find(']', arrayStart);
+        if (arrayEnd > arrayStart + 1 && arrayEnd != std::string::npos)
+          numIndices = std::max(numIndices, size_t(1 + std::count(layer.begin() + arrayStart, layer.begin() + arrayEnd, ',')));
+      }
+    }
+    return numIndices;
+  }
+
+  // Body of a variant in a variant set, up to its matching closing brace
+  std::string GetVariantBody(const std::string& layer, const std::string& variantName)
+  {
+    size_t start = layer.find("\"" + variantName + "\" {");
+    if (start == std::string::npos)
+      return std::string();
+    start = layer.find('{', start);
+    int depth = 0;
+    for (size_t pos = start; pos < layer.size(); ++pos)
+    {
+      depth += (layer[pos] == '{') ? 1 : ((layer[pos] == '}') ? -1 : 0);
+      if (depth == 0)
+        return layer.substr(start, pos - start + 1);
+    }
+    return std::string();
+  }
+
+  // Names of the prims deactivated in a variant body
+  std::set<std::string> GetInactivePrims(const std::string& variantBody)
+  {
+    std::set<std::string> prims;
+    for (size_t pos = variantBody.find("over \""); pos != std::string::npos; pos = variantBody.find("over \"", pos + 1))
+    {
+      size_t nameStart = pos + 6;
+      size_t nameEnd = variantBody.find('"', nameStart);
+      size_t metadataEnd = variantBody.find(')', nameEnd);
+      if (variantBody.find("active = false", nameEnd) < metadataEnd)
+        prims.insert(variantBody.substr(nameStart, nameEnd - nameStart));
+    }
+    return prims;
+  }
+
+  int CheckLevelsOfDetail(const std::string& outputDir, const char* sessionName, int meshResolution, const int budgets[3])
+  {
+    vtkOmniConnectTestScene scene;
+    vtkOmniConnectTestAssert(scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir, sessionName)), "Cannot initialize local output");
+
+    vtkOmniConnectRendererNode* rendererNode = scene.GetRendererNode();
+    rendererNode->SetLodTriangleBudgets(budgets[0], budgets[1], budgets[2]);
+    const int* lodBudgets = rendererNode->GetLodTriangleBudgets();
+
+    vtkSmartPointer<vtkPolyData> mesh = vtkOmniConnectTesting::MakeMesh(meshResolution);
+    vtkIdType numTriangles = 0;
+    for (vtkIdType cellIdx = 0; cellIdx < mesh->GetPolys()->GetNumberOfCells(); ++cellIdx)
+      numTriangles += mesh->GetPolys()->GetCellSize(cellIdx) - 2;
+
+    vtkActor* actor = scene.AddMesh("Mesh", mesh);
+    scene.SetAnimTime(actor, 0.0);
+    scene.Render(0.0);
+    // Unchanged input, so the levels are only tagged as still in use
+    scene.Render(0.0);
+
+    std::string sessionDir = scene.GetSessionDirectory();
+    scene.Shutdown();
+
+    // A level is written whenever the mesh exceeds its budget, and stays within it
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(sessionDir, fileNames);
+    std::string actorLayer;
+    size_t levelIndices[3] = { 0, 0, 0 };
+    for (const std::string& fileName : fileNames)
+    {
+      std::string layer;
+      vtkOmniConnectTestAssert(vtkOmniConnectTesting::ReadFile(sessionDir + fileName, layer), "Cannot read " << fileName);
+      if (layer.find("variantSet \"LOD\"") != std::string::npos)
+        actorLayer = layer;
+      for (int level = 1; level <= 3; ++level)
+      {
+        if (fileName.find("_LOD" + std::to_string(level) + "_MeshGeom_") != std::string::npos)
+          levelIndices[level-1] = std::max(levelIndices[level-1], CountFaceVertexIndices(layer));
+      }
+    }
+
+    int numWrittenLevels = 0;
+    for (int level = 1; level <= 3; ++level)
+    {
+      size_t numLevelIndices = levelIndices[level-1];
+
+      bool expectLevel = lodBudgets[level-1] > 0 && numTriangles > lodBudgets[level-1];
+      vtkOmniConnectTestAssert(expectLevel == (numLevelIndices > 0),
+        "Level " << level << " with a budget of " << lodBudgets[level-1] << " for " << numTriangles << " triangles " << (expectLevel ? "not written" : "written"));
+      vtkOmniConnectTestAssert(numLevelIndices / 3 <= size_t(lodBudgets[level-1]),
+        "Level " << level << " has " << numLevelIndices / 3 << " triangles, over its budget of " << lodBudgets[level-1]);
+      numWrittenLevels += expectLevel ? 1 : 0;
+    }
+    vtkOmniConnectTestAssert(numWrittenLevels > 0, "Mesh of " << numTriangles << " triangles is within all budgets, no levels to check");
+    vtkOmniConnectTestAssert(!actorLayer.empty(), "No LOD variant set written");
+
+    // Every variant shows a single level: the requested one, or the next finer one that exists
+    std::set<std::string> allPrims;
+    std::vector<std::set<std::string>> inactivePrims(4);
+    for (int level = 0; level <= 3; ++level)
+    {
+      std::string variantName = (level == 0) ? "full" : "lod" + std::to_string(level);
+      std::string variantBody = GetVariantBody(actorLayer, variantName);
+      vtkOmniConnectTestAssert(!variantBody.empty(), "Variant " << variantName << " missing");
+      inactivePrims[level] = GetInactivePrims(variantBody);
+      allPrims.insert(inactivePrims[level].begin(), inactivePrims[level].end());
+    }
+    vtkOmniConnectTestAssert(allPrims.size() == size_t(numWrittenLevels + 1),
+      allPrims.size() << " mesh prims in the LOD variants, expected " << numWrittenLevels + 1);
+
+    std::string basePrim = *allPrims.begin(); // The mesh itself sorts before its levels
+    for (int level = 0; level <= 3; ++level)
+    {
+      std::string shownPrim = basePrim;
+      for (int shownLevel = level; shownLevel > 0; --shownLevel)
+      {
+        if (allPrims.count(basePrim + "_LOD" + std::to_string(shownLevel)))
+        {
+          shownPrim = basePrim + "_LOD" + std::to_string(shownLevel);
+          break;
+        }
+      }
+      vtkOmniConnectTestAssert(inactivePrims[level].size() == allPrims.size() - 1 && !inactivePrims[level].count(shownPrim),
+        "Variant of level " << level << " doesn't show exactly " << shownPrim);
+    }
+
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectLevelsOfDetail(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectLevelsOfDetail");
+
+  // Budgets are ordered from fine to coarse, duplicates are disabled
+  {
+    vtkOmniConnectTestScene scene;
+    vtkOmniConnectTestAssert(scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir, "Budgets")), "Cannot initialize local output");
+    vtkOmniConnectRendererNode* rendererNode = scene.GetRendererNode();
+
+    rendererNode->SetLodTriangleBudgets(300, 3000, 60);
+    const int* lodBudgets = rendererNode->GetLodTriangleBudgets();
+    vtkOmniConnectTestAssert(lodBudgets[0] == 3000 && lodBudgets[1] == 300 && lodBudgets[2] == 60, "Budgets not sorted decreasingly");
+
+    rendererNode->SetLodTriangleBudgets(0, 500, 500);
+    vtkOmniConnectTestAssert(lodBudgets[0] == 500 && lodBudgets[1] == 0 && lodBudgets[2] == 0, "Duplicate budgets not disabled");
+    vtkOmniConnectTestAssert(rendererNode->HasLodTriangleBudgets(), "Single budget disabled");
+  }
+
+  // All levels of a large mesh, and the coarser levels of a small one
+  const int budgets[3] = { 300, 3000, 60 };
+  if (CheckLevelsOfDetail(outputDir, "Large", 64, budgets) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (CheckLevelsOfDetail(outputDir, "Small", 16, budgets) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Writes a volume split into 64 image blocks next to the same volume as a single image, and checks that every block
+// becomes a volume of its own covering the same region. Coarse AMR cells refined by a finer block are blanked.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVolume.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // Block of points [start, start+dim) along every axis of a volume
+  vtkSmartPointer<vtkImageData> ExtractBlock(vtkImageData* volume, const int start[3], int dim)
+  {
+    int volumeDims[3];
+    volume->GetDimensions(volumeDims);
+    double spacing[3];
+    volume->GetSpacing(spacing);
+    double* origin = volume->GetOrigin();
+
+    vtkSmartPointer<vtkImageData> block = vtkSmartPointer<vtkImageData>::New();
+    block->SetDimensions(dim, dim, dim);
+    block->SetSpacing(spacing);
+    block->SetOrigin(origin[0] + start[0] * spacing[0], origin[1] + start[1] * spacing[1], origin[2] + start[2] * spacing[2]);
+
+    vtkDataArray* volumeScalars = volume->GetPointData()->GetScalars();
+    vtkNew<vtkFloatArray> scalars;
+    scalars->SetName(volumeScalars->GetName());
+    scalars->SetNumberOfTuples(static_cast<vtkIdType>(dim) * dim * dim);
+    vtkIdType idx = 0;
+    for (int z = 0; z < dim; ++z)
+      for (int y = 0; y < dim; ++y)
+        for (int x = 0; x < dim; ++x, ++idx)
+        {
+          vtkIdType volumeIdx = ((static_cast<vtkIdType>(start[2] + z) * volumeDims[1]) + start[1] + y) * volumeDims[0] + start[0] + x;
+          scalars->SetValue(idx, static_cast<float>(volumeScalars->GetTuple1(volumeIdx)));
+        }
+    block->GetPointData()->SetScalars(scalars);
+    return block;
+  }
+
+  // Cube of dim^3 cells with constant cell scalars, of which the cells with x below markedX have ghostType set
+  vtkSmartPointer<vtkImageData> MakeAmrLevel(int dim, double spacing, const double origin[3], int markedX, unsigned char ghostType)
+  {
+    vtkSmartPointer<vtkImageData> level = vtkSmartPointer<vtkImageData>::New();
+    level->SetDimensions(dim + 1, dim + 1, dim + 1);
+    level->SetSpacing(spacing, spacing, spacing);
+    level->SetOrigin(origin[0], origin[1], origin[2]);
+
+    vtkIdType numCells = static_cast<vtkIdType>(dim) * dim * dim;
+    vtkNew<vtkFloatArray> density;
+    density->SetName("Density");
+    density->SetNumberOfTuples(numCells);
+    density->Fill(1.0);
+    level->GetCellData()->SetScalars(density);
+
+    vtkNew<vtkUnsignedCharArray> ghosts;
+    ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    ghosts->SetNumberOfTuples(numCells);
+    for (vtkIdType cellIdx = 0; cellIdx < numCells; ++cellIdx)
+      ghosts->SetValue(cellIdx, (cellIdx % dim < markedX) ? ghostType : 0);
+    level->GetCellData()->AddArray(ghosts);
+    return level;
+  }
+
+  int CountFilesWithExtension(const std::vector<std::string>& fileNames, const char* extension)
+  {
+    return static_cast<int>(std::count_if(fileNames.begin(), fileNames.end(),
+      [extension](const std::string& fileName) { return vtksys::SystemTools::GetFilenameLastExtension(fileName) == extension; }));
+  }
+
+  // Distinct names of the volume prims in usda text
+  std::set<std::string> FindVolumePrims(const std::string& layers)
+  {
+    const std::string prefix = "\"VolumeGeom_";
+    std::set<std::string> prims;
+    for (size_t pos = layers.find(prefix); pos != std::string::npos; pos = layers.find(prefix, pos + 1))
+    {
+      size_t nameEnd = layers.find('"', pos + 1);
+      std::string name = layers.substr(pos + 1, nameEnd - pos - 1);
+      if (name.size() > prefix.size() - 1 && std::all_of(name.begin() + prefix.size() - 1, name.end(), [](char c) { return std::isdigit((unsigned char)c) != 0; }))
+        prims.insert(name);
+    }
+    return prims;
+  }
+
+  // Union of all extents authored in usda text, as min/max per axis; false if there are none
+  bool GetExtentUnion(const std::string& layers, double bounds[6])
+  {
+    const std::string declaration = "float3[] extent";
+    bool found = false;
+    for (size_t pos = layers.find(declaration); pos != std::string::npos; pos = layers.find(declaration, pos + 1))
+    {
+      size_t valueStart = pos + declaration.size();
+      size_t valueEnd = std::string::npos;
+      if (layers.compare(valueStart, 3, " = ") == 0)
+        valueEnd = layers.find('\n', valueStart);
+      else if (layers.compare(valueStart, 16, ".timeSamples = {") == 0)
+        valueEnd = layers.find('}', valueStart);
+
+      // Every extent is written as [(minX, minY, minZ), (maxX, maxY, maxZ)]
+      for (size_t arrayStart = layers.find('[', valueStart); arrayStart < valueEnd; arrayStart = layers.find('[', arrayStart + 1))
+      {
+        double values[6];
+        const char* str = layers.c_str() + arrayStart;
+        int numValues = 0;
+        while (numValues < 6 && *str && *str != ']')
+        {
+          char* numberEnd = nullptr;
+          double value = std::strtod(str, &numberEnd);
+          if (numberEnd != str && (std::isdigit((unsigned char)*str) || *str == '-' || *str == '.'))
+          {
+            values[numValues++] = value;
+            str = numberEnd;
+          }
+          else
+            ++str;
+        }
+        if (numValues < 6)
+          continue;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          bounds[2 * axis] = found ? std::min(bounds[2 * axis], values[axis]) : values[axis];
+          bounds[2 * axis + 1] = found ? std::max(bounds[2 * axis + 1], values[axis + 3]) : values[axis + 3];
+        }
+        found = true;
+      }
+    }
+    return found;
+  }
+
+  bool RenderVolume(const std::string& outputDir, const char* sessionName, vtkDataObject* volumeData, std::string& sessionDir)
+  {
+    vtkOmniConnectTestScene scene;
+    if (!scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir, sessionName)))
+      return false;
+
+    vtkVolume* volume = scene.AddVolume("Volume", volumeData);
+    scene.SetAnimTime(volume, 0.0);
+    scene.Render(0.0);
+
+    sessionDir = scene.GetSessionDirectory();
+    scene.Shutdown();
+    return true;
+  }
+}
+
+int TestOmniConnectMultiBlockVolume(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectMultiBlockVolume");
+
+  // 4x4x4 blocks of 9^3 points, sharing their boundary points like the pieces of a distributed image
+  const int blockCells = 8;
+  const int blocksPerAxis = 4;
+  vtkSmartPointer<vtkImageData> singleVolume = vtkOmniConnectTesting::MakeVolume(blockCells * blocksPerAxis + 1);
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(blocksPerAxis * blocksPerAxis * blocksPerAxis);
+  for (unsigned int blockIdx = 0; blockIdx < blocks->GetNumberOfBlocks(); ++blockIdx)
+  {
+    int start[3] = { int(blockIdx % blocksPerAxis) * blockCells, int(blockIdx / blocksPerAxis % blocksPerAxis) * blockCells,
+      int(blockIdx / (blocksPerAxis * blocksPerAxis)) * blockCells };
+    blocks->SetBlock(blockIdx, ExtractBlock(singleVolume, start, blockCells + 1));
+  }
+
+  std::string singleDir, blocksDir;
+  vtkOmniConnectTestAssert(RenderVolume(outputDir, "Single", singleVolume, singleDir), "Cannot initialize local output");
+  vtkOmniConnectTestAssert(RenderVolume(outputDir, "Blocks", blocks, blocksDir), "Cannot initialize local output");
+
+  // A volume per block, together covering the region of the single volume
+  std::string singleLayers = vtkOmniConnectTesting::ReadAllLayers(singleDir);
+  std::string blockLayers = vtkOmniConnectTesting::ReadAllLayers(blocksDir);
+  size_t numSingleVolumes = FindVolumePrims(singleLayers).size();
+  size_t numBlockVolumes = FindVolumePrims(blockLayers).size();
+  vtkOmniConnectTestAssert(numSingleVolumes == 1, numSingleVolumes << " volumes written for a single image");
+  vtkOmniConnectTestAssert(numBlockVolumes == blocks->GetNumberOfBlocks(),
+    numBlockVolumes << " volumes written for " << blocks->GetNumberOfBlocks() << " blocks");
+
+  double singleBounds[6], blockBounds[6];
+  vtkOmniConnectTestAssert(GetExtentUnion(singleLayers, singleBounds), "No extent written for the single volume");
+  vtkOmniConnectTestAssert(GetExtentUnion(blockLayers, blockBounds), "No extents written for the volume blocks");
+  for (int i = 0; i < 6; ++i)
+    vtkOmniConnectTestAssert(std::fabs(singleBounds[i] - blockBounds[i]) < 1.0e-4,
+      "Volume blocks cover " << blockBounds[i] << " instead of " << singleBounds[i] << " at bound " << i);
+
+#ifdef OMNICONNECT_TEST_USE_OPENVDB
+  std::vector<std::string> fileNames;
+  vtkOmniConnectTesting::ListFiles(singleDir, fileNames);
+  vtkOmniConnectTestAssert(CountFilesWithExtension(fileNames, ".vdb") == 1, "Single volume not written as one vdb asset");
+  vtkOmniConnectTesting::ListFiles(blocksDir, fileNames);
+  vtkOmniConnectTestAssert(CountFilesWithExtension(fileNames, ".vdb") == int(blocks->GetNumberOfBlocks()), "Volume blocks not written as one vdb asset each");
+
+  // A coarse level of which half is covered by a finer level, with those cells marked once as refined and once as duplicate.
+  // Both write the same ghost array next to the density.
+  const double origin[3] = { 0.0, 0.0, 0.0 };
+  const unsigned char ghostTypes[2] = { vtkDataSetAttributes::DUPLICATECELL, vtkDataSetAttributes::REFINEDCELL };
+  std::string amrDirs[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkNew<vtkMultiBlockDataSet> levels;
+    levels->SetNumberOfBlocks(2);
+    levels->SetBlock(0, MakeAmrLevel(16, 2.0, origin, 8, ghostTypes[i]));
+    levels->SetBlock(1, MakeAmrLevel(16, 1.0, origin, 0, 0));
+    vtkOmniConnectTestAssert(RenderVolume(outputDir, i ? "AmrRefined" : "AmrDuplicate", levels, amrDirs[i]), "Cannot initialize local output");
+  }
+
+  // Refined cells become background, so the coarse level keeps only half of its active voxels
+  uint64_t duplicateSize = vtkOmniConnectTesting::GetDirectorySize(amrDirs[0]);
+  uint64_t refinedSize = vtkOmniConnectTesting::GetDirectorySize(amrDirs[1]);
+  vtkOmniConnectTestAssert(refinedSize < duplicateSize, "Refined AMR cells not blanked: " << refinedSize << " bytes written, "
+    << duplicateSize << " with duplicate cells");
+#endif
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Writes mesh normals with every normals encoding and reads them back from the usda output to check the round trip error,
+// checks that normals of an earlier encoding are blocked in a reopened session, and that half float generic arrays are
+// clamped to the half range.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+#include "OmniConnectUtilsInternal.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const double RadToDeg = 180.0 / 3.14159265358979;
+
+  std::unique_ptr<OmniConnect> OpenConnector(const std::string& outputDir, bool createNewSession,
+    OmniConnectNormalsEncoding normalsEncoding, bool genericArraysHalfFloat = false)
+  {
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str(); // Has to outlive the connector
+    settings.RootLevelFileName = "Session";
+    settings.OutputLocal = true;
+    settings.OutputBinary = false;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = createNewSession;
+    settings.NormalsEncoding = normalsEncoding;
+    settings.GenericArraysHalfFloat = genericArraysHalfFloat;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      connector.reset();
+    return connector;
+  }
+
+  // Random unit normals, on the vertices of separate triangles
+  struct NormalsMesh
+  {
+    std::vector<float> Points;
+    std::vector<float> Normals;
+    std::vector<unsigned int> Indices;
+
+    explicit NormalsMesh(size_t numTriangles)
+    {
+      std::mt19937 rng(7);
+      std::normal_distribution<float> dist;
+      for (size_t i = 0; i < 3 * numTriangles; ++i)
+      {
+        float normal[3] = { dist(rng), dist(rng), dist(rng) };
+        float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int c = 0; c < 3; ++c)
+        {
+          this->Normals.push_back(normal[c] / length);
+          this->Points.push_back((float)(i % 3 == c) + (float)(i / 3));
+        }
+        this->Indices.push_back((unsigned int)i);
+      }
+    }
+  };
+
+  void UploadMesh(OmniConnect& connector, NormalsMesh& mesh, OmniConnectGenericArray* genericArrays = nullptr, size_t numGenericArrays = 0)
+  {
+    OmniConnectMeshData meshData;
+    meshData.MeshId = 0;
+    meshData.NumPoints = mesh.Points.size() / 3;
+    meshData.Points = mesh.Points.data();
+    meshData.PointsType = OmniConnectType::FLOAT3;
+    meshData.Normals = mesh.Normals.data();
+    meshData.NormalsType = OmniConnectType::FLOAT3;
+    meshData.Indices = mesh.Indices.data();
+    meshData.NumIndices = mesh.Indices.size();
+    connector.UpdateMesh(0, 0.0, meshData, 0, genericArrays, numGenericArrays, nullptr, 0);
+
+    connector.FlushActorUpdates(0);
+    connector.FlushSceneUpdates();
+  }
+
+  // Largest angle in degrees between the written normals and the ones read back; negative if the count differs
+  double MaxAngularError(const std::vector<float>& normals, const std::vector<float>& readNormals)
+  {
+    if (readNormals.size() != normals.size())
+      return -1.0;
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < normals.size(); i += 3)
+    {
+      double dot = 0.0, readLength = 0.0;
+      for (int c = 0; c < 3; ++c)
+      {
+        dot += normals[i + c] * readNormals[i + c];
+        readLength += readNormals[i + c] * readNormals[i + c];
+      }
+      dot /= std::sqrt(readLength);
+      maxError = std::max(maxError, std::acos(std::min(dot, 1.0)) * RadToDeg);
+    }
+    return maxError;
+  }
+
+  // Normals as read back from the last value authored for the encoding's attribute
+  bool ReadNormals(const std::string& layers, OmniConnectNormalsEncoding encoding, std::vector<float>& readNormals)
+  {
+    const char* declarations[3] = { "normal3f[] normals", "normal3h[] primvars:normals", "int[] primvars:normalsOct" };
+    std::vector<std::string> values = vtkOmniConnectTesting::FindAttributeValues(layers, declarations[(int)encoding]);
+    if (values.empty())
+      return false;
+
+    std::vector<double> numbers = vtkOmniConnectTesting::ParseNumbers(values.back());
+    readNormals.clear();
+    if (encoding == OmniConnectNormalsEncoding::OCTAHEDRAL)
+    {
+      std::vector<int32_t> encoded(numbers.begin(), numbers.end());
+      readNormals.resize(3 * encoded.size());
+      ocutils::OctDecodeNormals(encoded.data(), readNormals.data(), encoded.size());
+    }
+    else
+    {
+      readNormals.assign(numbers.begin(), numbers.end());
+    }
+    return true;
+  }
+
+  bool AllBlocked(const std::vector<std::string>& values)
+  {
+    return !values.empty() && std::all_of(values.begin(), values.end(), [](const std::string& value) { return value.compare(0, 4, "None") == 0; });
+  }
+}
+
+int TestOmniConnectNormalsEncoding(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectNormalsEncoding");
+  NormalsMesh mesh(500);
+
+  // Round trip error of every encoding, through the usda output
+  const OmniConnectNormalsEncoding encodings[3] = { OmniConnectNormalsEncoding::FLOAT, OmniConnectNormalsEncoding::HALF, OmniConnectNormalsEncoding::OCTAHEDRAL };
+  const double maxErrors[3] = { 0.001, 0.05, 0.05 }; // Degrees
+  for (int i = 0; i < 3; ++i)
+  {
+    std::string encodingDir = outputDir + "Encoding" + std::to_string(i) + "/";
+    vtksys::SystemTools::MakeDirectory(encodingDir);
+    {
+      std::unique_ptr<OmniConnect> connector = OpenConnector(encodingDir, true, encodings[i]);
+      vtkOmniConnectTestAssert(connector, "Cannot initialize local output");
+      connector->CreateActor(0, "Actor");
+      UploadMesh(*connector, mesh);
+    }
+
+    std::string layers = vtkOmniConnectTesting::ReadAllLayers(encodingDir);
+    std::vector<float> readNormals;
+    vtkOmniConnectTestAssert(ReadNormals(layers, encodings[i], readNormals), "No normals written with encoding " << i);
+    double maxError = MaxAngularError(mesh.Normals, readNormals);
+    vtkOmniConnectTestAssert(maxError >= 0.0 && maxError < maxErrors[i],
+      "Normals of encoding " << i << " read back with an error of " << maxError << " degrees");
+    if (encodings[i] == OmniConnectNormalsEncoding::OCTAHEDRAL)
+      vtkOmniConnectTestAssert(layers.find("octahedral_snorm16x2") != std::string::npos, "Octahedral normals without decode hint");
+  }
+
+  // Reopening a session with another encoding blocks the normals of the earlier one
+  std::string reopenDir = outputDir + "Reopen/";
+  vtksys::SystemTools::MakeDirectory(reopenDir);
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(reopenDir, true, OmniConnectNormalsEncoding::FLOAT);
+    vtkOmniConnectTestAssert(connector, "Cannot initialize local output");
+    connector->CreateActor(0, "Actor");
+    UploadMesh(*connector, mesh);
+  }
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(reopenDir, false, OmniConnectNormalsEncoding::OCTAHEDRAL);
+    vtkOmniConnectTestAssert(connector, "Cannot reopen the session");
+    connector->CreateActor(0, "Actor");
+    UploadMesh(*connector, mesh);
+  }
+  std::string layers = vtkOmniConnectTesting::ReadAllLayers(reopenDir);
+  vtkOmniConnectTestAssert(AllBlocked(vtkOmniConnectTesting::FindAttributeValues(layers, "normal3f[] normals")), "Float normals of the earlier session remain next to octahedral normals");
+  std::vector<float> readNormals;
+  vtkOmniConnectTestAssert(ReadNormals(layers, OmniConnectNormalsEncoding::OCTAHEDRAL, readNormals) && MaxAngularError(mesh.Normals, readNormals) >= 0.0,
+    "No octahedral normals written in the reopened session");
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(reopenDir, false, OmniConnectNormalsEncoding::HALF);
+    vtkOmniConnectTestAssert(connector, "Cannot reopen the session");
+    connector->CreateActor(0, "Actor");
+    UploadMesh(*connector, mesh);
+  }
+  layers = vtkOmniConnectTesting::ReadAllLayers(reopenDir);
+  vtkOmniConnectTestAssert(AllBlocked(vtkOmniConnectTesting::FindAttributeValues(layers, "int[] primvars:normalsOct")), "Octahedral normals of the earlier session remain next to half normals");
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(reopenDir, false, OmniConnectNormalsEncoding::FLOAT);
+    vtkOmniConnectTestAssert(connector, "Cannot reopen the session");
+    connector->CreateActor(0, "Actor");
+    UploadMesh(*connector, mesh);
+  }
+  layers = vtkOmniConnectTesting::ReadAllLayers(reopenDir);
+  vtkOmniConnectTestAssert(AllBlocked(vtkOmniConnectTesting::FindAttributeValues(layers, "normal3h[] primvars:normals")), "Half normals of the earlier session override float normals");
+  vtkOmniConnectTestAssert(ReadNormals(layers, OmniConnectNormalsEncoding::FLOAT, readNormals) && MaxAngularError(mesh.Normals, readNormals) >= 0.0,
+    "Float normals not rewritten in the reopened session");
+
+  // Half float generic arrays are clamped to the half range instead of overflowing to infinity
+  std::vector<float> values(mesh.Points.size() / 3);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = (i % 3 == 0) ? 1.0e6f : ((i % 3 == 1) ? -1.0e9f : 0.25f * (float)i);
+  OmniConnectGenericArray genericArray("Values", false, false, values.data(), (int)values.size(), OmniConnectType::FLOAT);
+
+  std::string halfDir = outputDir + "HalfArrays/";
+  vtksys::SystemTools::MakeDirectory(halfDir);
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(halfDir, true, OmniConnectNormalsEncoding::FLOAT, true);
+    vtkOmniConnectTestAssert(connector, "Cannot initialize local output");
+    connector->CreateActor(0, "Actor");
+    UploadMesh(*connector, mesh, &genericArray, 1);
+  }
+  std::vector<std::string> halfValues = vtkOmniConnectTesting::FindAttributeValues(vtkOmniConnectTesting::ReadAllLayers(halfDir), "half[] primvars:Values");
+  vtkOmniConnectTestAssert(!halfValues.empty(), "No half float generic array written");
+  vtkOmniConnectTestAssert(halfValues.back().find("inf") == std::string::npos, "Half float generic array overflows to infinity");
+  std::vector<double> readValues = vtkOmniConnectTesting::ParseNumbers(halfValues.back());
+  vtkOmniConnectTestAssert(readValues.size() == values.size(), "Half float generic array has " << readValues.size() << " values instead of " << values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    double expected = std::max(std::min((double)values[i], 65504.0), -65504.0);
+    vtkOmniConnectTestAssert(std::fabs(readValues[i] - expected) <= std::fabs(expected) / 2048.0,
+      "Half float value " << readValues[i] << " differs from " << expected);
+  }
+
+  return EXIT_SUCCESS;
+}
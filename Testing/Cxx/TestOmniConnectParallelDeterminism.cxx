@@ -0,0 +1,126 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Renders the same multi-actor scene once with a single SMP thread and once with the default number of threads;
+// the actor nodes are traversed in parallel, so both sessions have to come out byte-identical.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkActor.h"
+#include "vtkMapper.h"
+#include "vtkVolume.h"
+#include "vtkAbstractVolumeMapper.h"
+#include "vtkPolyData.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkSMPTools.h"
+
+#include <vtksys/SystemTools.hxx>
+
+namespace
+{
+  const int NumMeshes = 6;
+  const int NumFrames = 3;
+
+  vtkSmartPointer<vtkMultiBlockDataSet> MakeBlocks(int numBlocks, double phase)
+  {
+    vtkSmartPointer<vtkMultiBlockDataSet> blocks = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    blocks->SetNumberOfBlocks(numBlocks);
+    for (int i = 0; i < numBlocks; ++i)
+    {
+      double center[3] = { 3.0 * i, -3.0, 0.0 };
+      blocks->SetBlock(i, vtkOmniConnectTesting::MakeMesh(8, phase, center));
+    }
+    return blocks;
+  }
+
+  // Returns the session directory, or an empty string if the connector cannot be initialized
+  std::string RenderSession(const std::string& outputDir, int numThreads)
+  {
+    vtkSMPTools::Initialize(numThreads);
+
+    vtkOmniConnectTestScene scene;
+    if (!scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir)))
+      return std::string();
+
+    std::vector<vtkProp3D*> props;
+    std::vector<vtkActor*> meshes;
+    for (int i = 0; i < NumMeshes; ++i)
+    {
+      std::string name = "Mesh" + std::to_string(i);
+      meshes.push_back(scene.AddMesh(name.c_str(), vtkOmniConnectTesting::MakeMesh(16)));
+      props.push_back(meshes.back());
+    }
+    vtkActor* blocks = scene.AddMesh("Blocks", MakeBlocks(8, 0.0));
+    vtkActor* lines = scene.AddMesh("Lines", vtkOmniConnectTesting::MakeLines(8, 32));
+    vtkActor* glyphs = scene.AddGlyphs("Glyphs", vtkOmniConnectTesting::MakeGlyphPoints(100));
+    vtkVolume* volume = scene.AddVolume("Volume", vtkOmniConnectTesting::MakeVolume(16));
+    props.insert(props.end(), { blocks, lines, glyphs, volume });
+
+    for (int frame = 0; frame < NumFrames; ++frame)
+    {
+      double phase = 0.5 * frame;
+      for (int i = 0; i < NumMeshes; ++i)
+      {
+        double center[3] = { 3.0 * i, 0.0, 0.0 };
+        meshes[i]->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(16, phase + i, center));
+      }
+      blocks->GetMapper()->SetInputDataObject(MakeBlocks(8, phase));
+      lines->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeLines(8, 32, phase));
+      glyphs->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeGlyphPoints(100, phase));
+      volume->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeVolume(16, phase));
+      for (vtkProp3D* prop : props)
+        scene.SetAnimTime(prop, frame);
+
+      scene.Render(frame);
+    }
+
+    std::string sessionDir = scene.GetSessionDirectory();
+    scene.Shutdown();
+    return sessionDir;
+  }
+}
+
+int TestOmniConnectParallelDeterminism(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectParallelDeterminism");
+
+  std::string serialDir = outputDir + "Serial/";
+  std::string parallelDir = outputDir + "Parallel/";
+  vtksys::SystemTools::MakeDirectory(serialDir);
+  vtksys::SystemTools::MakeDirectory(parallelDir);
+
+  std::string serialSession = RenderSession(serialDir, 1);
+  std::string parallelSession = RenderSession(parallelDir, 0); // Default number of threads
+  vtkOmniConnectTestAssert(!serialSession.empty() && !parallelSession.empty(), "Cannot initialize local output");
+
+  std::vector<std::string> fileNames;
+  vtkOmniConnectTesting::ListFiles(serialSession, fileNames);
+  vtkOmniConnectTestAssert(!fileNames.empty(), "No output written");
+
+  std::string difference;
+  vtkOmniConnectTestAssert(vtkOmniConnectTesting::CompareDirectories(serialSession, parallelSession, difference),
+    "Serial and parallel output differ: " << difference);
+
+  return EXIT_SUCCESS;
+}
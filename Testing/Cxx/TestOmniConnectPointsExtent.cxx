@@ -0,0 +1,184 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Checks the mesh extent written by the connector for float and double points, with nans skipped, for point counts that
+// span several of the blocks reduced in parallel and leave a tail, and for bounds passed in by the caller.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  std::unique_ptr<OmniConnect> OpenConnector(const std::string& outputDir)
+  {
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str(); // Has to outlive the connector
+    settings.RootLevelFileName = "Session";
+    settings.OutputLocal = true;
+    settings.OutputBinary = false;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = true;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      connector.reset();
+    return connector;
+  }
+
+  // Random points with the extremes of each axis at chosen positions, and nans that must not affect the extent
+  template<class ScalarType>
+  std::vector<ScalarType> MakePoints(size_t numPoints, const std::vector<size_t>& nanPoints, float expected[6])
+  {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<ScalarType> points(3 * numPoints);
+    for (ScalarType& coord : points)
+      coord = (ScalarType)dist(rng);
+
+    // Extremes in the first block, in a middle block and in the tail that isn't a multiple of 4 points
+    const size_t extremePoints[6] = { 1, numPoints / 2 + 3, numPoints - 1, 5, numPoints - 2, numPoints / 3 };
+    const double extremeValues[6] = { -3.25, 7.5, -11.0000001, 2.0625, -20.5, 1.0e7 + 0.3 };
+    for (int i = 0; i < 6; ++i)
+      points[3 * extremePoints[i] + i / 2] = (ScalarType)extremeValues[i];
+
+    for (size_t p : nanPoints)
+      for (int axis = 0; axis < 3; ++axis)
+        points[3 * p + axis] = std::numeric_limits<ScalarType>::quiet_NaN();
+
+    // Nans compare false, so std::min and std::max keep the running value
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      double minVal = std::numeric_limits<double>::max(), maxVal = -minVal;
+      for (size_t p = 0; p < numPoints; ++p)
+      {
+        minVal = std::min(minVal, (double)points[3 * p + axis]);
+        maxVal = std::max(maxVal, (double)points[3 * p + axis]);
+      }
+      expected[2 * axis] = (float)minVal;
+      expected[2 * axis + 1] = (float)maxVal;
+    }
+    return points;
+  }
+
+  bool WriteMesh(const std::string& outputDir, void* points, OmniConnectType pointsType, size_t numPoints, const double* bounds)
+  {
+    std::vector<unsigned int> indices(3 * (numPoints / 3));
+    for (size_t i = 0; i < indices.size(); ++i)
+      indices[i] = (unsigned int)i;
+
+    std::unique_ptr<OmniConnect> connector = OpenConnector(outputDir);
+    if (!connector)
+      return false;
+    connector->CreateActor(0, "Actor");
+
+    OmniConnectMeshData meshData;
+    meshData.MeshId = 0;
+    meshData.NumPoints = numPoints;
+    meshData.Points = points;
+    meshData.PointsType = pointsType;
+    meshData.Indices = indices.data();
+    meshData.NumIndices = indices.size();
+    if (bounds)
+    {
+      std::copy(bounds, bounds + 6, meshData.PointsBounds);
+      meshData.HasPointsBounds = true;
+    }
+    connector->UpdateMesh(0, 0.0, meshData, 0, nullptr, 0, nullptr, 0);
+
+    connector->FlushActorUpdates(0);
+    connector->FlushSceneUpdates();
+    return true;
+  }
+
+  // Whether any extent authored below outputDir is (min, max) of the expected bounds
+  bool HasExtent(const std::string& outputDir, const float expected[6], std::string& written)
+  {
+    std::vector<std::string> values = vtkOmniConnectTesting::FindAttributeValues(vtkOmniConnectTesting::ReadAllLayers(outputDir), "float3[] extent");
+    for (const std::string& value : values)
+    {
+      std::vector<double> numbers = vtkOmniConnectTesting::ParseNumbers(value);
+      if (numbers.size() != 6)
+        continue;
+      bool matches = true;
+      for (int axis = 0; axis < 3; ++axis)
+        matches = matches && (float)numbers[axis] == expected[2 * axis] && (float)numbers[3 + axis] == expected[2 * axis + 1];
+      if (matches)
+        return true;
+      written = value;
+    }
+    return false;
+  }
+}
+
+int TestOmniConnectPointsExtent(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectPointsExtent");
+
+  // Small inputs are reduced serially, large ones in parallel blocks of 32k points
+  for (size_t numPoints : { size_t(7), size_t(100003) })
+  {
+    std::vector<size_t> nanPoints = { 0, numPoints / 2, numPoints - 3 };
+    std::string written;
+
+    float floatExpected[6];
+    std::vector<float> floatPoints = MakePoints<float>(numPoints, nanPoints, floatExpected);
+    std::string floatDir = outputDir + "Float" + std::to_string(numPoints) + "/";
+    vtksys::SystemTools::MakeDirectory(floatDir);
+    vtkOmniConnectTestAssert(WriteMesh(floatDir, floatPoints.data(), OmniConnectType::FLOAT3, numPoints, nullptr), "Cannot initialize local output");
+    vtkOmniConnectTestAssert(HasExtent(floatDir, floatExpected, written), "Extent of " << numPoints << " float points written as " << written);
+
+    float doubleExpected[6];
+    std::vector<double> doublePoints = MakePoints<double>(numPoints, nanPoints, doubleExpected);
+    std::string doubleDir = outputDir + "Double" + std::to_string(numPoints) + "/";
+    vtksys::SystemTools::MakeDirectory(doubleDir);
+    vtkOmniConnectTestAssert(WriteMesh(doubleDir, doublePoints.data(), OmniConnectType::DOUBLE3, numPoints, nullptr), "Cannot initialize local output");
+    vtkOmniConnectTestAssert(HasExtent(doubleDir, doubleExpected, written), "Extent of " << numPoints << " double points written as " << written);
+  }
+
+  // Bounds known by the caller are taken as they are
+  std::vector<float> points = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+  const double bounds[6] = { -4.0, 5.0, -6.0, 7.0, -8.0, 9.0 };
+  const float boundsExpected[6] = { -4.0f, 5.0f, -6.0f, 7.0f, -8.0f, 9.0f };
+  std::string boundsDir = outputDir + "Bounds/";
+  vtksys::SystemTools::MakeDirectory(boundsDir);
+  std::string written;
+  vtkOmniConnectTestAssert(WriteMesh(boundsDir, points.data(), OmniConnectType::FLOAT3, 3, bounds), "Cannot initialize local output");
+  vtkOmniConnectTestAssert(HasExtent(boundsDir, boundsExpected, written), "Extent of passed in bounds written as " << written);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Renders a synthetic scene with the profiler enabled and checks the Chrome trace written from the ring buffers.
+// Also records scopes on threads that exit before the trace is written, whose rings are merged on exit.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkActor.h"
+#include "vtkMapper.h"
+#include "vtkPolyData.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+int TestOmniConnectProfilerTrace(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectProfilerTrace");
+  std::string traceFileName = outputDir + "Trace.json";
+
+  {
+    vtkOmniConnectTestScene scene;
+    vtkOmniConnectTestAssert(scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir)), "Cannot initialize local output");
+
+    vtkActor* mesh = scene.AddMesh("Mesh", vtkOmniConnectTesting::MakeMesh(16));
+
+    OmniConnectProfiler::SetEnabled(true);
+    for (int frame = 0; frame < 2; ++frame)
+    {
+      mesh->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(16, 0.5 * frame));
+      scene.SetAnimTime(mesh, frame);
+      scene.Render(frame);
+    }
+    scene.Shutdown(); // Flushes the layers, within the profiled region
+    OmniConnectProfiler::SetEnabled(false);
+  }
+
+  const int numExitedThreads = 8, numExitedScopes = 100;
+  {
+    OmniConnectProfiler::SetEnabled(true);
+    std::vector<std::thread> threads;
+    for (int threadIdx = 0; threadIdx < numExitedThreads; ++threadIdx)
+    {
+      threads.emplace_back([]()
+      {
+        for (int scopeIdx = 0; scopeIdx < numExitedScopes; ++scopeIdx)
+          OMNICONNECT_PROFILE_SCOPE("ExitedThreadScope");
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+    OmniConnectProfiler::SetEnabled(false);
+
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    OmniConnectProfiler::GetStatistics(statistics);
+    size_t exitedCount = 0;
+    for (const OmniConnectProfiler::Statistic& stat : statistics)
+    {
+      if (strcmp(stat.Name, "ExitedThreadScope") == 0)
+        exitedCount = stat.Count;
+    }
+    vtkOmniConnectTestAssert(exitedCount == numExitedThreads * numExitedScopes,
+      "Statistics of exited threads are lost: " << exitedCount << " scopes instead of " << numExitedThreads * numExitedScopes);
+  }
+
+  vtkOmniConnectTestAssert(OmniConnectProfiler::WriteChromeTrace(traceFileName.c_str()), "Cannot write " << traceFileName);
+
+  std::string trace;
+  vtkOmniConnectTestAssert(vtkOmniConnectTesting::ReadFile(traceFileName, trace), "Cannot read " << traceFileName);
+  vtkOmniConnectTestAssert(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0, "No traceEvents array in the trace");
+  vtkOmniConnectTestAssert(trace.size() >= 3 && trace.compare(trace.size() - 3, 3, "]}\n") == 0, "Trace is not terminated");
+
+  // Complete events for the timed scopes, counter events for the counts
+  for (const char* scope : { "Gather", "Triangulate", "UpdateMesh", "SaveLayer" })
+  {
+    std::string event = std::string("{\"name\":\"") + scope + "\",\"cat\":\"OmniConnect\"";
+    vtkOmniConnectTestAssert(trace.find(event) != std::string::npos, "No trace event for scope " << scope);
+  }
+  vtkOmniConnectTestAssert(trace.find("\"ph\":\"X\",\"dur\":") != std::string::npos, "No complete events in the trace");
+  vtkOmniConnectTestAssert(trace.find("{\"name\":\"SavedLayers\"") != std::string::npos && trace.find("\"ph\":\"C\"") != std::string::npos,
+    "No counter events in the trace");
+
+  size_t numExitedEvents = vtkOmniConnectTesting::CountOccurrences(trace, "{\"name\":\"ExitedThreadScope\"");
+  vtkOmniConnectTestAssert(numExitedEvents == numExitedThreads * numExitedScopes,
+    "Events of exited threads are lost: " << numExitedEvents << " events instead of " << numExitedThreads * numExitedScopes);
+
+  // One event per line, each with a thread id and a timestamp
+  size_t numEvents = vtkOmniConnectTesting::CountOccurrences(trace, "{\"name\":");
+  vtkOmniConnectTestAssert(vtkOmniConnectTesting::CountOccurrences(trace, "\"tid\":") == numEvents, "Trace events without a thread id");
+  vtkOmniConnectTestAssert(vtkOmniConnectTesting::CountOccurrences(trace, "\"ts\":") == numEvents, "Trace events without a timestamp");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+// Scene to animation retiming of several actors, batched into a single pass on the scene flush: every scene time of
+// every actor has to resolve through the clip actives overridden in the scene layer to the clip file holding the
+// contents of the animation time it is mapped to. Covers an unsorted sequence of clip actives, and an actor that
+// is retimed twice before the flush.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const size_t NumActors = 3;
+  const size_t NumTimeSteps = 40;
+
+  std::unique_ptr<OmniConnect> OpenConnector(const std::string& outputDir)
+  {
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str(); // Has to outlive the connector
+    settings.RootLevelFileName = "Session";
+    settings.OutputLocal = true;
+    settings.OutputBinary = false;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = true;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      connector.reset();
+    return connector;
+  }
+
+  std::string ActorName(size_t actorIdx)
+  {
+    return "Actor" + std::to_string(actorIdx);
+  }
+
+  // Identity, reversed and half speed
+  double AnimTime(size_t actorIdx, size_t sceneTime)
+  {
+    switch (actorIdx)
+    {
+    case 0: return (double)sceneTime;
+    case 1: return (double)(NumTimeSteps - 1 - sceneTime);
+    default: return (double)(sceneTime / 2);
+    }
+  }
+
+  // Triangle whose first coordinate identifies the actor and animation time
+  float StateCoord(size_t actorIdx, double animTime)
+  {
+    return (float)(100.0 * actorIdx + animTime);
+  }
+
+  void UploadTriangle(OmniConnect& connector, size_t actorIdx, double animTime)
+  {
+    float points[9] = { StateCoord(actorIdx, animTime), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    unsigned int indices[3] = { 0, 1, 2 };
+    OmniConnectMeshData meshData;
+    meshData.MeshId = 0;
+    meshData.NumPoints = 3;
+    meshData.Points = points;
+    meshData.PointsType = OmniConnectType::FLOAT3;
+    meshData.Indices = indices;
+    meshData.NumIndices = 3;
+
+    connector.AddTimeStep(actorIdx, animTime);
+    connector.UpdateMesh(actorIdx, animTime, meshData, 0, nullptr, 0, nullptr, 0);
+  }
+
+  // Layer text of the file below outputDir containing all of the patterns and none of the excluded ones
+  std::string FindLayer(const std::string& outputDir, const std::vector<std::string>& patterns, const std::vector<std::string>& excluded,
+    std::string* layerFileName = nullptr)
+  {
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(outputDir, fileNames);
+    for (const std::string& fileName : fileNames)
+    {
+      std::string contents;
+      if (!vtkOmniConnectTesting::ReadFile(outputDir + fileName, contents))
+        continue;
+      bool match = true;
+      for (const std::string& pattern : patterns)
+        match = match && contents.find(pattern) != std::string::npos;
+      for (const std::string& pattern : excluded)
+        match = match && contents.find(pattern) == std::string::npos;
+      if (match)
+      {
+        if (layerFileName)
+          *layerFileName = fileName;
+        return contents;
+      }
+    }
+    return std::string();
+  }
+
+  int CheckActorRetiming(const std::string& outputDir, const std::string& sceneLayer, size_t actorIdx)
+  {
+    std::string quotedName = "\"" + ActorName(actorIdx) + "\"";
+
+    // The scene layer part of the actor, up to the next actor prim
+    size_t actorStart = sceneLayer.find(quotedName);
+    vtkOmniConnectTestAssert(actorStart != std::string::npos, "No " << ActorName(actorIdx) << " prim in the scene layer");
+    size_t actorEnd = std::string::npos;
+    for (size_t otherIdx = 0; otherIdx < NumActors; ++otherIdx)
+    {
+      size_t otherStart = sceneLayer.find("\"" + ActorName(otherIdx) + "\"");
+      if (otherStart > actorStart && otherStart < actorEnd)
+        actorEnd = otherStart;
+    }
+    std::string actorScene = sceneLayer.substr(actorStart, actorEnd == std::string::npos ? std::string::npos : actorEnd - actorStart);
+
+    // The geom override follows the actor prim's own clip metadata
+    std::vector<std::string> activeValues = vtkOmniConnectTesting::FindAttributeValues(actorScene, "double2[] active");
+    std::vector<std::string> timesValues = vtkOmniConnectTesting::FindAttributeValues(actorScene, "double2[] times");
+    vtkOmniConnectTestAssert(!activeValues.empty() && !timesValues.empty(), "No retimed clips for " << ActorName(actorIdx) << " in the scene layer");
+    std::vector<double> sceneActives = vtkOmniConnectTesting::ParseNumbers(activeValues.back());
+    std::vector<double> sceneTimes = vtkOmniConnectTesting::ParseNumbers(timesValues.back());
+    vtkOmniConnectTestAssert(sceneActives.size() == 2 * NumTimeSteps && sceneTimes.size() == 2 * NumTimeSteps,
+      ActorName(actorIdx) << " is retimed at " << sceneActives.size() / 2 << " scene times instead of " << NumTimeSteps);
+
+    std::vector<std::string> otherNames;
+    for (size_t otherIdx = 0; otherIdx < NumActors; ++otherIdx)
+    {
+      if (otherIdx != actorIdx)
+        otherNames.push_back("\"" + ActorName(otherIdx) + "\"");
+    }
+    std::string actorLayer = FindLayer(outputDir, { quotedName, "asset[] assetPaths" }, otherNames);
+    std::vector<std::string> assetPathValues = vtkOmniConnectTesting::FindAttributeValues(actorLayer, "asset[] assetPaths");
+    vtkOmniConnectTestAssert(!assetPathValues.empty(), "No clip asset paths in the layer of " << ActorName(actorIdx));
+    std::vector<std::string> assetPaths = vtkOmniConnectTesting::ParseAssetPaths(assetPathValues.back());
+
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(outputDir, fileNames);
+    for (size_t sceneTime = 0; sceneTime < NumTimeSteps; ++sceneTime)
+    {
+      double animTime = AnimTime(actorIdx, sceneTime);
+      vtkOmniConnectTestAssert(sceneTimes[2 * sceneTime] == (double)sceneTime && sceneTimes[2 * sceneTime + 1] == animTime,
+        ActorName(actorIdx) << " maps scene time " << sceneTimes[2 * sceneTime] << " to " << sceneTimes[2 * sceneTime + 1] << " instead of " << sceneTime << " to " << animTime);
+      vtkOmniConnectTestAssert(sceneActives[2 * sceneTime] == (double)sceneTime,
+        ActorName(actorIdx) << " has a clip active at scene time " << sceneActives[2 * sceneTime] << " instead of " << sceneTime);
+
+      size_t assetIdx = (size_t)sceneActives[2 * sceneTime + 1];
+      vtkOmniConnectTestAssert(assetIdx < assetPaths.size(), ActorName(actorIdx) << " refers to missing asset " << assetIdx << " at scene time " << sceneTime);
+      const std::string& assetPath = assetPaths[assetIdx];
+
+      std::string clipContents;
+      for (const std::string& fileName : fileNames)
+      {
+        if (fileName.size() >= assetPath.size() && fileName.compare(fileName.size() - assetPath.size(), std::string::npos, assetPath) == 0)
+          vtkOmniConnectTesting::ReadFile(outputDir + fileName, clipContents);
+      }
+      std::vector<std::string> pointSamples = vtkOmniConnectTesting::FindAttributeValues(clipContents, "point3f[] points");
+      vtkOmniConnectTestAssert(pointSamples.size() == 1, ActorName(actorIdx) << " resolves scene time " << sceneTime << " to " << assetPath << ", which holds no single set of points");
+      std::vector<double> points = vtkOmniConnectTesting::ParseNumbers(pointSamples[0]);
+      vtkOmniConnectTestAssert(points.size() == 9 && (float)points[0] == StateCoord(actorIdx, animTime),
+        ActorName(actorIdx) << " resolves scene time " << sceneTime << " to the points " << pointSamples[0] << " instead of those of animation time " << animTime);
+    }
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectRetiming(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectRetiming");
+  vtksys::SystemTools::MakeDirectory(outputDir);
+
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(outputDir);
+    vtkOmniConnectTestAssert(connector, "Cannot initialize local output");
+
+    for (size_t actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+    {
+      vtkOmniConnectTestAssert(connector->CreateActor(actorIdx, ActorName(actorIdx).c_str()), "Cannot create " << ActorName(actorIdx));
+      for (size_t timeStep = 0; timeStep < NumTimeSteps; ++timeStep)
+        UploadTriangle(*connector, actorIdx, (double)timeStep);
+      connector->FlushActorUpdates(actorIdx);
+    }
+
+    // Removing and re-adding a timestep leaves the clip actives out of order
+    vtkOmniConnectTestAssert(!connector->DeleteGeomAtTime(0, 5.0, 0, OmniConnectGeomType::MESH), "Deleting a timestep should not delete the whole geometry");
+    UploadTriangle(*connector, 0, 5.0);
+    connector->FlushActorUpdates(0);
+
+    std::vector<std::vector<double>> sceneToAnimTimes(NumActors);
+    for (size_t actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+    {
+      for (size_t sceneTime = 0; sceneTime < NumTimeSteps; ++sceneTime)
+      {
+        sceneToAnimTimes[actorIdx].push_back((double)sceneTime);
+        sceneToAnimTimes[actorIdx].push_back(AnimTime(actorIdx, sceneTime));
+      }
+    }
+
+    // Superseded by the second call before the flush
+    connector->SetSceneToAnimTime(1, 0.0, sceneToAnimTimes[0].data(), NumTimeSteps);
+
+    for (size_t actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+      connector->SetSceneToAnimTime(actorIdx, (double)(NumTimeSteps - 1), sceneToAnimTimes[actorIdx].data(), NumTimeSteps);
+
+    // Pending retiming is visible before it has been authored
+    vtkOmniConnectTestAssert(connector->GetNumSceneToAnimTimes(2) == NumTimeSteps, "Pending scene to animation times are not reported");
+    std::vector<double> restoredTimes(2 * NumTimeSteps);
+    connector->RestoreSceneToAnimTimes(restoredTimes.data(), NumTimeSteps);
+    vtkOmniConnectTestAssert(restoredTimes == sceneToAnimTimes[2], "Pending scene to animation times are not restored as set");
+
+    connector->FlushSceneUpdates();
+  }
+
+  std::vector<std::string> actorNames;
+  for (size_t actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+    actorNames.push_back("\"" + ActorName(actorIdx) + "\"");
+  std::string sceneLayer = FindLayer(outputDir, actorNames, {});
+  vtkOmniConnectTestAssert(!sceneLayer.empty(), "No scene layer with all actors");
+
+  for (size_t actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+  {
+    if (CheckActorRetiming(outputDir, sceneLayer, actorIdx) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Animates meshes with static connectivity over many timesteps, next to a multiblock actor that adds geometries
+// while meshes are processed, and checks that the connectivity is triangulated and written only once per geometry.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkActor.h"
+#include "vtkMapper.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <cstring>
+
+int TestOmniConnectStaticTopology(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectStaticTopology");
+  const int numFrames = 200;
+  const int numBlocks = 8;
+
+  vtkOmniConnectTestScene scene;
+  vtkOmniConnectTestAssert(scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir)), "Cannot initialize local output");
+
+  vtkActor* mesh = scene.AddMesh("Mesh", vtkOmniConnectTesting::MakeMesh(16));
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  vtkActor* blockActor = scene.AddMesh("Blocks", blocks);
+
+  OmniConnectProfiler::SetEnabled(true);
+  OmniConnectProfiler::ResetStatistics();
+
+  for (int frame = 0; frame < numFrames; ++frame)
+  {
+    // Points change every frame, connectivity never does
+    double phase = 0.1 * frame;
+    mesh->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(16, phase));
+
+    // New blocks are added over the first frames, so geometries are added to the actor while earlier ones are updated
+    vtkNew<vtkMultiBlockDataSet> frameBlocks;
+    int numFrameBlocks = std::min(frame + 1, numBlocks);
+    frameBlocks->SetNumberOfBlocks(numFrameBlocks);
+    for (int blockIdx = 0; blockIdx < numFrameBlocks; ++blockIdx)
+    {
+      double center[3] = { 3.0 * blockIdx, 3.0, 0.0 };
+      frameBlocks->SetBlock(blockIdx, vtkOmniConnectTesting::MakeMesh(8, phase, center));
+    }
+    blockActor->GetMapper()->SetInputDataObject(frameBlocks);
+
+    scene.SetAnimTime(mesh, frame);
+    scene.SetAnimTime(blockActor, frame);
+    scene.Render(frame);
+  }
+
+  std::vector<OmniConnectProfiler::Statistic> statistics;
+  OmniConnectProfiler::GetStatistics(statistics);
+  OmniConnectProfiler::SetEnabled(false);
+
+  std::string sessionDir = scene.GetSessionDirectory();
+  scene.Shutdown();
+
+  // Every geometry is triangulated on its first timestep only
+  uint64_t numTriangulations = 0;
+  for (const OmniConnectProfiler::Statistic& stat : statistics)
+  {
+    if (strcmp(stat.Name, "Triangulate") == 0)
+      numTriangulations += stat.Count;
+  }
+  vtkOmniConnectTestAssert(numTriangulations == 1 + numBlocks,
+    "Static connectivity triangulated " << numTriangulations << " times, expected " << 1 + numBlocks);
+
+  // A single, non-timevarying copy of the connectivity per geometry
+  std::string layers = vtkOmniConnectTesting::ReadAllLayers(sessionDir);
+  vtkOmniConnectTestAssert(layers.find(std::to_string(numFrames - 1) + ": ") != std::string::npos, "Last time sample missing from the output");
+  size_t numIndexCopies = vtkOmniConnectTesting::CountOccurrences(layers, "faceVertexIndices");
+  vtkOmniConnectTestAssert(numIndexCopies > 0 && numIndexCopies < numFrames,
+    "Static connectivity written " << numIndexCopies << " times over " << numFrames << " timesteps");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Encodes textures and color maps with every vtkOmniConnectImageWriter encoding, and checks that the decoded
+// png pixels are identical to the input.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectImageWriter.h"
+#include "vtkImageData.h"
+#include "vtkPNGReader.h"
+#include "vtkPointData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+
+namespace
+{
+  // Returns the encoded size, or 0 if the image could not be encoded or does not decode to the same pixels
+  int EncodeAndCompare(vtkImageData* image, vtkOmniConnectImageWriter::Encoding encoding, bool frequentlyRewritten, bool modifyBorder = false)
+  {
+    vtkOmniConnectImageWriter writer;
+    writer.SetEncoding(encoding, frequentlyRewritten);
+    writer.SetModifyBorder(modifyBorder);
+    if (!writer.WriteData(image))
+      return 0;
+
+    char* imageData = nullptr;
+    int imageDataSize = 0;
+    writer.GetResult(imageData, imageDataSize);
+    if (!imageData || imageDataSize <= 0)
+      return 0;
+
+    vtkNew<vtkPNGReader> reader;
+    reader->SetMemoryBuffer(imageData);
+    reader->SetMemoryBufferLength(imageDataSize);
+    reader->Update();
+    vtkImageData* decoded = reader->GetOutput();
+
+    int* dims = image->GetDimensions();
+    int* decodedDims = decoded->GetDimensions();
+    vtkDataArray* srcScalars = image->GetPointData()->GetScalars();
+    vtkDataArray* decodedScalars = decoded->GetPointData()->GetScalars();
+    if (dims[0] != decodedDims[0] || dims[1] != decodedDims[1] || !decodedScalars ||
+      decodedScalars->GetDataType() != VTK_UNSIGNED_CHAR ||
+      decodedScalars->GetNumberOfComponents() != srcScalars->GetNumberOfComponents() ||
+      decodedScalars->GetNumberOfTuples() != srcScalars->GetNumberOfTuples())
+      return 0;
+
+    size_t numBytes = static_cast<size_t>(srcScalars->GetNumberOfTuples()) * srcScalars->GetNumberOfComponents();
+    if (memcmp(srcScalars->GetVoidPointer(0), decodedScalars->GetVoidPointer(0), numBytes) != 0)
+      return 0;
+
+    return imageDataSize;
+  }
+}
+
+int TestOmniConnectTextureEncoding(int, char*[])
+{
+  using Encoding = vtkOmniConnectImageWriter::Encoding;
+
+  vtkSmartPointer<vtkImageData> texture = vtkOmniConnectTesting::MakeTexture(512, 512);
+  vtkSmartPointer<vtkImageData> rgbTexture = vtkOmniConnectTesting::MakeTexture(300, 200, 3);
+
+  int storedSize = EncodeAndCompare(texture, Encoding::STORED, false);
+  int fastSize = EncodeAndCompare(texture, Encoding::FAST, false);
+  int defaultSize = EncodeAndCompare(texture, Encoding::DEFAULT, false);
+  vtkOmniConnectTestAssert(storedSize > 0, "Uncompressed encoding is not lossless");
+  vtkOmniConnectTestAssert(fastSize > 0, "Fast encoding is not lossless");
+  vtkOmniConnectTestAssert(defaultSize > 0, "Default encoding is not lossless");
+  vtkOmniConnectTestAssert(storedSize >= 512 * 512 * 4, "Uncompressed encoding is smaller than the pixel data");
+  vtkOmniConnectTestAssert(fastSize < storedSize && defaultSize < storedSize, "Compressed encodings are not smaller than the uncompressed one");
+
+  // Automatic picks the fast encoding for frequently rewritten textures, the default encoding otherwise
+  vtkOmniConnectTestAssert(EncodeAndCompare(texture, Encoding::AUTOMATIC, true) == fastSize, "Automatic encoding of a rewritten texture is not the fast encoding");
+  vtkOmniConnectTestAssert(EncodeAndCompare(texture, Encoding::AUTOMATIC, false) == defaultSize, "Automatic encoding of a static texture is not the default encoding");
+
+  for (Encoding encoding : { Encoding::STORED, Encoding::FAST, Encoding::DEFAULT })
+    vtkOmniConnectTestAssert(EncodeAndCompare(rgbTexture, encoding, false) > 0, "Rgb texture with encoding " << (int)encoding << " is not lossless");
+
+  // Color maps are two rows, of which the border removal overwrites the second with the first before encoding
+  vtkSmartPointer<vtkImageData> colorMap = vtkOmniConnectTesting::MakeTexture(256, 2, 3);
+  for (Encoding encoding : { Encoding::STORED, Encoding::FAST, Encoding::DEFAULT })
+  {
+    vtkOmniConnectTestAssert(EncodeAndCompare(colorMap, encoding, true, true) > 0, "Color map with encoding " << (int)encoding << " is not lossless");
+    unsigned char* rows = static_cast<unsigned char*>(colorMap->GetScalarPointer(0, 0, 0));
+    vtkOmniConnectTestAssert(memcmp(rows, rows + 256 * 3, 256 * 3) == 0, "Color map border has not been removed");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Drives the connector directly to check the session-wide texture store: files are shared by content between actors
+// and timesteps, removed once no texture refers to them anymore, and survive reopening the session.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <initializer_list>
+#include <memory>
+
+namespace
+{
+  std::unique_ptr<OmniConnect> OpenConnector(const std::string& outputDir, bool createNewSession)
+  {
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str(); // Has to outlive the connector
+    settings.RootLevelFileName = "Session";
+    settings.OutputLocal = true;
+    settings.OutputBinary = false;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = createNewSession;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      connector.reset();
+    return connector;
+  }
+
+  void UploadTexture(OmniConnect& connector, size_t actorId, size_t texId, const std::string& image, bool timeVarying, double animTimeStep)
+  {
+    // The store only sees encoded bytes, so any content will do
+    OmniConnectSamplerData samplerData;
+    samplerData.TexData = image.data();
+    samplerData.TexDataSize = image.size();
+    samplerData.WrapS = samplerData.WrapT = OmniConnectSamplerData::WrapMode::REPEAT;
+    connector.UpdateTexture(actorId, texId, samplerData, timeVarying, animTimeStep);
+  }
+
+  void UploadTriangle(OmniConnect& connector, size_t actorId, size_t texId, double animTimeStep)
+  {
+    OmniConnectMaterialData matData;
+    matData.MaterialId = 0;
+    matData.TexId = texId;
+    connector.UpdateMaterial(actorId, matData, animTimeStep);
+
+    float points[9] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    unsigned int indices[3] = { 0, 1, 2 };
+    OmniConnectMeshData meshData;
+    meshData.MeshId = 0;
+    meshData.NumPoints = 3;
+    meshData.Points = points;
+    meshData.PointsType = OmniConnectType::FLOAT3;
+    meshData.Indices = indices;
+    meshData.NumIndices = 3;
+    connector.UpdateMesh(actorId, animTimeStep, meshData, 0, nullptr, 0, nullptr, 0);
+  }
+
+  void Flush(OmniConnect& connector, std::initializer_list<size_t> actorIds)
+  {
+    for (size_t actorId : actorIds)
+      connector.FlushActorUpdates(actorId);
+    connector.FlushSceneUpdates();
+  }
+
+  // Number of stored files with the given contents
+  size_t CountTextureFiles(const std::string& textureDir, const std::string& image)
+  {
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(textureDir, fileNames);
+    size_t count = 0;
+    for (const std::string& fileName : fileNames)
+    {
+      std::string contents;
+      if (vtkOmniConnectTesting::ReadFile(textureDir + fileName, contents) && contents == image)
+        ++count;
+    }
+    return count;
+  }
+
+  size_t CountTextureFiles(const std::string& textureDir)
+  {
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(textureDir, fileNames);
+    return fileNames.size();
+  }
+}
+
+int TestOmniConnectTextureStore(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectTextureStore");
+  std::string textureDir = outputDir + "Session/textures/";
+
+  const std::string imageA = "ImageA", imageB = "ImageB", imageC = "ImageC", imageD = "ImageD", imageE = "ImageE";
+
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(outputDir, true);
+    vtkOmniConnectTestAssert(connector, "Cannot initialize local output");
+    connector->CreateActor(0, "ActorA");
+    connector->CreateActor(1, "ActorB");
+
+    // Reuse between actors
+    UploadTexture(*connector, 0, 0, imageA, false, 0.0);
+    UploadTexture(*connector, 1, 0, imageA, false, 0.0);
+    Flush(*connector, { 0, 1 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir) == 1 && CountTextureFiles(textureDir, imageA) == 1, "Identical textures of two actors are not shared");
+
+    // Reuse between timesteps
+    for (int timeStep = 0; timeStep < 3; ++timeStep)
+    {
+      UploadTexture(*connector, 0, 1, timeStep < 2 ? imageB : imageC, true, timeStep);
+      UploadTriangle(*connector, 0, 1, timeStep);
+    }
+    Flush(*connector, { 0 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir) == 3, "Identical timesteps of a texture are not shared");
+
+    // Eviction once the last reference is released
+    UploadTexture(*connector, 1, 0, imageD, false, 0.0);
+    Flush(*connector, { 1 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageA) == 1, "Texture removed while another actor still refers to it");
+    UploadTexture(*connector, 0, 0, imageD, false, 0.0);
+    Flush(*connector, { 0 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageA) == 0, "Unreferenced texture has not been removed");
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageD) == 1, "Replacement texture not shared between actors");
+
+    UploadTexture(*connector, 0, 1, imageB, true, 2.0);
+    Flush(*connector, { 0 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageC) == 0, "Rewritten timestep of a texture has not been removed");
+
+    // Textures belong to materials, which are not per timestep, so removing geometry at a timestep keeps them
+    vtkOmniConnectTestAssert(connector->DeleteGeomAtTime(0, 2.0, 0, OmniConnectGeomType::MESH), "Cannot delete geometry at a timestep");
+    Flush(*connector, { 0 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageB) == 1 && CountTextureFiles(textureDir, imageD) == 1,
+      "Texture removed with the geometry of a timestep");
+
+    // Deleting an actor releases all of its references
+    connector->DeleteActor(1);
+    Flush(*connector, { 0 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageD) == 1, "Texture of a remaining actor removed with a deleted actor");
+  }
+
+  // Reopened session: ActorA still refers to imageB at three timesteps and to imageD
+  {
+    std::unique_ptr<OmniConnect> connector = OpenConnector(outputDir, false);
+    vtkOmniConnectTestAssert(connector, "Cannot reopen the session");
+    connector->CreateActor(0, "ActorA");
+    connector->CreateActor(2, "ActorC");
+
+    // A new actor releasing a file written by the earlier session
+    UploadTexture(*connector, 2, 0, imageD, false, 0.0);
+    UploadTexture(*connector, 2, 0, imageE, false, 0.0);
+    Flush(*connector, { 2 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageD) == 1, "Texture of the earlier session removed while still referred to");
+
+    // An existing texture rewriting one of its timesteps
+    UploadTexture(*connector, 0, 1, imageE, true, 0.0);
+    Flush(*connector, { 0 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageB) == 1, "Timesteps of the earlier session removed while still referred to");
+
+    // The texture's remaining references of the earlier session are released with the actor
+    connector->DeleteActor(0);
+    Flush(*connector, { 2 });
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageB) == 0, "Texture of the earlier session not removed with its actor");
+    vtkOmniConnectTestAssert(CountTextureFiles(textureDir, imageE) == 1, "Texture shared with a remaining actor removed");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Renders several textured actors whose textures change every frame, through the texture encoder, and checks that
+// each actor's texture refers, at every timestep, to a stored file decoding to exactly the image of that actor and
+// frame, and that its material refers to the texture and is bound to the geometry.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectRendererNode.h"
+#include "vtkActor.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkMapper.h"
+#include "vtkPNGReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTexture.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const int NumActors = 4;
+  const int NumFrames = 3;
+
+  std::string ActorName(int actorIdx)
+  {
+    return "Textured" + std::to_string(actorIdx);
+  }
+
+  // Distinct for every actor and frame
+  vtkSmartPointer<vtkImageData> MakeFrameTexture(int actorIdx, int frame)
+  {
+    return vtkOmniConnectTesting::MakeTexture(64, 48, 4, actorIdx + 0.25 * frame);
+  }
+
+  vtkSmartPointer<vtkPolyData> MakeTexturedMesh(int actorIdx)
+  {
+    double center[3] = { 3.0 * actorIdx, 0.0, 0.0 };
+    vtkSmartPointer<vtkPolyData> mesh = vtkOmniConnectTesting::MakeMesh(8, 0.0, center);
+
+    vtkPoints* points = mesh->GetPoints();
+    vtkNew<vtkFloatArray> texCoords;
+    texCoords->SetName("TCoords");
+    texCoords->SetNumberOfComponents(2);
+    texCoords->SetNumberOfTuples(points->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      double p[3];
+      points->GetPoint(i, p);
+      texCoords->SetTypedComponent(i, 0, static_cast<float>(0.5 + 0.5 * std::atan2(p[1] - center[1], p[0] - center[0]) / 3.14159265358979));
+      texCoords->SetTypedComponent(i, 1, static_cast<float>(0.5 + 0.5 * (p[2] - center[2])));
+    }
+    mesh->GetPointData()->SetTCoords(texCoords);
+    return mesh;
+  }
+
+  bool DecodesTo(const std::string& fileName, vtkImageData* image)
+  {
+    vtkNew<vtkPNGReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    vtkImageData* decoded = reader->GetOutput();
+
+    vtkDataArray* srcScalars = image->GetPointData()->GetScalars();
+    vtkDataArray* decodedScalars = decoded->GetPointData()->GetScalars();
+    if (!decodedScalars || decodedScalars->GetDataType() != VTK_UNSIGNED_CHAR ||
+      decoded->GetDimensions()[0] != image->GetDimensions()[0] || decoded->GetDimensions()[1] != image->GetDimensions()[1] ||
+      decodedScalars->GetNumberOfComponents() != srcScalars->GetNumberOfComponents() ||
+      decodedScalars->GetNumberOfTuples() != srcScalars->GetNumberOfTuples())
+      return false;
+
+    size_t numBytes = static_cast<size_t>(srcScalars->GetNumberOfTuples()) * srcScalars->GetNumberOfComponents();
+    return memcmp(srcScalars->GetVoidPointer(0), decodedScalars->GetVoidPointer(0), numBytes) == 0;
+  }
+
+  // Asset paths of the texture reader's file input: the default first, then the time samples in order of time
+  std::vector<std::string> FindTextureFiles(const std::string& actorLayer)
+  {
+    std::vector<std::string> texFiles;
+    for (const std::string& value : vtkOmniConnectTesting::FindAttributeValues(actorLayer, "asset inputs:file"))
+    {
+      for (const std::string& assetPath : vtkOmniConnectTesting::ParseAssetPaths(value))
+      {
+        if (!assetPath.empty())
+          texFiles.push_back(assetPath);
+      }
+    }
+    return texFiles;
+  }
+
+  int RenderTexturedActors(const std::string& outputDir, const char* sessionName, bool timeVarying)
+  {
+    vtkOmniConnectTestScene scene;
+    vtkOmniConnectTestAssert(scene.Initialize(vtkOmniConnectTestScene::MakeSettings(outputDir, sessionName)), "Cannot initialize local output");
+    scene.GetRendererNode()->SetForceTimeVaryingTextures(timeVarying);
+
+    std::vector<vtkActor*> actors;
+    std::vector<vtkSmartPointer<vtkTexture>> textures;
+    for (int actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+    {
+      vtkActor* actor = scene.AddMesh(ActorName(actorIdx).c_str(), MakeTexturedMesh(actorIdx));
+      actor->GetMapper()->ScalarVisibilityOff(); // Otherwise the scalars are mapped to colors instead of the texture
+      textures.push_back(vtkSmartPointer<vtkTexture>::New());
+      actor->SetTexture(textures.back());
+      actors.push_back(actor);
+    }
+
+    for (int frame = 0; frame < NumFrames; ++frame)
+    {
+      for (int actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+      {
+        textures[actorIdx]->SetInputData(MakeFrameTexture(actorIdx, frame));
+        scene.SetAnimTime(actors[actorIdx], frame);
+      }
+      scene.Render(frame);
+    }
+
+    std::string sessionDir = scene.GetSessionDirectory();
+    scene.Shutdown();
+
+    std::vector<std::string> fileNames;
+    vtkOmniConnectTesting::ListFiles(sessionDir, fileNames);
+    size_t numTextureFiles = 0;
+    for (const std::string& fileName : fileNames)
+      numTextureFiles += fileName.find("textures/") != std::string::npos;
+    size_t expectedTextureFiles = timeVarying ? NumActors * NumFrames : NumActors;
+    vtkOmniConnectTestAssert(numTextureFiles == expectedTextureFiles,
+      sessionName << " stores " << numTextureFiles << " texture files instead of " << expectedTextureFiles);
+
+    for (int actorIdx = 0; actorIdx < NumActors; ++actorIdx)
+    {
+      // Texture paths are relative to the directory of the actor layer
+      std::string layerFileName, actorLayer;
+      for (const std::string& fileName : fileNames)
+      {
+        std::string layerName = ActorName(actorIdx) + ".usda";
+        if (fileName.size() >= layerName.size() && fileName.compare(fileName.size() - layerName.size(), std::string::npos, layerName) == 0 &&
+          (fileName.size() == layerName.size() || fileName[fileName.size() - layerName.size() - 1] == '/'))
+          layerFileName = fileName;
+      }
+      vtkOmniConnectTestAssert(!layerFileName.empty() && vtkOmniConnectTesting::ReadFile(sessionDir + layerFileName, actorLayer),
+        "No layer for " << ActorName(actorIdx) << " in " << sessionName);
+      std::string layerDir = sessionDir + layerFileName.substr(0, layerFileName.find_last_of('/') + 1);
+
+      // Time varying textures have a file per timestep, others a single default following the last upload
+      std::vector<std::string> texFiles = FindTextureFiles(actorLayer);
+      size_t numExpected = timeVarying ? NumFrames : 1;
+      vtkOmniConnectTestAssert(texFiles.size() >= numExpected,
+        ActorName(actorIdx) << " in " << sessionName << " refers to " << texFiles.size() << " texture files instead of " << numExpected);
+      for (size_t fileIdx = 0; fileIdx < numExpected; ++fileIdx)
+      {
+        int frame = timeVarying ? static_cast<int>(fileIdx) : NumFrames - 1;
+        const std::string& texFile = texFiles[texFiles.size() - numExpected + fileIdx];
+        vtkOmniConnectTestAssert(DecodesTo(layerDir + texFile, MakeFrameTexture(actorIdx, frame)),
+          ActorName(actorIdx) << " in " << sessionName << " refers to " << texFile << " at frame " << frame << ", which does not hold the image of that frame");
+      }
+
+      // The material's texture reader references the texture prim, and the material is bound to the geometry
+      bool refersToTexture = false;
+      for (size_t refStart = actorLayer.find("references = </"); refStart != std::string::npos; refStart = actorLayer.find("references = </", refStart + 1))
+        refersToTexture = refersToTexture || actorLayer.substr(refStart, actorLayer.find('>', refStart) - refStart).find(ActorName(actorIdx) + "_Tex_") != std::string::npos;
+      vtkOmniConnectTestAssert(refersToTexture, "Material of " << ActorName(actorIdx) << " in " << sessionName << " does not refer to its texture");
+      vtkOmniConnectTestAssert(actorLayer.find("rel material:binding") != std::string::npos,
+        "Material of " << ActorName(actorIdx) << " in " << sessionName << " is not bound");
+    }
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectTextureUploads(int argc, char* argv[])
+{
+  std::string outputDir = vtkOmniConnectTesting::GetOutputDirectory(argc, argv, "TestOmniConnectTextureUploads");
+
+  if (RenderTexturedActors(outputDir, "TimeVarying", true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (RenderTexturedActors(outputDir, "Static", false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
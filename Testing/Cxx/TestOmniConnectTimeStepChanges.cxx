@@ -0,0 +1,186 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+// Change detection of vtkOmniConnectTimeStep on datasets and their generic arrays, without a connector.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectTimeStep.h"
+#include "vtkOmniConnectPassArrays.h"
+#include "vtkCellData.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <cstring>
+
+namespace
+{
+  // Mesh as output by vtkOmniConnectPassArrays, with generic arrays Scalars and Pressure (points) and Material (cells)
+  vtkSmartPointer<vtkPolyData> MakeArrayMesh()
+  {
+    vtkSmartPointer<vtkPolyData> mesh = vtkOmniConnectTesting::MakeMesh(4);
+
+    vtkNew<vtkFloatArray> pressure;
+    pressure->SetName("Pressure");
+    pressure->SetNumberOfValues(mesh->GetNumberOfPoints());
+    pressure->FillValue(1.0f);
+    mesh->GetPointData()->AddArray(pressure);
+
+    vtkNew<vtkIntArray> material;
+    material->SetName("Material");
+    material->SetNumberOfValues(mesh->GetNumberOfCells());
+    material->FillValue(2);
+    mesh->GetCellData()->AddArray(material);
+
+    vtkNew<vtkUnsignedIntArray> passFlag;
+    passFlag->SetName(vtkOmniConnectPassArrays::PassArraysFlagName);
+    passFlag->SetNumberOfValues(1);
+    passFlag->SetValue(0, 0);
+    mesh->GetFieldData()->AddArray(passFlag);
+
+    return mesh;
+  }
+
+  const OmniConnectGenericArray* FindArray(const vtkOmniConnectGenericArrayList& arrays, const char* sourceName)
+  {
+    for (const OmniConnectGenericArray& arr : arrays)
+    {
+      if (strstr(arr.Name, sourceName))
+        return &arr;
+    }
+    return nullptr;
+  }
+}
+
+int TestOmniConnectTimeStepChanges(int, char*[])
+{
+  vtkOmniConnectGenericArrayList updatedArrays, deletedArrays;
+  bool forceArrayUpdate = false;
+
+  // Generic arrays of a single dataset
+  {
+    vtkOmniConnectTimeStep timeStep;
+    vtkSmartPointer<vtkPolyData> mesh = MakeArrayMesh();
+
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate), "New dataset not reported as updated");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(updatedArrays.size() == 3 && deletedArrays.empty(), "Expected all 3 generic arrays of a new dataset, got " << updatedArrays.size());
+    vtkOmniConnectTestAssert(FindArray(updatedArrays, "Material") && FindArray(updatedArrays, "Material")->PerPoly, "Cell array not reported per poly");
+    vtkOmniConnectTestAssert(timeStep.GetNumDataEntries() == 1, "Expected a single data entry");
+
+    vtkOmniConnectTestAssert(!timeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate), "Unchanged dataset reported as updated");
+
+    // Modifying an array updates only that array
+    mesh->GetPointData()->GetArray("Pressure")->Modified();
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate), "Modified array not detected");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(updatedArrays.size() == 1 && FindArray(updatedArrays, "Pressure") && deletedArrays.empty(),
+      "Expected only Pressure to be updated, got " << updatedArrays.size() << " updated and " << deletedArrays.size() << " deleted arrays");
+
+    // A replacement array of the same name is matched by name, not reported as a new array next to the old one
+    vtkNew<vtkFloatArray> newPressure;
+    newPressure->DeepCopy(mesh->GetPointData()->GetArray("Pressure"));
+    mesh->GetPointData()->RemoveArray("Pressure");
+    mesh->GetPointData()->AddArray(newPressure);
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate), "Replaced array not detected");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(updatedArrays.size() == 1 && FindArray(updatedArrays, "Pressure") && deletedArrays.empty(), "Replaced array not matched on its name");
+    timeStep.CleanupGenericArrayCache(0);
+
+    // Removed arrays are reported once
+    mesh->GetCellData()->RemoveArray("Material");
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate), "Removed array not detected");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(updatedArrays.empty() && deletedArrays.size() == 1 && FindArray(deletedArrays, "Material"), "Expected Material to be deleted");
+    timeStep.CleanupGenericArrayCache(0);
+
+    mesh->GetPointData()->GetArray("Scalars")->Modified();
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate), "Modified array not detected");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(updatedArrays.size() == 1 && deletedArrays.empty(), "Deleted array reported again after cleanup");
+
+    // Forced updates rewrite the dataset, but its arrays only when forced as well
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(mesh, 0, true, forceArrayUpdate), "Forced update not reported");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, false);
+    vtkOmniConnectTestAssert(updatedArrays.empty(), "Unchanged arrays updated without forceArrayUpdate");
+    timeStep.GetUpdatedDeletedGenericArrays(0, updatedArrays, deletedArrays, true);
+    vtkOmniConnectTestAssert(updatedArrays.size() == 2, "Expected both remaining arrays with forceArrayUpdate, got " << updatedArrays.size());
+
+    // Array names are interned, so all timesteps refer to the same name storage
+    vtkOmniConnectTimeStep otherTimeStep;
+    vtkOmniConnectGenericArrayList otherUpdatedArrays;
+    otherTimeStep.UpdateDataEntry(mesh, 0, false, forceArrayUpdate);
+    otherTimeStep.GetUpdatedDeletedGenericArrays(0, otherUpdatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(FindArray(otherUpdatedArrays, "Pressure") && FindArray(otherUpdatedArrays, "Pressure")->Name == FindArray(updatedArrays, "Pressure")->Name,
+      "Array name of the same source array not interned");
+  }
+
+  // Dense data entries over the blocks of a composite dataset
+  {
+    const size_t numBlocks = 1000;
+    vtkOmniConnectTimeStep timeStep;
+    std::vector<vtkSmartPointer<vtkPolyData>> blocks;
+    for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+      blocks.push_back(MakeArrayMesh());
+
+    timeStep.ResetDataEntryCache();
+    for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+      vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(blocks[blockIdx], blockIdx, false, forceArrayUpdate), "New block " << blockIdx << " not reported as updated");
+    timeStep.CleanupDataEntryCache();
+    vtkOmniConnectTestAssert(timeStep.GetNumDataEntries() == numBlocks, "Expected " << numBlocks << " data entries, got " << timeStep.GetNumDataEntries());
+
+    // Only a single modified block is updated
+    blocks[numBlocks / 2]->GetPointData()->GetArray("Pressure")->Modified();
+    size_t numUpdated = 0;
+    timeStep.ResetDataEntryCache();
+    for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+    {
+      if (timeStep.UpdateDataEntry(blocks[blockIdx], blockIdx, false, forceArrayUpdate))
+        ++numUpdated;
+    }
+    timeStep.CleanupDataEntryCache();
+    vtkOmniConnectTestAssert(numUpdated == 1, "Expected 1 updated block, got " << numUpdated);
+
+    // Blocks that are left out are removed at cleanup, and their slots come back as new entries
+    timeStep.ResetDataEntryCache();
+    for (size_t blockIdx = 0; blockIdx < numBlocks; blockIdx += 2)
+      timeStep.UpdateDataEntry(blocks[blockIdx], blockIdx, false, forceArrayUpdate);
+    timeStep.CleanupDataEntryCache();
+    vtkOmniConnectTestAssert(timeStep.GetNumDataEntries() == numBlocks / 2, "Expected " << numBlocks / 2 << " data entries after removal, got " << timeStep.GetNumDataEntries());
+
+    timeStep.ResetDataEntryCache();
+    timeStep.KeepDataEntryCache();
+    vtkOmniConnectTestAssert(timeStep.UpdateDataEntry(blocks[1], 1, false, forceArrayUpdate), "Re-added block not reported as updated");
+    timeStep.GetUpdatedDeletedGenericArrays(1, updatedArrays, deletedArrays, forceArrayUpdate);
+    vtkOmniConnectTestAssert(updatedArrays.size() == 3 && deletedArrays.empty(), "Re-added block did not start with a fresh array cache");
+    timeStep.CleanupDataEntryCache();
+    vtkOmniConnectTestAssert(timeStep.GetNumDataEntries() == numBlocks / 2 + 1, "Kept data entries removed at cleanup");
+  }
+
+  return EXIT_SUCCESS;
+}
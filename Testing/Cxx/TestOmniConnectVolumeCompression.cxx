@@ -0,0 +1,166 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// For every volume compression mode, the bytes streamed into a file have to match the in-memory serialization,
+// and the decoded grids have to be bitwise identical to the ones decoded from the uncompressed stream.
+
+#include "OmniConnectVolumeTestUtilities.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+  using namespace OmniConnectVolumeTesting;
+
+  const size_t Dims[3] = { 64, 48, 40 };
+  const size_t NumVoxels = Dims[0] * Dims[1] * Dims[2];
+
+  // Archive header: magic (8 bytes), file and library versions (3 x 4 bytes) and the grid offsets flag (1 byte),
+  // followed by a UUID which OpenVDB generates randomly for every write
+  const size_t UuidOffset = 21;
+  const size_t UuidSize = 36;
+
+  bool IsUuidAt(const std::string& bytes, size_t offset)
+  {
+    return bytes.size() >= offset + UuidSize && bytes[offset + 8] == '-' && bytes[offset + 13] == '-' &&
+      bytes[offset + 18] == '-' && bytes[offset + 23] == '-';
+  }
+
+  // Smooth field inside a sphere with an empty background, compressible but not trivially so
+  std::vector<float> MakeDenseInput()
+  {
+    std::vector<float> values(NumVoxels, 0.0f);
+    for (size_t i = 0; i < NumVoxels; ++i)
+    {
+      openvdb::Coord c = LinearToCoord(i, Dims);
+      float dx = float(c.x() - 32), dy = float(c.y() - 24), dz = float(c.z() - 20);
+      float dist2 = dx*dx + dy*dy + dz*dz;
+      if (dist2 < 400.0f)
+        values[i] = std::sqrt(dist2) + 0.25f * std::sin(0.9f * float(c.x() + c.y() * c.z()));
+    }
+    return values;
+  }
+
+  template<typename GridType>
+  int CompareGrids(const openvdb::GridPtrVecPtr& grids, const openvdb::GridPtrVecPtr& referenceGrids, const char* modeName)
+  {
+    typename GridType::Ptr grid = FindGrid<GridType>(grids, "density");
+    typename GridType::Ptr referenceGrid = FindGrid<GridType>(referenceGrids, "density");
+    OmniConnectVolumeTestAssert(grid && referenceGrid, modeName << ": density grid missing");
+
+    OmniConnectVolumeTestAssert(BitwiseEqual(grid->background(), referenceGrid->background()), modeName << ": background differs");
+    OmniConnectVolumeTestAssert(grid->activeVoxelCount() == referenceGrid->activeVoxelCount(), modeName << ": active voxel count differs");
+    OmniConnectVolumeTestAssert(grid->tree().leafCount() == referenceGrid->tree().leafCount(), modeName << ": leaf count differs");
+    OmniConnectVolumeTestAssert(grid->tree().activeTileCount() == referenceGrid->tree().activeTileCount(), modeName << ": tile count differs");
+
+    typename GridType::ConstAccessor accessor = grid->getConstAccessor();
+    typename GridType::ConstAccessor referenceAccessor = referenceGrid->getConstAccessor();
+    for (size_t i = 0; i < NumVoxels; ++i)
+    {
+      openvdb::Coord coord = LinearToCoord(i, Dims);
+      OmniConnectVolumeTestAssert(accessor.isValueOn(coord) == referenceAccessor.isValueOn(coord),
+        modeName << ": active state of voxel " << coord << " differs");
+      OmniConnectVolumeTestAssert(BitwiseEqual(accessor.getValue(coord), referenceAccessor.getValue(coord)),
+        modeName << ": voxel " << coord << " is " << accessor.getValue(coord) << " instead of " << referenceAccessor.getValue(coord));
+    }
+    return EXIT_SUCCESS;
+  }
+
+  template<typename GridType>
+  int TestCompressionModes(int argc, char* argv[], const OmniConnectVolumeData& volumeData, const char* typeName)
+  {
+    const OmniConnectVolumeCompression modes[] = { OmniConnectVolumeCompression::NONE, OmniConnectVolumeCompression::ZIP, OmniConnectVolumeCompression::BLOSC };
+    const char* modeNames[] = { "none", "zip", "blosc" };
+
+    std::string uncompressedBytes;
+    openvdb::GridPtrVecPtr uncompressedGrids;
+
+    for (int modeIdx = 0; modeIdx < 3; ++modeIdx)
+    {
+      std::string caseName = std::string(typeName) + " " + modeNames[modeIdx];
+
+      OmniConnectSettings settings;
+      settings.VolumeCompression = modes[modeIdx];
+      WriterPtr writer = CreateWriter(settings);
+      OmniConnectVolumeTestAssert(writer, caseName << ": volume writer could not be created");
+
+      std::string memoryBytes;
+      openvdb::GridPtrVecPtr grids = WriteAndRead(writer.get(), volumeData, &memoryBytes);
+      OmniConnectVolumeTestAssert(grids && grids->size() == 1, caseName << ": expected a single grid");
+
+      // Streaming into a file must produce the same bytes as the in-memory buffer
+      std::string fileName = GetOutputFileName(argc, argv,
+        (std::string("TestOmniConnectVolumeCompression_") + typeName + "_" + modeNames[modeIdx] + ".vdb").c_str());
+      OmniConnectVolumeTestAssert(writer->ToVDB(volumeData, nullptr, 0, fileName.c_str()), caseName << ": writing " << fileName << " failed");
+
+      std::string fileBytes;
+      OmniConnectVolumeTestAssert(ReadFile(fileName, fileBytes), caseName << ": cannot read back " << fileName);
+      OmniConnectVolumeTestAssert(fileBytes.size() == memoryBytes.size(),
+        caseName << ": file has " << fileBytes.size() << " bytes, memory stream " << memoryBytes.size());
+      OmniConnectVolumeTestAssert(IsUuidAt(fileBytes, UuidOffset) && IsUuidAt(memoryBytes, UuidOffset), caseName << ": unexpected archive header");
+      fileBytes.replace(UuidOffset, UuidSize, UuidSize, '0');
+      memoryBytes.replace(UuidOffset, UuidSize, UuidSize, '0');
+      OmniConnectVolumeTestAssert(fileBytes == memoryBytes, caseName << ": file and memory stream differ");
+      std::remove(fileName.c_str());
+
+      if (modeIdx == 0)
+      {
+        uncompressedBytes = memoryBytes;
+        uncompressedGrids = grids;
+        continue;
+      }
+
+      // Lossless: the decoded grids match the uncompressed ones bit for bit, at a smaller size
+      if (CompareGrids<GridType>(grids, uncompressedGrids, caseName.c_str()) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+      OmniConnectVolumeTestAssert(memoryBytes.size() < uncompressedBytes.size(),
+        caseName << ": " << memoryBytes.size() << " bytes, uncompressed " << uncompressedBytes.size());
+      OmniConnectVolumeTestAssert(memoryBytes != uncompressedBytes, caseName << ": stream is not compressed");
+    }
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectVolumeCompression(int argc, char* argv[])
+{
+  std::vector<float> floatValues = MakeDenseInput();
+  OmniConnectVolumeData floatVolume = MakeVolumeData(floatValues.data(), OmniConnectType::FLOAT, Dims);
+  if (TestCompressionModes<openvdb::FloatGrid>(argc, argv, floatVolume, "float") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::vector<long long> longValues(NumVoxels);
+  for (size_t i = 0; i < NumVoxels; ++i)
+    longValues[i] = (long long)std::llround(double(floatValues[i]) * 1e9);
+  OmniConnectVolumeData longVolume = MakeVolumeData(longValues.data(), OmniConnectType::LONG, Dims);
+  if (TestCompressionModes<openvdb::Int64Grid>(argc, argv, longVolume, "long") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Unwritable output files are reported instead of silently dropped
+  OmniConnectSettings settings;
+  WriterPtr writer = CreateWriter(settings);
+  std::string badFileName = GetOutputFileName(argc, argv, "NonExistentDirectory/Volume.vdb");
+  OmniConnectVolumeTestAssert(!writer->ToVDB(floatVolume, nullptr, 0, badFileName.c_str()), "writing into a missing directory should fail");
+
+  return EXIT_SUCCESS;
+}
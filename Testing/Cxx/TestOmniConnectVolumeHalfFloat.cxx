@@ -0,0 +1,187 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Round trip of floating point grids saved as half (VolumeHalfFloat): the error of every voxel has to stay within
+// half a half-precision ulp, alone and combined with the quantization tolerance, while active states are preserved.
+
+#include "OmniConnectVolumeTestUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  using namespace OmniConnectVolumeTesting;
+
+  const size_t Dims[3] = { 32, 32, 32 };
+  const size_t NumVoxels = Dims[0] * Dims[1] * Dims[2];
+
+  const double HalfMinNormal = std::ldexp(1.0, -14);
+  const double HalfRelativeBound = std::ldexp(1.0, -11); // Half ulp of the 10 bit mantissa
+  const double HalfSubnormalBound = std::ldexp(1.0, -25); // Half of the subnormal spacing
+  const double FloatRelativeBound = std::ldexp(1.0, -23); // Slack for the float arithmetic of the quantizer
+
+  // Signed values over the whole half range including subnormals and values that underflow to zero,
+  // with every 7th voxel (and the first one) at the background
+  std::vector<float> MakeDenseInput()
+  {
+    std::vector<float> values(NumVoxels, 0.0f);
+    for (size_t i = 0; i < NumVoxels; ++i)
+    {
+      if (i % 7 == 0)
+        continue;
+      float mantissa = 1.0f + float((uint32_t(i) * 2654435761u) % 1000u) / 1000.0f;
+      int exponent = -26 + int(i % 42); // Up to 2^15 * 1.999, below the largest half (65504)
+      values[i] = ((i & 1) ? -1.0f : 1.0f) * std::ldexp(mantissa, exponent);
+    }
+    return values;
+  }
+
+  // Bound on the distance of a value to its half representation
+  double HalfErrorBound(double value)
+  {
+    return std::abs(value) >= HalfMinNormal ? std::abs(value) * HalfRelativeBound : HalfSubnormalBound;
+  }
+
+  // Reference of the writer's quantizer in double precision
+  double QuantizedValue(double value, double tolerance)
+  {
+    if (tolerance <= 0.0)
+      return value;
+    if (std::abs(value) <= tolerance)
+      return 0.0;
+    return std::round(value / (2.0 * tolerance)) * (2.0 * tolerance);
+  }
+
+  double GetComponent(float value, int comp) { return double(value); }
+  double GetComponent(double value, int comp) { return value; }
+  double GetComponent(const openvdb::Vec3f& value, int comp) { return double(value[comp]); }
+
+  template<typename GridType, typename InputFunc>
+  int CheckRoundTrip(const openvdb::GridPtrVecPtr& grids, const InputFunc& input, float tolerance, bool saveHalf, const char* caseName)
+  {
+    typename GridType::Ptr grid = FindGrid<GridType>(grids, "density");
+    OmniConnectVolumeTestAssert(grid, caseName << ": no density grid of the expected type was read back");
+
+    typename GridType::ConstAccessor accessor = grid->getConstAccessor();
+    const int numComps = openvdb::VecTraits<typename GridType::ValueType>::Size;
+    double maxError = 0.0;
+    for (size_t i = 0; i < NumVoxels; ++i)
+    {
+      openvdb::Coord coord = LinearToCoord(i, Dims);
+      typename GridType::ValueType value = accessor.getValue(coord);
+
+      bool expectedActive = false;
+      for (int comp = 0; comp < numComps; ++comp)
+        expectedActive = expectedActive || QuantizedValue(input(i, comp), tolerance) != 0.0;
+      OmniConnectVolumeTestAssert(accessor.isValueOn(coord) == expectedActive,
+        caseName << ": voxel " << coord << " should be " << (expectedActive ? "active" : "inactive"));
+
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        double inValue = input(i, comp);
+        double outValue = GetComponent(value, comp);
+        double quantized = QuantizedValue(inValue, tolerance);
+
+        // Values snapped to the background are inactive and read back as the exact background
+        double bound = 0.0;
+        if (expectedActive)
+        {
+          // The float quantizer may round to the neighboring step of the double reference
+          double step = 2.0 * double(tolerance);
+          if (tolerance > 0.0f)
+            bound += double(tolerance) + (std::abs(inValue) + step) * FloatRelativeBound;
+          if (saveHalf)
+            bound += HalfErrorBound(std::abs(quantized) + step);
+        }
+        double error = std::abs(outValue - (expectedActive ? inValue : 0.0));
+        maxError = std::max(maxError, error / std::max(bound, HalfSubnormalBound));
+
+        OmniConnectVolumeTestAssert(error <= bound,
+          caseName << ": voxel " << coord << " component " << comp << " is " << outValue << " for input " << inValue
+          << ", error " << error << " exceeds " << bound);
+        OmniConnectVolumeTestAssert(!(saveHalf && std::abs(quantized) >= HalfMinNormal) || std::signbit(outValue) == std::signbit(inValue),
+          caseName << ": voxel " << coord << " changed sign");
+      }
+    }
+    std::cout << caseName << ": largest error relative to its bound " << maxError << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  template<typename GridType, typename InputFunc>
+  int TestCase(const OmniConnectVolumeData& volumeData, const InputFunc& input, float tolerance, bool saveHalf, bool convertDoubleToFloat,
+    const char* caseName, size_t* streamSize = nullptr)
+  {
+    OmniConnectSettings settings;
+    settings.VolumeCompression = OmniConnectVolumeCompression::NONE;
+    settings.VolumeHalfFloat = saveHalf;
+    settings.VolumeQuantizationTolerance = tolerance;
+    WriterPtr writer = CreateWriter(settings, convertDoubleToFloat);
+    OmniConnectVolumeTestAssert(writer, caseName << ": volume writer could not be created");
+
+    std::string bytes;
+    openvdb::GridPtrVecPtr grids = WriteAndRead(writer.get(), volumeData, &bytes);
+    if (streamSize)
+      *streamSize = bytes.size();
+    return CheckRoundTrip<GridType>(grids, input, tolerance, saveHalf, caseName);
+  }
+}
+
+int TestOmniConnectVolumeHalfFloat(int argc, char* argv[])
+{
+  std::vector<float> floatValues = MakeDenseInput();
+  OmniConnectVolumeData floatVolume = MakeVolumeData(floatValues.data(), OmniConnectType::FLOAT, Dims);
+  auto floatInput = [&floatValues](size_t i, int comp) { return double(floatValues[i]); };
+
+  // Full precision is exact, half precision within its bound and smaller
+  size_t fullSize = 0, halfSize = 0;
+  if (TestCase<openvdb::FloatGrid>(floatVolume, floatInput, 0.0f, false, false, "float", &fullSize) != EXIT_SUCCESS ||
+    TestCase<openvdb::FloatGrid>(floatVolume, floatInput, 0.0f, true, false, "float half", &halfSize) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  OmniConnectVolumeTestAssert(halfSize < fullSize, "half stream has " << halfSize << " bytes, full precision " << fullSize);
+
+  // Combined with quantization, the error is bounded by the tolerance plus the half error of the quantized value
+  if (TestCase<openvdb::FloatGrid>(floatVolume, floatInput, 0.01f, false, false, "float quantized", nullptr) != EXIT_SUCCESS ||
+    TestCase<openvdb::FloatGrid>(floatVolume, floatInput, 0.01f, true, false, "float quantized half", nullptr) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Double grids are saved as half as well, also when converted to float
+  std::vector<double> doubleValues(floatValues.begin(), floatValues.end());
+  OmniConnectVolumeData doubleVolume = MakeVolumeData(doubleValues.data(), OmniConnectType::DOUBLE, Dims);
+  auto doubleInput = [&doubleValues](size_t i, int comp) { return doubleValues[i]; };
+  if (TestCase<openvdb::DoubleGrid>(doubleVolume, doubleInput, 0.0f, true, false, "double half", nullptr) != EXIT_SUCCESS ||
+    TestCase<openvdb::FloatGrid>(doubleVolume, doubleInput, 0.0f, true, true, "double to float half", nullptr) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Vector grids per component
+  std::vector<openvdb::Vec3f> vecValues(NumVoxels);
+  for (size_t i = 0; i < NumVoxels; ++i)
+    vecValues[i] = openvdb::Vec3f(floatValues[i], -0.5f * floatValues[i], floatValues[NumVoxels - 1 - i] * (i % 7 == 0 ? 0.0f : 1.0f));
+  OmniConnectVolumeData vecVolume = MakeVolumeData(vecValues.data(), OmniConnectType::FLOAT3, Dims);
+  auto vecInput = [&vecValues](size_t i, int comp) { return double(vecValues[i][comp]); };
+  if (TestCase<openvdb::Vec3fGrid>(vecVolume, vecInput, 0.0f, true, false, "float3 half", nullptr) != EXIT_SUCCESS ||
+    TestCase<openvdb::Vec3fGrid>(vecVolume, vecInput, 0.01f, true, false, "float3 quantized half", nullptr) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
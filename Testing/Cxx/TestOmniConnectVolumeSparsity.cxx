@@ -0,0 +1,213 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Reads back the sparse grids of the volume writer and compares them voxel by voxel with the dense input:
+// background voxels must be inactive, all others active with the exact input value, uniform leaf-sized blocks must
+// become tiles and blocks at the (non leaf-aligned) volume border must not leak outside of the input bounds.
+
+#include "OmniConnectVolumeTestUtilities.h"
+
+#include <cmath>
+
+namespace
+{
+  using namespace OmniConnectVolumeTesting;
+
+  const size_t Dims[3] = { 37, 21, 45 };
+  const size_t NumVoxels = Dims[0] * Dims[1] * Dims[2];
+  const int LeafDim = 8;
+
+  // Background at 0, a uniform leaf-aligned box of 2x1x2 blocks, a noisy sphere crossing the partial border blocks,
+  // and a denormal just above the background in the very last voxel
+  std::vector<float> MakeDenseInput()
+  {
+    std::vector<float> values(NumVoxels, 0.0f);
+    for (size_t i = 0; i < NumVoxels; ++i)
+    {
+      openvdb::Coord c = LinearToCoord(i, Dims);
+      if (c.x() >= 8 && c.x() < 24 && c.y() >= 8 && c.y() < 16 && c.z() >= 8 && c.z() < 24)
+        values[i] = 2.5f;
+      else
+      {
+        float dx = float(c.x() - 30), dy = float(c.y() - 10), dz = float(c.z() - 38);
+        if (dx*dx + dy*dy + dz*dz < 49.0f)
+          values[i] = 3.0f + std::sin(0.7f * float(c.x()) + 0.3f * float(c.y() * c.z()));
+      }
+    }
+    values[NumVoxels - 1] = 1e-40f;
+    return values;
+  }
+
+  // Leaves and tiles the writer should produce for the expected values: blocks without active voxels are skipped,
+  // fully active uniform blocks become tiles and everything else a leaf
+  template<typename ValueType, typename ExpectedFunc>
+  void CountExpectedNodes(const ExpectedFunc& expected, const ValueType& background, size_t& numLeaves, size_t& numTiles)
+  {
+    numLeaves = numTiles = 0;
+    for (size_t bz = 0; bz < Dims[2]; bz += LeafDim)
+      for (size_t by = 0; by < Dims[1]; by += LeafDim)
+        for (size_t bx = 0; bx < Dims[0]; bx += LeafDim)
+        {
+          size_t numActive = 0;
+          bool uniform = true;
+          ValueType first = expected(bx + by * Dims[0] + bz * Dims[0] * Dims[1]);
+          for (size_t z = bz; z < std::min(bz + LeafDim, Dims[2]); ++z)
+            for (size_t y = by; y < std::min(by + LeafDim, Dims[1]); ++y)
+              for (size_t x = bx; x < std::min(bx + LeafDim, Dims[0]); ++x)
+              {
+                ValueType value = expected(x + y * Dims[0] + z * Dims[0] * Dims[1]);
+                numActive += !(value == background);
+                uniform = uniform && value == first;
+              }
+          if (numActive == size_t(LeafDim * LeafDim * LeafDim) && uniform)
+            ++numTiles;
+          else if (numActive > 0)
+            ++numLeaves;
+        }
+  }
+
+  template<typename GridType, typename ExpectedFunc>
+  int CheckSparseGrid(const openvdb::GridPtrVecPtr& grids, const ExpectedFunc& expected,
+    const typename GridType::ValueType& expectedBackground, const char* caseName)
+  {
+    using ValueType = typename GridType::ValueType;
+
+    typename GridType::Ptr grid = FindGrid<GridType>(grids, "density");
+    OmniConnectVolumeTestAssert(grid, caseName << ": no density grid of the expected type was read back");
+    OmniConnectVolumeTestAssert(BitwiseEqual(grid->background(), expectedBackground), caseName << ": unexpected background value");
+
+    typename GridType::ConstAccessor accessor = grid->getConstAccessor();
+    size_t numExpectedActive = 0;
+    for (size_t i = 0; i < NumVoxels; ++i)
+    {
+      openvdb::Coord coord = LinearToCoord(i, Dims);
+      ValueType expectedValue = expected(i);
+      bool expectedActive = !(expectedValue == expectedBackground);
+      numExpectedActive += expectedActive;
+
+      OmniConnectVolumeTestAssert(accessor.isValueOn(coord) == expectedActive,
+        caseName << ": voxel " << coord << " should be " << (expectedActive ? "active" : "inactive"));
+      OmniConnectVolumeTestAssert(BitwiseEqual(accessor.getValue(coord), expectedValue),
+        caseName << ": voxel " << coord << " is " << accessor.getValue(coord) << " instead of " << expectedValue);
+    }
+
+    // Active voxels outside of the input bounds would add to the count
+    OmniConnectVolumeTestAssert(grid->activeVoxelCount() == numExpectedActive,
+      caseName << ": " << grid->activeVoxelCount() << " active voxels instead of " << numExpectedActive);
+
+    openvdb::CoordBBox activeBBox = grid->evalActiveVoxelBoundingBox();
+    OmniConnectVolumeTestAssert(numExpectedActive == 0 ||
+      openvdb::CoordBBox(0, 0, 0, int(Dims[0]) - 1, int(Dims[1]) - 1, int(Dims[2]) - 1).isInside(activeBBox),
+      caseName << ": active bounding box " << activeBBox << " exceeds the input");
+
+    size_t numLeaves = 0, numTiles = 0;
+    CountExpectedNodes(expected, expectedBackground, numLeaves, numTiles);
+    OmniConnectVolumeTestAssert(grid->tree().leafCount() == numLeaves,
+      caseName << ": " << grid->tree().leafCount() << " leaves instead of " << numLeaves);
+    OmniConnectVolumeTestAssert(size_t(grid->tree().activeTileCount()) == numTiles,
+      caseName << ": " << grid->tree().activeTileCount() << " tiles instead of " << numTiles);
+
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectVolumeSparsity(int argc, char* argv[])
+{
+  OmniConnectSettings settings;
+  settings.VolumeCompression = OmniConnectVolumeCompression::NONE;
+  WriterPtr writer = CreateWriter(settings);
+  OmniConnectVolumeTestAssert(writer, "volume writer could not be created");
+
+  std::vector<float> floatValues = MakeDenseInput();
+
+  // Float input, background taken from element 0
+  {
+    OmniConnectVolumeData volumeData = MakeVolumeData(floatValues.data(), OmniConnectType::FLOAT, Dims);
+    volumeData.Origin[0] = -1.0f; volumeData.Origin[1] = 2.0f; volumeData.Origin[2] = 3.0f;
+    volumeData.CellDimensions[0] = 0.5f; volumeData.CellDimensions[1] = 1.0f; volumeData.CellDimensions[2] = 2.0f;
+
+    openvdb::GridPtrVecPtr grids = WriteAndRead(writer.get(), volumeData);
+    OmniConnectVolumeTestAssert(grids && grids->size() == 1, "float: expected a single grid");
+    if (CheckSparseGrid<openvdb::FloatGrid>(grids, [&](size_t i) { return floatValues[i]; }, 0.0f, "float") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    openvdb::Vec3d world = (*grids)[0]->transform().indexToWorld(openvdb::Coord(1, 2, 3));
+    OmniConnectVolumeTestAssert(world.eq(openvdb::Vec3d(-0.5, 4.0, 9.0)), "float: unexpected index to world transform " << world);
+  }
+
+  // Without background index the background is 0, so every voxel of the shifted input is active
+  {
+    std::vector<float> shiftedValues(floatValues);
+    for (float& value : shiftedValues)
+      value += 1.0f;
+
+    OmniConnectVolumeData volumeData = MakeVolumeData(shiftedValues.data(), OmniConnectType::FLOAT, Dims, -1);
+    if (CheckSparseGrid<openvdb::FloatGrid>(WriteAndRead(writer.get(), volumeData),
+      [&](size_t i) { return shiftedValues[i]; }, 0.0f, "dense float") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Integer input is copied into an integer grid
+  {
+    std::vector<int> intValues(NumVoxels);
+    for (size_t i = 0; i < NumVoxels; ++i)
+      intValues[i] = int(std::lround(floatValues[i] * 100.0f));
+
+    OmniConnectVolumeData volumeData = MakeVolumeData(intValues.data(), OmniConnectType::INT, Dims);
+    if (CheckSparseGrid<openvdb::Int32Grid>(WriteAndRead(writer.get(), volumeData),
+      [&](size_t i) { return intValues[i]; }, 0, "int") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Small integer input is normalized into a float grid
+  {
+    std::vector<unsigned char> ucharValues(NumVoxels);
+    for (size_t i = 0; i < NumVoxels; ++i)
+      ucharValues[i] = (unsigned char)std::lround(floatValues[i] * 60.0f);
+
+    const float invRange = 1.0f / 255.0f;
+    OmniConnectVolumeData volumeData = MakeVolumeData(ucharValues.data(), OmniConnectType::UCHAR, Dims);
+    if (CheckSparseGrid<openvdb::FloatGrid>(WriteAndRead(writer.get(), volumeData),
+      [&](size_t i) { return (static_cast<float>(ucharValues[i]) - 0.0f) * invRange; }, 0.0f, "uchar") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Vector input, with and without conversion to float
+  {
+    std::vector<openvdb::Vec3d> vecValues(NumVoxels);
+    for (size_t i = 0; i < NumVoxels; ++i)
+      vecValues[i] = openvdb::Vec3d(floatValues[i], 0.0, floatValues[i] == 2.5f ? 2.5 : -double(floatValues[i]) / 3.0);
+
+    OmniConnectVolumeData volumeData = MakeVolumeData(vecValues.data(), OmniConnectType::DOUBLE3, Dims);
+    if (CheckSparseGrid<openvdb::Vec3dGrid>(WriteAndRead(writer.get(), volumeData),
+      [&](size_t i) { return vecValues[i]; }, openvdb::Vec3d(0.0), "double3") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    WriterPtr floatWriter = CreateWriter(settings, true);
+    if (CheckSparseGrid<openvdb::Vec3fGrid>(WriteAndRead(floatWriter.get(), volumeData),
+      [&](size_t i) { return openvdb::Vec3f(vecValues[i]); }, openvdb::Vec3f(0.0f), "double3 to float3") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,246 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+// Drives the write-behind queue with a fault-injecting backend: failed writes have to surface at the next barrier,
+// the remaining writes still drain, and shutting down returns with everything written.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "OmniConnectWriteQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // Records every issued write and fails the ones to chosen paths, either by returning false or by throwing
+  class FaultInjectingBackend
+  {
+  public:
+    bool Write(const char* data, size_t dataSize, const char* filePath, bool binary)
+    {
+      std::string path(filePath);
+
+      // Checks that writes to one path are never issued concurrently
+      {
+        std::unique_lock<std::mutex> lock(Mutex);
+        if (!InFlight.insert(path).second)
+          ConcurrentSamePath = true;
+        MaxInFlightBytes = std::max(MaxInFlightBytes, InFlightBytes += dataSize);
+      }
+
+      if (WriteDelayMs > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(WriteDelayMs));
+
+      bool fail = FailingPaths.count(path) != 0;
+      bool fault = ThrowingPaths.count(path) != 0;
+
+      {
+        std::unique_lock<std::mutex> lock(Mutex);
+        InFlight.erase(path);
+        InFlightBytes -= dataSize;
+        ++NumIssued;
+        if (!fail && !fault)
+          Written[path] = std::string(data, dataSize);
+      }
+
+      if (fault)
+        throw std::runtime_error("Injected write fault");
+      return !fail;
+    }
+
+    OmniConnectWriteQueue::WriteFunc GetFunc()
+    {
+      return [this](const char* data, size_t dataSize, const char* filePath, bool binary)
+      { return Write(data, dataSize, filePath, binary); };
+    }
+
+    std::set<std::string> FailingPaths;
+    std::set<std::string> ThrowingPaths;
+    int WriteDelayMs = 0;
+
+    std::mutex Mutex;
+    std::map<std::string, std::string> Written;
+    std::set<std::string> InFlight;
+    size_t InFlightBytes = 0;
+    size_t MaxInFlightBytes = 0;
+    size_t NumIssued = 0;
+    bool ConcurrentSamePath = false;
+  };
+
+  std::string PathName(int i)
+  {
+    return "file" + std::to_string(i) + ".usda";
+  }
+
+  std::string Contents(int i, int version)
+  {
+    return std::string(64 + i, static_cast<char>('a' + (i + version) % 26));
+  }
+
+  bool Enqueue(OmniConnectWriteQueue& queue, const std::string& path, const std::string& contents)
+  {
+    return queue.Enqueue(contents.data(), contents.size(), path.c_str(), false);
+  }
+
+  int TestFailuresSurface(size_t numThreads)
+  {
+    const int numFiles = 32;
+
+    FaultInjectingBackend backend;
+    backend.FailingPaths = { PathName(3), PathName(17) };
+    backend.ThrowingPaths = { PathName(9) };
+
+    OmniConnectWriteQueue queue(backend.GetFunc(), numThreads, size_t(1) << 20);
+
+    std::set<std::string> expectedFailed = { PathName(3), PathName(9), PathName(17) };
+
+    // Without worker threads, failures are also returned immediately
+    for (int i = 0; i < numFiles; ++i)
+    {
+      bool expectEnqueued = numThreads > 0 || expectedFailed.count(PathName(i)) == 0;
+      vtkOmniConnectTestAssert(Enqueue(queue, PathName(i), Contents(i, 0)) == expectEnqueued, "Unexpected enqueue result on a running queue");
+    }
+
+    std::vector<std::string> failedPaths;
+    vtkOmniConnectTestAssert(!queue.WaitAll(&failedPaths), "Barrier did not report the failing writes");
+
+    std::set<std::string> failedSet(failedPaths.begin(), failedPaths.end());
+    vtkOmniConnectTestAssert(failedPaths.size() == expectedFailed.size() && failedSet == expectedFailed,
+      "Barrier reported the wrong failed paths");
+
+    // Every other write still went through, despite the failures in between
+    vtkOmniConnectTestAssert(backend.Written.size() == size_t(numFiles) - expectedFailed.size(), "Queue did not drain past the failures");
+    for (int i = 0; i < numFiles; ++i)
+    {
+      if (expectedFailed.count(PathName(i)))
+        continue;
+      auto writtenIt = backend.Written.find(PathName(i));
+      vtkOmniConnectTestAssert(writtenIt != backend.Written.end() && writtenIt->second == Contents(i, 0), "Written contents differ");
+    }
+
+    // Failures are reported once; a clean round afterwards succeeds
+    backend.FailingPaths.clear();
+    backend.ThrowingPaths.clear();
+    failedPaths.clear();
+    vtkOmniConnectTestAssert(queue.WaitAll(&failedPaths) && failedPaths.empty(), "Failures were reported twice");
+
+    for (int i = 0; i < numFiles; ++i)
+      vtkOmniConnectTestAssert(Enqueue(queue, PathName(i), Contents(i, 1)), "Enqueue failed after a failing round");
+    vtkOmniConnectTestAssert(queue.WaitAll(&failedPaths) && failedPaths.empty(), "Retried writes failed");
+    vtkOmniConnectTestAssert(backend.Written.size() == size_t(numFiles), "Retried writes did not all land");
+    for (int i = 0; i < numFiles; ++i)
+      vtkOmniConnectTestAssert(backend.Written[PathName(i)] == Contents(i, 1), "Retried contents differ");
+
+    // Shutdown drains whatever is still pending, failing or not, then refuses new writes
+    backend.FailingPaths = { PathName(5) };
+    for (int i = 0; i < numFiles; ++i)
+    {
+      bool expectEnqueued = numThreads > 0 || i != 5;
+      vtkOmniConnectTestAssert(Enqueue(queue, PathName(i), Contents(i, 2)) == expectEnqueued, "Unexpected enqueue result before shutdown");
+    }
+    queue.Shutdown();
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+      const std::string& expected = Contents(i, i == 5 ? 1 : 2);
+      vtkOmniConnectTestAssert(backend.Written[PathName(i)] == expected, "Shutdown did not drain the pending writes");
+    }
+    vtkOmniConnectTestAssert(!Enqueue(queue, PathName(0), Contents(0, 3)), "Enqueue succeeded after shutdown");
+    vtkOmniConnectTestAssert(backend.Written[PathName(0)] == Contents(0, 2), "Write after shutdown reached the backend");
+
+    failedPaths.clear();
+    vtkOmniConnectTestAssert(!queue.WaitAll(&failedPaths) && failedPaths.size() == 1 && failedPaths[0] == PathName(5),
+      "Failure during shutdown was lost");
+
+    queue.Shutdown(); // Idempotent
+    vtkOmniConnectTestAssert(!backend.ConcurrentSamePath, "Writes to the same path were issued concurrently");
+
+    return EXIT_SUCCESS;
+  }
+
+  int TestCoalescingAndBackPressure()
+  {
+    const size_t maxPendingBytes = 1024;
+    const int numWrites = 200;
+
+    FaultInjectingBackend backend;
+    backend.FailingPaths = { PathName(1) };
+    backend.WriteDelayMs = 1;
+
+    OmniConnectWriteQueue queue(backend.GetFunc(), 2, maxPendingBytes);
+
+    // Rewrites of a few paths; the budget bounds the bytes held by the queue, including the ones being written
+    for (int i = 0; i < numWrites; ++i)
+      vtkOmniConnectTestAssert(Enqueue(queue, PathName(i % 4), Contents(i % 4, i)), "Enqueue failed under back-pressure");
+
+    // A write larger than the budget is still accepted once the queue has drained
+    std::string large(4 * maxPendingBytes, 'x');
+    vtkOmniConnectTestAssert(Enqueue(queue, PathName(4), large), "Oversized write was refused");
+
+    std::vector<std::string> failedPaths;
+    vtkOmniConnectTestAssert(!queue.WaitAll(&failedPaths), "Barrier did not report the failing writes");
+    vtkOmniConnectTestAssert(std::all_of(failedPaths.begin(), failedPaths.end(), [](const std::string& path) { return path == PathName(1); }),
+      "Barrier reported a path that did not fail");
+
+    // Last write wins for every path
+    for (int p = 0; p < 4; ++p)
+    {
+      if (p == 1)
+        continue;
+      int lastVersion = numWrites - 4 + p;
+      vtkOmniConnectTestAssert(backend.Written[PathName(p)] == Contents(p, lastVersion), "Coalesced write lost the last contents");
+    }
+    vtkOmniConnectTestAssert(backend.Written[PathName(4)] == large, "Oversized write did not land");
+    vtkOmniConnectTestAssert(backend.NumIssued <= size_t(numWrites) + 1, "Queue issued more writes than were enqueued");
+    vtkOmniConnectTestAssert(backend.MaxInFlightBytes <= large.size(), "In-flight bytes exceeded the budget");
+    vtkOmniConnectTestAssert(!backend.ConcurrentSamePath, "Writes to the same path were issued concurrently");
+
+    // Cancel drops a pending write and waits for an in-flight one
+    Enqueue(queue, PathName(2), Contents(2, -1));
+    queue.Cancel(PathName(2).c_str());
+    vtkOmniConnectTestAssert(queue.WaitAll(), "Cancelled write was reported as failed");
+
+    queue.Shutdown();
+    return EXIT_SUCCESS;
+  }
+}
+
+int TestOmniConnectWriteQueue(int argc, char* argv[])
+{
+  // Synchronous (no worker threads) and threaded queues report failures the same way
+  for (size_t numThreads : { size_t(0), size_t(1), size_t(4) })
+  {
+    if (TestFailuresSurface(numThreads) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return TestCoalescingAndBackPressure();
+}
@@ -0,0 +1,1072 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+// Renders a synthetic, animated scene through vtkOmniConnectPass without an OpenGL context or
+// Omniverse server, and reports the per-stage profiler timings of every frame as json.
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectRendererNode.h"
+#include "vtkOmniConnectImageWriter.h"
+#include "vtkOmniConnectConnectivity.h"
+#include "vtkOmniConnectLogCallback.h"
+#include "OmniConnect.h"
+#include "OmniConnectIdMap.h"
+#include "OmniConnectUtilsInternal.h"
+#include "vtkActor.h"
+#include "vtkMapper.h"
+#include "vtkAbstractVolumeMapper.h"
+#include "vtkCellArray.h"
+#include "vtkPolyData.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPoints.h"
+#include "vtkVolume.h"
+#include "vtkSMPTools.h"
+#include "vtkTexture.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  struct BenchmarkOptions
+  {
+    std::string OutputDirectory = "OmniConnectBenchmark";
+    std::string JsonFileName;
+    int NumMeshes = 16;
+    int MeshResolution = 128;
+    int NumLines = 64;
+    int NumGlyphs = 4096;
+    int VolumeDim = 64;
+    int NumFrames = 10;
+    int NumBlocks = 0;
+    int TextureResolution = 0;
+    int IndexCells = 0;
+    int NumNormals = 0;
+    int NumColors = 0;
+    int NumStageActors = 0;
+    int NumStageTimesteps = 100;
+    int NumClipTimesteps = 0;
+    int NumRetimeActors = 0;
+    int NumRetimeTimesteps = 100;
+    int NumIdMapEntries = 0;
+    int NumConcurrentActors = 0;
+    int NumTexturedActors = 0;
+    bool DiscardAssetWrites = false;
+  };
+
+  void PrintUsage()
+  {
+    std::cout << "Usage: vtkOmniConnectBenchmark [--output <dir>] [--json <file>] [--meshes <n>] [--resolution <n>]\n"
+      "  [--lines <n>] [--glyphs <n>] [--volume-dim <n>] [--frames <n>] [--blocks <n>] [--texture-resolution <n>]\n"
+      "  [--index-cells <n>] [--normals <n>] [--colors <n>] [--stage-actors <n>] [--stage-timesteps <n>]\n"
+      "  [--clip-timesteps <n>] [--retime-actors <n>] [--retime-timesteps <n>] [--idmap-entries <n>]\n"
+      "  [--concurrent-actors <n>] [--textured-actors <n>] [--discard-asset-writes]\n"
+      "A count of 0 leaves out the corresponding actors.\n"
+      "--blocks adds a static multiblock actor of small meshes, of which a single block changes per frame.\n"
+      "--texture-resolution encodes a square rgba texture once per frame with every texture encoding, outside of the scene.\n"
+      "--index-cells builds the triangle index buffer and per-triangle cell data of a quad mesh with that many cells once per frame,\n"
+      "  outside of the scene.\n"
+      "--normals encodes that many unit normals once per frame with every normals encoding, outside of the scene.\n"
+      "--colors converts that many srgb byte colors to linear once per frame, batched and with the scalar reference, outside of the scene.\n"
+      "--stage-actors writes a separate scene of that many small animated meshes over --stage-timesteps timesteps (default 100)\n"
+      "  to <output>/Stages, and reports the parallel layer flush against the summed time of saving each layer in turn.\n"
+      "--clip-timesteps writes a static and an animated mesh over that many timesteps to <output>/Clips, and reports the clip metadata\n"
+      "  flush time per tenth of the timesteps, which stays flat as long as each flush only covers the new timesteps.\n"
+      "--retime-actors adds that many static single triangle actors over --retime-timesteps timesteps (default 100) to <output>/Retiming,\n"
+      "  and reports the time of retiming all of them on the scene stage, half with an identity and half with a reversed mapping.\n"
+      "--idmap-entries fills the id map of the connector caches, std::map and std::unordered_map with that many entries\n"
+      "  once per frame, and reports the time per insert, found and missed lookup, iterated entry and erase.\n"
+      "--concurrent-actors renders that many small animated meshes over --frames frames to <output>/Concurrent, once with the\n"
+      "  actors traversed on a single thread and once on all threads, and reports the wall time per frame of both.\n"
+      "--textured-actors renders that many meshes with a 512x512 texture that changes every frame over --frames frames to\n"
+      "  <output>/Textured, and reports the wall time per frame and the time spent waiting for texture encodes after the gather." << std::endl;
+  }
+
+  bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const char* arg = argv[i];
+      bool hasValue = i + 1 < argc;
+      if (strcmp(arg, "--discard-asset-writes") == 0)
+        options.DiscardAssetWrites = true;
+      else if (strcmp(arg, "--output") == 0 && hasValue)
+        options.OutputDirectory = argv[++i];
+      else if (strcmp(arg, "--json") == 0 && hasValue)
+        options.JsonFileName = argv[++i];
+      else if (strcmp(arg, "--meshes") == 0 && hasValue)
+        options.NumMeshes = atoi(argv[++i]);
+      else if (strcmp(arg, "--resolution") == 0 && hasValue)
+        options.MeshResolution = atoi(argv[++i]);
+      else if (strcmp(arg, "--lines") == 0 && hasValue)
+        options.NumLines = atoi(argv[++i]);
+      else if (strcmp(arg, "--glyphs") == 0 && hasValue)
+        options.NumGlyphs = atoi(argv[++i]);
+      else if (strcmp(arg, "--volume-dim") == 0 && hasValue)
+        options.VolumeDim = atoi(argv[++i]);
+      else if (strcmp(arg, "--frames") == 0 && hasValue)
+        options.NumFrames = atoi(argv[++i]);
+      else if (strcmp(arg, "--blocks") == 0 && hasValue)
+        options.NumBlocks = atoi(argv[++i]);
+      else if (strcmp(arg, "--texture-resolution") == 0 && hasValue)
+        options.TextureResolution = atoi(argv[++i]);
+      else if (strcmp(arg, "--index-cells") == 0 && hasValue)
+        options.IndexCells = atoi(argv[++i]);
+      else if (strcmp(arg, "--normals") == 0 && hasValue)
+        options.NumNormals = atoi(argv[++i]);
+      else if (strcmp(arg, "--colors") == 0 && hasValue)
+        options.NumColors = atoi(argv[++i]);
+      else if (strcmp(arg, "--stage-actors") == 0 && hasValue)
+        options.NumStageActors = atoi(argv[++i]);
+      else if (strcmp(arg, "--stage-timesteps") == 0 && hasValue)
+        options.NumStageTimesteps = atoi(argv[++i]);
+      else if (strcmp(arg, "--clip-timesteps") == 0 && hasValue)
+        options.NumClipTimesteps = atoi(argv[++i]);
+      else if (strcmp(arg, "--retime-actors") == 0 && hasValue)
+        options.NumRetimeActors = atoi(argv[++i]);
+      else if (strcmp(arg, "--retime-timesteps") == 0 && hasValue)
+        options.NumRetimeTimesteps = atoi(argv[++i]);
+      else if (strcmp(arg, "--idmap-entries") == 0 && hasValue)
+        options.NumIdMapEntries = atoi(argv[++i]);
+      else if (strcmp(arg, "--concurrent-actors") == 0 && hasValue)
+        options.NumConcurrentActors = atoi(argv[++i]);
+      else if (strcmp(arg, "--textured-actors") == 0 && hasValue)
+        options.NumTexturedActors = atoi(argv[++i]);
+      else
+        return false;
+    }
+    return options.NumFrames > 0 && options.MeshResolution >= 3 && options.NumStageTimesteps > 0 && options.NumRetimeTimesteps > 0;
+  }
+
+  double ElapsedMs(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // Encode time and size of a texture for every encoding, as a json array
+  bool BenchmarkTextureEncoding(const BenchmarkOptions& options, std::ostream& json)
+  {
+    using Encoding = vtkOmniConnectImageWriter::Encoding;
+    const std::pair<Encoding, const char*> encodings[] = { { Encoding::STORED, "stored" }, { Encoding::FAST, "fast" }, { Encoding::DEFAULT, "default" } };
+
+    json << "[";
+    for (const auto& encoding : encodings)
+    {
+      vtkOmniConnectImageWriter writer;
+      writer.SetEncoding(encoding.first, false);
+
+      double encodeMs = 0.0;
+      int encodedSize = 0;
+      for (int frame = 0; frame < options.NumFrames; ++frame)
+      {
+        // Input generation is not part of the measurement
+        vtkSmartPointer<vtkImageData> texture = vtkOmniConnectTesting::MakeTexture(options.TextureResolution, options.TextureResolution, 4, 0.1 * frame);
+
+        auto encodeStart = std::chrono::steady_clock::now();
+        if (!writer.WriteData(texture))
+          return false;
+        encodeMs += ElapsedMs(encodeStart);
+
+        char* imageData = nullptr;
+        writer.GetResult(imageData, encodedSize);
+      }
+
+      json << (encoding.first == encodings[0].first ? "\n" : ",\n") << "    { \"encoding\": \"" << encoding.second
+        << "\", \"encode\": " << encodeMs / options.NumFrames << ", \"bytes\": " << encodedSize << " }";
+      std::cout << "Texture encoding " << encoding.second << ": " << encodeMs / options.NumFrames << " ms, " << encodedSize << " bytes" << std::endl;
+    }
+    json << "\n  ]";
+    return true;
+  }
+
+  // Square grid of at least numCells quads
+  vtkSmartPointer<vtkPolyData> MakeQuadGrid(int numCells)
+  {
+    vtkIdType cellsPerRow = (vtkIdType)std::ceil(std::sqrt((double)numCells));
+    vtkIdType pointsPerRow = cellsPerRow + 1;
+
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(pointsPerRow * pointsPerRow);
+    for (vtkIdType y = 0; y < pointsPerRow; ++y)
+      for (vtkIdType x = 0; x < pointsPerRow; ++x)
+        points->SetPoint(y * pointsPerRow + x, (double)x, (double)y, 0.0);
+
+    vtkNew<vtkCellArray> polys;
+    polys->AllocateExact(cellsPerRow * cellsPerRow, 4 * cellsPerRow * cellsPerRow);
+    for (vtkIdType y = 0; y < cellsPerRow; ++y)
+    {
+      for (vtkIdType x = 0; x < cellsPerRow; ++x)
+      {
+        vtkIdType base = y * pointsPerRow + x;
+        vtkIdType quad[4] = { base, base + 1, base + pointsPerRow + 1, base + pointsPerRow };
+        polys->InsertNextCell(4, quad);
+      }
+    }
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    return polyData;
+  }
+
+  // Build time of the triangle index buffer and scatter time of per-triangle cell data, with buffers reused over
+  // frames as by the mapper node. Allocations counts the buffer (re)allocations over all frames.
+  void BenchmarkIndexBuffers(const BenchmarkOptions& options, std::ostream& json)
+  {
+    vtkSmartPointer<vtkPolyData> polyData = MakeQuadGrid(options.IndexCells);
+    vtkIdType numCells = polyData->GetNumberOfCells();
+    std::vector<float> cellNormals(numCells * 3, 1.0f);
+
+    std::vector<vtkIdType> cellOffsets;
+    std::vector<unsigned int> indexArray, indexToCell;
+    std::vector<float> perPrimNormal;
+
+    double buildMs = 0.0, scatterMs = 0.0;
+    int numAllocations = 0;
+    for (int frame = 0; frame < options.NumFrames; ++frame)
+    {
+      const void* buffers[4] = { cellOffsets.data(), indexArray.data(), indexToCell.data(), perPrimNormal.data() };
+
+      auto buildStart = std::chrono::steady_clock::now();
+      vtkOmniConnectConnectivity::MakeConnectivity(polyData, VTK_SURFACE, (size_t)polyData->GetNumberOfPoints(),
+        indexArray, indexToCell, nullptr, cellOffsets, 2);
+      buildMs += ElapsedMs(buildStart);
+
+      auto scatterStart = std::chrono::steady_clock::now();
+      vtkOmniConnectConnectivity::ScatterCellTuples(indexToCell, 3, cellNormals.data(), numCells, 3, perPrimNormal);
+      scatterMs += ElapsedMs(scatterStart);
+
+      const void* newBuffers[4] = { cellOffsets.data(), indexArray.data(), indexToCell.data(), perPrimNormal.data() };
+      for (int i = 0; i < 4; ++i)
+        numAllocations += (buffers[i] != newBuffers[i]) ? 1 : 0;
+    }
+
+    json << "{ \"cells\": " << numCells << ", \"build\": " << buildMs / options.NumFrames
+      << ", \"scatter\": " << scatterMs / options.NumFrames << ", \"allocations\": " << numAllocations << " }";
+    std::cout << "Index buffers of " << numCells << " cells: build " << buildMs / options.NumFrames << " ms, scatter "
+      << scatterMs / options.NumFrames << " ms, " << numAllocations << " allocations" << std::endl;
+  }
+
+  // Encode time, size and largest angular error in degrees of unit normals for every normals encoding, as a json array
+  void BenchmarkNormalsEncoding(const BenchmarkOptions& options, std::ostream& json)
+  {
+    size_t numNormals = (size_t)options.NumNormals;
+    std::vector<float> normals(3 * numNormals);
+    std::mt19937 rng(7);
+    std::normal_distribution<float> dist;
+    for (size_t i = 0; i < numNormals; ++i)
+    {
+      float* normal = normals.data() + 3 * i;
+      for (int c = 0; c < 3; ++c)
+        normal[c] = dist(rng);
+      float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      for (int c = 0; c < 3; ++c)
+        normal[c] /= length;
+    }
+
+    std::vector<float> floatNormals(3 * numNormals), decoded(3 * numNormals);
+    std::vector<uint16_t> halfNormals(3 * numNormals);
+    std::vector<int32_t> octNormals(numNormals);
+
+    const char* encodings[] = { "float", "half", "octahedral" };
+    const size_t bytesPerNormal[] = { 3 * sizeof(float), 3 * sizeof(uint16_t), sizeof(int32_t) };
+
+    json << "[";
+    for (int encoding = 0; encoding < 3; ++encoding)
+    {
+      double encodeMs = 0.0;
+      for (int frame = 0; frame < options.NumFrames; ++frame)
+      {
+        auto encodeStart = std::chrono::steady_clock::now();
+        if (encoding == 0)
+          std::copy(normals.begin(), normals.end(), floatNormals.begin());
+        else if (encoding == 1)
+          ocutils::FloatToHalf(normals.data(), halfNormals.data(), halfNormals.size());
+        else
+          ocutils::OctEncodeNormals(normals.data(), octNormals.data(), numNormals);
+        encodeMs += ElapsedMs(encodeStart);
+      }
+
+      // Error as seen by a reader of the output
+      if (encoding == 0)
+        decoded = floatNormals;
+      else if (encoding == 1)
+        std::transform(halfNormals.begin(), halfNormals.end(), decoded.begin(), ocutils::HalfToFloat);
+      else
+        ocutils::OctDecodeNormals(octNormals.data(), decoded.data(), numNormals);
+
+      double maxError = 0.0;
+      for (size_t i = 0; i < 3 * numNormals; i += 3)
+      {
+        double dot = 0.0, length = 0.0;
+        for (int c = 0; c < 3; ++c)
+        {
+          dot += normals[i + c] * decoded[i + c];
+          length += decoded[i + c] * decoded[i + c];
+        }
+        maxError = std::max(maxError, std::acos(std::min(dot / std::sqrt(length), 1.0)) * 180.0 / 3.14159265358979);
+      }
+
+      size_t numBytes = bytesPerNormal[encoding] * numNormals;
+      json << (encoding == 0 ? "\n" : ",\n") << "    { \"encoding\": \"" << encodings[encoding]
+        << "\", \"encode\": " << encodeMs / options.NumFrames << ", \"bytes\": " << numBytes << ", \"maxErrorDegrees\": " << maxError << " }";
+      std::cout << "Normals encoding " << encodings[encoding] << ": " << encodeMs / options.NumFrames << " ms, " << numBytes
+        << " bytes, max error " << maxError << " degrees" << std::endl;
+    }
+    json << "\n  ]";
+  }
+
+  // Conversion time of display colors with 3 and 4 components, batched and per value with the scalar reference, as a json array
+  void BenchmarkColorConversion(const BenchmarkOptions& options, std::ostream& json)
+  {
+    size_t numColors = (size_t)options.NumColors;
+    std::vector<uint8_t> srgb(4 * numColors);
+    std::mt19937 rng(7);
+    for (uint8_t& value : srgb)
+      value = (uint8_t)(rng() & 0xFF);
+    std::vector<float> linearRgb(3 * numColors), linearAlpha(numColors);
+
+    json << "[";
+    for (int components = 3; components <= 4; ++components)
+    {
+      double batchMs = 0.0, scalarMs = 0.0;
+      for (int frame = 0; frame < options.NumFrames; ++frame)
+      {
+        auto batchStart = std::chrono::steady_clock::now();
+        ocutils::SrgbToLinearBatch(srgb.data(), linearRgb.data(), numColors, components, linearAlpha.data());
+        batchMs += ElapsedMs(batchStart);
+
+        auto scalarStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numColors; ++i)
+        {
+          for (int c = 0; c < 3; ++c)
+            linearRgb[3 * i + c] = ocutils::SrgbToLinear(srgb[components * i + c] / 255.0f);
+        }
+        scalarMs += ElapsedMs(scalarStart);
+      }
+
+      double colorsPerSecond = batchMs > 0.0 ? numColors * options.NumFrames / (batchMs * 1.0e-3) : 0.0;
+      json << (components == 3 ? "\n" : ",\n") << "    { \"components\": " << components << ", \"batch\": " << batchMs / options.NumFrames
+        << ", \"scalar\": " << scalarMs / options.NumFrames << ", \"colorsPerSecond\": " << colorsPerSecond << " }";
+      std::cout << "Color conversion of " << numColors << " colors with " << components << " components: batch " << batchMs / options.NumFrames
+        << " ms, scalar " << scalarMs / options.NumFrames << " ms" << std::endl;
+    }
+    json << "\n  ]";
+  }
+
+  // Wall time of writing many small actor stages per timestep. Every actor stage is dirtied each timestep, so the
+  // flush at the end of each frame saves all of them concurrently; "serialSave" sums the individual layer saves,
+  // which is what saving each stage in turn as it is modified costs.
+  bool BenchmarkStageFlush(const BenchmarkOptions& options, std::ostream& json)
+  {
+    std::string outputDir = options.OutputDirectory + "/Stages";
+    vtksys::SystemTools::MakeDirectory(outputDir);
+
+    vtkOmniConnectSettings settings = vtkOmniConnectTestScene::MakeSettings(outputDir, "Stages");
+    settings.DiscardAssetWrites = options.DiscardAssetWrites;
+
+    vtkOmniConnectTestScene scene;
+    if (!scene.Initialize(settings))
+      return false;
+
+    int actorsPerRow = (int)std::ceil(std::sqrt((double)options.NumStageActors));
+    std::vector<vtkActor*> actors;
+    for (int actorIdx = 0; actorIdx < options.NumStageActors; ++actorIdx)
+    {
+      std::string name = "Actor" + std::to_string(actorIdx);
+      actors.push_back(scene.AddMesh(name.c_str(), vtkOmniConnectTesting::MakeMesh(4)));
+    }
+
+    OmniConnectProfiler::SetEnabled(true);
+
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    double wallMs = 0.0, flushMs = 0.0, serialSaveMs = 0.0;
+    size_t numSavedLayers = 0;
+    for (int timestep = 0; timestep < options.NumStageTimesteps; ++timestep)
+    {
+      double phase = 0.1 * timestep;
+      for (int actorIdx = 0; actorIdx < options.NumStageActors; ++actorIdx)
+      {
+        double center[3] = { 3.0 * (actorIdx % actorsPerRow), 3.0 * (actorIdx / actorsPerRow), 10.0 };
+        actors[actorIdx]->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(4, phase, center));
+        scene.SetAnimTime(actors[actorIdx], timestep);
+      }
+
+      OmniConnectProfiler::ResetStatistics();
+      auto frameStart = std::chrono::steady_clock::now();
+      scene.Render(timestep);
+      wallMs += ElapsedMs(frameStart);
+
+      OmniConnectProfiler::GetStatistics(statistics);
+      for (const OmniConnectProfiler::Statistic& stat : statistics)
+      {
+        if (strcmp(stat.Name, "SaveDirtyLayers") == 0)
+          flushMs += stat.Total;
+        else if (strcmp(stat.Name, "SaveLayer") == 0)
+        {
+          serialSaveMs += stat.Total;
+          numSavedLayers += stat.Count;
+        }
+      }
+    }
+
+    auto shutdownStart = std::chrono::steady_clock::now();
+    scene.Shutdown();
+    wallMs += ElapsedMs(shutdownStart);
+
+    OmniConnectProfiler::SetEnabled(false);
+
+    json << "{ \"actors\": " << options.NumStageActors << ", \"timesteps\": " << options.NumStageTimesteps
+      << ", \"wall\": " << wallMs << ", \"flush\": " << flushMs << ", \"serialSave\": " << serialSaveMs
+      << ", \"savedLayers\": " << numSavedLayers << " }";
+    std::cout << "Stages of " << options.NumStageActors << " actors x " << options.NumStageTimesteps << " timesteps: " << wallMs
+      << " ms wall, parallel flush " << flushMs << " ms, serial save " << serialSaveMs << " ms, " << numSavedLayers << " layers saved" << std::endl;
+    return true;
+  }
+
+  // Wall time per frame of converting and authoring many small animated actors, with the render pass traversing
+  // the actors on a single thread and on all threads of the smp backend. Each actor's stage is locked separately,
+  // so the speedup is bounded by the scene stage and layer flush that all actors share.
+  bool BenchmarkConcurrentActors(const BenchmarkOptions& options, std::ostream& json)
+  {
+    const int numThreadsRuns[] = { 1, 0 }; // 0 is the backend default
+    int actorsPerRow = (int)std::ceil(std::sqrt((double)options.NumConcurrentActors));
+    double frameMs[2] = { 0.0, 0.0 };
+    int maxThreads = 1;
+
+    for (int runIdx = 0; runIdx < 2; ++runIdx)
+    {
+      vtkSMPTools::Initialize(numThreadsRuns[runIdx]);
+      if (runIdx == 1)
+        maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+
+      std::string sessionName = runIdx == 0 ? "Serial" : "Parallel";
+      std::string outputDir = options.OutputDirectory + "/Concurrent";
+      vtksys::SystemTools::MakeDirectory(outputDir);
+
+      vtkOmniConnectSettings settings = vtkOmniConnectTestScene::MakeSettings(outputDir, sessionName.c_str());
+      settings.DiscardAssetWrites = options.DiscardAssetWrites;
+
+      vtkOmniConnectTestScene scene;
+      if (!scene.Initialize(settings))
+      {
+        vtkSMPTools::Initialize(0);
+        return false;
+      }
+
+      std::vector<vtkActor*> actors;
+      for (int actorIdx = 0; actorIdx < options.NumConcurrentActors; ++actorIdx)
+      {
+        std::string name = "Actor" + std::to_string(actorIdx);
+        actors.push_back(scene.AddMesh(name.c_str(), vtkOmniConnectTesting::MakeMesh(16)));
+      }
+
+      double wallMs = 0.0;
+      for (int frame = 0; frame < options.NumFrames; ++frame)
+      {
+        double phase = 0.1 * frame;
+        for (int actorIdx = 0; actorIdx < options.NumConcurrentActors; ++actorIdx)
+        {
+          double center[3] = { 3.0 * (actorIdx % actorsPerRow), 3.0 * (actorIdx / actorsPerRow), 20.0 };
+          actors[actorIdx]->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(16, phase, center));
+          scene.SetAnimTime(actors[actorIdx], frame);
+        }
+
+        auto frameStart = std::chrono::steady_clock::now();
+        scene.Render(frame);
+        wallMs += ElapsedMs(frameStart);
+      }
+      scene.Shutdown();
+
+      frameMs[runIdx] = wallMs / options.NumFrames;
+    }
+    vtkSMPTools::Initialize(0);
+
+    double speedup = frameMs[1] > 0.0 ? frameMs[0] / frameMs[1] : 0.0;
+    json << "{ \"actors\": " << options.NumConcurrentActors << ", \"backend\": \"" << vtkSMPTools::GetBackend()
+      << "\", \"threads\": " << maxThreads << ", \"serialFrame\": " << frameMs[0] << ", \"parallelFrame\": " << frameMs[1]
+      << ", \"speedup\": " << speedup << " }";
+    std::cout << "Frames of " << options.NumConcurrentActors << " actors: " << frameMs[0] << " ms on one thread, " << frameMs[1]
+      << " ms on " << maxThreads << " threads (" << speedup << "x)" << std::endl;
+    return true;
+  }
+
+  // Wall time per frame of meshes whose textures change every frame. Textures are encoded on the encoder's threads while
+  // the geometry is gathered; "textureWait" is the part of the encodes that the gather did not cover.
+  bool BenchmarkTexturedActors(const BenchmarkOptions& options, std::ostream& json)
+  {
+    const int textureSize = 512;
+
+    std::string outputDir = options.OutputDirectory + "/Textured";
+    vtksys::SystemTools::MakeDirectory(outputDir);
+
+    vtkOmniConnectSettings settings = vtkOmniConnectTestScene::MakeSettings(outputDir, "Textured");
+    settings.DiscardAssetWrites = options.DiscardAssetWrites;
+
+    vtkOmniConnectTestScene scene;
+    if (!scene.Initialize(settings))
+      return false;
+
+    int actorsPerRow = (int)std::ceil(std::sqrt((double)options.NumTexturedActors));
+    std::vector<vtkActor*> actors;
+    std::vector<vtkSmartPointer<vtkTexture>> textures;
+    for (int actorIdx = 0; actorIdx < options.NumTexturedActors; ++actorIdx)
+    {
+      std::string name = "Actor" + std::to_string(actorIdx);
+      vtkActor* actor = scene.AddMesh(name.c_str(), vtkOmniConnectTesting::MakeMesh(4));
+      actor->GetMapper()->ScalarVisibilityOff(); // Textured instead of color mapped
+      textures.push_back(vtkSmartPointer<vtkTexture>::New());
+      actor->SetTexture(textures.back());
+      actors.push_back(actor);
+    }
+
+    OmniConnectProfiler::SetEnabled(true);
+
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    double wallMs = 0.0, textureWaitMs = 0.0;
+    for (int frame = 0; frame < options.NumFrames; ++frame)
+    {
+      double phase = 0.1 * frame;
+      for (int actorIdx = 0; actorIdx < options.NumTexturedActors; ++actorIdx)
+      {
+        double center[3] = { 3.0 * (actorIdx % actorsPerRow), 3.0 * (actorIdx / actorsPerRow), 30.0 };
+        actors[actorIdx]->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(options.MeshResolution, phase, center));
+        textures[actorIdx]->SetInputData(vtkOmniConnectTesting::MakeTexture(textureSize, textureSize, 4, actorIdx + phase));
+        scene.SetAnimTime(actors[actorIdx], frame);
+      }
+
+      OmniConnectProfiler::ResetStatistics();
+      auto frameStart = std::chrono::steady_clock::now();
+      scene.Render(frame);
+      wallMs += ElapsedMs(frameStart);
+
+      OmniConnectProfiler::GetStatistics(statistics);
+      for (const OmniConnectProfiler::Statistic& stat : statistics)
+      {
+        if (strcmp(stat.Name, "TextureWait") == 0)
+          textureWaitMs += stat.Total;
+      }
+    }
+    scene.Shutdown();
+
+    OmniConnectProfiler::SetEnabled(false);
+
+    json << "{ \"actors\": " << options.NumTexturedActors << ", \"textureResolution\": " << textureSize
+      << ", \"frame\": " << wallMs / options.NumFrames << ", \"textureWait\": " << textureWaitMs / options.NumFrames << " }";
+    std::cout << "Frames of " << options.NumTexturedActors << " textured actors: " << wallMs / options.NumFrames << " ms, of which "
+      << textureWaitMs / options.NumFrames << " ms summed over all threads waiting for texture encodes" << std::endl;
+    return true;
+  }
+
+  // Clip metadata flush time over a long animation. The static mesh deduplicates into a single clip file shared by all
+  // timesteps, the animated mesh gets a clip file per timestep; either way every timestep appends to the clip metadata.
+  bool BenchmarkClipMetadata(const BenchmarkOptions& options, std::ostream& json)
+  {
+    std::string outputDir = options.OutputDirectory + "/Clips";
+    vtksys::SystemTools::MakeDirectory(outputDir);
+
+    vtkOmniConnectSettings settings = vtkOmniConnectTestScene::MakeSettings(outputDir, "Clips");
+    settings.DiscardAssetWrites = options.DiscardAssetWrites;
+
+    vtkOmniConnectTestScene scene;
+    if (!scene.Initialize(settings))
+      return false;
+
+    double animatedCenter[3] = { 3.0, 0.0, 0.0 };
+    vtkActor* staticActor = scene.AddMesh("Static", vtkOmniConnectTesting::MakeMesh(4));
+    vtkActor* animatedActor = scene.AddMesh("Animated", vtkOmniConnectTesting::MakeMesh(4, 0.0, animatedCenter));
+
+    OmniConnectProfiler::SetEnabled(true);
+
+    int numChunks = std::min(options.NumClipTimesteps, 10);
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    double totalWallMs = 0.0;
+    int timestep = 0;
+    json << "{ \"timesteps\": " << options.NumClipTimesteps << ", \"chunks\": [";
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {
+      int chunkEnd = (int)((long long)options.NumClipTimesteps * (chunk + 1) / numChunks);
+      int chunkBegin = timestep;
+      double wallMs = 0.0, clipFlushMs = 0.0;
+      for (; timestep < chunkEnd; ++timestep)
+      {
+        staticActor->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(4));
+        animatedActor->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeMesh(4, 0.1 * timestep, animatedCenter));
+        scene.SetAnimTime(staticActor, timestep);
+        scene.SetAnimTime(animatedActor, timestep);
+
+        OmniConnectProfiler::ResetStatistics();
+        auto frameStart = std::chrono::steady_clock::now();
+        scene.Render(timestep);
+        wallMs += ElapsedMs(frameStart);
+
+        OmniConnectProfiler::GetStatistics(statistics);
+        for (const OmniConnectProfiler::Statistic& stat : statistics)
+        {
+          if (strcmp(stat.Name, "FlushClipMetadata") == 0)
+            clipFlushMs += stat.Total;
+        }
+      }
+      totalWallMs += wallMs;
+
+      int chunkTimesteps = chunkEnd - chunkBegin;
+      json << (chunk ? ",\n" : "\n") << "    { \"firstTimestep\": " << chunkBegin << ", \"timesteps\": " << chunkTimesteps
+        << ", \"wall\": " << wallMs << ", \"clipFlushPerTimestep\": " << clipFlushMs / chunkTimesteps << " }";
+      std::cout << "Clip timesteps " << chunkBegin << "-" << chunkEnd - 1 << ": " << wallMs << " ms wall, clip metadata flush "
+        << clipFlushMs / chunkTimesteps << " ms per timestep" << std::endl;
+    }
+
+    auto shutdownStart = std::chrono::steady_clock::now();
+    scene.Shutdown();
+    totalWallMs += ElapsedMs(shutdownStart);
+
+    OmniConnectProfiler::SetEnabled(false);
+
+    json << "\n  ], \"wall\": " << totalWallMs << " }";
+    return true;
+  }
+
+  // Nanoseconds per operation of an id to cache entry map. Half of the ids are consecutive, as the ids of the actors
+  // of a scene, half are spread out, as ids derived from pointers. Lookups are in random order.
+  template<typename MapType>
+  void BenchmarkIdMap(const BenchmarkOptions& options, const char* mapName, const std::vector<size_t>& ids,
+    const std::vector<size_t>& lookupIds, const std::vector<size_t>& missingIds, std::ostream& json)
+  {
+    double insertMs = 0.0, findMs = 0.0, missMs = 0.0, iterateMs = 0.0, eraseMs = 0.0;
+    size_t checksum = 0;
+    for (int frame = 0; frame < options.NumFrames; ++frame)
+    {
+      MapType idMap;
+
+      auto start = std::chrono::steady_clock::now();
+      for (size_t id : ids)
+        idMap.emplace(id, id);
+      insertMs += ElapsedMs(start);
+
+      start = std::chrono::steady_clock::now();
+      for (size_t id : lookupIds)
+        checksum += idMap.find(id)->second;
+      findMs += ElapsedMs(start);
+
+      start = std::chrono::steady_clock::now();
+      for (size_t id : missingIds)
+        checksum += (idMap.find(id) == idMap.end()) ? 1 : 0;
+      missMs += ElapsedMs(start);
+
+      start = std::chrono::steady_clock::now();
+      for (const auto& entry : idMap)
+        checksum += entry.second;
+      iterateMs += ElapsedMs(start);
+
+      start = std::chrono::steady_clock::now();
+      for (size_t id : lookupIds)
+        checksum += idMap.erase(id);
+      eraseMs += ElapsedMs(start);
+    }
+
+    double nsPerOp = 1.0e6 / ((double)options.NumFrames * ids.size());
+    json << "{ \"map\": \"" << mapName << "\", \"insert\": " << insertMs * nsPerOp << ", \"find\": " << findMs * nsPerOp
+      << ", \"miss\": " << missMs * nsPerOp << ", \"iterate\": " << iterateMs * nsPerOp << ", \"erase\": " << eraseMs * nsPerOp
+      << ", \"checksum\": " << checksum << " }";
+    std::cout << "Id map " << mapName << " of " << ids.size() << " entries (ns per entry): insert " << insertMs * nsPerOp << ", find "
+      << findMs * nsPerOp << ", miss " << missMs * nsPerOp << ", iterate " << iterateMs * nsPerOp << ", erase " << eraseMs * nsPerOp << std::endl;
+  }
+
+  void BenchmarkIdMaps(const BenchmarkOptions& options, std::ostream& json)
+  {
+    std::mt19937_64 rng(11);
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < (size_t)options.NumIdMapEntries; ++i)
+      ids.push_back((i % 2) ? (size_t)(rng() | 1) : i);
+    std::vector<size_t> lookupIds(ids);
+    std::shuffle(lookupIds.begin(), lookupIds.end(), rng);
+    std::vector<size_t> missingIds;
+    for (size_t i = 0; i < ids.size(); ++i)
+      missingIds.push_back((i % 2) ? (size_t)(rng() & ~size_t(1)) : ids.size() + i);
+
+    json << "[\n    ";
+    BenchmarkIdMap<OmniConnectIdMap<size_t>>(options, "OmniConnectIdMap", ids, lookupIds, missingIds, json);
+    json << ",\n    ";
+    BenchmarkIdMap<std::map<size_t, size_t>>(options, "std::map", ids, lookupIds, missingIds, json);
+    json << ",\n    ";
+    BenchmarkIdMap<std::unordered_map<size_t, size_t>>(options, "std::unordered_map", ids, lookupIds, missingIds, json);
+    json << "\n  ]";
+  }
+
+  // Scene to animation retiming of many actors with long animations. The connector is driven directly, as the render
+  // passes would add the gather of every actor at every timestep. Only requesting the retiming and the retiming pass of
+  // the scene flush are measured, not building the actor clips or saving the layers.
+  bool BenchmarkRetiming(const BenchmarkOptions& options, std::ostream& json)
+  {
+    std::string outputDir = options.OutputDirectory + "/Retiming/";
+    vtksys::SystemTools::MakeDirectory(outputDir);
+
+    OmniConnectSettings settings = {};
+    settings.OmniServer = "";
+    settings.OmniWorkingDirectory = "";
+    settings.LocalOutputDirectory = outputDir.c_str();
+    settings.RootLevelFileName = "Retiming";
+    settings.OutputLocal = true;
+    settings.OutputBinary = true;
+    settings.UpAxis = OmniConnectAxis::Z;
+    settings.CreateNewOmniSession = true;
+    settings.DiscardAssetWrites = options.DiscardAssetWrites;
+
+    OmniConnectEnvironment environment{ 0, 1 };
+    std::unique_ptr<OmniConnect> connector(new OmniConnect(settings, environment, vtkOmniConnectLogCallback::Callback));
+    if (!connector->OpenConnection())
+      return false;
+
+    // Static triangles, deduplicated into a single clip per actor, with clip actives for all timesteps
+    float points[9] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    unsigned int indices[3] = { 0, 1, 2 };
+    auto setupStart = std::chrono::steady_clock::now();
+    for (int actorIdx = 0; actorIdx < options.NumRetimeActors; ++actorIdx)
+    {
+      std::string name = "Actor" + std::to_string(actorIdx);
+      connector->CreateActor(actorIdx, name.c_str());
+      for (int timestep = 0; timestep < options.NumRetimeTimesteps; ++timestep)
+      {
+        OmniConnectMeshData meshData;
+        meshData.MeshId = 0;
+        meshData.NumPoints = 3;
+        meshData.Points = points;
+        meshData.PointsType = OmniConnectType::FLOAT3;
+        meshData.Indices = indices;
+        meshData.NumIndices = 3;
+        connector->AddTimeStep(actorIdx, timestep);
+        connector->UpdateMesh(actorIdx, timestep, meshData, 0, nullptr, 0, nullptr, 0);
+      }
+      connector->FlushActorUpdates(actorIdx);
+    }
+    double setupMs = ElapsedMs(setupStart);
+
+    std::vector<double> identityTimes, reversedTimes;
+    for (int sceneTime = 0; sceneTime < options.NumRetimeTimesteps; ++sceneTime)
+    {
+      identityTimes.push_back(sceneTime);
+      identityTimes.push_back(sceneTime);
+      reversedTimes.push_back(sceneTime);
+      reversedTimes.push_back(options.NumRetimeTimesteps - 1 - sceneTime);
+    }
+
+    OmniConnectProfiler::SetEnabled(true);
+    OmniConnectProfiler::ResetStatistics();
+
+    auto requestStart = std::chrono::steady_clock::now();
+    double lastSceneTime = options.NumRetimeTimesteps - 1;
+    for (int actorIdx = 0; actorIdx < options.NumRetimeActors; ++actorIdx)
+    {
+      const std::vector<double>& sceneToAnimTimes = (actorIdx % 2) ? reversedTimes : identityTimes;
+      connector->SetSceneToAnimTime(actorIdx, lastSceneTime, sceneToAnimTimes.data(), options.NumRetimeTimesteps);
+    }
+    double requestMs = ElapsedMs(requestStart);
+
+    connector->FlushSceneUpdates();
+
+    double retimeMs = 0.0;
+    std::vector<OmniConnectProfiler::Statistic> statistics;
+    OmniConnectProfiler::GetStatistics(statistics);
+    for (const OmniConnectProfiler::Statistic& stat : statistics)
+    {
+      if (strcmp(stat.Name, "RetimeActors") == 0)
+        retimeMs += stat.Total;
+    }
+    OmniConnectProfiler::SetEnabled(false);
+
+    connector.reset();
+
+    json << "{ \"actors\": " << options.NumRetimeActors << ", \"timesteps\": " << options.NumRetimeTimesteps
+      << ", \"setup\": " << setupMs << ", \"request\": " << requestMs << ", \"retime\": " << retimeMs << " }";
+    std::cout << "Retiming of " << options.NumRetimeActors << " actors x " << options.NumRetimeTimesteps << " timesteps: request "
+      << requestMs << " ms, retime " << retimeMs << " ms (setup " << setupMs << " ms)" << std::endl;
+    return true;
+  }
+
+  void UpdateInputs(const BenchmarkOptions& options, vtkOmniConnectTestScene& scene,
+    const std::vector<vtkActor*>& meshActors, vtkActor* lineActor, vtkActor* glyphActor, vtkVolume* volume,
+    vtkMultiBlockDataSet* blocks, int frame)
+  {
+    double phase = 0.1 * frame;
+    for (size_t meshIdx = 0; meshIdx < meshActors.size(); ++meshIdx)
+    {
+      double center[3] = { 3.0 * meshIdx, 0.0, 0.0 };
+      meshActors[meshIdx]->GetMapper()->SetInputDataObject(
+        vtkOmniConnectTesting::MakeMesh(options.MeshResolution, phase, center));
+      scene.SetAnimTime(meshActors[meshIdx], frame);
+    }
+    if (lineActor)
+    {
+      lineActor->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeLines(options.NumLines, 256, phase));
+      scene.SetAnimTime(lineActor, frame);
+    }
+    if (glyphActor)
+    {
+      glyphActor->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeGlyphPoints(options.NumGlyphs, phase));
+      scene.SetAnimTime(glyphActor, frame);
+    }
+    if (volume)
+    {
+      volume->GetMapper()->SetInputDataObject(vtkOmniConnectTesting::MakeVolume(options.VolumeDim, phase));
+      scene.SetAnimTime(volume, frame);
+    }
+    if (blocks && frame > 0)
+    {
+      // Stays at the same animation time, so the cost is dominated by finding the one changed block
+      vtkPolyData* block = vtkPolyData::SafeDownCast(blocks->GetBlock(frame % blocks->GetNumberOfBlocks()));
+      block->GetPoints()->Modified();
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  BenchmarkOptions options;
+  if (!ParseOptions(argc, argv, options))
+  {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+
+  vtksys::SystemTools::RemoveADirectory(options.OutputDirectory);
+  vtksys::SystemTools::MakeDirectory(options.OutputDirectory);
+
+  vtkOmniConnectSettings settings = vtkOmniConnectTestScene::MakeSettings(options.OutputDirectory, "Benchmark");
+  settings.DiscardAssetWrites = options.DiscardAssetWrites;
+
+  vtkOmniConnectTestScene scene;
+  if (!scene.Initialize(settings))
+  {
+    std::cerr << "Cannot initialize the connector with output directory " << options.OutputDirectory << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Build the scene
+  std::vector<vtkActor*> meshActors;
+  for (int meshIdx = 0; meshIdx < options.NumMeshes; ++meshIdx)
+  {
+    std::string name = "Mesh" + std::to_string(meshIdx);
+    meshActors.push_back(scene.AddMesh(name.c_str(), vtkOmniConnectTesting::MakeMesh(options.MeshResolution)));
+  }
+  vtkActor* lineActor = options.NumLines > 0 ? scene.AddMesh("Lines", vtkOmniConnectTesting::MakeLines(options.NumLines, 256)) : nullptr;
+  vtkActor* glyphActor = options.NumGlyphs > 0 ? scene.AddGlyphs("Glyphs", vtkOmniConnectTesting::MakeGlyphPoints(options.NumGlyphs)) : nullptr;
+  vtkVolume* volume = options.VolumeDim > 1 ? scene.AddVolume("Volume", vtkOmniConnectTesting::MakeVolume(options.VolumeDim)) : nullptr;
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  if (options.NumBlocks > 0)
+  {
+    blocks->SetNumberOfBlocks(options.NumBlocks);
+    int blocksPerRow = (int)std::ceil(std::sqrt((double)options.NumBlocks));
+    for (int blockIdx = 0; blockIdx < options.NumBlocks; ++blockIdx)
+    {
+      double center[3] = { 3.0 * (blockIdx % blocksPerRow), 3.0 * (blockIdx / blocksPerRow), -10.0 };
+      blocks->SetBlock(blockIdx, vtkOmniConnectTesting::MakeMesh(4, 0.0, center));
+    }
+    scene.AddMesh("Blocks", blocks);
+  }
+
+  OmniConnectProfiler::SetEnabled(true);
+
+  std::ostringstream framesJson;
+  vtkOmniConnectStageTimings totalTimings;
+  double totalWallMs = 0.0;
+  std::vector<OmniConnectProfiler::Statistic> statistics;
+
+  for (int frame = 0; frame < options.NumFrames; ++frame)
+  {
+    // Input generation is not part of the measurement
+    UpdateInputs(options, scene, meshActors, lineActor, glyphActor, volume, options.NumBlocks > 0 ? blocks.Get() : nullptr, frame);
+
+    OmniConnectProfiler::ResetStatistics();
+    auto frameStart = std::chrono::steady_clock::now();
+
+    scene.Render(frame);
+
+    double frameWallMs = ElapsedMs(frameStart);
+    OmniConnectProfiler::GetStatistics(statistics);
+
+    vtkOmniConnectStageTimings frameTimings;
+    frameTimings.Accumulate(statistics);
+    totalTimings.Accumulate(frameTimings);
+    totalWallMs += frameWallMs;
+
+    framesJson << (frame ? ",\n" : "\n") << "    { \"frame\": " << frame << ", \"wall\": " << frameWallMs << ", \"stages\": ";
+    frameTimings.WriteJson(framesJson);
+    framesJson << " }";
+
+    std::cout << "Frame " << frame << ": " << frameWallMs << " ms" << std::endl;
+  }
+
+  // Pending layers and asset writes are flushed on destruction of the connector
+  OmniConnectProfiler::ResetStatistics();
+  auto shutdownStart = std::chrono::steady_clock::now();
+  scene.Shutdown();
+  double shutdownWallMs = ElapsedMs(shutdownStart);
+  OmniConnectProfiler::GetStatistics(statistics);
+  totalTimings.Accumulate(statistics);
+
+  OmniConnectProfiler::SetEnabled(false);
+
+  std::ostringstream textureJson;
+  if (options.TextureResolution > 0)
+  {
+    if (!BenchmarkTextureEncoding(options, textureJson))
+    {
+      std::cerr << "Cannot encode a texture of resolution " << options.TextureResolution << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream indexJson;
+  if (options.IndexCells > 0)
+    BenchmarkIndexBuffers(options, indexJson);
+
+  std::ostringstream normalsJson;
+  if (options.NumNormals > 0)
+    BenchmarkNormalsEncoding(options, normalsJson);
+
+  std::ostringstream colorsJson;
+  if (options.NumColors > 0)
+    BenchmarkColorConversion(options, colorsJson);
+
+  std::ostringstream stagesJson;
+  if (options.NumStageActors > 0)
+  {
+    if (!BenchmarkStageFlush(options, stagesJson))
+    {
+      std::cerr << "Cannot initialize the connector with output directory " << options.OutputDirectory << "/Stages" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream clipsJson;
+  if (options.NumClipTimesteps > 0)
+  {
+    if (!BenchmarkClipMetadata(options, clipsJson))
+    {
+      std::cerr << "Cannot initialize the connector with output directory " << options.OutputDirectory << "/Clips" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream idMapJson;
+  if (options.NumIdMapEntries > 0)
+    BenchmarkIdMaps(options, idMapJson);
+
+  std::ostringstream retimingJson;
+  if (options.NumRetimeActors > 0)
+  {
+    if (!BenchmarkRetiming(options, retimingJson))
+    {
+      std::cerr << "Cannot initialize the connector with output directory " << options.OutputDirectory << "/Retiming" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream concurrentJson;
+  if (options.NumConcurrentActors > 0)
+  {
+    if (!BenchmarkConcurrentActors(options, concurrentJson))
+    {
+      std::cerr << "Cannot initialize the connector with output directory " << options.OutputDirectory << "/Concurrent" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream texturedJson;
+  if (options.NumTexturedActors > 0)
+  {
+    if (!BenchmarkTexturedActors(options, texturedJson))
+    {
+      std::cerr << "Cannot initialize the connector with output directory " << options.OutputDirectory << "/Textured" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream json;
+  json << "{\n"
+    << "  \"settings\": { \"meshes\": " << options.NumMeshes << ", \"resolution\": " << options.MeshResolution
+    << ", \"lines\": " << options.NumLines << ", \"glyphs\": " << options.NumGlyphs << ", \"volumeDim\": " << options.VolumeDim
+    << ", \"frames\": " << options.NumFrames << ", \"blocks\": " << options.NumBlocks << ", \"textureResolution\": " << options.TextureResolution << ", \"indexCells\": " << options.IndexCells << ", \"normals\": " << options.NumNormals << ", \"colors\": " << options.NumColors << ", \"stageActors\": " << options.NumStageActors << ", \"stageTimesteps\": " << options.NumStageTimesteps << ", \"clipTimesteps\": " << options.NumClipTimesteps << ", \"retimeActors\": " << options.NumRetimeActors << ", \"retimeTimesteps\": " << options.NumRetimeTimesteps << ", \"idMapEntries\": " << options.NumIdMapEntries << ", \"concurrentActors\": " << options.NumConcurrentActors << ", \"texturedActors\": " << options.NumTexturedActors << ", \"discardAssetWrites\": " << (options.DiscardAssetWrites ? "true" : "false") << " },\n"
+    << "  \"frames\": [" << framesJson.str() << "\n  ],\n"
+    << "  \"shutdown\": " << shutdownWallMs << ",\n"
+    << "  \"total\": { \"wall\": " << totalWallMs + shutdownWallMs << ", \"stages\": ";
+  totalTimings.WriteJson(json);
+  json << " },\n";
+  if (options.TextureResolution > 0)
+    json << "  \"textureEncoding\": " << textureJson.str() << ",\n";
+  if (options.IndexCells > 0)
+    json << "  \"indexBuffers\": " << indexJson.str() << ",\n";
+  if (options.NumNormals > 0)
+    json << "  \"normalsEncoding\": " << normalsJson.str() << ",\n";
+  if (options.NumColors > 0)
+    json << "  \"colorConversion\": " << colorsJson.str() << ",\n";
+  if (options.NumStageActors > 0)
+    json << "  \"stageFlush\": " << stagesJson.str() << ",\n";
+  if (options.NumClipTimesteps > 0)
+    json << "  \"clipMetadata\": " << clipsJson.str() << ",\n";
+  if (options.NumRetimeActors > 0)
+    json << "  \"retiming\": " << retimingJson.str() << ",\n";
+  if (options.NumIdMapEntries > 0)
+    json << "  \"idMap\": " << idMapJson.str() << ",\n";
+  if (options.NumConcurrentActors > 0)
+    json << "  \"concurrentActors\": " << concurrentJson.str() << ",\n";
+  if (options.NumTexturedActors > 0)
+    json << "  \"texturedActors\": " << texturedJson.str() << ",\n";
+  json
+    << "  \"outputBytes\": " << vtkOmniConnectTesting::GetDirectorySize(options.OutputDirectory) << "\n"
+    << "}\n";
+
+  if (options.JsonFileName.empty())
+  {
+    std::cout << json.str();
+  }
+  else
+  {
+    std::ofstream jsonFile(options.JsonFileName);
+    if (!(jsonFile << json.str()))
+    {
+      std::cerr << "Cannot write " << options.JsonFileName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,644 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#include "vtkOmniConnectTestUtilities.h"
+
+#include "vtkOmniConnectRendererNode.h"
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
+#include "vtkColorTransferFunction.h"
+#include "vtkCompositePolyDataMapper.h"
+#include "vtkDataObject.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3DMapper.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockVolumeMapper.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderState.h"
+#include "vtkRenderer.h"
+#include "vtkSmartVolumeMapper.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVolume.h"
+#include "vtkVolumeProperty.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+vtkOmniConnectTestScene::vtkOmniConnectTestScene()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkOmniConnectTestScene::~vtkOmniConnectTestScene()
+{
+  this->Shutdown();
+}
+
+//----------------------------------------------------------------------------
+vtkOmniConnectSettings vtkOmniConnectTestScene::MakeSettings(const std::string& outputDirectory, const char* sessionName)
+{
+  vtkOmniConnectSettings settings;
+  settings.LocalOutputDirectory = outputDirectory;
+  if (!settings.LocalOutputDirectory.empty() && settings.LocalOutputDirectory.back() != '/')
+    settings.LocalOutputDirectory += '/';
+  settings.RootLevelFileName = sessionName;
+  settings.OutputLocal = true;
+  settings.OutputBinary = false;
+  return settings;
+}
+
+//----------------------------------------------------------------------------
+bool vtkOmniConnectTestScene::Initialize(const vtkOmniConnectSettings& settings, double sceneTime)
+{
+  this->Shutdown();
+
+  this->Settings = settings;
+
+  // Build() of the renderer node would otherwise reset the camera, which requires a window
+  this->Renderer->GetActiveCamera();
+
+  this->Pass = vtkSmartPointer<vtkOmniConnectPass>::New();
+
+  OmniConnectEnvironment omniEnv{ 0, 1 };
+  this->Pass->Initialize(this->Settings, omniEnv, sceneTime);
+
+  vtkOmniConnectRendererNode* rendererNode = this->Pass->GetSceneGraph();
+  if (!rendererNode)
+  {
+    this->Pass = nullptr;
+    return false;
+  }
+
+  rendererNode->SetRenderingEnabled(false); // Don't render, just output to USD
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectTestScene::Shutdown()
+{
+  if (this->Pass)
+  {
+    this->Pass->SetSceneGraph(nullptr);
+    this->Pass = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkOmniConnectRendererNode* vtkOmniConnectTestScene::GetRendererNode()
+{
+  return this->Pass ? this->Pass->GetSceneGraph() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkOmniConnectTestScene::GetSessionDirectory() const
+{
+  return this->Settings.LocalOutputDirectory + this->Settings.RootLevelFileName + "/";
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectTestScene::AddProp(const char* name, vtkProp3D* prop)
+{
+  // Actors without a name are treated as widgets by the actor nodes
+  vtkNew<vtkInformation> propertyKeys;
+  propertyKeys->Set(vtkOmniConnectRendererNode::ACTORNAME(), name);
+  prop->SetPropertyKeys(propertyKeys);
+
+  this->Renderer->AddViewProp(prop);
+}
+
+//----------------------------------------------------------------------------
+vtkActor* vtkOmniConnectTestScene::AddMesh(const char* name, vtkDataObject* meshData)
+{
+  vtkNew<vtkActor> actor;
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(meshData))
+  {
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputData(polyData);
+    actor->SetMapper(mapper);
+  }
+  else
+  {
+    vtkNew<vtkCompositePolyDataMapper> mapper;
+    mapper->SetInputDataObject(meshData);
+    actor->SetMapper(mapper);
+  }
+
+  this->AddProp(name, actor);
+  return actor;
+}
+
+//----------------------------------------------------------------------------
+vtkActor* vtkOmniConnectTestScene::AddGlyphs(const char* name, vtkPolyData* points)
+{
+  vtkNew<vtkGlyph3DMapper> mapper;
+  mapper->SetInputData(points);
+  mapper->SetSourceData(vtkOmniConnectTesting::MakeMesh(8));
+  mapper->ScalingOff();
+
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  this->AddProp(name, actor);
+  return actor;
+}
+
+//----------------------------------------------------------------------------
+vtkVolume* vtkOmniConnectTestScene::AddVolume(const char* name, vtkDataObject* volumeData)
+{
+  vtkNew<vtkVolume> volume;
+  if (vtkImageData* imageData = vtkImageData::SafeDownCast(volumeData))
+  {
+    vtkNew<vtkSmartVolumeMapper> mapper;
+    mapper->SetInputData(imageData);
+    volume->SetMapper(mapper);
+  }
+  else
+  {
+    vtkNew<vtkMultiBlockVolumeMapper> mapper;
+    mapper->SetInputDataObject(volumeData);
+    volume->SetMapper(mapper);
+  }
+
+  vtkNew<vtkColorTransferFunction> colorTf;
+  colorTf->AddRGBPoint(-1.0, 0.0, 0.0, 1.0);
+  colorTf->AddRGBPoint(1.0, 1.0, 0.0, 0.0);
+  vtkNew<vtkPiecewiseFunction> opacityTf;
+  opacityTf->AddPoint(-1.0, 0.0);
+  opacityTf->AddPoint(1.0, 1.0);
+  volume->GetProperty()->SetColor(colorTf);
+  volume->GetProperty()->SetScalarOpacity(opacityTf);
+
+  this->AddProp(name, volume);
+  return volume;
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectTestScene::SetAnimTime(vtkProp3D* prop, double animTime)
+{
+  prop->GetPropertyKeys()->Set(vtkDataObject::DATA_TIME_STEP(), animTime);
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectTestScene::Render(double sceneTime)
+{
+  vtkOmniConnectRendererNode* rendererNode = this->GetRendererNode();
+  if (!rendererNode)
+    return;
+
+  rendererNode->SetSceneTime(sceneTime);
+
+  vtkRenderState state(this->Renderer);
+  this->Pass->Render(&state);
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectStageTimings::Accumulate(const std::vector<OmniConnectProfiler::Statistic>& statistics)
+{
+  static const char* authorScopes[] = { "UpdateMesh", "UpdateInstancer", "UpdateCurve", "UpdateVolume", "UpdateTexture" };
+
+  double authorTotal = 0.0, gatherTotal = 0.0, volumeSerializeTotal = 0.0, triangulateTotal = 0.0;
+  for (const OmniConnectProfiler::Statistic& stat : statistics)
+  {
+    if (stat.IsCounter)
+    {
+      if (strcmp(stat.Name, "DiscardedWriteBytes") == 0)
+        this->DiscardedWriteBytes += stat.Total;
+      continue;
+    }
+
+    if (strcmp(stat.Name, "Gather") == 0)
+      gatherTotal += stat.Total;
+    else if (strcmp(stat.Name, "Triangulate") == 0)
+      triangulateTotal += stat.Total;
+    else if (strcmp(stat.Name, "SerializeVolume") == 0)
+      volumeSerializeTotal += stat.Total;
+    else if (strcmp(stat.Name, "SaveLayer") == 0)
+      this->Serialize += stat.Total;
+    else if (strcmp(stat.Name, "ConnectionWrite") == 0)
+      this->Write += stat.Total;
+    else
+    {
+      for (const char* scope : authorScopes)
+      {
+        if (strcmp(stat.Name, scope) == 0)
+          authorTotal += stat.Total;
+      }
+    }
+  }
+
+  // Triangulation runs within gather scopes, vdb serialization within UpdateVolume
+  this->Gather += std::max(0.0, gatherTotal - triangulateTotal);
+  this->Triangulate += triangulateTotal;
+  this->Author += std::max(0.0, authorTotal - volumeSerializeTotal);
+  this->Serialize += volumeSerializeTotal;
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectStageTimings::Accumulate(const vtkOmniConnectStageTimings& other)
+{
+  this->Gather += other.Gather;
+  this->Triangulate += other.Triangulate;
+  this->Author += other.Author;
+  this->Serialize += other.Serialize;
+  this->Write += other.Write;
+  this->DiscardedWriteBytes += other.DiscardedWriteBytes;
+}
+
+//----------------------------------------------------------------------------
+void vtkOmniConnectStageTimings::WriteJson(std::ostream& os) const
+{
+  os << "{ \"gather\": " << this->Gather
+    << ", \"triangulate\": " << this->Triangulate
+    << ", \"author\": " << this->Author
+    << ", \"serialize\": " << this->Serialize
+    << ", \"write\": " << this->Write
+    << ", \"discardedWriteBytes\": " << (uint64_t)this->DiscardedWriteBytes
+    << " }";
+}
+
+namespace vtkOmniConnectTesting
+{
+  //----------------------------------------------------------------------------
+  vtkSmartPointer<vtkPolyData> MakeMesh(int resolution, double phase, const double center[3])
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(resolution);
+    sphere->SetPhiResolution(resolution);
+    sphere->SetRadius(1.0 + 0.1 * std::sin(phase));
+    if (center)
+      sphere->SetCenter(center[0], center[1], center[2]);
+    sphere->Update();
+
+    vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+    mesh->ShallowCopy(sphere->GetOutput());
+
+    vtkPoints* points = mesh->GetPoints();
+    vtkIdType numPoints = points->GetNumberOfPoints();
+
+    vtkNew<vtkFloatArray> scalars;
+    scalars->SetName("Scalars");
+    scalars->SetNumberOfTuples(numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      double p[3];
+      points->GetPoint(i, p);
+      scalars->SetValue(i, static_cast<float>(std::sin(3.0 * p[2] + phase)));
+    }
+    mesh->GetPointData()->SetScalars(scalars);
+
+    return mesh;
+  }
+
+  //----------------------------------------------------------------------------
+  vtkSmartPointer<vtkPolyData> MakeLines(int numLines, int pointsPerLine, double phase)
+  {
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToFloat();
+    vtkNew<vtkCellArray> lines;
+    vtkNew<vtkFloatArray> scalars;
+    scalars->SetName("Scalars");
+
+    for (int lineIdx = 0; lineIdx < numLines; ++lineIdx)
+    {
+      double offset = 2.0 * vtkMath::Pi() * lineIdx / numLines;
+      lines->InsertNextCell(pointsPerLine);
+      for (int i = 0; i < pointsPerLine; ++i)
+      {
+        double t = static_cast<double>(i) / std::max(1, pointsPerLine - 1);
+        double angle = 6.0 * vtkMath::Pi() * t + offset + phase;
+        vtkIdType ptId = points->InsertNextPoint(std::cos(angle), std::sin(angle), 4.0 * t - 2.0);
+        lines->InsertCellPoint(ptId);
+        scalars->InsertNextValue(static_cast<float>(t));
+      }
+    }
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetLines(lines);
+    polyData->GetPointData()->SetScalars(scalars);
+    return polyData;
+  }
+
+  //----------------------------------------------------------------------------
+  vtkSmartPointer<vtkPolyData> MakeGlyphPoints(int numPoints, double phase)
+  {
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(numPoints);
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkFloatArray> scalars;
+    scalars->SetName("Scalars");
+    scalars->SetNumberOfTuples(numPoints);
+
+    // Fibonacci sphere
+    const double goldenAngle = vtkMath::Pi() * (3.0 - std::sqrt(5.0));
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      double z = 1.0 - 2.0 * (i + 0.5) / numPoints;
+      double r = std::sqrt(1.0 - z * z);
+      double angle = goldenAngle * i + phase;
+      points->SetPoint(i, 3.0 * r * std::cos(angle), 3.0 * r * std::sin(angle), 3.0 * z);
+      scalars->SetValue(i, static_cast<float>(z));
+      verts->InsertNextCell(1, &i);
+    }
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetVerts(verts);
+    polyData->GetPointData()->SetScalars(scalars);
+    return polyData;
+  }
+
+  //----------------------------------------------------------------------------
+  vtkSmartPointer<vtkImageData> MakeVolume(int dim, double phase, const double origin[3], double spacing)
+  {
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetDimensions(dim, dim, dim);
+    imageData->SetSpacing(spacing, spacing, spacing);
+    if (origin)
+      imageData->SetOrigin(origin[0], origin[1], origin[2]);
+
+    vtkNew<vtkFloatArray> density;
+    density->SetName("Density");
+    density->SetNumberOfTuples(static_cast<vtkIdType>(dim) * dim * dim);
+    vtkIdType idx = 0;
+    for (int z = 0; z < dim; ++z)
+      for (int y = 0; y < dim; ++y)
+        for (int x = 0; x < dim; ++x, ++idx)
+          density->SetValue(idx, static_cast<float>(std::sin(0.3 * x + phase) * std::cos(0.2 * y) * std::cos(0.1 * z)));
+
+    imageData->GetPointData()->SetScalars(density);
+    return imageData;
+  }
+
+  //----------------------------------------------------------------------------
+  vtkSmartPointer<vtkImageData> MakeTexture(int width, int height, int numComponents, double phase)
+  {
+    vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+    imageData->SetDimensions(width, height, 1);
+
+    vtkNew<vtkUnsignedCharArray> colors;
+    colors->SetName("Colors");
+    colors->SetNumberOfComponents(numComponents);
+    colors->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+    unsigned char* colorData = colors->GetPointer(0);
+    for (int y = 0; y < height; ++y)
+    {
+      for (int x = 0; x < width; ++x)
+      {
+        double u = static_cast<double>(x) / width, v = static_cast<double>(y) / height;
+        unsigned int hash = (static_cast<unsigned int>(x) * 73856093u) ^ (static_cast<unsigned int>(y) * 19349663u);
+        double values[4] = { u, v, 0.5 + 0.5 * std::sin(20.0 * (u + v) + phase), 1.0 - 0.25 * u };
+        for (int c = 0; c < numComponents; ++c)
+          *(colorData++) = static_cast<unsigned char>(std::min(255.0, values[c] * 240.0 + ((hash >> (4 * c)) & 0xF)));
+      }
+    }
+
+    imageData->GetPointData()->SetScalars(colors);
+    return imageData;
+  }
+
+  //----------------------------------------------------------------------------
+  std::string GetOutputDirectory(int argc, char* argv[], const char* testName)
+  {
+    std::string baseDirectory = ".";
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+      if (strcmp(argv[i], "-T") == 0)
+        baseDirectory = argv[i + 1];
+    }
+
+    std::string directory = baseDirectory + "/" + testName + "/";
+    vtksys::SystemTools::ConvertToUnixSlashes(directory);
+    directory += '/';
+
+    vtksys::SystemTools::RemoveADirectory(directory);
+    vtksys::SystemTools::MakeDirectory(directory);
+    return directory;
+  }
+
+  //----------------------------------------------------------------------------
+  bool ReadFile(const std::string& fileName, std::string& contents)
+  {
+    std::ifstream file(fileName, std::ios_base::in | std::ios_base::binary);
+    if (!file)
+      return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  static void ListFilesRecursive(const std::string& directory, const std::string& prefix, std::vector<std::string>& relativeFileNames)
+  {
+    vtksys::Directory dir;
+    if (!dir.Load(directory + prefix))
+      return;
+
+    for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i)
+    {
+      std::string name = dir.GetFile(i);
+      if (name == "." || name == "..")
+        continue;
+
+      std::string relativeName = prefix + name;
+      if (vtksys::SystemTools::FileIsDirectory(directory + relativeName))
+        ListFilesRecursive(directory, relativeName + "/", relativeFileNames);
+      else
+        relativeFileNames.push_back(relativeName);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void ListFiles(const std::string& directory, std::vector<std::string>& relativeFileNames)
+  {
+    relativeFileNames.clear();
+
+    std::string baseDirectory = directory;
+    if (!baseDirectory.empty() && baseDirectory.back() != '/')
+      baseDirectory += '/';
+
+    ListFilesRecursive(baseDirectory, "", relativeFileNames);
+    std::sort(relativeFileNames.begin(), relativeFileNames.end());
+  }
+
+  //----------------------------------------------------------------------------
+  std::string ReadAllLayers(const std::string& directory)
+  {
+    std::vector<std::string> fileNames;
+    ListFiles(directory, fileNames);
+
+    std::string allLayers;
+    for (const std::string& fileName : fileNames)
+    {
+      std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
+      if (ext != ".usda" && ext != ".usd")
+        continue;
+
+      std::string contents;
+      if (ReadFile(directory + "/" + fileName, contents))
+        allLayers += "#--- " + fileName + "\n" + contents;
+    }
+    return allLayers;
+  }
+
+  //----------------------------------------------------------------------------
+  size_t CountOccurrences(const std::string& text, const std::string& pattern)
+  {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+      ++count;
+    return count;
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<std::string> FindAttributeValues(const std::string& layers, const std::string& declaration)
+  {
+    std::vector<std::string> values;
+    for (size_t pos = layers.find(declaration); pos != std::string::npos; pos = layers.find(declaration, pos + 1))
+    {
+      size_t valueStart = pos + declaration.size();
+      if (layers.compare(valueStart, 3, " = ") == 0)
+      {
+        size_t lineEnd = layers.find('\n', valueStart);
+        values.push_back(layers.substr(valueStart + 3, lineEnd - valueStart - 3));
+      }
+      else if (layers.compare(valueStart, 16, ".timeSamples = {") == 0)
+      {
+        size_t samplesEnd = layers.find('}', valueStart + 16);
+        size_t lineStart = layers.find('\n', valueStart) + 1;
+        while (lineStart < samplesEnd)
+        {
+          size_t lineEnd = std::min(layers.find('\n', lineStart), samplesEnd);
+          size_t sampleStart = layers.find(": ", lineStart);
+          if (sampleStart < lineEnd)
+            values.push_back(layers.substr(sampleStart + 2, lineEnd - sampleStart - 2));
+          lineStart = lineEnd + 1;
+        }
+      }
+    }
+    return values;
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<double> ParseNumbers(const std::string& value)
+  {
+    std::vector<double> numbers;
+    const char* str = value.c_str();
+    while (*str)
+    {
+      char* numberEnd = nullptr;
+      double number = std::strtod(str, &numberEnd);
+      if (numberEnd != str && (std::isdigit((unsigned char)*str) || *str == '-' || *str == '.'))
+      {
+        numbers.push_back(number);
+        str = numberEnd;
+      }
+      else
+        ++str;
+    }
+    return numbers;
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<std::string> ParseAssetPaths(const std::string& value)
+  {
+    std::vector<std::string> assetPaths;
+    for (size_t start = value.find('@'); start != std::string::npos; )
+    {
+      size_t end = value.find('@', start + 1);
+      if (end == std::string::npos)
+        break;
+      std::string assetPath = value.substr(start + 1, end - start - 1);
+      start = value.find('@', end + 1);
+      if (assetPath.compare(0, 2, "./") == 0)
+        assetPath = assetPath.substr(2);
+      assetPaths.push_back(assetPath);
+    }
+    return assetPaths;
+  }
+
+  //----------------------------------------------------------------------------
+  bool CompareDirectories(const std::string& dirA, const std::string& dirB, std::string& difference)
+  {
+    std::vector<std::string> filesA, filesB;
+    ListFiles(dirA, filesA);
+    ListFiles(dirB, filesB);
+
+    if (filesA != filesB)
+    {
+      std::vector<std::string> onlyInOne;
+      std::set_symmetric_difference(filesA.begin(), filesA.end(), filesB.begin(), filesB.end(), std::back_inserter(onlyInOne));
+      difference = "File lists differ" + (onlyInOne.empty() ? std::string() : (", e.g. " + onlyInOne[0]));
+      return false;
+    }
+
+    for (const std::string& fileName : filesA)
+    {
+      std::string contentsA, contentsB;
+      if (!ReadFile(dirA + "/" + fileName, contentsA) || !ReadFile(dirB + "/" + fileName, contentsB))
+      {
+        difference = "Cannot read " + fileName;
+        return false;
+      }
+      if (contentsA != contentsB)
+      {
+        difference = "Contents of " + fileName + " differ";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  uint64_t GetDirectorySize(const std::string& directory)
+  {
+    std::vector<std::string> fileNames;
+    ListFiles(directory, fileNames);
+
+    uint64_t totalSize = 0;
+    for (const std::string& fileName : fileNames)
+      totalSize += vtksys::SystemTools::FileLength(directory + "/" + fileName);
+    return totalSize;
+  }
+}
@@ -0,0 +1,145 @@
+/*###############################################################################
+#
+# Copyright 2024 NVIDIA Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+###############################################################################*/
+
+
+#ifndef vtkOmniConnectTestUtilities_h
+#define vtkOmniConnectTestUtilities_h
+
+#include "vtkOmniConnectPass.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "OmniConnectProfiler.h"
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+
+class vtkActor;
+class vtkDataObject;
+class vtkImageData;
+class vtkPolyData;
+class vtkProp3D;
+class vtkRenderer;
+class vtkVolume;
+class vtkOmniConnectRendererNode;
+
+// Headless scene for tests and benchmarks: a renderer with synthetic actors, pushed through
+// vtkOmniConnectPass without an OpenGL context or an Omniverse server (see vtkOmniConnectUsdExporter).
+class vtkOmniConnectTestScene
+{
+public:
+  vtkOmniConnectTestScene();
+  ~vtkOmniConnectTestScene();
+
+  // Local usda output into <outputDirectory>/<sessionName>/
+  static vtkOmniConnectSettings MakeSettings(const std::string& outputDirectory, const char* sessionName = "Session");
+
+  bool Initialize(const vtkOmniConnectSettings& settings, double sceneTime = 0.0);
+  void Shutdown(); // Destroys the connector, which flushes all pending output
+
+  // Polydata gets a vtkPolyDataMapper, composite data a vtkCompositePolyDataMapper
+  vtkActor* AddMesh(const char* name, vtkDataObject* meshData);
+  vtkActor* AddGlyphs(const char* name, vtkPolyData* points);
+  // Image data gets a vtkSmartVolumeMapper, composite data a vtkMultiBlockVolumeMapper
+  vtkVolume* AddVolume(const char* name, vtkDataObject* volumeData);
+
+  // Animation time of an actor's data (DATA_TIME_STEP), as set by the render view
+  void SetAnimTime(vtkProp3D* prop, double animTime);
+
+  void Render(double sceneTime);
+
+  vtkRenderer* GetRenderer() { return this->Renderer; }
+  vtkOmniConnectRendererNode* GetRendererNode();
+  const vtkOmniConnectSettings& GetSettings() const { return this->Settings; }
+  std::string GetSessionDirectory() const;
+
+protected:
+  void AddProp(const char* name, vtkProp3D* prop);
+
+  vtkNew<vtkRenderer> Renderer;
+  vtkSmartPointer<vtkOmniConnectPass> Pass;
+  vtkOmniConnectSettings Settings;
+};
+
+// Per-stage totals in milliseconds of the profiler scopes, summed over all threads
+struct vtkOmniConnectStageTimings
+{
+  double Gather = 0.0;      // Extraction of vtk data, excluding triangulation
+  double Triangulate = 0.0; // Polygon triangulation into index buffers
+  double Author = 0.0;      // Usd authoring by the connector, excluding volume serialization
+  double Serialize = 0.0;   // Usd layer saves and vdb serialization
+  double Write = 0.0;       // Asset file writes by the connection
+  double DiscardedWriteBytes = 0.0; // Bytes counted by the null connection
+
+  void Accumulate(const std::vector<OmniConnectProfiler::Statistic>& statistics);
+  void Accumulate(const vtkOmniConnectStageTimings& other);
+  void WriteJson(std::ostream& os) const; // Single json object
+};
+
+namespace vtkOmniConnectTesting
+{
+  //
+  // Synthetic inputs, varying with phase to simulate animation
+  //
+
+  // Sphere with point normals and an active point scalar array "Scalars"
+  vtkSmartPointer<vtkPolyData> MakeMesh(int resolution, double phase = 0.0, const double center[3] = nullptr);
+  // Helices as polylines, with an active point scalar array "Scalars"
+  vtkSmartPointer<vtkPolyData> MakeLines(int numLines, int pointsPerLine, double phase = 0.0);
+  // Points with vertex cells and a point scalar array "Scalars"
+  vtkSmartPointer<vtkPolyData> MakeGlyphPoints(int numPoints, double phase = 0.0);
+  // Cube of dim^3 points with an active float point scalar array "Density"
+  vtkSmartPointer<vtkImageData> MakeVolume(int dim, double phase = 0.0, const double origin[3] = nullptr, double spacing = 1.0);
+  // 2D texture of width x height unsigned char tuples with numComponents (1-4), smooth gradients with some high frequency detail
+  vtkSmartPointer<vtkImageData> MakeTexture(int width, int height, int numComponents = 4, double phase = 0.0);
+
+  //
+  // Output inspection
+  //
+
+  // Parses -T <directory> from the test driver arguments and returns an empty <directory>/<testName>/
+  std::string GetOutputDirectory(int argc, char* argv[], const char* testName);
+  bool ReadFile(const std::string& fileName, std::string& contents);
+  // Files below directory, relative to it, sorted
+  void ListFiles(const std::string& directory, std::vector<std::string>& relativeFileNames);
+  // Concatenation of all usd(a) layers below directory
+  std::string ReadAllLayers(const std::string& directory);
+  size_t CountOccurrences(const std::string& text, const std::string& pattern);
+  // Values authored for an attribute declaration in usda text, as its default and/or time samples ("None" for blocks)
+  std::vector<std::string> FindAttributeValues(const std::string& layers, const std::string& declaration);
+  // Numbers in a usda value, ignoring brackets and parentheses
+  std::vector<double> ParseNumbers(const std::string& value);
+  // Asset paths in a usda value, written as @path@, without a leading "./"
+  std::vector<std::string> ParseAssetPaths(const std::string& value);
+  // Whether both directories contain the same files with the same contents, with a description of the first difference otherwise
+  bool CompareDirectories(const std::string& dirA, const std::string& dirB, std::string& difference);
+  uint64_t GetDirectorySize(const std::string& directory);
+}
+
+// Test failure reporting in the style of the vtk test drivers
+#define vtkOmniConnectTestAssert(condition, message) \
+  do { if (!(condition)) { std::cerr << "Test failure in " << __FILE__ << ":" << __LINE__ << ": " << message << std::endl; return EXIT_FAILURE; } } while(0)
+
+#endif